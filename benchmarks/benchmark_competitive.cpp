@@ -0,0 +1,632 @@
+#include "corpus_generators.hpp"
+#include <benchmark/benchmark.h>
+#include <jsom/jsom.hpp>
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#ifdef JSOM_HAVE_SIMDJSON
+#include <simdjson.h>
+#endif
+#ifdef JSOM_HAVE_RAPIDJSON
+#include <rapidjson/document.h>
+#include <rapidjson/pointer.h>
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
+#endif
+#ifdef JSOM_HAVE_YYJSON
+#include <yyjson.h>
+#endif
+
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+#include <malloc.h>
+#define JSOM_HAVE_MALLINFO2 1
+#endif
+
+// Competitive matrix: the generated corpora run through parse, parse+access, serialize and
+// JSON Pointer lookup in JSOM, nlohmann::json and, when built in, simdjson (DOM API),
+// RapidJSON and yyjson. Besides Google Benchmark's normal output, a combined table of MB/s
+// per library and of heap held by each parsed document is printed at the end.
+//
+// Corpus size defaults to 16 MB, as for BM_JSOM_Corpus_*; set JSOM_CORPUS_MB to change it.
+
+namespace {
+
+constexpr std::size_t LOOKUP_POINTERS = 64; // Pointers per lookup iteration
+
+struct Input {
+    std::string name;
+    std::string text;
+    std::vector<std::string> pointers; // Leaf values spread over the whole document
+#ifdef JSOM_HAVE_SIMDJSON
+    simdjson::padded_string padded;
+#endif
+};
+
+// RFC 6901 escaping of one reference token
+auto escape_token(const std::string& token) -> std::string {
+    std::string escaped;
+    for (char character : token) {
+        if (character == '~') {
+            escaped += "~0";
+        } else if (character == '/') {
+            escaped += "~1";
+        } else {
+            escaped += character;
+        }
+    }
+    return escaped;
+}
+
+auto count_leaves(const jsom::JsonDocument& doc) -> std::size_t {
+    std::size_t count = 0;
+    if (doc.is_object()) {
+        for (const auto& [key, value] : doc.as_object()) {
+            count += count_leaves(value);
+        }
+    } else if (doc.is_array()) {
+        for (const auto& value : doc.as_array()) {
+            count += count_leaves(value);
+        }
+    } else {
+        count = 1;
+    }
+    return count;
+}
+
+// Every `stride`-th leaf's pointer, up to LOOKUP_POINTERS
+void collect_pointers(const jsom::JsonDocument& doc, const std::string& path, std::size_t stride,
+                      std::size_t& seen, std::vector<std::string>& pointers) {
+    if (pointers.size() >= LOOKUP_POINTERS) {
+        return;
+    }
+    if (doc.is_object()) {
+        for (const auto& [key, value] : doc.as_object()) {
+            collect_pointers(value, path + "/" + escape_token(key), stride, seen, pointers);
+        }
+    } else if (doc.is_array()) {
+        const auto& values = doc.as_array();
+        for (std::size_t i = 0; i < values.size(); ++i) {
+            collect_pointers(values[i], path + "/" + std::to_string(i), stride, seen, pointers);
+        }
+    } else if (seen++ % stride == 0) {
+        pointers.push_back(path);
+    }
+}
+
+auto make_input(const std::string& name, std::string text) -> std::unique_ptr<Input> {
+    auto input = std::make_unique<Input>();
+    input->name = name;
+    input->text = std::move(text);
+    auto doc = jsom::parse_document(input->text);
+    std::size_t stride = std::max<std::size_t>(1, count_leaves(doc) / LOOKUP_POINTERS);
+    std::size_t seen = 0;
+    collect_pointers(doc, "", stride, seen, input->pointers);
+#ifdef JSOM_HAVE_SIMDJSON
+    input->padded = simdjson::padded_string(input->text);
+#endif
+    return input;
+}
+
+// Single-document corpora (NDJSON is covered by BM_JSOM_Corpus_*), generated on first use
+enum class Corpus : std::uint8_t { GeoJson, Twitter, DeepConfig, Unicode, Wide };
+constexpr std::array<Corpus, 5> CORPORA
+    = {Corpus::GeoJson, Corpus::Twitter, Corpus::DeepConfig, Corpus::Unicode, Corpus::Wide};
+
+auto corpus_name(Corpus corpus) -> const char* {
+    switch (corpus) {
+    case Corpus::GeoJson:
+        return "geojson";
+    case Corpus::Twitter:
+        return "twitter";
+    case Corpus::DeepConfig:
+        return "deep_config";
+    case Corpus::Unicode:
+        return "unicode";
+    case Corpus::Wide:
+        return "wide_object";
+    }
+    return "unknown";
+}
+
+auto input_for(Corpus corpus) -> const Input& {
+    static std::array<std::unique_ptr<Input>, CORPORA.size()> cache;
+    auto& input = cache[static_cast<std::size_t>(corpus)];
+    if (!input) {
+        std::size_t size = corpus::corpus_bytes();
+        switch (corpus) {
+        case Corpus::GeoJson:
+            input = make_input(corpus_name(corpus), corpus::geojson(size));
+            break;
+        case Corpus::Twitter:
+            input = make_input(corpus_name(corpus), corpus::twitter(size));
+            break;
+        case Corpus::DeepConfig:
+            input = make_input(corpus_name(corpus), corpus::deep_config(size));
+            break;
+        case Corpus::Unicode:
+            input = make_input(corpus_name(corpus), corpus::unicode_strings(size));
+            break;
+        case Corpus::Wide:
+            input = make_input(corpus_name(corpus), corpus::wide_object(size));
+            break;
+        }
+    }
+    return *input;
+}
+
+// Heap in use according to malloc, which every library here ends up in
+auto heap_in_use() -> std::size_t {
+#ifdef JSOM_HAVE_MALLINFO2
+    struct mallinfo2 info = mallinfo2();
+    return info.uordblks + info.hblkhd;
+#else
+    return 0;
+#endif
+}
+
+// ---------------------------------------------------------------------------------------
+// Library adapters: parse, visit every value, serialize compactly, look up a pointer
+// ---------------------------------------------------------------------------------------
+
+struct JsomLibrary {
+    static constexpr const char* NAME = "jsom";
+    using Document = jsom::JsonDocument;
+
+    static auto parse(const Input& input) -> Document { return jsom::parse_document(input.text); }
+
+    static auto visit(const Document& doc) -> std::size_t {
+        switch (doc.type()) {
+        case jsom::JsonType::Object: {
+            std::size_t count = 1;
+            for (const auto& [key, value] : doc.as_object()) {
+                benchmark::DoNotOptimize(key.size());
+                count += visit(value);
+            }
+            return count;
+        }
+        case jsom::JsonType::Array: {
+            std::size_t count = 1;
+            for (const auto& value : doc.as_array()) {
+                count += visit(value);
+            }
+            return count;
+        }
+        case jsom::JsonType::Number:
+            benchmark::DoNotOptimize(doc.as<double>());
+            return 1;
+        case jsom::JsonType::String:
+            benchmark::DoNotOptimize(doc.as<std::string>().size());
+            return 1;
+        default:
+            return 1;
+        }
+    }
+
+    static auto serialize(const Document& doc) -> std::size_t { return doc.to_json().size(); }
+
+    static auto lookup(Document& doc, const std::string& pointer) -> bool {
+        return doc.find(pointer) != nullptr;
+    }
+};
+
+struct NlohmannLibrary {
+    static constexpr const char* NAME = "nlohmann";
+    using Document = nlohmann::json;
+
+    static auto parse(const Input& input) -> Document { return nlohmann::json::parse(input.text); }
+
+    static auto visit(const Document& doc) -> std::size_t {
+        if (doc.is_object()) {
+            std::size_t count = 1;
+            for (const auto& [key, value] : doc.items()) {
+                benchmark::DoNotOptimize(key.size());
+                count += visit(value);
+            }
+            return count;
+        }
+        if (doc.is_array()) {
+            std::size_t count = 1;
+            for (const auto& value : doc) {
+                count += visit(value);
+            }
+            return count;
+        }
+        if (doc.is_number()) {
+            benchmark::DoNotOptimize(doc.get<double>());
+        } else if (doc.is_string()) {
+            benchmark::DoNotOptimize(doc.get_ref<const std::string&>().size());
+        }
+        return 1;
+    }
+
+    static auto serialize(const Document& doc) -> std::size_t { return doc.dump().size(); }
+
+    static auto lookup(Document& doc, const std::string& pointer) -> bool {
+        return doc.contains(nlohmann::json::json_pointer(pointer));
+    }
+};
+
+#ifdef JSOM_HAVE_SIMDJSON
+struct SimdjsonLibrary {
+    static constexpr const char* NAME = "simdjson";
+
+    // The parser owns the document's memory, so it travels with the root element
+    struct Document {
+        std::unique_ptr<simdjson::dom::parser> parser;
+        simdjson::dom::element root;
+    };
+
+    static auto parse(const Input& input) -> Document {
+        Document doc{std::make_unique<simdjson::dom::parser>(), {}};
+        if (auto error = doc.parser->parse(input.padded).get(doc.root)) {
+            throw std::runtime_error(simdjson::error_message(error));
+        }
+        return doc;
+    }
+
+    static auto visit(simdjson::dom::element element) -> std::size_t {
+        switch (element.type()) {
+        case simdjson::dom::element_type::OBJECT: {
+            std::size_t count = 1;
+            for (auto field : element.get_object()) {
+                benchmark::DoNotOptimize(field.key.size());
+                count += visit(field.value);
+            }
+            return count;
+        }
+        case simdjson::dom::element_type::ARRAY: {
+            std::size_t count = 1;
+            for (auto value : element.get_array()) {
+                count += visit(value);
+            }
+            return count;
+        }
+        case simdjson::dom::element_type::INT64:
+        case simdjson::dom::element_type::UINT64:
+        case simdjson::dom::element_type::DOUBLE:
+            benchmark::DoNotOptimize(element.get_double().value_unsafe());
+            return 1;
+        case simdjson::dom::element_type::STRING:
+            benchmark::DoNotOptimize(element.get_string().value_unsafe().size());
+            return 1;
+        default:
+            return 1;
+        }
+    }
+
+    static auto visit(const Document& doc) -> std::size_t { return visit(doc.root); }
+
+    static auto serialize(const Document& doc) -> std::size_t {
+        return simdjson::minify(doc.root).size();
+    }
+
+    static auto lookup(Document& doc, const std::string& pointer) -> bool {
+        return doc.root.at_pointer(pointer).error() == simdjson::SUCCESS;
+    }
+};
+#endif
+
+#ifdef JSOM_HAVE_RAPIDJSON
+struct RapidjsonLibrary {
+    static constexpr const char* NAME = "rapidjson";
+    using Document = rapidjson::Document;
+
+    static auto parse(const Input& input) -> Document {
+        Document doc;
+        doc.Parse(input.text.data(), input.text.size());
+        if (doc.HasParseError()) {
+            throw std::runtime_error("RapidJSON parse error");
+        }
+        return doc;
+    }
+
+    static auto visit(const rapidjson::Value& value) -> std::size_t {
+        if (value.IsObject()) {
+            std::size_t count = 1;
+            for (const auto& member : value.GetObject()) {
+                benchmark::DoNotOptimize(member.name.GetStringLength());
+                count += visit(member.value);
+            }
+            return count;
+        }
+        if (value.IsArray()) {
+            std::size_t count = 1;
+            for (const auto& element : value.GetArray()) {
+                count += visit(element);
+            }
+            return count;
+        }
+        if (value.IsNumber()) {
+            benchmark::DoNotOptimize(value.GetDouble());
+        } else if (value.IsString()) {
+            benchmark::DoNotOptimize(value.GetStringLength());
+        }
+        return 1;
+    }
+
+    static auto serialize(const Document& doc) -> std::size_t {
+        rapidjson::StringBuffer buffer;
+        rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+        doc.Accept(writer);
+        return buffer.GetSize();
+    }
+
+    static auto lookup(Document& doc, const std::string& pointer) -> bool {
+        return rapidjson::Pointer(pointer.c_str(), pointer.size()).Get(doc) != nullptr;
+    }
+};
+#endif
+
+#ifdef JSOM_HAVE_YYJSON
+struct YyjsonLibrary {
+    static constexpr const char* NAME = "yyjson";
+
+    struct Free {
+        void operator()(yyjson_doc* doc) const { yyjson_doc_free(doc); }
+    };
+    using Document = std::unique_ptr<yyjson_doc, Free>;
+
+    static auto parse(const Input& input) -> Document {
+        Document doc(yyjson_read(input.text.data(), input.text.size(), 0));
+        if (!doc) {
+            throw std::runtime_error("yyjson parse error");
+        }
+        return doc;
+    }
+
+    static auto visit(yyjson_val* value) -> std::size_t {
+        if (yyjson_is_obj(value)) {
+            std::size_t count = 1;
+            yyjson_obj_iter iter;
+            yyjson_obj_iter_init(value, &iter);
+            while (yyjson_val* key = yyjson_obj_iter_next(&iter)) {
+                benchmark::DoNotOptimize(yyjson_get_len(key));
+                count += visit(yyjson_obj_iter_get_val(key));
+            }
+            return count;
+        }
+        if (yyjson_is_arr(value)) {
+            std::size_t count = 1;
+            yyjson_arr_iter iter;
+            yyjson_arr_iter_init(value, &iter);
+            while (yyjson_val* element = yyjson_arr_iter_next(&iter)) {
+                count += visit(element);
+            }
+            return count;
+        }
+        if (yyjson_is_num(value)) {
+            benchmark::DoNotOptimize(yyjson_get_num(value));
+        } else if (yyjson_is_str(value)) {
+            benchmark::DoNotOptimize(yyjson_get_len(value));
+        }
+        return 1;
+    }
+
+    static auto visit(const Document& doc) -> std::size_t {
+        return visit(yyjson_doc_get_root(doc.get()));
+    }
+
+    static auto serialize(const Document& doc) -> std::size_t {
+        std::size_t length = 0;
+        char* output = yyjson_write(doc.get(), 0, &length);
+        std::free(output); // NOLINT(cppcoreguidelines-no-malloc)
+        return length;
+    }
+
+    static auto lookup(Document& doc, const std::string& pointer) -> bool {
+        return yyjson_doc_ptr_getn(doc.get(), pointer.data(), pointer.size()) != nullptr;
+    }
+};
+#endif
+
+// ---------------------------------------------------------------------------------------
+// Operations, identical for every library
+// ---------------------------------------------------------------------------------------
+
+void set_input_bytes(benchmark::State& state, const Input& input) {
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations())
+                            * static_cast<int64_t>(input.text.size()));
+}
+
+template <typename Library> void BM_Parse(benchmark::State& state, Corpus corpus) {
+    const Input& input = input_for(corpus);
+    // NOLINTNEXTLINE(readability-identifier-length)
+    for (auto _ : state) {
+        auto doc = Library::parse(input);
+        benchmark::DoNotOptimize(doc);
+    }
+    set_input_bytes(state, input);
+
+    // Heap held by one parsed document, measured outside the timed loop
+    std::size_t before = heap_in_use();
+    auto doc = Library::parse(input);
+    std::size_t after = heap_in_use();
+    if (after > before) {
+        std::size_t held = after - before;
+        state.counters["doc_bytes"] = static_cast<double>(held);
+        state.counters["doc_ratio"]
+            = static_cast<double>(held) / static_cast<double>(input.text.size());
+    }
+}
+
+template <typename Library> void BM_ParseAccess(benchmark::State& state, Corpus corpus) {
+    const Input& input = input_for(corpus);
+    // NOLINTNEXTLINE(readability-identifier-length)
+    for (auto _ : state) {
+        auto doc = Library::parse(input);
+        benchmark::DoNotOptimize(Library::visit(doc));
+    }
+    set_input_bytes(state, input);
+}
+
+template <typename Library> void BM_Serialize(benchmark::State& state, Corpus corpus) {
+    const Input& input = input_for(corpus);
+    auto doc = Library::parse(input);
+    // NOLINTNEXTLINE(readability-identifier-length)
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(Library::serialize(doc));
+    }
+    set_input_bytes(state, input);
+}
+
+template <typename Library> void BM_PointerLookup(benchmark::State& state, Corpus corpus) {
+    const Input& input = input_for(corpus);
+    auto doc = Library::parse(input);
+    std::size_t found = 0;
+    // NOLINTNEXTLINE(readability-identifier-length)
+    for (auto _ : state) {
+        found = 0;
+        for (const auto& pointer : input.pointers) {
+            found += Library::lookup(doc, pointer) ? 1 : 0;
+        }
+        benchmark::DoNotOptimize(found);
+    }
+    if (found != input.pointers.size()) {
+        state.SkipWithError("pointer lookup missed values");
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations())
+                            * static_cast<int64_t>(input.pointers.size()));
+}
+
+constexpr std::array<const char*, 4> OPERATIONS = {"Parse", "ParseAccess", "Serialize",
+                                                   "PointerLookup"};
+
+template <typename Library> void register_library() {
+    using Function = void (*)(benchmark::State&, Corpus);
+    constexpr std::array<Function, OPERATIONS.size()> FUNCTIONS
+        = {BM_Parse<Library>, BM_ParseAccess<Library>, BM_Serialize<Library>,
+           BM_PointerLookup<Library>};
+    for (std::size_t op = 0; op < OPERATIONS.size(); ++op) {
+        for (Corpus corpus : CORPORA) {
+            // Names are "<operation>/<corpus>/<library>"; the summary table splits them
+            std::string name = std::string(OPERATIONS[op]) + "/" + corpus_name(corpus) + "/"
+                               + Library::NAME;
+            benchmark::RegisterBenchmark(name.c_str(), FUNCTIONS[op], corpus)
+                ->Unit(benchmark::kMillisecond);
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------------------
+// Combined table
+// ---------------------------------------------------------------------------------------
+
+// Console output as usual, plus one table per metric with a column per library
+class MatrixReporter : public benchmark::ConsoleReporter {
+public:
+    void ReportRuns(const std::vector<Run>& reports) override {
+        ConsoleReporter::ReportRuns(reports);
+        for (const auto& run : reports) {
+            if (run.run_type != Run::RT_Iteration) {
+                continue;
+            }
+            std::string name = run.benchmark_name();
+            std::size_t split = name.rfind('/');
+            if (split == std::string::npos) {
+                continue;
+            }
+            std::string row = name.substr(0, split);
+            std::string library = name.substr(split + 1);
+            if (std::find(libraries_.begin(), libraries_.end(), library) == libraries_.end()) {
+                libraries_.push_back(library);
+            }
+            if (std::find(rows_.begin(), rows_.end(), row) == rows_.end()) {
+                rows_.push_back(row);
+            }
+            store(throughput_, run, "bytes_per_second", row, library);
+            store(throughput_, run, "items_per_second", row, library);
+            store(memory_, run, "doc_ratio", row, library);
+        }
+    }
+
+    void Finalize() override {
+        ConsoleReporter::Finalize();
+        print_table("Throughput (MB/s of input; PointerLookup: thousand lookups/s)", throughput_,
+                    [](const std::string& row, double value) {
+                        constexpr double THOUSAND = 1000.0;
+                        return row.rfind("PointerLookup", 0) == 0
+                                   ? value / THOUSAND
+                                   : value / static_cast<double>(corpus::BYTES_PER_MB);
+                    });
+        print_table("Heap held by the parsed document (x input size)", memory_,
+                    [](const std::string& /*row*/, double value) { return value; });
+    }
+
+private:
+    using Table = std::map<std::string, std::map<std::string, double>>;
+    std::vector<std::string> rows_;
+    std::vector<std::string> libraries_;
+    Table throughput_;
+    Table memory_;
+
+    static void store(Table& table, const Run& run, const char* counter, const std::string& row,
+                      const std::string& library) {
+        auto found = run.counters.find(counter);
+        if (found != run.counters.end()) {
+            table[row][library] = found->second.value;
+        }
+    }
+
+    template <typename Scale>
+    void print_table(const char* title, const Table& table, Scale scale) const {
+        if (table.empty()) {
+            return;
+        }
+        constexpr int ROW_WIDTH = 28;
+        constexpr int COLUMN_WIDTH = 12;
+        std::printf("\n%s\n%-*s", title, ROW_WIDTH, "");
+        for (const auto& library : libraries_) {
+            std::printf("%*s", COLUMN_WIDTH, library.c_str());
+        }
+        std::printf("\n");
+        for (const auto& row : rows_) {
+            auto cells = table.find(row);
+            if (cells == table.end()) {
+                continue;
+            }
+            std::printf("%-*s", ROW_WIDTH, row.c_str());
+            for (const auto& library : libraries_) {
+                auto cell = cells->second.find(library);
+                if (cell == cells->second.end()) {
+                    std::printf("%*s", COLUMN_WIDTH, "-");
+                } else {
+                    std::printf("%*.2f", COLUMN_WIDTH, scale(row, cell->second));
+                }
+            }
+            std::printf("\n");
+        }
+    }
+};
+
+} // namespace
+
+auto main(int argc, char** argv) -> int {
+    ::benchmark::Initialize(&argc, argv);
+    if (::benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+
+    register_library<JsomLibrary>();
+    register_library<NlohmannLibrary>();
+#ifdef JSOM_HAVE_SIMDJSON
+    register_library<SimdjsonLibrary>();
+#endif
+#ifdef JSOM_HAVE_RAPIDJSON
+    register_library<RapidjsonLibrary>();
+#endif
+#ifdef JSOM_HAVE_YYJSON
+    register_library<YyjsonLibrary>();
+#endif
+
+    MatrixReporter reporter;
+    ::benchmark::RunSpecifiedBenchmarks(&reporter);
+    ::benchmark::Shutdown();
+}
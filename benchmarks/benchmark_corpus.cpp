@@ -0,0 +1,181 @@
+#include "benchmark_utils.hpp"
+#include "corpus_generators.hpp"
+#include "perf_counters.hpp"
+#include <benchmark/benchmark.h>
+#include <jsom/jsom.hpp>
+#include <array>
+#include <string>
+#include <vector>
+
+// Large-corpus benchmarks: parse, navigate, format and serialize throughput over the
+// generated corpora. Every result is reported against the corpus's input size, so the
+// bytes_per_second column reads as MB/s of JSON handled.
+//
+// Corpus size defaults to 16 MB and can be raised to production sizes with the
+// JSOM_CORPUS_MB environment variable, e.g. JSOM_CORPUS_MB=1024.
+
+namespace {
+
+enum class Corpus : std::uint8_t { GeoJson, Twitter, LogNdjson, DeepConfig, Unicode, Wide };
+constexpr std::size_t CORPUS_COUNT = 6;
+
+// Generated once per process; large corpora are expensive to build
+auto corpus_text(Corpus corpus) -> const std::string& {
+    static std::array<std::string, CORPUS_COUNT> cache;
+    auto& text = cache[static_cast<std::size_t>(corpus)];
+    if (text.empty()) {
+        std::size_t size = corpus::corpus_bytes();
+        switch (corpus) {
+        case Corpus::GeoJson:
+            text = corpus::geojson(size);
+            break;
+        case Corpus::Twitter:
+            text = corpus::twitter(size);
+            break;
+        case Corpus::LogNdjson:
+            text = corpus::log_ndjson(size);
+            break;
+        case Corpus::DeepConfig:
+            text = corpus::deep_config(size);
+            break;
+        case Corpus::Unicode:
+            text = corpus::unicode_strings(size);
+            break;
+        case Corpus::Wide:
+            text = corpus::wide_object(size);
+            break;
+        }
+    }
+    return text;
+}
+
+// Parse a corpus: one document, or one per line for NDJSON
+auto parse_corpus(Corpus corpus) -> std::vector<jsom::JsonDocument> {
+    const std::string& text = corpus_text(corpus);
+    std::vector<jsom::JsonDocument> docs;
+    if (corpus != Corpus::LogNdjson) {
+        docs.push_back(jsom::parse_document(text));
+        return docs;
+    }
+    std::size_t start = 0;
+    while (start < text.size()) {
+        std::size_t end = text.find('\n', start);
+        if (end == std::string::npos) {
+            end = text.size();
+        }
+        if (end > start) {
+            docs.push_back(jsom::parse_document(text.substr(start, end - start)));
+        }
+        start = end + 1;
+    }
+    return docs;
+}
+
+// Visit every value, decoding numbers and reading strings as a consumer would
+auto visit(const jsom::JsonDocument& doc) -> std::size_t {
+    switch (doc.type()) {
+    case jsom::JsonType::Object: {
+        std::size_t count = 1;
+        for (const auto& [key, value] : doc.as_object()) {
+            benchmark::DoNotOptimize(key.data());
+            count += visit(value);
+        }
+        return count;
+    }
+    case jsom::JsonType::Array: {
+        std::size_t count = 1;
+        for (const auto& value : doc.as_array()) {
+            count += visit(value);
+        }
+        return count;
+    }
+    case jsom::JsonType::Number:
+        benchmark::DoNotOptimize(doc.as<double>());
+        return 1;
+    case jsom::JsonType::String:
+        benchmark::DoNotOptimize(doc.as<std::string>().size());
+        return 1;
+    default:
+        return 1;
+    }
+}
+
+void set_corpus_bytes(benchmark::State& state, Corpus corpus) {
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations())
+                            * static_cast<int64_t>(corpus_text(corpus).size()));
+}
+
+} // namespace
+
+static void BM_JSOM_Corpus_Parse(benchmark::State& state, Corpus corpus) {
+    corpus_text(corpus); // Generate outside the timed loop
+    benchmark_utils::AllocationCounters allocations;
+    benchmark_utils::PerfCounters counters;
+    // NOLINTNEXTLINE(readability-identifier-length)
+    for (auto _ : state) {
+        auto docs = parse_corpus(corpus);
+        benchmark::DoNotOptimize(docs);
+    }
+    counters.report(state, corpus_text(corpus).size());
+    allocations.report(state);
+    set_corpus_bytes(state, corpus);
+}
+
+static void BM_JSOM_Corpus_Navigate(benchmark::State& state, Corpus corpus) {
+    auto docs = parse_corpus(corpus);
+    std::size_t nodes = 0;
+    // NOLINTNEXTLINE(readability-identifier-length)
+    for (auto _ : state) {
+        nodes = 0;
+        for (const auto& doc : docs) {
+            nodes += visit(doc);
+        }
+        benchmark::DoNotOptimize(nodes);
+    }
+    state.counters["nodes"] = static_cast<double>(nodes);
+    set_corpus_bytes(state, corpus);
+}
+
+static void BM_JSOM_Corpus_Format(benchmark::State& state, Corpus corpus) {
+    auto docs = parse_corpus(corpus);
+    benchmark_utils::PerfCounters counters;
+    // NOLINTNEXTLINE(readability-identifier-length)
+    for (auto _ : state) {
+        for (const auto& doc : docs) {
+            auto output = doc.to_json(jsom::FormatPresets::Pretty);
+            benchmark::DoNotOptimize(output);
+        }
+    }
+    counters.report(state, corpus_text(corpus).size());
+    set_corpus_bytes(state, corpus);
+}
+
+static void BM_JSOM_Corpus_Serialize(benchmark::State& state, Corpus corpus) {
+    auto docs = parse_corpus(corpus);
+    benchmark_utils::PerfCounters counters;
+    // NOLINTNEXTLINE(readability-identifier-length)
+    for (auto _ : state) {
+        for (const auto& doc : docs) {
+            auto output = doc.to_json();
+            benchmark::DoNotOptimize(output);
+        }
+    }
+    counters.report(state, corpus_text(corpus).size());
+    set_corpus_bytes(state, corpus);
+}
+
+// One benchmark per operation and corpus; whole-corpus iterations are long, so report
+// in milliseconds
+#define JSOM_CORPUS_BENCHMARKS(operation)                                                         \
+    BENCHMARK_CAPTURE(operation, geojson, Corpus::GeoJson)->Unit(benchmark::kMillisecond);      \
+    BENCHMARK_CAPTURE(operation, twitter, Corpus::Twitter)->Unit(benchmark::kMillisecond);      \
+    BENCHMARK_CAPTURE(operation, log_ndjson, Corpus::LogNdjson)->Unit(benchmark::kMillisecond); \
+    BENCHMARK_CAPTURE(operation, deep_config, Corpus::DeepConfig)                               \
+        ->Unit(benchmark::kMillisecond);                                                        \
+    BENCHMARK_CAPTURE(operation, unicode, Corpus::Unicode)->Unit(benchmark::kMillisecond);      \
+    BENCHMARK_CAPTURE(operation, wide_object, Corpus::Wide)->Unit(benchmark::kMillisecond)
+
+JSOM_CORPUS_BENCHMARKS(BM_JSOM_Corpus_Parse);
+JSOM_CORPUS_BENCHMARKS(BM_JSOM_Corpus_Navigate);
+JSOM_CORPUS_BENCHMARKS(BM_JSOM_Corpus_Format);
+JSOM_CORPUS_BENCHMARKS(BM_JSOM_Corpus_Serialize);
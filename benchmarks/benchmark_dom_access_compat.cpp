@@ -1,4 +1,5 @@
 #include "benchmark_utils.hpp"
+#include "perf_counters.hpp"
 #include <benchmark/benchmark.h>
 #include <jsom/jsom.hpp>
 #include <nlohmann/json.hpp>
@@ -43,17 +44,17 @@ static void BM_JSOM_TypeChecking_Medium(benchmark::State& state) {
 
     // NOLINTNEXTLINE(readability-identifier-length)
     for (auto _ : state) {
-        // Type checking operations
-        bool status_is_string = doc["status"].is_string();
+        // Type checking operations; get_if<T>() checks and yields the value without copying
+        bool status_is_string = doc["status"].get_if<std::string>() != nullptr;
         bool page_is_number = doc["pagination"]["page"].is_number();
-        bool data_is_array = doc["data"].is_array();
+        bool data_is_array = doc["data"].get_if<std::vector<jsom::JsonDocument>>() != nullptr;
 
         // Check types of first 10 items
         // NOLINTNEXTLINE(readability-magic-numbers)
         for (int i = 0; i < 10; ++i) {
             bool id_is_number = doc["data"][i]["id"].is_number();
-            bool name_is_string = doc["data"][i]["name"].is_string();
-            bool active_is_bool = doc["data"][i]["active"].is_bool();
+            bool name_is_string = doc["data"][i]["name"].get_if<std::string>() != nullptr;
+            bool active_is_bool = doc["data"][i]["active"].get_if<bool>() != nullptr;
 
             benchmark::DoNotOptimize(id_is_number);
             benchmark::DoNotOptimize(name_is_string);
@@ -79,7 +80,8 @@ static void BM_JSOM_Construction(benchmark::State& state) {
             {"salary", jsom::JsonDocument(75000.50)},
             {"active", jsom::JsonDocument(true)},
             {"tags",
-             jsom::JsonDocument{jsom::JsonDocument("developer"), jsom::JsonDocument("senior")}},
+             jsom::JsonDocument(std::vector<jsom::JsonDocument>{jsom::JsonDocument("developer"),
+                                                                jsom::JsonDocument("senior")})},
             {"address", jsom::JsonDocument{{"street", jsom::JsonDocument("123 Main St")},
                                            // NOLINTNEXTLINE(readability-magic-numbers)
                                            {"zip", jsom::JsonDocument(12345)}}}};
@@ -94,17 +96,132 @@ static void BM_JSOM_Serialization_Medium(benchmark::State& state) {
     auto json = benchmark_utils::get_medium_json();
     auto doc = jsom::parse_document(json);
 
+    benchmark_utils::PerfCounters counters;
     // NOLINTNEXTLINE(readability-identifier-length)
     for (auto _ : state) {
         auto output = doc.to_json();
         benchmark::DoNotOptimize(output);
     }
+    counters.report(state, json.size());
     state.SetBytesProcessed(static_cast<int64_t>(state.iterations())
                             * static_cast<int64_t>(json.size()));
 }
 BENCHMARK(BM_JSOM_Serialization_Medium);
 
+// Key enumeration of every record: keys() copies each key, key_view() reads them in place
+static void BM_JSOM_ObjectKeys_Vector(benchmark::State& state) {
+    auto doc = jsom::parse_document(benchmark_utils::get_medium_json());
+
+    // NOLINTNEXTLINE(readability-identifier-length)
+    for (auto _ : state) {
+        std::size_t key_bytes = 0;
+        for (const auto& record : doc["data"]) {
+            for (const auto& key : record.keys()) {
+                key_bytes += key.size();
+            }
+        }
+        benchmark::DoNotOptimize(key_bytes);
+    }
+}
+BENCHMARK(BM_JSOM_ObjectKeys_Vector);
+
+static void BM_JSOM_ObjectKeys_View(benchmark::State& state) {
+    auto doc = jsom::parse_document(benchmark_utils::get_medium_json());
+
+    // NOLINTNEXTLINE(readability-identifier-length)
+    for (auto _ : state) {
+        std::size_t key_bytes = 0;
+        for (const auto& record : doc["data"]) {
+            for (const auto& key : record.key_view()) {
+                key_bytes += key.size();
+            }
+        }
+        benchmark::DoNotOptimize(key_bytes);
+    }
+}
+BENCHMARK(BM_JSOM_ObjectKeys_View);
+
 // nlohmann::json comparison benchmarks
+// Three fields from each of the 5000 user records, looked up by key in per-object maps and
+// then in shared object shapes
+static void record_fields(benchmark::State& state, const jsom::JsonDocument& doc) {
+    // NOLINTNEXTLINE(readability-identifier-length)
+    for (auto _ : state) {
+        long long sum = 0;
+        for (const auto& user : doc["users"]) {
+            sum += user["id"].as<long long>();
+            sum += static_cast<long long>(user["email"].as_string_view().size());
+            sum += user["activity"]["posts_count"].as<int>();
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+}
+
+static void BM_JSOM_RecordFields_Large(benchmark::State& state) {
+    record_fields(state, jsom::parse_document(benchmark_utils::get_large_json()));
+}
+BENCHMARK(BM_JSOM_RecordFields_Large);
+
+static void BM_JSOM_RecordFields_Large_SharedShapes(benchmark::State& state) {
+    jsom::JsonParseOptions options;
+    options.share_object_shapes = true;
+    record_fields(state, jsom::parse_document(benchmark_utils::get_large_json(), options));
+}
+BENCHMARK(BM_JSOM_RecordFields_Large_SharedShapes);
+
+// Each of the 5000 user records as a document of its own, as from a message stream
+static auto user_documents(const jsom::JsonParseOptions& options)
+    -> std::vector<jsom::JsonDocument> {
+    const auto records = jsom::parse_document(benchmark_utils::get_large_json());
+    std::vector<jsom::JsonDocument> users;
+    for (const auto& user : records["users"]) {
+        users.push_back(jsom::parse_document(user.to_json(), options));
+    }
+    return users;
+}
+
+// One pointer read from every record: at() parses the pointer and goes through each document's
+// own path cache on every call, while one Extractor parses it once and keeps its inline caches
+// from one document to the next
+static void pointer_per_document(benchmark::State& state, bool shared_shapes, bool extractor) {
+    jsom::JsonParseOptions options;
+    options.share_object_shapes = shared_shapes;
+    const auto users = user_documents(options);
+    const std::string pointer = "/activity/posts_count";
+    jsom::Extractor posts_count(pointer);
+
+    // NOLINTNEXTLINE(readability-identifier-length)
+    for (auto _ : state) {
+        long long sum = 0;
+        for (const auto& user : users) {
+            sum += (extractor ? posts_count.at(user) : user.at(pointer)).as<int>();
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations())
+                            * static_cast<int64_t>(users.size()));
+}
+
+static void BM_JSOM_FreshAt_Records(benchmark::State& state) {
+    pointer_per_document(state, false, false);
+}
+BENCHMARK(BM_JSOM_FreshAt_Records);
+
+static void BM_JSOM_Extractor_Records(benchmark::State& state) {
+    pointer_per_document(state, false, true);
+}
+BENCHMARK(BM_JSOM_Extractor_Records);
+
+static void BM_JSOM_FreshAt_Records_SharedShapes(benchmark::State& state) {
+    pointer_per_document(state, true, false);
+}
+BENCHMARK(BM_JSOM_FreshAt_Records_SharedShapes);
+
+static void BM_JSOM_Extractor_Records_SharedShapes(benchmark::State& state) {
+    pointer_per_document(state, true, true);
+}
+BENCHMARK(BM_JSOM_Extractor_Records_SharedShapes);
+
 static void BM_Nlohmann_ContainerAccess_Medium(benchmark::State& state) {
     auto json = benchmark_utils::get_medium_json();
     auto doc = nlohmann::json::parse(json);
@@ -183,11 +300,13 @@ static void BM_Nlohmann_Serialization_Medium(benchmark::State& state) {
     auto json = benchmark_utils::get_medium_json();
     auto doc = nlohmann::json::parse(json);
 
+    benchmark_utils::PerfCounters counters;
     // NOLINTNEXTLINE(readability-identifier-length)
     for (auto _ : state) {
         auto output = doc.dump();
         benchmark::DoNotOptimize(output);
     }
+    counters.report(state, json.size());
     state.SetBytesProcessed(static_cast<int64_t>(state.iterations())
                             * static_cast<int64_t>(json.size()));
 }
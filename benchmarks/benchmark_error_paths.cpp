@@ -0,0 +1,88 @@
+#include "benchmark_utils.hpp"
+#include <benchmark/benchmark.h>
+#include <jsom/jsom.hpp>
+#include <string>
+#include <vector>
+
+// Misses and invalid input: lookups of absent paths and parses of malformed documents.
+// These paths report failure through return values, so their cost should be close to a
+// successful lookup or parse of the same size rather than an exception unwind.
+
+namespace {
+// Absent keys, out-of-range indices and a malformed pointer, all against the medium document
+auto missing_paths() -> std::vector<std::string> {
+    return {"/missing", "/pagination/missing", "/data/999", "/data/0/missing",
+            "/data/0/price/missing/deeper", "/status/0", "no-leading-slash"};
+}
+
+// Each input fails at a different stage of the parser
+auto invalid_documents() -> std::vector<std::string> {
+    return {R"({"a": 1,})", R"([1, 2)", R"({"key" 1})", R"("unterminated)", R"(tru)",
+            R"({"a": [1, 2, 3]} trailing)", R"(["\uZZZZ"])"};
+}
+} // namespace
+
+static void BM_JSOM_Find_Miss(benchmark::State& state) {
+    auto doc = jsom::parse_document(benchmark_utils::get_medium_json());
+    auto paths = missing_paths();
+
+    // NOLINTNEXTLINE(readability-identifier-length)
+    for (auto _ : state) {
+        for (const auto& path : paths) {
+            benchmark::DoNotOptimize(doc.find(path));
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations())
+                            * static_cast<int64_t>(paths.size()));
+}
+BENCHMARK(BM_JSOM_Find_Miss);
+
+static void BM_JSOM_Exists_Miss(benchmark::State& state) {
+    auto doc = jsom::parse_document(benchmark_utils::get_medium_json());
+    auto paths = missing_paths();
+
+    // NOLINTNEXTLINE(readability-identifier-length)
+    for (auto _ : state) {
+        for (const auto& path : paths) {
+            benchmark::DoNotOptimize(doc.exists(path));
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations())
+                            * static_cast<int64_t>(paths.size()));
+}
+BENCHMARK(BM_JSOM_Exists_Miss);
+
+// Invalid input through the throwing API, as callers without try_parse_document() do it
+static void BM_JSOM_Parse_InvalidCatch(benchmark::State& state) {
+    auto inputs = invalid_documents();
+
+    // NOLINTNEXTLINE(readability-identifier-length)
+    for (auto _ : state) {
+        for (const auto& input : inputs) {
+            try {
+                benchmark::DoNotOptimize(jsom::parse_document(input));
+            } catch (const std::exception& error) {
+                benchmark::DoNotOptimize(error.what());
+            }
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations())
+                            * static_cast<int64_t>(inputs.size()));
+}
+BENCHMARK(BM_JSOM_Parse_InvalidCatch);
+
+// The same inputs through try_parse_document(): the failure comes back as a value
+static void BM_JSOM_TryParse_Invalid(benchmark::State& state) {
+    auto inputs = invalid_documents();
+
+    // NOLINTNEXTLINE(readability-identifier-length)
+    for (auto _ : state) {
+        for (const auto& input : inputs) {
+            auto result = jsom::try_parse_document(input);
+            benchmark::DoNotOptimize(result.error().offset);
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations())
+                            * static_cast<int64_t>(inputs.size()));
+}
+BENCHMARK(BM_JSOM_TryParse_Invalid);
@@ -17,8 +17,8 @@ static void BM_JSOM_MixedAccess_Medium(benchmark::State& state) {
 
     // NOLINTNEXTLINE(readability-identifier-length)
     for (auto _ : state) {
-        // String access (no lazy evaluation)
-        auto status = doc["status"].as<std::string>();
+        // String access (no lazy evaluation, no copy)
+        auto status = doc["status"].as_string_view();
 
         // Number access (triggers lazy evaluation)
         auto page = doc["pagination"]["page"].as<int>();
@@ -29,7 +29,7 @@ static void BM_JSOM_MixedAccess_Medium(benchmark::State& state) {
         for (int i = 0; i < FIRST_N_RECORDS; ++i) {
             // NOLINTNEXTLINE(readability-identifier-length)
             auto id = doc["data"][i]["id"].as<int>();
-            auto name = doc["data"][i]["name"].as<std::string>();
+            auto name = doc["data"][i]["name"].as_string_view();
             auto price = doc["data"][i]["price"]["amount"].as<double>();
 
             benchmark::DoNotOptimize(id);
@@ -118,14 +118,14 @@ static void BM_Nlohmann_MixedAccess_Medium(benchmark::State& state) {
 
     // NOLINTNEXTLINE(readability-identifier-length)
     for (auto _ : state) {
-        auto status = doc["status"].get<std::string>();
+        const auto& status = doc["status"].get_ref<const std::string&>();
         auto page = doc["pagination"]["page"].get<int>();
         auto total = doc["pagination"]["total"].get<int>();
 
         for (int i = 0; i < FIRST_N_RECORDS; ++i) {
             // NOLINTNEXTLINE(readability-identifier-length)
             auto id = doc["data"][i]["id"].get<int>();
-            auto name = doc["data"][i]["name"].get<std::string>();
+            const auto& name = doc["data"][i]["name"].get_ref<const std::string&>();
             auto price = doc["data"][i]["price"]["amount"].get<double>();
 
             benchmark::DoNotOptimize(id);
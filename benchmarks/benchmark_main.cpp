@@ -5,5 +5,12 @@ auto main(int argc, char** argv) -> int {
     if (::benchmark::ReportUnrecognizedArguments(argc, argv)) {
         return 1;
     }
+    // library_build_type in the context describes Google Benchmark's own build, which may be
+    // a prebuilt package; jsom_build_type is the build of the code being measured
+#ifdef NDEBUG
+    ::benchmark::AddCustomContext("jsom_build_type", "release");
+#else
+    ::benchmark::AddCustomContext("jsom_build_type", "debug");
+#endif
     ::benchmark::RunSpecifiedBenchmarks();
-}
\ No newline at end of file
+}
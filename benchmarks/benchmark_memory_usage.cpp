@@ -1,10 +1,22 @@
 #include "benchmark_utils.hpp"
+#include "corpus_generators.hpp"
 #include <benchmark/benchmark.h>
 #include <jsom/jsom.hpp>
+#include <memory>
 
 namespace {
 constexpr int DOCUMENT_COUNT = 100;
 constexpr int ACCESS_COUNT = 10;
+constexpr std::size_t DEDUP_CORPUS_BYTES = std::size_t{4} << 20U; // 4 MB
+
+// Heap held by one document, from JsonDocument::memory_usage()
+void report_document_memory(benchmark::State& state, const jsom::JsonDocument& doc) {
+    auto usage = doc.memory_usage();
+    state.counters["doc_bytes"] = static_cast<double>(usage.total());
+    state.counters["doc_containers"] = static_cast<double>(usage.containers);
+    state.counters["doc_map_nodes"] = static_cast<double>(usage.map_nodes);
+    state.counters["doc_strings"] = static_cast<double>(usage.strings + usage.numbers);
+}
 } // namespace
 #include <nlohmann/json.hpp>
 
@@ -21,6 +33,7 @@ static void BM_JSOM_SmallNumbers(benchmark::State& state) {
         "retry": 3
     })";
 
+    benchmark_utils::AllocationCounters allocations;
     // NOLINTNEXTLINE(readability-identifier-length)
     for (auto _ : state) {
         auto doc = jsom::parse_document(json);
@@ -33,6 +46,8 @@ static void BM_JSOM_SmallNumbers(benchmark::State& state) {
         benchmark::DoNotOptimize(count);
         benchmark::DoNotOptimize(page);
     }
+    allocations.report(state);
+    report_document_memory(state, jsom::parse_document(json));
     state.SetBytesProcessed(static_cast<int64_t>(state.iterations())
                             * static_cast<int64_t>(strlen(json)));
 }
@@ -47,6 +62,7 @@ static void BM_JSOM_LargeNumbers(benchmark::State& state) {
         "transaction_id": 555444333222111
     })";
 
+    benchmark_utils::AllocationCounters allocations;
     // NOLINTNEXTLINE(readability-identifier-length)
     for (auto _ : state) {
         auto doc = jsom::parse_document(json);
@@ -59,6 +75,8 @@ static void BM_JSOM_LargeNumbers(benchmark::State& state) {
         benchmark::DoNotOptimize(id);
         benchmark::DoNotOptimize(timestamp);
     }
+    allocations.report(state);
+    report_document_memory(state, jsom::parse_document(json));
     state.SetBytesProcessed(static_cast<int64_t>(state.iterations())
                             * static_cast<int64_t>(strlen(json)));
 }
@@ -68,6 +86,7 @@ BENCHMARK(BM_JSOM_LargeNumbers);
 static void BM_JSOM_ManyDocuments(benchmark::State& state) {
     auto json = benchmark_utils::get_small_json();
 
+    benchmark_utils::AllocationCounters allocations;
     // NOLINTNEXTLINE(readability-identifier-length)
     for (auto _ : state) {
         std::vector<jsom::JsonDocument> docs;
@@ -87,6 +106,8 @@ static void BM_JSOM_ManyDocuments(benchmark::State& state) {
 
         benchmark::DoNotOptimize(docs);
     }
+    allocations.report(state);
+    report_document_memory(state, jsom::parse_document(json)); // Per document
     state.SetBytesProcessed(static_cast<int64_t>(state.iterations())
                             * static_cast<int64_t>(json.size()) * DOCUMENT_COUNT);
 }
@@ -97,6 +118,7 @@ static void BM_JSOM_DocumentCopy(benchmark::State& state) {
     auto json = benchmark_utils::get_medium_json();
     auto original = jsom::parse_document(json);
 
+    benchmark_utils::AllocationCounters allocations;
     // NOLINTNEXTLINE(readability-identifier-length)
     for (auto _ : state) {
         // Copy document (should copy lazy evaluation state)
@@ -112,9 +134,118 @@ static void BM_JSOM_DocumentCopy(benchmark::State& state) {
         benchmark::DoNotOptimize(status1);
         benchmark::DoNotOptimize(page2);
     }
+    allocations.report(state);
+    report_document_memory(state, jsom::JsonDocument(original)); // One copy
 }
 BENCHMARK(BM_JSOM_DocumentCopy);
 
+// The 5000 user records of the large payload, parsed into per-object maps and then with
+// shared object shapes; doc_bytes shows the memory each form holds
+static void BM_JSOM_LargeRecords(benchmark::State& state) {
+    auto json = benchmark_utils::get_large_json();
+
+    // NOLINTNEXTLINE(readability-identifier-length)
+    for (auto _ : state) {
+        auto doc = jsom::parse_document(json);
+        benchmark::DoNotOptimize(doc);
+    }
+    report_document_memory(state, jsom::parse_document(json));
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations())
+                            * static_cast<int64_t>(json.size()));
+}
+BENCHMARK(BM_JSOM_LargeRecords)->Unit(benchmark::kMillisecond);
+
+static void BM_JSOM_LargeRecords_SharedShapes(benchmark::State& state) {
+    auto json = benchmark_utils::get_large_json();
+    jsom::JsonParseOptions options;
+    options.share_object_shapes = true;
+
+    // NOLINTNEXTLINE(readability-identifier-length)
+    for (auto _ : state) {
+        auto doc = jsom::parse_document(json, options);
+        benchmark::DoNotOptimize(doc);
+    }
+    report_document_memory(state, jsom::parse_document(json, options));
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations())
+                            * static_cast<int64_t>(json.size()));
+}
+BENCHMARK(BM_JSOM_LargeRecords_SharedShapes)->Unit(benchmark::kMillisecond);
+
+// Freeing a large document on the calling thread; only the teardown is timed
+static void BM_JSOM_Destroy_Large(benchmark::State& state) {
+    const auto original = jsom::parse_document(benchmark_utils::get_large_json());
+
+    // NOLINTNEXTLINE(readability-identifier-length)
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto doc = std::make_unique<jsom::JsonDocument>(original);
+        state.ResumeTiming();
+        doc.reset();
+    }
+}
+BENCHMARK(BM_JSOM_Destroy_Large)->Unit(benchmark::kMillisecond);
+
+// The same document handed to a DeferredDestroyer: the caller only pays for the handoff
+static void BM_JSOM_DeferredDestroy_Large(benchmark::State& state) {
+    const auto original = jsom::parse_document(benchmark_utils::get_large_json());
+    jsom::DeferredDestroyer reclaimer;
+
+    // NOLINTNEXTLINE(readability-identifier-length)
+    for (auto _ : state) {
+        state.PauseTiming();
+        reclaimer.flush(); // The previous teardown stays out of the timed region
+        auto doc = std::make_unique<jsom::JsonDocument>(original);
+        state.ResumeTiming();
+        reclaimer.destroy(std::move(*doc));
+        doc.reset();
+    }
+}
+// Fixed count: the untimed copy and flush dwarf the timed handoff
+BENCHMARK(BM_JSOM_DeferredDestroy_Large)->Unit(benchmark::kMicrosecond)->Iterations(200);
+
+// deduplicate() over generated corpora: only the pass is timed, on a fresh copy each time.
+// doc_bytes is what the document holds afterwards, saved_percent what the pass gave back.
+static void deduplicate_corpus(benchmark::State& state, const std::string& json) {
+    const auto original = jsom::parse_document(json);
+    auto before = static_cast<double>(original.memory_usage().total());
+    jsom::JsonDocument::DedupStats stats;
+
+    // NOLINTNEXTLINE(readability-identifier-length)
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto doc = std::make_unique<jsom::JsonDocument>(original);
+        state.ResumeTiming();
+        stats = doc->deduplicate();
+        state.PauseTiming();
+        doc.reset(); // Teardown stays out of the timed region
+        state.ResumeTiming();
+    }
+    auto doc = original;
+    doc.deduplicate();
+    report_document_memory(state, doc);
+    auto after = static_cast<double>(doc.memory_usage().total());
+    state.counters["before_bytes"] = before;
+    state.counters["saved_percent"] = 100.0 * (before - after) / before; // NOLINT
+    state.counters["replaced"] = static_cast<double>(stats.replaced);
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations())
+                            * static_cast<int64_t>(json.size()));
+}
+
+static void BM_JSOM_Deduplicate_Feed(benchmark::State& state) {
+    deduplicate_corpus(state, corpus::feed(DEDUP_CORPUS_BYTES));
+}
+BENCHMARK(BM_JSOM_Deduplicate_Feed)->Unit(benchmark::kMillisecond);
+
+static void BM_JSOM_Deduplicate_Twitter(benchmark::State& state) {
+    deduplicate_corpus(state, corpus::twitter(DEDUP_CORPUS_BYTES));
+}
+BENCHMARK(BM_JSOM_Deduplicate_Twitter)->Unit(benchmark::kMillisecond);
+
+static void BM_JSOM_Deduplicate_DeepConfig(benchmark::State& state) {
+    deduplicate_corpus(state, corpus::deep_config(DEDUP_CORPUS_BYTES));
+}
+BENCHMARK(BM_JSOM_Deduplicate_DeepConfig)->Unit(benchmark::kMillisecond);
+
 // Comparison benchmarks with nlohmann
 static void BM_Nlohmann_SmallNumbers(benchmark::State& state) {
     const auto* json = R"({
@@ -126,6 +257,7 @@ static void BM_Nlohmann_SmallNumbers(benchmark::State& state) {
         "retry": 3
     })";
 
+    benchmark_utils::AllocationCounters allocations;
     // NOLINTNEXTLINE(readability-identifier-length)
     for (auto _ : state) {
         auto doc = nlohmann::json::parse(json);
@@ -137,6 +269,7 @@ static void BM_Nlohmann_SmallNumbers(benchmark::State& state) {
         benchmark::DoNotOptimize(count);
         benchmark::DoNotOptimize(page);
     }
+    allocations.report(state);
     state.SetBytesProcessed(static_cast<int64_t>(state.iterations())
                             * static_cast<int64_t>(strlen(json)));
 }
@@ -145,6 +278,7 @@ BENCHMARK(BM_Nlohmann_SmallNumbers);
 static void BM_Nlohmann_ManyDocuments(benchmark::State& state) {
     auto json = benchmark_utils::get_small_json();
 
+    benchmark_utils::AllocationCounters allocations;
     // NOLINTNEXTLINE(readability-identifier-length)
     for (auto _ : state) {
         std::vector<nlohmann::json> docs;
@@ -162,6 +296,7 @@ static void BM_Nlohmann_ManyDocuments(benchmark::State& state) {
 
         benchmark::DoNotOptimize(docs);
     }
+    allocations.report(state);
     // NOLINTNEXTLINE(readability-magic-numbers)
     state.SetBytesProcessed(static_cast<int64_t>(state.iterations())
                             * static_cast<int64_t>(json.size()) * DOCUMENT_COUNT);
@@ -172,6 +307,7 @@ static void BM_Nlohmann_DocumentCopy(benchmark::State& state) {
     auto json = benchmark_utils::get_medium_json();
     auto original = nlohmann::json::parse(json);
 
+    benchmark_utils::AllocationCounters allocations;
     // NOLINTNEXTLINE(readability-identifier-length)
     for (auto _ : state) {
         auto copy1 = original;
@@ -185,5 +321,6 @@ static void BM_Nlohmann_DocumentCopy(benchmark::State& state) {
         benchmark::DoNotOptimize(status1);
         benchmark::DoNotOptimize(page2);
     }
+    allocations.report(state);
 }
 BENCHMARK(BM_Nlohmann_DocumentCopy);
@@ -1,4 +1,5 @@
 #include "benchmark_utils.hpp"
+#include "perf_counters.hpp"
 #include <benchmark/benchmark.h>
 #include <jsom/jsom.hpp>
 #include <nlohmann/json.hpp>
@@ -6,12 +7,16 @@
 // JSOM Parse-Serialize Benchmarks (Primary Phase 3 Optimization Target)
 static void BM_JSOM_ParseSerialize_Small(benchmark::State& state) {
     auto input = benchmark_utils::get_small_json();
+    benchmark_utils::AllocationCounters allocations;
+    benchmark_utils::PerfCounters counters;
     // NOLINTNEXTLINE(readability-identifier-length)
     for (auto _ : state) {
         auto doc = jsom::parse_document(input);
         auto output = doc.to_json();
         benchmark::DoNotOptimize(output);
     }
+    counters.report(state, input.size());
+    allocations.report(state);
     state.SetBytesProcessed(static_cast<int64_t>(state.iterations())
                             * static_cast<int64_t>(input.size()));
 }
@@ -19,12 +24,16 @@ BENCHMARK(BM_JSOM_ParseSerialize_Small);
 
 static void BM_JSOM_ParseSerialize_Medium(benchmark::State& state) {
     auto input = benchmark_utils::get_medium_json();
+    benchmark_utils::AllocationCounters allocations;
+    benchmark_utils::PerfCounters counters;
     // NOLINTNEXTLINE(readability-identifier-length)
     for (auto _ : state) {
         auto doc = jsom::parse_document(input);
         auto output = doc.to_json();
         benchmark::DoNotOptimize(output);
     }
+    counters.report(state, input.size());
+    allocations.report(state);
     state.SetBytesProcessed(static_cast<int64_t>(state.iterations())
                             * static_cast<int64_t>(input.size()));
 }
@@ -32,12 +41,16 @@ BENCHMARK(BM_JSOM_ParseSerialize_Medium);
 
 static void BM_JSOM_ParseSerialize_Large(benchmark::State& state) {
     auto input = benchmark_utils::get_large_json();
+    benchmark_utils::AllocationCounters allocations;
+    benchmark_utils::PerfCounters counters;
     // NOLINTNEXTLINE(readability-identifier-length)
     for (auto _ : state) {
         auto doc = jsom::parse_document(input);
         auto output = doc.to_json();
         benchmark::DoNotOptimize(output);
     }
+    counters.report(state, input.size());
+    allocations.report(state);
     state.SetBytesProcessed(static_cast<int64_t>(state.iterations())
                             * static_cast<int64_t>(input.size()));
 }
@@ -45,12 +58,16 @@ BENCHMARK(BM_JSOM_ParseSerialize_Large);
 
 static void BM_JSOM_ParseSerialize_NumberHeavy(benchmark::State& state) {
     auto input = benchmark_utils::get_number_heavy_json();
+    benchmark_utils::AllocationCounters allocations;
+    benchmark_utils::PerfCounters counters;
     // NOLINTNEXTLINE(readability-identifier-length)
     for (auto _ : state) {
         auto doc = jsom::parse_document(input);
         auto output = doc.to_json();
         benchmark::DoNotOptimize(output);
     }
+    counters.report(state, input.size());
+    allocations.report(state);
     state.SetBytesProcessed(static_cast<int64_t>(state.iterations())
                             * static_cast<int64_t>(input.size()));
 }
@@ -59,12 +76,16 @@ BENCHMARK(BM_JSOM_ParseSerialize_NumberHeavy);
 // nlohmann::json Parse-Serialize Comparison
 static void BM_Nlohmann_ParseSerialize_Small(benchmark::State& state) {
     auto input = benchmark_utils::get_small_json();
+    benchmark_utils::AllocationCounters allocations;
+    benchmark_utils::PerfCounters counters;
     // NOLINTNEXTLINE(readability-identifier-length)
     for (auto _ : state) {
         auto doc = nlohmann::json::parse(input);
         auto output = doc.dump();
         benchmark::DoNotOptimize(output);
     }
+    counters.report(state, input.size());
+    allocations.report(state);
     state.SetBytesProcessed(static_cast<int64_t>(state.iterations())
                             * static_cast<int64_t>(input.size()));
 }
@@ -72,12 +93,16 @@ BENCHMARK(BM_Nlohmann_ParseSerialize_Small);
 
 static void BM_Nlohmann_ParseSerialize_Medium(benchmark::State& state) {
     auto input = benchmark_utils::get_medium_json();
+    benchmark_utils::AllocationCounters allocations;
+    benchmark_utils::PerfCounters counters;
     // NOLINTNEXTLINE(readability-identifier-length)
     for (auto _ : state) {
         auto doc = nlohmann::json::parse(input);
         auto output = doc.dump();
         benchmark::DoNotOptimize(output);
     }
+    counters.report(state, input.size());
+    allocations.report(state);
     state.SetBytesProcessed(static_cast<int64_t>(state.iterations())
                             * static_cast<int64_t>(input.size()));
 }
@@ -85,12 +110,16 @@ BENCHMARK(BM_Nlohmann_ParseSerialize_Medium);
 
 static void BM_Nlohmann_ParseSerialize_Large(benchmark::State& state) {
     auto input = benchmark_utils::get_large_json();
+    benchmark_utils::AllocationCounters allocations;
+    benchmark_utils::PerfCounters counters;
     // NOLINTNEXTLINE(readability-identifier-length)
     for (auto _ : state) {
         auto doc = nlohmann::json::parse(input);
         auto output = doc.dump();
         benchmark::DoNotOptimize(output);
     }
+    counters.report(state, input.size());
+    allocations.report(state);
     state.SetBytesProcessed(static_cast<int64_t>(state.iterations())
                             * static_cast<int64_t>(input.size()));
 }
@@ -98,12 +127,16 @@ BENCHMARK(BM_Nlohmann_ParseSerialize_Large);
 
 static void BM_Nlohmann_ParseSerialize_NumberHeavy(benchmark::State& state) {
     auto input = benchmark_utils::get_number_heavy_json();
+    benchmark_utils::AllocationCounters allocations;
+    benchmark_utils::PerfCounters counters;
     // NOLINTNEXTLINE(readability-identifier-length)
     for (auto _ : state) {
         auto doc = nlohmann::json::parse(input);
         auto output = doc.dump();
         benchmark::DoNotOptimize(output);
     }
+    counters.report(state, input.size());
+    allocations.report(state);
     state.SetBytesProcessed(static_cast<int64_t>(state.iterations())
                             * static_cast<int64_t>(input.size()));
 }
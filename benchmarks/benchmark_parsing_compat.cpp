@@ -1,4 +1,5 @@
 #include "benchmark_utils.hpp"
+#include "perf_counters.hpp"
 #include <benchmark/benchmark.h>
 #include <jsom/jsom.hpp>
 #include <nlohmann/json.hpp>
@@ -6,23 +7,48 @@
 // JSOM Parse-Only Benchmarks (compatible with Phase 2)
 static void BM_JSOM_ParseSmall(benchmark::State& state) {
     auto json = benchmark_utils::get_small_json();
+    benchmark_utils::AllocationCounters allocations;
+    benchmark_utils::PerfCounters counters;
     // NOLINTNEXTLINE(readability-identifier-length)
     for (auto _ : state) {
         auto doc = jsom::parse_document(json);
         benchmark::DoNotOptimize(doc);
     }
+    counters.report(state, json.size());
+    allocations.report(state);
     state.SetBytesProcessed(static_cast<int64_t>(state.iterations())
                             * static_cast<int64_t>(json.size()));
 }
 BENCHMARK(BM_JSOM_ParseSmall);
 
+// parse_document() reuses this thread's ParserWorkspace; a fresh FastParser sets up its own
+// buffers on every call, as parse_document() did before workspaces
+static void BM_JSOM_ParseSmall_FreshParser(benchmark::State& state) {
+    auto json = benchmark_utils::get_small_json();
+    benchmark_utils::AllocationCounters allocations;
+    // NOLINTNEXTLINE(readability-identifier-length)
+    for (auto _ : state) {
+        jsom::FastParser parser;
+        auto doc = parser.parse(json);
+        benchmark::DoNotOptimize(doc);
+    }
+    allocations.report(state);
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations())
+                            * static_cast<int64_t>(json.size()));
+}
+BENCHMARK(BM_JSOM_ParseSmall_FreshParser);
+
 static void BM_JSOM_ParseMedium(benchmark::State& state) {
     auto json = benchmark_utils::get_medium_json();
+    benchmark_utils::AllocationCounters allocations;
+    benchmark_utils::PerfCounters counters;
     // NOLINTNEXTLINE(readability-identifier-length)
     for (auto _ : state) {
         auto doc = jsom::parse_document(json);
         benchmark::DoNotOptimize(doc);
     }
+    counters.report(state, json.size());
+    allocations.report(state);
     state.SetBytesProcessed(static_cast<int64_t>(state.iterations())
                             * static_cast<int64_t>(json.size()));
 }
@@ -30,11 +56,15 @@ BENCHMARK(BM_JSOM_ParseMedium);
 
 static void BM_JSOM_ParseLarge(benchmark::State& state) {
     auto json = benchmark_utils::get_large_json();
+    benchmark_utils::AllocationCounters allocations;
+    benchmark_utils::PerfCounters counters;
     // NOLINTNEXTLINE(readability-identifier-length)
     for (auto _ : state) {
         auto doc = jsom::parse_document(json);
         benchmark::DoNotOptimize(doc);
     }
+    counters.report(state, json.size());
+    allocations.report(state);
     state.SetBytesProcessed(static_cast<int64_t>(state.iterations())
                             * static_cast<int64_t>(json.size()));
 }
@@ -54,11 +84,15 @@ BENCHMARK(BM_JSOM_ParseLarge);
 
 static void BM_JSOM_ParseNumberHeavy(benchmark::State& state) {
     auto json = benchmark_utils::get_number_heavy_json();
+    benchmark_utils::AllocationCounters allocations;
+    benchmark_utils::PerfCounters counters;
     // NOLINTNEXTLINE(readability-identifier-length)
     for (auto _ : state) {
         auto doc = jsom::parse_document(json);
         benchmark::DoNotOptimize(doc);
     }
+    counters.report(state, json.size());
+    allocations.report(state);
     state.SetBytesProcessed(static_cast<int64_t>(state.iterations())
                             * static_cast<int64_t>(json.size()));
 }
@@ -67,11 +101,15 @@ BENCHMARK(BM_JSOM_ParseNumberHeavy);
 // nlohmann::json comparison benchmarks
 static void BM_Nlohmann_ParseSmall(benchmark::State& state) {
     auto json = benchmark_utils::get_small_json();
+    benchmark_utils::AllocationCounters allocations;
+    benchmark_utils::PerfCounters counters;
     // NOLINTNEXTLINE(readability-identifier-length)
     for (auto _ : state) {
         auto doc = nlohmann::json::parse(json);
         benchmark::DoNotOptimize(doc);
     }
+    counters.report(state, json.size());
+    allocations.report(state);
     state.SetBytesProcessed(static_cast<int64_t>(state.iterations())
                             * static_cast<int64_t>(json.size()));
 }
@@ -79,11 +117,15 @@ BENCHMARK(BM_Nlohmann_ParseSmall);
 
 static void BM_Nlohmann_ParseMedium(benchmark::State& state) {
     auto json = benchmark_utils::get_medium_json();
+    benchmark_utils::AllocationCounters allocations;
+    benchmark_utils::PerfCounters counters;
     // NOLINTNEXTLINE(readability-identifier-length)
     for (auto _ : state) {
         auto doc = nlohmann::json::parse(json);
         benchmark::DoNotOptimize(doc);
     }
+    counters.report(state, json.size());
+    allocations.report(state);
     state.SetBytesProcessed(static_cast<int64_t>(state.iterations())
                             * static_cast<int64_t>(json.size()));
 }
@@ -91,11 +133,15 @@ BENCHMARK(BM_Nlohmann_ParseMedium);
 
 static void BM_Nlohmann_ParseLarge(benchmark::State& state) {
     auto json = benchmark_utils::get_large_json();
+    benchmark_utils::AllocationCounters allocations;
+    benchmark_utils::PerfCounters counters;
     // NOLINTNEXTLINE(readability-identifier-length)
     for (auto _ : state) {
         auto doc = nlohmann::json::parse(json);
         benchmark::DoNotOptimize(doc);
     }
+    counters.report(state, json.size());
+    allocations.report(state);
     state.SetBytesProcessed(static_cast<int64_t>(state.iterations())
                             * static_cast<int64_t>(json.size()));
 }
@@ -115,11 +161,15 @@ BENCHMARK(BM_Nlohmann_ParseLarge);
 
 static void BM_Nlohmann_ParseNumberHeavy(benchmark::State& state) {
     auto json = benchmark_utils::get_number_heavy_json();
+    benchmark_utils::AllocationCounters allocations;
+    benchmark_utils::PerfCounters counters;
     // NOLINTNEXTLINE(readability-identifier-length)
     for (auto _ : state) {
         auto doc = nlohmann::json::parse(json);
         benchmark::DoNotOptimize(doc);
     }
+    counters.report(state, json.size());
+    allocations.report(state);
     state.SetBytesProcessed(static_cast<int64_t>(state.iterations())
                             * static_cast<int64_t>(json.size()));
 }
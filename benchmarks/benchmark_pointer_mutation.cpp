@@ -0,0 +1,144 @@
+#include "benchmark_utils.hpp"
+#include "corpus_generators.hpp"
+#include <benchmark/benchmark.h>
+#include <jsom/jsom.hpp>
+#include <string>
+#include <utility>
+#include <vector>
+
+// JSON Pointer mutations: set_at/extract_at/remove_at move subtrees instead of copying them,
+// so the cost of moving a subtree between slots should not grow with its size.
+
+namespace {
+constexpr std::size_t KIB = 1024;
+constexpr int DEEP_CONFIG_DEPTH = 24;
+// Moves are O(1), so report moves/s rather than bytes/s; the subtree size stays in the Arg
+constexpr int64_t MOVES_PER_ITERATION = 2;
+
+// {"from": {"payload": <geojson of about `bytes`>}, "to": {}}
+auto make_two_slot_document(std::size_t bytes) -> jsom::JsonDocument {
+    auto doc = jsom::JsonDocument::make_object();
+    doc.set_at("/from", jsom::JsonDocument::make_object());
+    doc.set_at("/to", jsom::JsonDocument::make_object());
+    doc.set_at("/from/payload", jsom::parse_document(corpus::geojson(bytes)));
+    return doc;
+}
+} // namespace
+
+// Move a large subtree to another slot and back: extract_at + set_at, twice per iteration
+static void BM_JSOM_PointerMove_Subtree(benchmark::State& state) {
+    auto bytes = static_cast<std::size_t>(state.range(0)) * KIB;
+    auto doc = make_two_slot_document(bytes);
+
+    benchmark_utils::AllocationCounters allocations;
+    // NOLINTNEXTLINE(readability-identifier-length)
+    for (auto _ : state) {
+        doc.set_at("/to/payload", doc.extract_at("/from/payload"));
+        doc.set_at("/from/payload", doc.extract_at("/to/payload"));
+        benchmark::DoNotOptimize(doc);
+    }
+    allocations.report(state);
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * MOVES_PER_ITERATION);
+}
+BENCHMARK(BM_JSOM_PointerMove_Subtree)->Arg(64)->Arg(1024)->Arg(8 * 1024);
+
+// Move a large subtree into another document, then take it back
+static void BM_JSOM_PointerMove_BetweenDocuments(benchmark::State& state) {
+    auto bytes = static_cast<std::size_t>(state.range(0)) * KIB;
+    auto source = make_two_slot_document(bytes);
+    auto target = jsom::JsonDocument::make_object();
+
+    // NOLINTNEXTLINE(readability-identifier-length)
+    for (auto _ : state) {
+        target.set_at("/payload", source.extract_at("/from/payload"));
+        source.set_at("/from/payload", target.extract_at("/payload"));
+        benchmark::DoNotOptimize(source);
+        benchmark::DoNotOptimize(target);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * MOVES_PER_ITERATION);
+}
+BENCHMARK(BM_JSOM_PointerMove_BetweenDocuments)->Arg(64)->Arg(1024)->Arg(8 * 1024);
+
+// set_at and remove_at of a small value at the bottom of a deep configuration tree
+static void BM_JSOM_PointerMutate_DeepPath(benchmark::State& state) {
+    auto doc = jsom::parse_document(corpus::deep_config(64 * KIB, DEEP_CONFIG_DEPTH));
+    std::string parent;
+    const jsom::JsonDocument* node = &doc;
+    while (node->is_object() && node->size() > 0) {
+        const auto& [key, child] = *node->items().begin();
+        if (!child.is_object()) {
+            break;
+        }
+        parent += "/" + jsom::JsonPointer::escape_segment(key);
+        node = &child;
+    }
+    const std::string pointer = parent + "/benchmark_value";
+
+    // NOLINTNEXTLINE(readability-identifier-length)
+    for (auto _ : state) {
+        doc.set_at(pointer, jsom::JsonDocument(1));
+        benchmark::DoNotOptimize(doc.remove_at(pointer));
+    }
+    state.counters["depth"] = static_cast<double>(jsom::JsonPointer::parse(pointer).size());
+}
+BENCHMARK(BM_JSOM_PointerMutate_DeepPath);
+
+namespace {
+constexpr int FIELDS_PER_RECORD = 8;
+
+// Key/value hydration: /tables/<t>/rows/<r> objects, then FIELDS_PER_RECORD fields each
+auto make_hydration_ops(int records) -> std::vector<jsom::PointerOperation> {
+    std::vector<jsom::PointerOperation> ops;
+    ops.push_back(jsom::PointerOperation::set("/tables", jsom::JsonDocument::make_object()));
+    for (int record = 0; record < records; ++record) {
+        std::string table = "/tables/t" + std::to_string(record % 4);
+        if (record < 4) {
+            ops.push_back(jsom::PointerOperation::set(table, jsom::JsonDocument::make_object()));
+            ops.push_back(
+                jsom::PointerOperation::set(table + "/rows", jsom::JsonDocument::make_object()));
+        }
+        std::string row = table + "/rows/r" + std::to_string(record);
+        ops.push_back(jsom::PointerOperation::set(row, jsom::JsonDocument::make_object()));
+        for (int field = 0; field < FIELDS_PER_RECORD; ++field) {
+            ops.push_back(jsom::PointerOperation::set(row + "/field_" + std::to_string(field),
+                                                      jsom::JsonDocument(field)));
+        }
+    }
+    return ops;
+}
+} // namespace
+
+static void BM_JSOM_PointerBatch_Hydrate(benchmark::State& state) {
+    auto records = static_cast<int>(state.range(0));
+    auto ops = make_hydration_ops(records);
+
+    // NOLINTNEXTLINE(readability-identifier-length)
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto batch = ops;
+        state.ResumeTiming();
+        auto doc = jsom::JsonDocument::make_object();
+        benchmark::DoNotOptimize(doc.apply_batch(std::move(batch)));
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations())
+                            * static_cast<int64_t>(ops.size()));
+}
+BENCHMARK(BM_JSOM_PointerBatch_Hydrate)->Arg(1000)->Arg(10000);
+
+// The same operations through one set_at() call each
+static void BM_JSOM_PointerSequential_Hydrate(benchmark::State& state) {
+    auto records = static_cast<int>(state.range(0));
+    auto ops = make_hydration_ops(records);
+
+    // NOLINTNEXTLINE(readability-identifier-length)
+    for (auto _ : state) {
+        auto doc = jsom::JsonDocument::make_object();
+        for (const auto& op : ops) {
+            doc.set_at(op.pointer, op.value);
+        }
+        benchmark::DoNotOptimize(doc);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations())
+                            * static_cast<int64_t>(ops.size()));
+}
+BENCHMARK(BM_JSOM_PointerSequential_Hydrate)->Arg(1000)->Arg(10000);
@@ -1,10 +1,45 @@
 #pragma once
 
+#include <algorithm>
+#include <benchmark/benchmark.h>
 #include <string>
 #include <sstream>
 
+#ifdef JSOM_COUNT_ALLOCATIONS
+#include <jsom/allocation_counter.hpp>
+#endif
+
 namespace benchmark_utils {
 
+// Heap activity of a benchmark loop, reported as counters: allocs and alloc_bytes per
+// iteration, and peak_bytes above the heap in use when the loop started. Construct just
+// before the loop and call report() after it. Without -DJSOM_COUNT_ALLOCATIONS=ON this
+// does nothing and no counters appear.
+class AllocationCounters {
+public:
+#ifdef JSOM_COUNT_ALLOCATIONS
+    AllocationCounters() {
+        jsom::reset_allocation_peak();
+        start_ = jsom::allocation_stats();
+    }
+
+    void report(benchmark::State& state) const {
+        jsom::AllocationStats delta = jsom::allocation_stats() - start_;
+        state.counters["allocs"] = benchmark::Counter(static_cast<double>(delta.allocations),
+                                                      benchmark::Counter::kAvgIterations);
+        state.counters["alloc_bytes"] = benchmark::Counter(
+            static_cast<double>(delta.allocated_bytes), benchmark::Counter::kAvgIterations);
+        state.counters["peak_bytes"]
+            = static_cast<double>(delta.peak_bytes - std::min(delta.peak_bytes, start_.live_bytes));
+    }
+
+private:
+    jsom::AllocationStats start_;
+#else
+    void report(benchmark::State& /*state*/) const {}
+#endif
+};
+
 inline std::string get_small_json() {
     return R"({
         "id": 1234567890,
@@ -0,0 +1,327 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+// Seeded generators for large, realistic benchmark inputs.
+//
+// Each generator appends whole records until the output reaches `target_bytes`, so sizes
+// scale from kilobytes to gigabytes with the same shape. Output depends only on the size
+// and seed: the same arguments always produce byte-identical text on every platform.
+namespace corpus {
+
+constexpr std::uint64_t DEFAULT_SEED = 0x4A534F4D; // "JSOM"
+constexpr std::size_t DEFAULT_CORPUS_MB = 16;
+constexpr std::size_t BYTES_PER_MB = 1024 * 1024;
+
+// Corpus size for the benchmarks: JSOM_CORPUS_MB megabytes, or DEFAULT_CORPUS_MB when unset
+inline auto corpus_bytes() -> std::size_t {
+    const char* env = std::getenv("JSOM_CORPUS_MB");
+    std::size_t megabytes = env != nullptr ? std::strtoull(env, nullptr, 10) : 0;
+    return (megabytes > 0 ? megabytes : DEFAULT_CORPUS_MB) * BYTES_PER_MB;
+}
+
+// SplitMix64: tiny, fast and fully specified, unlike std:: distributions
+class Rng {
+public:
+    explicit Rng(std::uint64_t seed) : state_(seed) {}
+
+    auto next() -> std::uint64_t {
+        // NOLINTBEGIN(readability-magic-numbers)
+        std::uint64_t value = (state_ += 0x9E3779B97F4A7C15ULL);
+        value = (value ^ (value >> 30U)) * 0xBF58476D1CE4E5B9ULL;
+        value = (value ^ (value >> 27U)) * 0x94D049BB133111EBULL;
+        return value ^ (value >> 31U);
+        // NOLINTEND(readability-magic-numbers)
+    }
+
+    // Uniform integer in [0, bound)
+    auto below(std::uint64_t bound) -> std::uint64_t { return next() % bound; }
+
+    // Uniform double in [low, high)
+    auto between(double low, double high) -> double {
+        constexpr double UNIT = 1.0 / 9007199254740992.0; // 2^-53
+        constexpr unsigned MANTISSA_SHIFT = 11;
+        return low + (high - low) * static_cast<double>(next() >> MANTISSA_SHIFT) * UNIT;
+    }
+
+    auto chance(unsigned percent) -> bool {
+        constexpr std::uint64_t PERCENT = 100;
+        return below(PERCENT) < percent;
+    }
+
+    template <typename T, std::size_t N> auto pick(const std::array<T, N>& items) -> const T& {
+        return items[below(N)];
+    }
+
+private:
+    std::uint64_t state_;
+};
+
+namespace detail {
+
+inline const std::array<const char*, 16> WORDS
+    = {"alpha", "bravo",  "charlie", "delta", "echo",  "foxtrot", "golf",   "hotel",
+       "india", "juliet", "kilo",    "lima",  "mike",  "november", "oscar", "papa"};
+
+inline const std::array<const char*, 8> UNICODE_WORDS
+    = {"caf\xC3\xA9", "na\xC3\xAFve", "\xE6\x97\xA5\xE6\x9C\xAC\xE8\xAA\x9E",
+       "\xD0\x9C\xD0\xBE\xD1\x81\xD0\xBA\xD0\xB2\xD0\xB0", "\xCE\xB1\xCE\xB2\xCE\xB3",
+       "\xF0\x9F\x98\x80", "\xE0\xA4\xB9\xE0\xA4\xBF\xE0\xA4\x82", "\xEA\xB0\x80"};
+
+// JSON escapes the parser must decode, including a surrogate pair
+inline const std::array<const char*, 6> ESCAPES = {"\\u00e9", "\\u65e5", "\\ud83d\\ude00",
+                                                   "\\n",     "\\\"",    "\\\\"};
+
+inline void append_double(std::string& out, double value, int precision) {
+    constexpr std::size_t BUFFER_SIZE = 32;
+    std::array<char, BUFFER_SIZE> buffer{};
+    int length = std::snprintf(buffer.data(), buffer.size(), "%.*f", precision, value);
+    out.append(buffer.data(), static_cast<std::size_t>(length));
+}
+
+inline void append_words(std::string& out, Rng& rng, std::size_t count) {
+    for (std::size_t i = 0; i < count; ++i) {
+        if (i > 0) {
+            out += ' ';
+        }
+        out += rng.pick(WORDS);
+    }
+}
+
+// Opens `prefix`, calls append_record(out, index) until the target size, closes with
+// `suffix`; records are separated by `separator`
+template <typename AppendRecord>
+auto fill(std::size_t target_bytes, const char* prefix, const char* separator,
+          const char* suffix, AppendRecord&& append_record) -> std::string {
+    std::string out;
+    out.reserve(target_bytes + target_bytes / 16); // NOLINT(readability-magic-numbers)
+    out += prefix;
+    for (std::size_t index = 0; out.size() < target_bytes || index == 0; ++index) {
+        if (index > 0) {
+            out += separator;
+        }
+        append_record(out, index);
+    }
+    out += suffix;
+    return out;
+}
+
+} // namespace detail
+
+// GeoJSON FeatureCollection: polygons with long coordinate arrays (number-dense)
+inline auto geojson(std::size_t target_bytes, std::uint64_t seed = DEFAULT_SEED) -> std::string {
+    Rng rng(seed);
+    return detail::fill(
+        target_bytes, R"({"type":"FeatureCollection","features":[)", ",", "]}",
+        [&](std::string& out, std::size_t index) {
+            out += R"({"type":"Feature","id":)";
+            out += std::to_string(index);
+            out += R"(,"properties":{"name":")";
+            detail::append_words(out, rng, 2);
+            out += R"(","population":)";
+            out += std::to_string(rng.below(10000000)); // NOLINT(readability-magic-numbers)
+            out += R"(},"geometry":{"type":"Polygon","coordinates":[[)";
+            double lon = rng.between(-180.0, 180.0); // NOLINT(readability-magic-numbers)
+            double lat = rng.between(-85.0, 85.0);   // NOLINT(readability-magic-numbers)
+            std::size_t points = 16 + rng.below(48); // NOLINT(readability-magic-numbers)
+            for (std::size_t i = 0; i < points; ++i) {
+                out += i > 0 ? ",[" : "[";
+                detail::append_double(out, lon + rng.between(-0.01, 0.01), 6);
+                out += ',';
+                detail::append_double(out, lat + rng.between(-0.01, 0.01), 6);
+                out += ']';
+            }
+            out += "]]}}";
+        });
+}
+
+// Twitter-like statuses: nested user objects, entity arrays, mixed scalar types
+inline auto twitter(std::size_t target_bytes, std::uint64_t seed = DEFAULT_SEED) -> std::string {
+    Rng rng(seed);
+    const std::array<const char*, 4> langs = {"en", "ja", "es", "de"};
+    return detail::fill(
+        target_bytes, R"({"statuses":[)", ",", R"(],"search_metadata":{"count":100}})",
+        [&](std::string& out, std::size_t index) {
+            // NOLINTBEGIN(readability-magic-numbers)
+            out += R"({"id":)";
+            out += std::to_string(1000000000000ULL + index);
+            out += R"(,"created_at":"2024-01-)";
+            out += std::to_string(10 + rng.below(19));
+            out += R"(T12:00:00Z","text":")";
+            detail::append_words(out, rng, 8 + rng.below(16));
+            out += R"(","lang":")";
+            out += rng.pick(langs);
+            out += R"(","user":{"id":)";
+            out += std::to_string(rng.below(100000000));
+            out += R"(,"screen_name":"user_)";
+            out += std::to_string(rng.below(1000000));
+            out += R"(","followers_count":)";
+            out += std::to_string(rng.below(5000000));
+            out += R"(,"verified":)";
+            out += rng.chance(5) ? "true" : "false";
+            out += R"(,"profile":{"location":)";
+            if (rng.chance(30)) {
+                out += "null";
+            } else {
+                out += '"';
+                detail::append_words(out, rng, 2);
+                out += '"';
+            }
+            out += R"(}},"entities":{"hashtags":[)";
+            std::size_t tags = rng.below(4);
+            for (std::size_t i = 0; i < tags; ++i) {
+                out += i > 0 ? R"(,{"text":")" : R"({"text":")";
+                out += rng.pick(detail::WORDS);
+                out += R"(","indices":[)";
+                out += std::to_string(i * 10);
+                out += ',';
+                out += std::to_string(i * 10 + 6);
+                out += "]}";
+            }
+            out += R"(]},"retweet_count":)";
+            out += std::to_string(rng.below(10000));
+            out += R"(,"favorite_count":)";
+            out += std::to_string(rng.below(50000));
+            out += R"(,"possibly_sensitive":false})";
+            // NOLINTEND(readability-magic-numbers)
+        });
+}
+
+// Activity feed: each post embeds the full object of one of `authors` authors, so the same
+// subtrees repeat throughout (what deduplicate() is for)
+inline auto feed(std::size_t target_bytes, std::size_t authors = 50,
+                 std::uint64_t seed = DEFAULT_SEED) -> std::string {
+    Rng rng(seed);
+    return detail::fill(target_bytes, R"({"posts":[)", ",", "]}", [&](std::string& out,
+                                                                      std::size_t index) {
+        // NOLINTBEGIN(readability-magic-numbers)
+        std::uint64_t author = rng.below(authors);
+        Rng about(author); // The author's object depends only on who they are
+        out += R"({"id":)";
+        out += std::to_string(index);
+        out += R"(,"text":")";
+        detail::append_words(out, rng, 4 + rng.below(8));
+        out += R"(","author":{"id":)";
+        out += std::to_string(author);
+        out += R"(,"name":")";
+        detail::append_words(out, about, 2);
+        out += R"(","bio":")";
+        detail::append_words(out, about, 12);
+        out += R"(","links":[")";
+        out += about.pick(detail::WORDS);
+        out += R"(.example.com","status.example.com"],"settings":{"theme":")";
+        out += about.chance(50) ? "dark" : "light";
+        out += R"(","notifications":{"email":true,"push":false,"digest":"weekly"}}})";
+        out += R"(,"likes":)";
+        out += std::to_string(rng.below(1000));
+        out += '}';
+        // NOLINTEND(readability-magic-numbers)
+    });
+}
+
+// Log records, one compact JSON object per line (NDJSON)
+inline auto log_ndjson(std::size_t target_bytes, std::uint64_t seed = DEFAULT_SEED)
+    -> std::string {
+    Rng rng(seed);
+    const std::array<const char*, 4> levels = {"DEBUG", "INFO", "WARN", "ERROR"};
+    const std::array<const char*, 5> services = {"api", "auth", "billing", "search", "worker"};
+    return detail::fill(target_bytes, "", "\n", "\n", [&](std::string& out, std::size_t index) {
+        // NOLINTBEGIN(readability-magic-numbers)
+        out += R"({"ts":)";
+        out += std::to_string(1700000000000ULL + index * 7);
+        out += R"(,"level":")";
+        out += rng.pick(levels);
+        out += R"(","service":")";
+        out += rng.pick(services);
+        out += R"(","msg":")";
+        detail::append_words(out, rng, 4 + rng.below(8));
+        out += R"(","latency_ms":)";
+        detail::append_double(out, rng.between(0.1, 900.0), 3);
+        out += R"(,"status":)";
+        out += std::to_string(rng.chance(90) ? 200 : 500);
+        out += R"(,"trace":{"id":")";
+        out += std::to_string(rng.next());
+        out += R"(","sampled":)";
+        out += rng.chance(10) ? "true" : "false";
+        out += "}}";
+        // NOLINTEND(readability-magic-numbers)
+    });
+}
+
+// Configuration tree: repeated sections nested `depth` levels deep
+inline auto deep_config(std::size_t target_bytes, std::size_t depth = 24,
+                        std::uint64_t seed = DEFAULT_SEED) -> std::string {
+    Rng rng(seed);
+    return detail::fill(
+        target_bytes, "{", ",", "}", [&](std::string& out, std::size_t index) {
+            out += R"("section_)";
+            out += std::to_string(index);
+            out += R"(":)";
+            for (std::size_t level = 0; level < depth; ++level) {
+                out += R"({"enabled":)";
+                out += rng.chance(50) ? "true" : "false"; // NOLINT(readability-magic-numbers)
+                out += R"(,"name":")";
+                out += rng.pick(detail::WORDS);
+                out += R"(","retries":)";
+                out += std::to_string(rng.below(10)); // NOLINT(readability-magic-numbers)
+                out += R"(,"child":)";
+            }
+            out += "null";
+            out.append(depth, '}');
+        });
+}
+
+// Array of strings mixing multi-byte UTF-8 with escape sequences
+inline auto unicode_strings(std::size_t target_bytes, std::uint64_t seed = DEFAULT_SEED)
+    -> std::string {
+    Rng rng(seed);
+    return detail::fill(target_bytes, "[", ",", "]", [&](std::string& out, std::size_t) {
+        out += '"';
+        std::size_t parts = 4 + rng.below(12); // NOLINT(readability-magic-numbers)
+        for (std::size_t i = 0; i < parts; ++i) {
+            if (i > 0) {
+                out += ' ';
+            }
+            if (rng.chance(25)) { // NOLINT(readability-magic-numbers)
+                out += rng.pick(detail::ESCAPES);
+            } else {
+                out += rng.pick(detail::UNICODE_WORDS);
+            }
+        }
+        out += '"';
+    });
+}
+
+// One flat object with very many members (stresses key handling and member lookup)
+inline auto wide_object(std::size_t target_bytes, std::uint64_t seed = DEFAULT_SEED)
+    -> std::string {
+    Rng rng(seed);
+    return detail::fill(target_bytes, "{", ",", "}", [&](std::string& out, std::size_t index) {
+        out += R"("field_)";
+        out += std::to_string(index);
+        out += R"(":)";
+        switch (rng.below(4)) {
+        case 0:
+            out += std::to_string(rng.below(1000000)); // NOLINT(readability-magic-numbers)
+            break;
+        case 1:
+            detail::append_double(out, rng.between(-1.0, 1.0), 8);
+            break;
+        case 2:
+            out += '"';
+            out += rng.pick(detail::WORDS);
+            out += '"';
+            break;
+        default:
+            out += rng.chance(50) ? "true" : "null"; // NOLINT(readability-magic-numbers)
+            break;
+        }
+    });
+}
+
+} // namespace corpus
@@ -0,0 +1,179 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+// Compile cost of each public header, to keep the minimal profile minimal.
+//
+// For every header a translation unit containing only that #include is compiled; the tool
+// reports the best wall time over --runs compiles and the preprocessed size. Two usage rows
+// compile the same parse-and-serialize snippet against jsom_core.hpp and jsom.hpp and also
+// report object size, which is what a consumer of each profile pays.
+//
+//   jsom_header_cost [--runs=N] [--cxx=COMPILER] [--include=DIR] [--flags=FLAGS]
+//
+// "make header_cost" runs it with the configured compiler and include directory.
+
+#ifndef JSOM_CXX_COMPILER
+#define JSOM_CXX_COMPILER "c++"
+#endif
+#ifndef JSOM_INCLUDE_DIR
+#define JSOM_INCLUDE_DIR "include"
+#endif
+
+namespace {
+
+constexpr int DEFAULT_RUNS = 3;
+constexpr int NAME_WIDTH = 24;
+constexpr double NS_PER_MS = 1e6;
+
+const std::vector<std::string> HEADERS = {
+    "jsom_core.hpp",   "jsom.hpp",          "core_types.hpp",        "json_document.hpp",
+    "fast_parser.hpp", "json_pointer.hpp",  "path_cache.hpp",        "navigation_engine.hpp",
+    "metrics.hpp",     "trace_hooks.hpp",   "trace.hpp",             "json_formatter.hpp",
+    "batch_parser.hpp", "streaming_parser.hpp",
+};
+
+auto stem(const std::string& header) -> std::string {
+    return header.substr(0, header.find('.'));
+}
+
+const char* const USAGE_SNIPPET = R"(
+auto roundtrip(const std::string& text) -> std::string {
+    auto doc = jsom::parse_document(text);
+    doc["added"] = jsom::JsonDocument(1.5);
+    return doc.to_json() + doc.to_json(true) + doc.at("/added").to_json();
+}
+)";
+
+struct Options {
+    int runs = DEFAULT_RUNS;
+    std::string cxx = JSOM_CXX_COMPILER;
+    std::string include_dir = JSOM_INCLUDE_DIR;
+    std::string flags = "-std=c++17 -O2";
+};
+
+struct Cost {
+    double best_ms = 0.0;
+    std::size_t preprocessed_lines = 0;
+    std::uintmax_t object_bytes = 0;
+    bool ok = true;
+};
+
+auto count_lines(const std::filesystem::path& path) -> std::size_t {
+    std::ifstream in(path);
+    return static_cast<std::size_t>(std::count(std::istreambuf_iterator<char>(in),
+                                               std::istreambuf_iterator<char>(), '\n'));
+}
+
+auto measure(const Options& options, const std::filesystem::path& source) -> Cost {
+    Cost cost;
+    std::filesystem::path object = source;
+    object.replace_extension(".o");
+    std::filesystem::path preprocessed = source;
+    preprocessed.replace_extension(".ii");
+    std::string base = options.cxx + " " + options.flags + " -I" + options.include_dir + " ";
+
+    for (int run = 0; run < options.runs; ++run) {
+        auto start = std::chrono::steady_clock::now();
+        int status = std::system((base + "-c " + source.string() + " -o " + object.string())
+                                     .c_str());
+        double elapsed = std::chrono::duration<double, std::nano>(
+                             std::chrono::steady_clock::now() - start)
+                             .count()
+                         / NS_PER_MS;
+        if (status != 0) {
+            cost.ok = false;
+            return cost;
+        }
+        cost.best_ms = (run == 0) ? elapsed : std::min(cost.best_ms, elapsed);
+    }
+    cost.object_bytes = std::filesystem::file_size(object);
+
+    if (std::system((base + "-E -P " + source.string() + " -o " + preprocessed.string()).c_str())
+        == 0) {
+        cost.preprocessed_lines = count_lines(preprocessed);
+    }
+    return cost;
+}
+
+void print_row(const std::string& name, const Cost& cost, bool with_object) {
+    if (!cost.ok) {
+        std::printf("  %-*s   compile failed\n", NAME_WIDTH, name.c_str());
+        return;
+    }
+    std::printf("  %-*s %9.0f ms %10zu lines", NAME_WIDTH, name.c_str(), cost.best_ms,
+                cost.preprocessed_lines);
+    if (with_object) {
+        std::printf(" %10ju bytes", cost.object_bytes);
+    }
+    std::printf("\n");
+}
+
+auto parse_options(int argc, char** argv, Options& options) -> bool {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        auto value = [&arg](const std::string& flag) { return arg.substr(flag.size()); };
+        if (arg.rfind("--runs=", 0) == 0) {
+            options.runs = std::max(1, std::atoi(value("--runs=").c_str()));
+        } else if (arg.rfind("--cxx=", 0) == 0) {
+            options.cxx = value("--cxx=");
+        } else if (arg.rfind("--include=", 0) == 0) {
+            options.include_dir = value("--include=");
+        } else if (arg.rfind("--flags=", 0) == 0) {
+            options.flags = value("--flags=");
+        } else {
+            std::cerr << "Unknown argument: " << arg << "\n";
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+auto main(int argc, char** argv) -> int {
+    Options options;
+    if (!parse_options(argc, argv, options)) {
+        return 2;
+    }
+
+    std::filesystem::path work = std::filesystem::temp_directory_path() / "jsom_header_cost";
+    std::filesystem::create_directories(work);
+
+    std::printf("%s %s, best of %d\n", options.cxx.c_str(), options.flags.c_str(),
+                options.runs);
+    bool all_ok = true;
+
+    // Baseline: what the standard library headers every JSOM header needs cost on their own
+    std::filesystem::path baseline = work / "baseline.cpp";
+    std::ofstream(baseline) << "#include <string>\n#include <vector>\n#include <map>\n";
+    print_row("<string> <vector> <map>", measure(options, baseline), false);
+
+    for (const auto& header : HEADERS) {
+        std::filesystem::path source = work / (stem(header) + ".cpp");
+        std::ofstream(source) << "#include <jsom/" << header << ">\n";
+        Cost cost = measure(options, source);
+        all_ok = all_ok && cost.ok;
+        print_row(header, cost, false);
+    }
+
+    std::printf("parse + navigate + serialize:\n");
+    for (const std::string header : {"jsom_core.hpp", "jsom.hpp"}) {
+        std::filesystem::path source = work / ("usage_" + stem(header) + ".cpp");
+        std::ofstream(source) << "#include <jsom/" << header << ">\n" << USAGE_SNIPPET;
+        Cost cost = measure(options, source);
+        all_ok = all_ok && cost.ok;
+        print_row(header, cost, true);
+    }
+
+    std::filesystem::remove_all(work);
+    return all_ok ? 0 : 1;
+}
@@ -0,0 +1,171 @@
+#pragma once
+
+#include <benchmark/benchmark.h>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+#ifdef __linux__
+#include <cerrno>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace benchmark_utils {
+
+// Hardware performance counters (Linux perf_event_open) around a benchmark loop, reported
+// as cycles_per_byte, instructions_per_byte, ipc, branch_miss_rate and cache_miss_rate.
+//
+// Only the CPU's own PMU is used, counting user space of this thread. Where counters are
+// unavailable (non-Linux, no PMU as in many VMs, perf_event_paranoid too strict) no
+// counters are reported and a single note explains why; timings are unaffected. Set
+// JSOM_PERF_COUNTERS=0 to skip them entirely.
+//
+// Construct just before the loop and call report() right after it.
+class PerfCounters {
+public:
+#ifdef __linux__
+    PerfCounters() {
+        if (disabled_by_environment()) {
+            return;
+        }
+        for (std::size_t i = 0; i < EVENT_COUNT; ++i) {
+            fds_[i] = open_event(EVENTS[i]);
+        }
+        if (fds_[CYCLES] < 0 || fds_[INSTRUCTIONS] < 0) {
+            note_unavailable(std::strerror(open_errno_));
+            close_all();
+            return;
+        }
+        for (int fd : fds_) {
+            if (fd >= 0) {
+                ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+                ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+            }
+        }
+    }
+
+    ~PerfCounters() { close_all(); }
+
+    PerfCounters(const PerfCounters&) = delete;
+    auto operator=(const PerfCounters&) -> PerfCounters& = delete;
+    PerfCounters(PerfCounters&&) = delete;
+    auto operator=(PerfCounters&&) -> PerfCounters& = delete;
+
+    // `bytes_per_iteration` is the input size each iteration handles
+    void report(benchmark::State& state, std::size_t bytes_per_iteration) {
+        if (fds_[CYCLES] < 0) {
+            return;
+        }
+        std::array<double, EVENT_COUNT> counts{};
+        for (std::size_t i = 0; i < EVENT_COUNT; ++i) {
+            if (fds_[i] >= 0) {
+                ioctl(fds_[i], PERF_EVENT_IOC_DISABLE, 0);
+                counts[i] = read_scaled(fds_[i]);
+            }
+        }
+
+        double bytes = static_cast<double>(bytes_per_iteration)
+                       * static_cast<double>(state.iterations());
+        if (bytes > 0.0) {
+            state.counters["cycles_per_byte"] = counts[CYCLES] / bytes;
+            state.counters["instructions_per_byte"] = counts[INSTRUCTIONS] / bytes;
+        }
+        if (counts[CYCLES] > 0.0) {
+            state.counters["ipc"] = counts[INSTRUCTIONS] / counts[CYCLES];
+        }
+        if (fds_[BRANCHES] >= 0 && fds_[BRANCH_MISSES] >= 0 && counts[BRANCHES] > 0.0) {
+            state.counters["branch_miss_rate"] = counts[BRANCH_MISSES] / counts[BRANCHES];
+        }
+        if (fds_[CACHE_REFERENCES] >= 0 && fds_[CACHE_MISSES] >= 0
+            && counts[CACHE_REFERENCES] > 0.0) {
+            state.counters["cache_miss_rate"] = counts[CACHE_MISSES] / counts[CACHE_REFERENCES];
+        }
+    }
+
+private:
+    enum Event : std::uint8_t {
+        CYCLES,
+        INSTRUCTIONS,
+        BRANCHES,
+        BRANCH_MISSES,
+        CACHE_REFERENCES,
+        CACHE_MISSES,
+        EVENT_COUNT
+    };
+    static constexpr std::array<std::uint64_t, EVENT_COUNT> EVENTS = {
+        PERF_COUNT_HW_CPU_CYCLES,          PERF_COUNT_HW_INSTRUCTIONS,
+        PERF_COUNT_HW_BRANCH_INSTRUCTIONS, PERF_COUNT_HW_BRANCH_MISSES,
+        PERF_COUNT_HW_CACHE_REFERENCES,    PERF_COUNT_HW_CACHE_MISSES};
+
+    std::array<int, EVENT_COUNT> fds_{-1, -1, -1, -1, -1, -1};
+    int open_errno_ = 0;
+
+    static auto disabled_by_environment() -> bool {
+        const char* env = std::getenv("JSOM_PERF_COUNTERS");
+        return env != nullptr && std::string(env) == "0";
+    }
+
+    // Each event is its own group, so the kernel may multiplex them when the PMU has
+    // fewer counters than events; read_scaled() corrects for that
+    auto open_event(std::uint64_t config) -> int {
+        perf_event_attr attr{};
+        attr.size = sizeof(attr);
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = config;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+        long fd = syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+        if (fd < 0 && open_errno_ == 0) {
+            open_errno_ = errno;
+        }
+        return static_cast<int>(fd);
+    }
+
+    static auto read_scaled(int fd) -> double {
+        struct {
+            std::uint64_t value;
+            std::uint64_t time_enabled;
+            std::uint64_t time_running;
+        } reading{};
+        if (read(fd, &reading, sizeof(reading)) != static_cast<ssize_t>(sizeof(reading))
+            || reading.time_running == 0) {
+            return 0.0;
+        }
+        return static_cast<double>(reading.value) * static_cast<double>(reading.time_enabled)
+               / static_cast<double>(reading.time_running);
+    }
+
+    void close_all() {
+        for (int& fd : fds_) {
+            if (fd >= 0) {
+                close(fd);
+                fd = -1;
+            }
+        }
+    }
+#else
+    void report(benchmark::State& /*state*/, std::size_t /*bytes_per_iteration*/) {}
+
+private:
+#endif
+
+    static void note_unavailable(const char* reason) {
+        static bool noted = false;
+        if (!noted) {
+            noted = true;
+            std::cerr << "Note: hardware performance counters unavailable (" << reason
+                      << "); cycles_per_byte, ipc and miss rates will not be reported\n";
+        }
+    }
+};
+
+} // namespace benchmark_utils
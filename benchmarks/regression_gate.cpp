@@ -0,0 +1,379 @@
+#include "regression_stats.hpp"
+#include <jsom/jsom.hpp>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Statistical performance regression gate.
+//
+// Runs jsom_benchmarks with repetitions (randomly interleaved, so drift hits every
+// benchmark alike), then compares each benchmark's CPU-time samples with the baseline
+// stored in the repository using Welch's t-test. A benchmark fails only if it is slower
+// with one-sided p < 1 - confidence *and* by more than the threshold, so noise on a loaded
+// machine does not fail the gate while a real 10-30% slowdown does.
+//
+//   jsom_regression_gate --benchmarks=build/jsom_benchmarks
+//                        --baseline=benchmarks/baseline/regression_baseline.json
+//   ... --update-baseline   Record the run as the new baseline instead of comparing
+//   ... --results=run.json  Compare an existing --benchmark_out JSON file instead of running
+//
+// Baselines are recorded from release builds only, and comparing runs of different build
+// types is an error.
+//
+// Exit status: 0 = no significant slowdown, 1 = regression, 2 = usage, I/O or build type
+// error.
+
+namespace {
+
+constexpr int EXIT_REGRESSION = 1;
+constexpr int EXIT_ERROR = 2;
+
+constexpr int DEFAULT_REPETITIONS = 10;
+constexpr double DEFAULT_MIN_TIME = 0.2;    // Seconds per repetition
+constexpr double DEFAULT_CONFIDENCE = 0.99; // Interval width and 1 - significance level
+constexpr double DEFAULT_THRESHOLD = 0.05;  // Smallest slowdown worth failing for
+// Stable, single-threaded benchmarks that cover parsing, serialization and access
+const char* const DEFAULT_FILTER
+    = "BM_JSOM_(Parse|Serialization_|SmallNumbers|LargeNumbers|ContainerAccess)";
+
+constexpr int NAME_WIDTH = 44;
+constexpr int NUMBER_WIDTH = 12;
+constexpr int PERCENT_WIDTH = 9;
+constexpr double PERCENT = 100.0;
+
+struct GateOptions {
+    std::string benchmarks;
+    std::string baseline;
+    std::string results;
+    std::string filter = DEFAULT_FILTER;
+    int repetitions = DEFAULT_REPETITIONS;
+    double min_time = DEFAULT_MIN_TIME;
+    double confidence = DEFAULT_CONFIDENCE;
+    double threshold = DEFAULT_THRESHOLD;
+    bool update_baseline = false;
+};
+
+// Samples per benchmark (CPU ns per iteration), plus the run's context block
+struct BenchmarkRun {
+    jsom::JsonDocument context;
+    std::map<std::string, std::vector<double>> samples;
+};
+
+void show_usage() {
+    std::cout << R"(Statistical performance regression gate
+
+USAGE: jsom_regression_gate --baseline=FILE (--benchmarks=EXE | --results=FILE) [OPTIONS]
+
+OPTIONS:
+    --benchmarks=EXE     jsom_benchmarks executable to run
+    --results=FILE       Use an existing --benchmark_out JSON file instead of running
+    --baseline=FILE      Baseline JSON to compare against (or write)
+    --update-baseline    Write this run as the new baseline and exit
+    --filter=REGEX       Benchmarks to run (default: stable parse/serialize/access set)
+    --repetitions=N      Samples per benchmark (default: 10)
+    --min-time=SECONDS   Minimum time per sample (default: 0.2)
+    --confidence=P       Confidence level for intervals and tests (default: 0.99)
+    --threshold=R        Smallest relative slowdown that fails (default: 0.05)
+)";
+}
+
+auto read_file(const std::string& filename) -> std::string {
+    std::ifstream file(filename);
+    if (!file.is_open()) {
+        throw std::runtime_error("Cannot open file: " + filename);
+    }
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    return buffer.str();
+}
+
+auto nanoseconds_per_unit(const std::string& unit) -> double {
+    // NOLINTBEGIN(readability-magic-numbers)
+    if (unit == "us") {
+        return 1e3;
+    }
+    if (unit == "ms") {
+        return 1e6;
+    }
+    if (unit == "s") {
+        return 1e9;
+    }
+    // NOLINTEND(readability-magic-numbers)
+    return 1.0;
+}
+
+// Google Benchmark writes NaN and Infinity for counters it cannot aggregate (the coefficient
+// of variation of a counter that is always 0, say), which JSON has no literal for. Replace
+// them with null outside strings.
+auto replace_non_finite(const std::string& json) -> std::string {
+    // Length of the NaN, Infinity, -NaN or -Infinity at `pos`, or 0
+    auto non_finite_length = [&json](std::size_t pos) -> std::size_t {
+        std::size_t sign = json[pos] == '-' ? 1 : 0;
+        for (std::string_view token : {"NaN", "Infinity"}) {
+            if (json.compare(pos + sign, token.size(), token) == 0) {
+                return sign + token.size();
+            }
+        }
+        return 0;
+    };
+
+    std::string result;
+    result.reserve(json.size());
+    bool in_string = false;
+    for (std::size_t i = 0; i < json.size(); ++i) {
+        char c = json[i]; // NOLINT(readability-identifier-length)
+        if (in_string) {
+            result += c;
+            if (c == '\\' && i + 1 < json.size()) {
+                result += json[++i];
+            } else if (c == '"') {
+                in_string = false;
+            }
+        } else if (std::size_t length = non_finite_length(i); length > 0) {
+            result += "null";
+            i += length - 1;
+        } else {
+            in_string = c == '"';
+            result += c;
+        }
+    }
+    return result;
+}
+
+// Collect per-repetition samples from Google Benchmark's JSON output
+auto load_benchmark_output(const std::string& filename) -> BenchmarkRun {
+    auto output = jsom::parse_document(replace_non_finite(read_file(filename)));
+    BenchmarkRun run;
+    if (output.contains("context")) {
+        run.context = output["context"];
+    }
+    for (const auto& entry : output["benchmarks"].as_array()) {
+        bool aggregate = entry.contains("run_type")
+                         && entry["run_type"].as<std::string>() != "iteration";
+        if (aggregate || entry.contains("error_occurred")) {
+            continue;
+        }
+        std::string name = entry.contains("run_name") ? entry["run_name"].as<std::string>()
+                                                      : entry["name"].as<std::string>();
+        std::string unit = entry.contains("time_unit") ? entry["time_unit"].as<std::string>()
+                                                       : "ns";
+        run.samples[name].push_back(entry["cpu_time"].as<double>() * nanoseconds_per_unit(unit));
+    }
+    return run;
+}
+
+auto run_benchmarks(const GateOptions& options) -> BenchmarkRun {
+    auto output_file = std::filesystem::temp_directory_path() / "jsom_regression_run.json";
+    std::ostringstream command;
+    command << '"' << options.benchmarks << '"' << " '--benchmark_filter=" << options.filter
+            << "' --benchmark_repetitions=" << options.repetitions
+            << " --benchmark_min_time=" << options.min_time
+            << " --benchmark_enable_random_interleaving=true"
+            << " --benchmark_out_format=json --benchmark_out=\"" << output_file.string() << '"';
+    std::cerr << "Running: " << command.str() << '\n';
+    if (std::system(command.str().c_str()) != 0) {
+        throw std::runtime_error("benchmark run failed");
+    }
+    auto run = load_benchmark_output(output_file.string());
+    std::filesystem::remove(output_file);
+    return run;
+}
+
+auto load_baseline(const std::string& filename) -> BenchmarkRun {
+    auto baseline = jsom::parse_document(read_file(filename));
+    BenchmarkRun run;
+    run.context = baseline["context"];
+    for (const auto& [name, entry] : baseline["benchmarks"].as_object()) {
+        for (const auto& sample : entry["samples"].as_array()) {
+            run.samples[name].push_back(sample.as<double>());
+        }
+    }
+    return run;
+}
+
+void write_baseline(const std::string& filename, const BenchmarkRun& run) {
+    auto benchmarks = jsom::JsonDocument::make_object();
+    for (const auto& [name, samples] : run.samples) {
+        std::vector<jsom::JsonDocument> values(samples.begin(), samples.end());
+        benchmarks.set(name, jsom::JsonDocument{{"unit", jsom::JsonDocument("ns")},
+                                                {"samples", jsom::JsonDocument(std::move(values))}});
+    }
+    jsom::JsonDocument baseline{{"context", run.context}, {"benchmarks", std::move(benchmarks)}};
+
+    std::ofstream file(filename);
+    if (!file.is_open()) {
+        throw std::runtime_error("Cannot write to file: " + filename);
+    }
+    file << baseline.to_json(jsom::FormatPresets::Pretty) << '\n';
+}
+
+// Build type of the measured code, recorded by jsom_benchmarks; empty for runs without it
+auto build_type(const BenchmarkRun& run) -> std::string {
+    if (!run.context.is_object() || !run.context.contains("jsom_build_type")) {
+        return "";
+    }
+    return run.context["jsom_build_type"].as<std::string>();
+}
+
+// Debug and release timings are not comparable at all, so a build type mismatch is an error
+void check_build_type(const BenchmarkRun& baseline, const BenchmarkRun& current) {
+    std::string recorded = build_type(baseline);
+    std::string measured = build_type(current);
+    if (recorded.empty() || measured.empty()) {
+        throw std::runtime_error("jsom_build_type missing from the "
+                                 + std::string(recorded.empty() ? "baseline" : "benchmark run")
+                                 + "; re-run with the current jsom_benchmarks");
+    }
+    if (recorded != measured) {
+        throw std::runtime_error("baseline was recorded with a " + recorded
+                                 + " build but this run is a " + measured + " build");
+    }
+}
+
+// Baselines only transfer between comparable machines; say so when they differ
+void warn_on_context_mismatch(const BenchmarkRun& baseline, const BenchmarkRun& current) {
+    for (const char* key : {"host_name", "num_cpus", "library_build_type"}) {
+        bool in_baseline = baseline.context.is_object() && baseline.context.contains(key);
+        bool in_current = current.context.is_object() && current.context.contains(key);
+        if (in_baseline && in_current
+            && !(baseline.context[key] == current.context[key])) {
+            std::cerr << "Warning: " << key << " differs from the baseline ("
+                      << baseline.context[key].to_json() << " vs "
+                      << current.context[key].to_json() << "); results may not be comparable\n";
+        }
+    }
+}
+
+auto percent(double ratio) -> std::string {
+    std::ostringstream out;
+    out << std::showpos << std::fixed << std::setprecision(1) << ratio * PERCENT << '%';
+    return out.str();
+}
+
+// NOLINTBEGIN(readability-function-size)
+auto compare_runs(const BenchmarkRun& baseline, const BenchmarkRun& current,
+                  const GateOptions& options) -> bool {
+    double alpha = 1.0 - options.confidence;
+    std::cout << std::left << std::setw(NAME_WIDTH) << "Benchmark" << std::right
+              << std::setw(NUMBER_WIDTH) << "base ns" << std::setw(NUMBER_WIDTH) << "new ns"
+              << std::setw(PERCENT_WIDTH) << "change" << "  "
+              << static_cast<int>(options.confidence * PERCENT) << "% interval"
+              << "         p  verdict\n";
+
+    int regressions = 0;
+    for (const auto& [name, samples] : current.samples) {
+        auto base = baseline.samples.find(name);
+        std::cout << std::left << std::setw(NAME_WIDTH) << name << std::right;
+        if (base == baseline.samples.end()) {
+            std::cout << "  (no baseline)\n";
+            continue;
+        }
+        auto result = regression_stats::compare(base->second, samples, options.confidence);
+        const char* verdict = "ok";
+        if (result.p_value < alpha && result.change > options.threshold) {
+            verdict = "SLOWER";
+            ++regressions;
+        } else if (1.0 - result.p_value < alpha && result.change < -options.threshold) {
+            verdict = "faster";
+        }
+        std::cout << std::fixed << std::setprecision(0) << std::setw(NUMBER_WIDTH)
+                  << regression_stats::summarize(base->second).mean << std::setw(NUMBER_WIDTH)
+                  << regression_stats::summarize(samples).mean << std::setw(PERCENT_WIDTH)
+                  << percent(result.change) << "  [" << percent(result.change_low) << ", "
+                  << percent(result.change_high) << "]  " << std::setprecision(4)
+                  << std::setw(PERCENT_WIDTH) << result.p_value << "  " << verdict << '\n';
+    }
+    for (const auto& [name, samples] : baseline.samples) {
+        if (current.samples.count(name) == 0) {
+            std::cout << std::left << std::setw(NAME_WIDTH) << name << "  (not run)\n";
+        }
+    }
+
+    if (regressions > 0) {
+        std::cout << '\n' << regressions << " benchmark(s) significantly slower than baseline\n";
+        return false;
+    }
+    std::cout << "\nNo significant slowdowns\n";
+    return true;
+}
+// NOLINTEND(readability-function-size)
+
+auto parse_options(int argc, char* argv[]) -> GateOptions {
+    GateOptions options;
+    auto value_of = [](const std::string& arg) { return arg.substr(arg.find('=') + 1); };
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg.rfind("--benchmarks=", 0) == 0) {
+            options.benchmarks = value_of(arg);
+        } else if (arg.rfind("--baseline=", 0) == 0) {
+            options.baseline = value_of(arg);
+        } else if (arg.rfind("--results=", 0) == 0) {
+            options.results = value_of(arg);
+        } else if (arg.rfind("--filter=", 0) == 0) {
+            options.filter = value_of(arg);
+        } else if (arg.rfind("--repetitions=", 0) == 0) {
+            options.repetitions = std::stoi(value_of(arg));
+        } else if (arg.rfind("--min-time=", 0) == 0) {
+            options.min_time = std::stod(value_of(arg));
+        } else if (arg.rfind("--confidence=", 0) == 0) {
+            options.confidence = std::stod(value_of(arg));
+        } else if (arg.rfind("--threshold=", 0) == 0) {
+            options.threshold = std::stod(value_of(arg));
+        } else if (arg == "--update-baseline") {
+            options.update_baseline = true;
+        } else {
+            throw std::invalid_argument("Unknown option: " + arg);
+        }
+    }
+    if (options.baseline.empty() || (options.benchmarks.empty() && options.results.empty())) {
+        throw std::invalid_argument("--baseline and one of --benchmarks or --results are required");
+    }
+    if (options.repetitions < 2) {
+        throw std::invalid_argument("--repetitions must be at least 2");
+    }
+    return options;
+}
+
+} // namespace
+
+auto main(int argc, char* argv[]) -> int {
+    if (argc > 1 && (std::string(argv[1]) == "--help" || std::string(argv[1]) == "-h")) {
+        show_usage();
+        return 0;
+    }
+    try {
+        GateOptions options = parse_options(argc, argv);
+        BenchmarkRun current = options.results.empty() ? run_benchmarks(options)
+                                                       : load_benchmark_output(options.results);
+        if (current.samples.empty()) {
+            throw std::runtime_error("no benchmark samples (check --filter)");
+        }
+
+        if (options.update_baseline) {
+            if (build_type(current) != "release") {
+                throw std::runtime_error("baselines must be recorded from a release build of "
+                                         "jsom_benchmarks (CMAKE_BUILD_TYPE=Release)");
+            }
+            write_baseline(options.baseline, current);
+            std::cout << "Wrote baseline for " << current.samples.size() << " benchmarks to "
+                      << options.baseline << '\n';
+            return 0;
+        }
+
+        BenchmarkRun baseline = load_baseline(options.baseline);
+        check_build_type(baseline, current);
+        warn_on_context_mismatch(baseline, current);
+        return compare_runs(baseline, current, options) ? 0 : EXIT_REGRESSION;
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << '\n';
+        show_usage();
+        return EXIT_ERROR;
+    }
+}
@@ -0,0 +1,168 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+// Statistics for the performance regression gate: Welch's t-test between a baseline and a
+// new set of benchmark samples, with a confidence interval for the relative change.
+namespace regression_stats {
+
+struct Summary {
+    std::size_t count = 0;
+    double mean = 0.0;
+    double variance = 0.0; // Sample variance (n - 1)
+};
+
+inline auto summarize(const std::vector<double>& samples) -> Summary {
+    Summary summary;
+    summary.count = samples.size();
+    if (samples.empty()) {
+        return summary;
+    }
+    summary.mean = std::accumulate(samples.begin(), samples.end(), 0.0)
+                   / static_cast<double>(samples.size());
+    if (samples.size() > 1) {
+        double squares = 0.0;
+        for (double sample : samples) {
+            squares += (sample - summary.mean) * (sample - summary.mean);
+        }
+        summary.variance = squares / static_cast<double>(samples.size() - 1);
+    }
+    return summary;
+}
+
+namespace detail {
+
+// Continued fraction for the incomplete beta function (modified Lentz)
+// NOLINTBEGIN(readability-magic-numbers,readability-identifier-length)
+inline auto beta_fraction(double a, double b, double x) -> double {
+    constexpr int MAX_ITERATIONS = 300;
+    constexpr double EPSILON = 1e-14;
+    constexpr double TINY = 1e-300;
+
+    double c = 1.0;
+    double d = 1.0 - (a + b) * x / (a + 1.0);
+    d = 1.0 / (std::fabs(d) < TINY ? TINY : d);
+    double h = d;
+    for (int m = 1; m <= MAX_ITERATIONS; ++m) {
+        double m2 = 2.0 * m;
+        double numerator = m * (b - m) * x / ((a + m2 - 1.0) * (a + m2));
+        d = 1.0 + numerator * d;
+        d = 1.0 / (std::fabs(d) < TINY ? TINY : d);
+        c = 1.0 + numerator / c;
+        c = std::fabs(c) < TINY ? TINY : c;
+        h *= d * c;
+
+        numerator = -(a + m) * (a + b + m) * x / ((a + m2) * (a + m2 + 1.0));
+        d = 1.0 + numerator * d;
+        d = 1.0 / (std::fabs(d) < TINY ? TINY : d);
+        c = 1.0 + numerator / c;
+        c = std::fabs(c) < TINY ? TINY : c;
+        double step = d * c;
+        h *= step;
+        if (std::fabs(step - 1.0) < EPSILON) {
+            break;
+        }
+    }
+    return h;
+}
+// NOLINTEND(readability-magic-numbers,readability-identifier-length)
+
+} // namespace detail
+
+// Regularized incomplete beta function I_x(a, b)
+// NOLINTNEXTLINE(readability-identifier-length)
+inline auto incomplete_beta(double a, double b, double x) -> double {
+    if (x <= 0.0) {
+        return 0.0;
+    }
+    if (x >= 1.0) {
+        return 1.0;
+    }
+    double front = std::exp(std::lgamma(a + b) - std::lgamma(a) - std::lgamma(b)
+                            + a * std::log(x) + b * std::log1p(-x));
+    // The continued fraction converges quickly only below the mean; use symmetry above
+    if (x < (a + 1.0) / (a + b + 2.0)) {
+        return front * detail::beta_fraction(a, b, x) / a;
+    }
+    return 1.0 - front * detail::beta_fraction(b, a, 1.0 - x) / b;
+}
+
+// Student's t cumulative distribution P(T <= t) with `df` degrees of freedom
+// NOLINTNEXTLINE(readability-identifier-length)
+inline auto t_cdf(double t, double df) -> double {
+    double tail = 0.5 * incomplete_beta(df / 2.0, 0.5, df / (df + t * t));
+    return t >= 0.0 ? 1.0 - tail : tail;
+}
+
+// Inverse of t_cdf for probability in (0.5, 1), by bisection
+inline auto t_quantile(double probability, double df) -> double {
+    constexpr int BISECTION_STEPS = 200;
+    constexpr double UPPER_BOUND = 1e6;
+    double low = 0.0;
+    double high = UPPER_BOUND;
+    for (int i = 0; i < BISECTION_STEPS; ++i) {
+        double middle = (low + high) / 2.0;
+        if (t_cdf(middle, df) < probability) {
+            low = middle;
+        } else {
+            high = middle;
+        }
+    }
+    return (low + high) / 2.0;
+}
+
+// Welch's t-test of "candidate is slower than baseline"
+struct Comparison {
+    double ratio = 1.0;        // candidate mean / baseline mean
+    double change = 0.0;       // Relative change of the mean (0.10 = 10% slower)
+    double change_low = 0.0;   // Confidence interval for `change`
+    double change_high = 0.0;
+    double p_value = 1.0;      // One-sided: probability of a slowdown this large by chance
+    double degrees_of_freedom = 0.0;
+};
+
+// Compare two sample sets at the given confidence (e.g. 0.99 for a 99% interval)
+inline auto compare(const std::vector<double>& baseline, const std::vector<double>& candidate,
+                    double confidence) -> Comparison {
+    Summary base = summarize(baseline);
+    Summary next = summarize(candidate);
+    if (base.count < 2 || next.count < 2 || base.mean <= 0.0) {
+        throw std::invalid_argument("need at least two positive samples on each side");
+    }
+
+    Comparison result;
+    double difference = next.mean - base.mean;
+    result.ratio = next.mean / base.mean;
+    result.change = difference / base.mean;
+
+    double base_term = base.variance / static_cast<double>(base.count);
+    double next_term = next.variance / static_cast<double>(next.count);
+    double standard_error = std::sqrt(base_term + next_term);
+    if (standard_error == 0.0) {
+        // Identical repetitions: the difference is exact
+        result.change_low = result.change_high = result.change;
+        result.p_value = difference > 0.0 ? 0.0 : 1.0;
+        result.degrees_of_freedom = std::numeric_limits<double>::infinity();
+        return result;
+    }
+
+    // Welch-Satterthwaite degrees of freedom
+    double df = (base_term + next_term) * (base_term + next_term)
+                / (base_term * base_term / static_cast<double>(base.count - 1)
+                   + next_term * next_term / static_cast<double>(next.count - 1));
+    double t_statistic = difference / standard_error;
+    double margin = t_quantile(0.5 + confidence / 2.0, df) * standard_error;
+
+    result.degrees_of_freedom = df;
+    result.p_value = 1.0 - t_cdf(t_statistic, df);
+    result.change_low = (difference - margin) / base.mean;
+    result.change_high = (difference + margin) / base.mean;
+    return result;
+}
+
+} // namespace regression_stats
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstddef>
+
+namespace jsom {
+
+// Heap activity seen by the counting allocator
+struct AllocationStats {
+    std::size_t allocations = 0;     // Calls to operator new
+    std::size_t deallocations = 0;   // Calls to operator delete (non-null)
+    std::size_t allocated_bytes = 0; // Bytes requested over the program's lifetime
+    std::size_t live_bytes = 0;      // Bytes currently allocated
+    std::size_t peak_bytes = 0;      // Highest live_bytes seen
+};
+
+// Counters kept by src/allocation_counter.cpp, which replaces the global operator new and
+// delete. Only programs that compile that file in (the jsom CLI) can call these; the
+// library itself never replaces the allocator.
+auto allocation_stats() -> AllocationStats;
+
+// Reset peak_bytes to the current live_bytes, so a phase can measure its own peak
+void reset_allocation_peak();
+
+// Counting is on from program start. Turned off, allocations skip the shared counters and
+// are never counted, not even when freed after counting is turned back on.
+void set_allocation_counting(bool enabled);
+
+// Difference between two snapshots (peak and live come from `later`)
+inline auto operator-(const AllocationStats& later, const AllocationStats& earlier)
+    -> AllocationStats {
+    AllocationStats delta = later;
+    delta.allocations -= earlier.allocations;
+    delta.deallocations -= earlier.deallocations;
+    delta.allocated_bytes -= earlier.allocated_bytes;
+    return delta;
+}
+
+} // namespace jsom
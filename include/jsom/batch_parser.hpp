@@ -2,8 +2,9 @@
 
 #include "fast_parser.hpp"
 #include "json_document.hpp"
+#include "json_pointer.hpp"
 #include "streaming_parser.hpp"
-#include <algorithm>
+#include <stack>
 #include <stdexcept>
 
 namespace jsom {
@@ -11,49 +12,32 @@ namespace jsom {
 class DocumentBuilder {
 private:
     JsonDocument root_;
+    // Containers still open, innermost on top. Events arrive in document order, so every
+    // value belongs to the top container and only the last path segment is needed; walking
+    // the whole path from the root for each value made deep documents O(n * depth).
     std::stack<JsonDocument*> container_stack_;
     bool has_root_{false};
 
-    auto get_current_container() -> JsonDocument* {
-        if (container_stack_.empty()) {
-            return &root_;
-        }
-        return container_stack_.top();
-    }
-
 public:
     DocumentBuilder() = default;
 
-    void on_value(const JsonDocument& value, const std::string& path) {
-        if (path.empty()) {
-            root_ = value;
-            has_root_ = true;
-        } else {
-            set_value_at_path(value, path);
-        }
-    }
+    void on_value(const JsonDocument& value, const std::string& path) { place(value, path); }
 
     void on_enter_object(const std::string& path) {
-        JsonDocument obj(std::initializer_list<std::pair<const std::string, JsonDocument>>{});
-        if (path.empty()) {
-            root_ = obj;
-            has_root_ = true;
-        } else {
-            set_value_at_path(obj, path);
-        }
+        container_stack_.push(place(
+            JsonDocument(std::initializer_list<std::pair<const std::string, JsonDocument>>{}),
+            path));
     }
 
     void on_enter_array(const std::string& path) {
-        JsonDocument arr(std::vector<JsonDocument>{});
-        if (path.empty()) {
-            root_ = arr;
-            has_root_ = true;
-        } else {
-            set_value_at_path(arr, path);
-        }
+        container_stack_.push(place(JsonDocument(std::vector<JsonDocument>{}), path));
     }
 
-    void on_exit_container(const std::string& /*unused*/) {}
+    void on_exit_container(const std::string& /*unused*/) {
+        if (!container_stack_.empty()) {
+            container_stack_.pop();
+        }
+    }
 
     static void on_error(const ParseError& error) {
         throw std::runtime_error("Parse error at position " + std::to_string(error.position)
@@ -76,102 +60,31 @@ public:
     }
 
 private:
-    // NOLINTBEGIN(readability-function-size)
-    void set_value_at_path(const JsonDocument& value, const std::string& path) {
-        if (!has_root_) {
-            throw std::runtime_error("Cannot set value - no root container");
-        }
-
-        std::vector<std::string> segments = parse_json_pointer(path);
-        JsonDocument* current = &root_;
-
-        for (size_t i = 0; i < segments.size(); ++i) {
-            const std::string& segment = segments[i];
-
-            if (i == segments.size() - 1) {
-                if (current->is_object()) {
-                    current->set(segment, value);
-                } else if (current->is_array()) {
-                    size_t index = std::stoull(segment);
-                    current->set(index, value);
-                }
-            } else {
-                if (current->is_object()) {
-                    auto& obj_map
-                        = std::get<std::map<std::string, JsonDocument>>(current->storage_);
-                    if (obj_map.find(segment) == obj_map.end()) {
-                        if (i + 1 < segments.size() && is_numeric(segments[i + 1])) {
-                            current->set(segment,
-                                         JsonDocument(std::vector<JsonDocument>{}));
-                        } else {
-                            current->set(
-                                segment,
-                                JsonDocument(std::initializer_list<
-                                             std::pair<const std::string, JsonDocument>>{}));
-                        }
-                    }
-                    current = &obj_map[segment];
-                } else if (current->is_array()) {
-                    size_t index = std::stoull(segment);
-                    auto& arr = std::get<std::vector<JsonDocument>>(current->storage_);
-                    if (index >= arr.size()) {
-                        arr.resize(index + 1);
-                    }
-                    current = &arr[index];
-                }
-            }
-        }
-    }
-    // NOLINTEND(readability-function-size)
-
-    static auto parse_json_pointer(const std::string& path) -> std::vector<std::string> {
-        std::vector<std::string> segments;
-        if (path.empty() || path[0] != '/') {
-            return segments;
-        }
-
-        std::string current;
-        for (size_t i = 1; i < path.length(); ++i) {
-            if (path[i] == '/') {
-                segments.push_back(unescape_json_pointer(current));
-                current.clear();
-            } else {
-                current += path[i];
-            }
+    // Stores `value` at `path` inside the innermost open container and returns where it
+    // landed. Parents only grow after their open child is popped, so the returned pointer
+    // stays valid while it is on the stack.
+    auto place(const JsonDocument& value, const std::string& path) -> JsonDocument* {
+        if (path.empty()) {
+            root_ = value;
+            has_root_ = true;
+            return &root_;
         }
-        if (!current.empty()) {
-            segments.push_back(unescape_json_pointer(current));
+        if (container_stack_.empty()) {
+            throw std::runtime_error("Cannot set value - no root container");
         }
 
-        return segments;
-    }
-
-    static auto unescape_json_pointer(const std::string& str) -> std::string {
-        std::string result;
-        for (size_t i = 0; i < str.length(); ++i) {
-            if (str[i] == '~' && i + 1 < str.length()) {
-                if (str[i + 1] == '0') {
-                    result += '~';
-                    ++i;
-                } else if (str[i + 1] == '1') {
-                    result += '/';
-                    ++i;
-                } else {
-                    result += str[i];
-                }
-            } else {
-                result += str[i];
-            }
+        JsonDocument* parent = container_stack_.top();
+        if (parent->is_array()) {
+            auto& arr = std::get<std::vector<JsonDocument>>(parent->own_storage());
+            arr.push_back(value);
+            return &arr.back();
         }
-        return result;
-    }
 
-    static auto is_numeric(const std::string& str) -> bool {
-        if (str.empty()) {
-            return false;
-        }
-        // NOLINTNEXTLINE(readability-identifier-length)
-        return std::all_of(str.begin(), str.end(), [](char c) { return std::isdigit(c) != 0; });
+        // The key may be empty ("/" or "/a/"), so it is taken from the path, never skipped
+        auto& obj_map = parent->object_map();
+        auto& slot = obj_map[JsonPointer::get_last_segment(path)];
+        slot = value;
+        return &slot;
     }
 };
 
@@ -220,19 +133,6 @@ public:
     }
 };
 
-inline auto parse_document(const std::string& json) -> JsonDocument {
-    // Use fast parser by default for better performance
-    FastParser parser;
-    return parser.parse(json);
-}
-
-inline auto parse_document(const std::string& json, const JsonParseOptions& options)
-    -> JsonDocument {
-    // Use fast parser with options for better performance
-    FastParser parser(options);
-    return parser.parse(json);
-}
-
 // Legacy streaming parser (for compatibility/debugging)
 inline auto parse_document_streaming(const std::string& json) -> JsonDocument {
     DocumentBuilder builder;
@@ -0,0 +1,534 @@
+#pragma once
+
+#include "constants.hpp"
+#include "json_document.hpp"
+#include "json_pointer.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define JSOM_HAS_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace jsom {
+
+// Binary snapshot layout (all integers in the writer's byte order, read with memcpy so
+// nodes need no alignment):
+//
+//   header:  "JSOMB" | u8 version | u16 byte-order mark | u64 root offset
+//   null/false/true:  u8 tag
+//   number:  u8 tag | u32 length | original text
+//   string:  u8 tag | u32 length | decoded bytes
+//   array:   u8 tag | u32 count  | count x u64 element offset
+//   object:  u8 tag | u32 count  | count x (u64 key offset, u64 value offset), sorted by key
+//   key:     u32 length | bytes
+//
+// Children are written before their parent, so a snapshot is produced in one pass and
+// every lookup is a bounded number of reads: array access is O(1) and object access is a
+// binary search over the sorted member table.
+enum class SnapshotTag : std::uint8_t { Null, False, True, Number, String, Array, Object };
+
+class SnapshotException : public std::runtime_error {
+public:
+    explicit SnapshotException(const std::string& message)
+        : std::runtime_error("Binary snapshot: " + message) {}
+};
+
+// Serializes a JsonDocument into the snapshot format
+class SnapshotWriter {
+public:
+    static auto write(const JsonDocument& doc) -> std::string {
+        SnapshotWriter writer;
+        writer.out_.assign(snapshot_constants::HEADER_SIZE, '\0');
+        writer.out_.replace(0, snapshot_constants::MAGIC_SIZE, MAGIC);
+        writer.out_[snapshot_constants::VERSION_OFFSET]
+            = static_cast<char>(snapshot_constants::FORMAT_VERSION);
+        std::uint16_t mark = snapshot_constants::BYTE_ORDER_MARK;
+        std::memcpy(&writer.out_[snapshot_constants::BYTE_ORDER_OFFSET], &mark, sizeof(mark));
+
+        std::uint64_t root = writer.write_node(doc);
+        std::memcpy(&writer.out_[snapshot_constants::ROOT_OFFSET], &root, sizeof(root));
+        return std::move(writer.out_);
+    }
+
+    static constexpr const char* MAGIC = "JSOMB";
+
+private:
+    std::string out_;
+
+    template <typename T> void append(T value) {
+        out_.append(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    void append_blob(std::string_view bytes) {
+        if (bytes.size() > UINT32_MAX) {
+            throw SnapshotException("string too large");
+        }
+        append(static_cast<std::uint32_t>(bytes.size()));
+        out_.append(bytes);
+    }
+
+    // Element and member counts are stored in 32 bits too; checked before any child is written
+    static void check_count(std::size_t count, const char* container) {
+        if (count > UINT32_MAX) {
+            throw SnapshotException(std::string(container) + " too large");
+        }
+    }
+
+    // NOLINTBEGIN(readability-function-size)
+    auto write_node(const JsonDocument& doc) -> std::uint64_t {
+        switch (doc.type()) {
+        case JsonType::Null:
+            return write_tag(SnapshotTag::Null);
+        case JsonType::Boolean:
+            return write_tag(doc.as<bool>() ? SnapshotTag::True : SnapshotTag::False);
+        case JsonType::Number: {
+            std::string text = doc.to_json(); // Original text when parsed
+            std::uint64_t offset = write_tag(SnapshotTag::Number);
+            append_blob(text);
+            return offset;
+        }
+        case JsonType::String: {
+            std::string value = doc.as<std::string>();
+            std::uint64_t offset = write_tag(SnapshotTag::String);
+            append_blob(value);
+            return offset;
+        }
+        case JsonType::Array: {
+            const auto& elements = doc.as_array();
+            check_count(elements.size(), "array");
+            std::vector<std::uint64_t> offsets;
+            offsets.reserve(elements.size());
+            for (const auto& element : elements) {
+                offsets.push_back(write_node(element));
+            }
+            std::uint64_t offset = write_tag(SnapshotTag::Array);
+            append(static_cast<std::uint32_t>(offsets.size()));
+            for (auto child : offsets) {
+                append(child);
+            }
+            return offset;
+        }
+        case JsonType::Object: {
+            // Objects iterate in key order, which is the order readers binary-search in
+            check_count(doc.size(), "object");
+            std::vector<std::pair<std::uint64_t, std::uint64_t>> members;
+            members.reserve(doc.size());
+            for (const auto& [key, value] : doc.members()) {
+                std::uint64_t key_offset = out_.size();
+                append_blob(key);
+                members.emplace_back(key_offset, write_node(value));
+            }
+            std::uint64_t offset = write_tag(SnapshotTag::Object);
+            append(static_cast<std::uint32_t>(members.size()));
+            for (const auto& [key_offset, value_offset] : members) {
+                append(key_offset);
+                append(value_offset);
+            }
+            return offset;
+        }
+        }
+        throw SnapshotException("unknown node type");
+    }
+    // NOLINTEND(readability-function-size)
+
+    auto write_tag(SnapshotTag tag) -> std::uint64_t {
+        std::uint64_t offset = out_.size();
+        out_ += static_cast<char>(tag);
+        return offset;
+    }
+};
+
+// Read-only handle to one node of a snapshot. Cheap to copy; valid while the snapshot's
+// bytes are alive. Every read is bounds-checked, and a child must come before its parent as
+// the writer lays them out, so a truncated or corrupt file throws SnapshotException instead
+// of reading out of range or looping through a cycle.
+class SnapshotValue {
+public:
+    SnapshotValue(std::string_view data, std::uint64_t offset) : data_(data), offset_(offset) {
+        if (offset_ >= data_.size()) {
+            throw SnapshotException("node offset out of range");
+        }
+        auto tag = static_cast<std::uint8_t>(data_[offset_]);
+        if (tag > static_cast<std::uint8_t>(SnapshotTag::Object)) {
+            throw SnapshotException("invalid node tag");
+        }
+        tag_ = static_cast<SnapshotTag>(tag);
+    }
+
+    [[nodiscard]] auto type() const -> JsonType {
+        switch (tag_) {
+        case SnapshotTag::Null:
+            return JsonType::Null;
+        case SnapshotTag::False:
+        case SnapshotTag::True:
+            return JsonType::Boolean;
+        case SnapshotTag::Number:
+            return JsonType::Number;
+        case SnapshotTag::String:
+            return JsonType::String;
+        case SnapshotTag::Array:
+            return JsonType::Array;
+        case SnapshotTag::Object:
+            return JsonType::Object;
+        }
+        return JsonType::Null;
+    }
+
+    [[nodiscard]] auto is_object() const -> bool { return tag_ == SnapshotTag::Object; }
+    [[nodiscard]] auto is_array() const -> bool { return tag_ == SnapshotTag::Array; }
+
+    [[nodiscard]] auto as_bool() const -> bool {
+        if (tag_ != SnapshotTag::True && tag_ != SnapshotTag::False) {
+            throw TypeException("Snapshot value is not a boolean");
+        }
+        return tag_ == SnapshotTag::True;
+    }
+
+    // Decoded string bytes, or the original text of a number
+    [[nodiscard]] auto text() const -> std::string_view {
+        if (tag_ != SnapshotTag::String && tag_ != SnapshotTag::Number) {
+            throw TypeException("Snapshot value is not a string or number");
+        }
+        return blob_at(offset_ + 1);
+    }
+
+    // Element count for arrays, member count for objects, 0 otherwise
+    [[nodiscard]] auto size() const -> std::size_t {
+        if (tag_ != SnapshotTag::Array && tag_ != SnapshotTag::Object) {
+            return 0;
+        }
+        return read<std::uint32_t>(offset_ + 1);
+    }
+
+    [[nodiscard]] auto element(std::size_t index) const -> std::optional<SnapshotValue> {
+        if (tag_ != SnapshotTag::Array || index >= size()) {
+            return std::nullopt;
+        }
+        return child(element_slot(index));
+    }
+
+    [[nodiscard]] auto key_at(std::size_t index) const -> std::string_view {
+        return blob_at(read<std::uint64_t>(member_slot(index)));
+    }
+
+    [[nodiscard]] auto value_at(std::size_t index) const -> SnapshotValue {
+        return child(member_slot(index) + snapshot_constants::OFFSET_SIZE);
+    }
+
+    // Binary search over the sorted member table
+    [[nodiscard]] auto member(std::string_view key) const -> std::optional<SnapshotValue> {
+        if (tag_ != SnapshotTag::Object) {
+            return std::nullopt;
+        }
+        std::size_t low = 0;
+        std::size_t high = size();
+        while (low < high) {
+            std::size_t mid = low + (high - low) / 2;
+            int cmp = key_at(mid).compare(key);
+            if (cmp == 0) {
+                return value_at(mid);
+            }
+            if (cmp < 0) {
+                low = mid + 1;
+            } else {
+                high = mid;
+            }
+        }
+        return std::nullopt;
+    }
+
+    // Resolve an RFC 6901 pointer relative to this node; nullopt if any step is missing.
+    // Throws InvalidJsonPointerException for malformed pointers, like JsonDocument::find.
+    [[nodiscard]] auto find(const std::string& json_pointer) const
+        -> std::optional<SnapshotValue> {
+        std::optional<SnapshotValue> current = *this;
+        for (const auto& segment : JsonPointer::parse(json_pointer)) {
+            if (current->is_object()) {
+                current = current->member(segment);
+            } else if (current->is_array() && JsonPointer::is_array_index(segment)) {
+                current = current->element(JsonPointer::to_array_index(segment));
+            } else {
+                return std::nullopt;
+            }
+            if (!current) {
+                return std::nullopt;
+            }
+        }
+        return current;
+    }
+
+    [[nodiscard]] auto at(const std::string& json_pointer) const -> SnapshotValue {
+        auto found = find(json_pointer);
+        if (!found) {
+            throw JsonPointerNotFoundException(json_pointer);
+        }
+        return *found;
+    }
+
+    // Compact JSON text, identical to to_document().to_json()
+    [[nodiscard]] auto to_json() const -> std::string {
+        std::string out;
+        append_json(out);
+        return out;
+    }
+
+    // Materialize this subtree as a mutable JsonDocument
+    // NOLINTBEGIN(readability-function-size)
+    [[nodiscard]] auto to_document() const -> JsonDocument {
+        switch (tag_) {
+        case SnapshotTag::Null:
+            return JsonDocument(nullptr);
+        case SnapshotTag::False:
+            return JsonDocument(false);
+        case SnapshotTag::True:
+            return JsonDocument(true);
+        case SnapshotTag::Number:
+            return JsonDocument::from_lazy_number(std::string(text()));
+        case SnapshotTag::String:
+            return JsonDocument(std::string(text()));
+        case SnapshotTag::Array: {
+            std::vector<JsonDocument> elements;
+            elements.reserve(size());
+            for (std::size_t i = 0; i < size(); ++i) {
+                elements.push_back(child(element_slot(i)).to_document());
+            }
+            return JsonDocument(std::move(elements));
+        }
+        case SnapshotTag::Object: {
+            JsonObject members;
+            for (std::size_t i = 0; i < size(); ++i) {
+                // Keys are already sorted, so each insertion is amortized constant time
+                members.emplace_hint(members.end(), std::string(key_at(i)),
+                                     value_at(i).to_document());
+            }
+            return JsonDocument(std::move(members));
+        }
+        }
+        return JsonDocument();
+    }
+    // NOLINTEND(readability-function-size)
+
+private:
+    std::string_view data_;
+    std::uint64_t offset_;
+    SnapshotTag tag_;
+
+    template <typename T> [[nodiscard]] auto read(std::uint64_t position) const -> T {
+        if (position > data_.size() || data_.size() - position < sizeof(T)) {
+            throw SnapshotException("read past end of data");
+        }
+        T value;
+        std::memcpy(&value, data_.data() + position, sizeof(T));
+        return value;
+    }
+
+    [[nodiscard]] auto blob_at(std::uint64_t position) const -> std::string_view {
+        auto length = read<std::uint32_t>(position);
+        position += snapshot_constants::LENGTH_SIZE;
+        if (data_.size() - position < length) {
+            throw SnapshotException("string extends past end of data");
+        }
+        return data_.substr(position, length);
+    }
+
+    [[nodiscard]] auto element_slot(std::size_t index) const -> std::uint64_t {
+        return offset_ + 1 + snapshot_constants::LENGTH_SIZE
+               + (index * snapshot_constants::OFFSET_SIZE);
+    }
+
+    [[nodiscard]] auto member_slot(std::size_t index) const -> std::uint64_t {
+        if (tag_ != SnapshotTag::Object || index >= size()) {
+            throw SnapshotException("member index out of range");
+        }
+        return offset_ + 1 + snapshot_constants::LENGTH_SIZE
+               + (index * 2 * snapshot_constants::OFFSET_SIZE);
+    }
+
+    [[nodiscard]] auto child(std::uint64_t slot) const -> SnapshotValue {
+        auto offset = read<std::uint64_t>(slot);
+        if (offset >= offset_) {
+            throw SnapshotException("child offset does not precede its parent");
+        }
+        return {data_, offset};
+    }
+
+    // NOLINTBEGIN(readability-function-size)
+    void append_json(std::string& out) const {
+        switch (tag_) {
+        case SnapshotTag::Null:
+            out += "null";
+            break;
+        case SnapshotTag::False:
+            out += "false";
+            break;
+        case SnapshotTag::True:
+            out += "true";
+            break;
+        case SnapshotTag::Number:
+            out += text();
+            break;
+        case SnapshotTag::String:
+            out += '"';
+            JsonDocument::escape_string_to_string(out, std::string(text()));
+            out += '"';
+            break;
+        case SnapshotTag::Array:
+            out += '[';
+            for (std::size_t i = 0; i < size(); ++i) {
+                if (i > 0) {
+                    out += ',';
+                }
+                child(element_slot(i)).append_json(out);
+            }
+            out += ']';
+            break;
+        case SnapshotTag::Object:
+            out += '{';
+            for (std::size_t i = 0; i < size(); ++i) {
+                if (i > 0) {
+                    out += ',';
+                }
+                out += '"';
+                JsonDocument::escape_string_to_string(out, std::string(key_at(i)));
+                out += "\":";
+                value_at(i).append_json(out);
+            }
+            out += '}';
+            break;
+        }
+    }
+    // NOLINTEND(readability-function-size)
+};
+
+// Owns the bytes of a snapshot file: memory-mapped where available, read into memory
+// otherwise. Opening only maps the file and checks the header; nodes are paged in as
+// they are navigated.
+class BinarySnapshot {
+public:
+    static auto open(const std::string& filename) -> BinarySnapshot {
+        BinarySnapshot snapshot;
+        snapshot.load_file(filename);
+        snapshot.validate_header();
+        return snapshot;
+    }
+
+    // Wrap bytes already in memory (e.g. the result of SnapshotWriter::write)
+    static auto from_bytes(std::string bytes) -> BinarySnapshot {
+        BinarySnapshot snapshot;
+        snapshot.buffer_ = std::move(bytes);
+        snapshot.data_ = snapshot.buffer_;
+        snapshot.validate_header();
+        return snapshot;
+    }
+
+    BinarySnapshot(const BinarySnapshot&) = delete;
+    auto operator=(const BinarySnapshot&) -> BinarySnapshot& = delete;
+
+    BinarySnapshot(BinarySnapshot&& other) noexcept
+        : buffer_(std::move(other.buffer_)), mapped_(std::exchange(other.mapped_, nullptr)),
+          size_(std::exchange(other.size_, 0)) {
+        data_ = mapped_ != nullptr ? std::string_view(mapped_, size_) : std::string_view(buffer_);
+    }
+
+    auto operator=(BinarySnapshot&&) -> BinarySnapshot& = delete;
+
+    ~BinarySnapshot() {
+#ifdef JSOM_HAS_MMAP
+        if (mapped_ != nullptr) {
+            ::munmap(const_cast<char*>(mapped_), size_);
+        }
+#endif
+    }
+
+    [[nodiscard]] auto root() const -> SnapshotValue {
+        std::uint64_t offset = 0;
+        std::memcpy(&offset, data_.data() + snapshot_constants::ROOT_OFFSET, sizeof(offset));
+        return {data_, offset};
+    }
+
+    [[nodiscard]] auto size_bytes() const -> std::size_t { return data_.size(); }
+
+    // True if `bytes` begins with the snapshot magic
+    static auto has_magic(std::string_view bytes) -> bool {
+        return bytes.substr(0, snapshot_constants::MAGIC_SIZE) == SnapshotWriter::MAGIC;
+    }
+
+    // True if the named file begins with the snapshot magic (false if unreadable)
+    static auto is_snapshot_file(const std::string& filename) -> bool {
+        std::ifstream file(filename, std::ios::binary);
+        std::string magic(snapshot_constants::MAGIC_SIZE, '\0');
+        return file.read(magic.data(), static_cast<std::streamsize>(magic.size()))
+               && has_magic(magic);
+    }
+
+private:
+    std::string buffer_;
+    const char* mapped_{nullptr};
+    std::size_t size_{0};
+    std::string_view data_;
+
+    BinarySnapshot() = default;
+
+    void load_file(const std::string& filename) {
+#ifdef JSOM_HAS_MMAP
+        int fd = ::open(filename.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throw std::runtime_error("Cannot open file: " + filename);
+        }
+        struct stat info {};
+        if (::fstat(fd, &info) != 0) {
+            ::close(fd);
+            throw std::runtime_error("Cannot stat file: " + filename);
+        }
+        size_ = static_cast<std::size_t>(info.st_size);
+        if (size_ > 0) {
+            void* mapped = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapped == MAP_FAILED) {
+                ::close(fd);
+                throw std::runtime_error("Cannot map file: " + filename);
+            }
+            mapped_ = static_cast<const char*>(mapped);
+        }
+        ::close(fd);
+        data_ = std::string_view(mapped_, size_);
+#else
+        std::ifstream file(filename, std::ios::binary);
+        if (!file.is_open()) {
+            throw std::runtime_error("Cannot open file: " + filename);
+        }
+        buffer_.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        data_ = buffer_;
+#endif
+    }
+
+    void validate_header() const {
+        if (data_.size() < snapshot_constants::HEADER_SIZE || !has_magic(data_)) {
+            throw SnapshotException("missing JSOMB header");
+        }
+        if (static_cast<std::uint8_t>(data_[snapshot_constants::VERSION_OFFSET])
+            != snapshot_constants::FORMAT_VERSION) {
+            throw SnapshotException("unsupported format version");
+        }
+        std::uint16_t mark = 0;
+        std::memcpy(&mark, data_.data() + snapshot_constants::BYTE_ORDER_OFFSET, sizeof(mark));
+        if (mark != snapshot_constants::BYTE_ORDER_MARK) {
+            throw SnapshotException("written on a host with different byte order");
+        }
+    }
+};
+
+} // namespace jsom
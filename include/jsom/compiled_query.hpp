@@ -0,0 +1,501 @@
+#pragma once
+
+#include "json_pointer.hpp"
+#include <array>
+#include <charconv>
+#include <cstddef>
+#include <cstring>
+#include <limits>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace jsom {
+
+// A value matched by a CompiledQuery, reported as a byte span into the scanned text
+struct QueryMatch {
+    std::size_t pattern; // Index into CompiledQuery::patterns()
+    std::size_t offset;  // Offset of the first byte of the value
+    std::size_t length;  // Length of the value's JSON text
+};
+
+// A set of JSON Pointer patterns compiled once into a prefix trie and matched against
+// raw JSON text without building a JsonDocument.
+//
+// Segments equal to "*" match any object key or array index. Subtrees that no pattern
+// can reach are skipped at scanning speed; matched values are reported as spans into
+// the input, so callers decide whether to copy, parse or print them. A CompiledQuery is
+// immutable after construction and can be shared between threads.
+class CompiledQuery {
+public:
+    explicit CompiledQuery(std::vector<std::string> patterns) : patterns_(std::move(patterns)) {
+        nodes_.emplace_back(); // Root
+        for (std::size_t i = 0; i < patterns_.size(); ++i) {
+            add_pattern(i);
+        }
+    }
+
+    [[nodiscard]] auto patterns() const -> const std::vector<std::string>& { return patterns_; }
+
+    // Scan one JSON text and append every match to `matches`. Matches are appended when
+    // the matched value has been fully scanned, so a pattern's matches appear in
+    // document order. Throws std::runtime_error on malformed input.
+    void extract(std::string_view json, std::vector<QueryMatch>& matches) const {
+        Scanner scanner(*this, json, matches);
+        scanner.run();
+    }
+
+    [[nodiscard]] auto extract(std::string_view json) const -> std::vector<QueryMatch> {
+        std::vector<QueryMatch> matches;
+        extract(json, matches);
+        return matches;
+    }
+
+private:
+    static constexpr std::size_t NO_NODE = std::numeric_limits<std::size_t>::max();
+    static constexpr std::size_t INDEX_BUFFER_SIZE = 24; // Fits any size_t in decimal
+
+    struct TrieNode {
+        std::map<std::string, std::size_t, std::less<>> children;
+        std::size_t wildcard{NO_NODE};
+        std::vector<std::size_t> terminals; // Patterns that end at this node
+
+        [[nodiscard]] auto has_children() const -> bool {
+            return !children.empty() || wildcard != NO_NODE;
+        }
+    };
+
+    std::vector<std::string> patterns_;
+    std::vector<TrieNode> nodes_;
+
+    void add_pattern(std::size_t pattern_index) {
+        std::size_t node = 0;
+        for (const auto& segment : JsonPointer::parse(patterns_[pattern_index])) {
+            std::size_t next = NO_NODE;
+            if (segment == "*") {
+                next = nodes_[node].wildcard;
+            } else {
+                // NOLINTNEXTLINE(readability-identifier-length)
+                auto it = nodes_[node].children.find(segment);
+                if (it != nodes_[node].children.end()) {
+                    next = it->second;
+                }
+            }
+            if (next == NO_NODE) {
+                next = nodes_.size();
+                nodes_.emplace_back(); // May reallocate - index nodes_ again below
+                if (segment == "*") {
+                    nodes_[node].wildcard = next;
+                } else {
+                    nodes_[node].children.emplace(segment, next);
+                }
+            }
+            node = next;
+        }
+        nodes_[node].terminals.push_back(pattern_index);
+    }
+
+    // Single-use scanner over one JSON text. The set of trie nodes that are live at the
+    // current value is kept on active_ as a [begin, end) range, so descending into a
+    // container never allocates once active_ has grown to the query's width.
+    class Scanner {
+    public:
+        Scanner(const CompiledQuery& query, std::string_view json,
+                std::vector<QueryMatch>& matches)
+            : query_(query), data_(json.data()), size_(json.size()), matches_(matches) {}
+
+        void run() {
+            active_.push_back(0);
+            scan_value(0, 1);
+            skip_whitespace();
+            if (pos_ < size_) {
+                fail("Unexpected characters after JSON");
+            }
+        }
+
+    private:
+        const CompiledQuery& query_;
+        const char* data_;
+        std::size_t size_;
+        std::size_t pos_{0};
+        std::vector<QueryMatch>& matches_;
+        std::vector<std::size_t> active_;
+        std::string key_buffer_;
+
+        [[noreturn]] void fail(const std::string& message) const {
+            throw std::runtime_error("Query scan error at offset " + std::to_string(pos_) + ": "
+                                     + message);
+        }
+
+        void skip_whitespace() {
+            while (pos_ < size_
+                   && (data_[pos_] == ' ' || data_[pos_] == '\n' || data_[pos_] == '\r'
+                       || data_[pos_] == '\t')) {
+                ++pos_;
+            }
+        }
+
+        [[nodiscard]] auto peek() const -> char { return pos_ < size_ ? data_[pos_] : '\0'; }
+
+        void expect(char expected) {
+            if (peek() != expected) {
+                fail(std::string("Expected '") + expected + "'");
+            }
+            ++pos_;
+        }
+
+        // NOLINTBEGIN(readability-function-size)
+        void scan_value(std::size_t set_begin, std::size_t set_end) {
+            skip_whitespace();
+            std::size_t start = pos_;
+            bool descend = false;
+            bool terminal = false;
+            for (std::size_t i = set_begin; i < set_end; ++i) {
+                const auto& node = query_.nodes_[active_[i]];
+                descend = descend || node.has_children();
+                terminal = terminal || !node.terminals.empty();
+            }
+
+            // NOLINTNEXTLINE(readability-identifier-length)
+            char c = peek();
+            if (descend && c == '{') {
+                scan_object(set_begin, set_end);
+            } else if (descend && c == '[') {
+                scan_array(set_begin, set_end);
+            } else {
+                skip_value();
+            }
+
+            if (terminal) {
+                for (std::size_t i = set_begin; i < set_end; ++i) {
+                    for (auto pattern : query_.nodes_[active_[i]].terminals) {
+                        matches_.push_back({pattern, start, pos_ - start});
+                    }
+                }
+            }
+        }
+        // NOLINTEND(readability-function-size)
+
+        // Push the children of [set_begin, set_end) reached through `key` onto active_
+        void push_children(std::size_t set_begin, std::size_t set_end, std::string_view key) {
+            for (std::size_t i = set_begin; i < set_end; ++i) {
+                const auto& node = query_.nodes_[active_[i]];
+                // NOLINTNEXTLINE(readability-identifier-length)
+                auto it = node.children.find(key);
+                std::size_t wildcard = node.wildcard;
+                if (it != node.children.end()) {
+                    active_.push_back(it->second);
+                }
+                if (wildcard != NO_NODE) {
+                    active_.push_back(wildcard);
+                }
+            }
+        }
+
+        void scan_member_value(std::size_t child_begin) {
+            std::size_t child_end = active_.size();
+            if (child_begin == child_end) {
+                skip_value();
+            } else {
+                scan_value(child_begin, child_end);
+            }
+            active_.resize(child_begin);
+        }
+
+        // NOLINTBEGIN(readability-function-size)
+        void scan_object(std::size_t set_begin, std::size_t set_end) {
+            expect('{');
+            skip_whitespace();
+            if (peek() == '}') {
+                ++pos_;
+                return;
+            }
+            while (true) {
+                skip_whitespace();
+                std::string_view key = read_key();
+                skip_whitespace();
+                expect(':');
+
+                std::size_t child_begin = active_.size();
+                push_children(set_begin, set_end, key);
+                scan_member_value(child_begin);
+
+                skip_whitespace();
+                // NOLINTNEXTLINE(readability-identifier-length)
+                char c = peek();
+                ++pos_;
+                if (c == '}') {
+                    return;
+                }
+                if (c != ',') {
+                    --pos_;
+                    fail("Expected ',' or '}' in object");
+                }
+            }
+        }
+
+        void scan_array(std::size_t set_begin, std::size_t set_end) {
+            expect('[');
+            skip_whitespace();
+            if (peek() == ']') {
+                ++pos_;
+                return;
+            }
+
+            bool keyed = false; // Only format indices when some node has exact children
+            for (std::size_t i = set_begin; i < set_end; ++i) {
+                keyed = keyed || !query_.nodes_[active_[i]].children.empty();
+            }
+
+            std::array<char, INDEX_BUFFER_SIZE> index_buffer{};
+            for (std::size_t index = 0;; ++index) {
+                std::string_view key;
+                if (keyed) {
+                    auto result = std::to_chars(index_buffer.data(),
+                                                index_buffer.data() + index_buffer.size(), index);
+                    key = std::string_view(index_buffer.data(),
+                                           static_cast<std::size_t>(result.ptr
+                                                                    - index_buffer.data()));
+                }
+
+                std::size_t child_begin = active_.size();
+                push_children(set_begin, set_end, key);
+                scan_member_value(child_begin);
+
+                skip_whitespace();
+                // NOLINTNEXTLINE(readability-identifier-length)
+                char c = peek();
+                ++pos_;
+                if (c == ']') {
+                    return;
+                }
+                if (c != ',') {
+                    --pos_;
+                    fail("Expected ',' or ']' in array");
+                }
+            }
+        }
+        // NOLINTEND(readability-function-size)
+
+        // Read an object key; escapes are decoded the way FastParser decodes them by
+        // default (\uXXXX is kept verbatim), so keys compare equal to parsed keys.
+        // NOLINTBEGIN(readability-function-size)
+        auto read_key() -> std::string_view {
+            expect('"');
+            std::size_t start = pos_;
+            while (pos_ < size_ && data_[pos_] != '"' && data_[pos_] != '\\') {
+                ++pos_;
+            }
+            if (pos_ < size_ && data_[pos_] == '"') {
+                return {data_ + start, pos_++ - start};
+            }
+
+            key_buffer_.assign(data_ + start, pos_ - start);
+            while (pos_ < size_ && data_[pos_] != '"') {
+                // NOLINTNEXTLINE(readability-identifier-length)
+                char c = data_[pos_++];
+                if (c != '\\') {
+                    key_buffer_ += c;
+                    continue;
+                }
+                if (pos_ >= size_) {
+                    break;
+                }
+                char escaped = data_[pos_++];
+                switch (escaped) {
+                case 'b':
+                    key_buffer_ += '\b';
+                    break;
+                case 'f':
+                    key_buffer_ += '\f';
+                    break;
+                case 'n':
+                    key_buffer_ += '\n';
+                    break;
+                case 'r':
+                    key_buffer_ += '\r';
+                    break;
+                case 't':
+                    key_buffer_ += '\t';
+                    break;
+                case 'u':
+                    key_buffer_ += "\\u";
+                    break;
+                default:
+                    key_buffer_ += escaped;
+                    break;
+                }
+            }
+            if (pos_ >= size_) {
+                fail("Unterminated string");
+            }
+            ++pos_; // Closing quote
+            return key_buffer_;
+        }
+        // NOLINTEND(readability-function-size)
+
+        void skip_string() {
+            ++pos_; // Opening quote
+            while (pos_ < size_) {
+                // NOLINTNEXTLINE(readability-identifier-length)
+                char c = data_[pos_++];
+                if (c == '"') {
+                    return;
+                }
+                if (c == '\\') {
+                    ++pos_;
+                }
+            }
+            fail("Unterminated string");
+        }
+
+        // What may come next inside a container being skipped, as bits so that a token can
+        // check every state it is allowed in at once
+        static constexpr unsigned SKIP_VALUE = 1;          // After ':' or a ',' in an array
+        static constexpr unsigned SKIP_CLOSE_ARRAY = 2;    // After '[': a value or ']'
+        static constexpr unsigned SKIP_KEY = 4;            // After a ',' in an object
+        static constexpr unsigned SKIP_CLOSE_OBJECT = 8;   // After '{': a key or '}'
+        static constexpr unsigned SKIP_COLON = 16;         // After a key
+        static constexpr unsigned SKIP_COMMA_OR_CLOSE = 32; // After a value
+
+        // Skip one value without interpreting it, still checking JSON's grammar: literals,
+        // key and ':' placement, and ',' between members. Containers are skipped
+        // iteratively so deeply nested input that no pattern reaches cannot exhaust the
+        // stack.
+        // NOLINTBEGIN(readability-function-size)
+        void skip_value() {
+            skip_whitespace();
+            // NOLINTNEXTLINE(readability-identifier-length)
+            char c = peek();
+            if (c == '"') {
+                skip_string();
+                return;
+            }
+            if (c != '{' && c != '[') {
+                skip_literal();
+                return;
+            }
+
+            constexpr unsigned VALUE = SKIP_VALUE | SKIP_CLOSE_ARRAY;
+            std::string closers;
+            unsigned state = SKIP_VALUE;
+            while (pos_ < size_) {
+                c = data_[pos_];
+                if (c == ' ' || c == '\n' || c == '\r' || c == '\t') {
+                    ++pos_;
+                } else if (c == '"') {
+                    if ((state & (VALUE | SKIP_KEY | SKIP_CLOSE_OBJECT)) == 0) {
+                        fail("Unexpected string");
+                    }
+                    skip_string();
+                    state = (state & VALUE) != 0 ? SKIP_COMMA_OR_CLOSE : SKIP_COLON;
+                } else if (c == ',') {
+                    if (state != SKIP_COMMA_OR_CLOSE) {
+                        fail("Unexpected ','");
+                    }
+                    ++pos_;
+                    state = closers.back() == '}' ? SKIP_KEY : SKIP_VALUE;
+                } else if (c == ':') {
+                    if (state != SKIP_COLON) {
+                        fail("Unexpected ':'");
+                    }
+                    ++pos_;
+                    state = SKIP_VALUE;
+                } else if (c == '}' || c == ']') {
+                    if (closers.empty() || closers.back() != c) {
+                        fail("Mismatched bracket");
+                    }
+                    if ((state & (SKIP_COMMA_OR_CLOSE | SKIP_CLOSE_ARRAY | SKIP_CLOSE_OBJECT))
+                        == 0) {
+                        fail("Expected value");
+                    }
+                    ++pos_;
+                    closers.pop_back();
+                    if (closers.empty()) {
+                        return;
+                    }
+                    state = SKIP_COMMA_OR_CLOSE;
+                } else if ((state & VALUE) == 0) {
+                    fail(state == SKIP_COMMA_OR_CLOSE ? "Expected ',' or closing bracket"
+                                                      : "Expected object key");
+                } else if (c == '{' || c == '[') {
+                    ++pos_;
+                    closers += c == '{' ? '}' : ']';
+                    state = c == '{' ? SKIP_CLOSE_OBJECT : SKIP_CLOSE_ARRAY;
+                } else {
+                    skip_literal();
+                    state = SKIP_COMMA_OR_CLOSE;
+                }
+            }
+            fail("Unterminated container");
+        }
+        // NOLINTEND(readability-function-size)
+
+        // Skip a bare token, which must be true, false, null or a number
+        void skip_literal() {
+            std::size_t length = literal_length({data_ + pos_, size_ - pos_});
+            std::size_t end = pos_ + length;
+            if (end < size_) {
+                // NOLINTNEXTLINE(readability-identifier-length)
+                char c = data_[end];
+                if (c != ',' && c != ':' && c != '}' && c != ']' && c != ' ' && c != '\n'
+                    && c != '\r' && c != '\t') {
+                    length = 0; // The literal runs on into other characters
+                }
+            }
+            if (length == 0) {
+                fail(pos_ < size_ && std::strchr(",:}] \n\r\t", data_[pos_]) == nullptr
+                         ? "Invalid literal"
+                         : "Expected value");
+            }
+            pos_ = end;
+        }
+
+        // Length of the true, false, null or JSON-grammar number that `text` starts with;
+        // 0 when it starts with none of them
+        static auto literal_length(std::string_view text) -> std::size_t {
+            if (!text.empty() && (text[0] == 't' || text[0] == 'f' || text[0] == 'n')) {
+                std::string_view keyword = text[0] == 't'   ? "true"
+                                           : text[0] == 'f' ? "false"
+                                                            : "null";
+                return text.substr(0, keyword.size()) == keyword ? keyword.size() : 0;
+            }
+            std::size_t pos = 0;
+            auto digits = [&]() {
+                std::size_t first = pos;
+                while (pos < text.size() && text[pos] >= '0' && text[pos] <= '9') {
+                    ++pos;
+                }
+                return pos - first;
+            };
+            if (pos < text.size() && text[pos] == '-') {
+                ++pos;
+            }
+            bool leading_zero = pos < text.size() && text[pos] == '0';
+            std::size_t integer = digits();
+            if (integer == 0 || (leading_zero && integer > 1)) {
+                return 0;
+            }
+            if (pos < text.size() && text[pos] == '.') {
+                ++pos;
+                if (digits() == 0) {
+                    return 0;
+                }
+            }
+            if (pos < text.size() && (text[pos] == 'e' || text[pos] == 'E')) {
+                ++pos;
+                if (pos < text.size() && (text[pos] == '+' || text[pos] == '-')) {
+                    ++pos;
+                }
+                if (digits() == 0) {
+                    return 0;
+                }
+            }
+            return pos;
+        }
+    };
+};
+
+} // namespace jsom
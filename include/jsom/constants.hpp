@@ -41,6 +41,27 @@ constexpr int EXAMPLE_INDENT = 4;        // Example indent value
 constexpr int EXAMPLE_INLINE_ARRAYS = 5; // Example inline-arrays value
 constexpr int EXAMPLE_MAX_WIDTH = 80;    // Example max-width value
 
+// Query command
+constexpr std::size_t QUERY_RECORDS_PER_BATCH = 4096;  // NDJSON lines processed per batch
+constexpr std::size_t QUERY_RECORDS_PER_TASK = 64;     // NDJSON lines claimed by a worker at once
+constexpr std::size_t QUERY_READ_CHUNK_BYTES = 4 << 20; // NDJSON bytes read at a time
+
+// Watch mode (format/validate --watch)
+constexpr int WATCH_DEBOUNCE_MS = 50;                  // Quiet period that ends a burst of events
+constexpr int WATCH_POLL_MS = 200;                     // Polling interval without inotify
+constexpr std::size_t WATCH_EVENT_BUFFER_SIZE = 4096; // Bytes read from inotify at once
+
+// --profile report
+constexpr int PROFILE_NAME_WIDTH = 10;       // Phase name column width
+constexpr int PROFILE_COLUMN_WIDTH = 14;     // Width of each numeric column
+constexpr int PROFILE_PRECISION = 2;         // Decimal places for times and rates
+constexpr double BYTES_PER_MIB = 1048576.0;  // Bytes in a mebibyte
+constexpr double MS_PER_SECOND = 1000.0;     // Milliseconds in a second
+
+// Diff command exit status (same convention as diff(1))
+constexpr int DIFF_EXIT_DIFFERENT = 1; // Documents differ
+constexpr int DIFF_EXIT_ERROR = 2;     // Bad arguments or unreadable input
+
 // Error codes
 constexpr int ERROR_CODE_GENERAL = 1;
 constexpr int ERROR_CODE_PATH_NOT_FOUND = 2;
@@ -84,6 +105,15 @@ constexpr int NUMBER_BUFFER_PARSE_SIZE = 64;     // Number buffer size for parsi
 constexpr int ARRAY_INITIAL_CAPACITY = 16;       // Initial array capacity
 constexpr int JSON_DOCUMENT_INITIAL_SIZE = 1024; // Initial JsonDocument string size
 
+// ParserWorkspace limits: scratch larger than this is freed after the parse that grew it
+constexpr std::size_t WORKSPACE_MAX_RETAINED_BYTES = 1 << 20;
+constexpr std::size_t WORKSPACE_MAX_ELEMENT_DEPTHS = 64; // Element buffers kept, one per depth
+
+// Object shape limits (JsonParseOptions::share_object_shapes); objects past them become maps
+constexpr std::size_t SHAPE_MAX_KEYS = 64;        // Keys in one shaped object
+constexpr std::size_t SHAPE_MAX_TRANSITIONS = 32; // Different next keys after one key sequence
+constexpr std::size_t SHAPE_MAX_NODES = 4096;     // Transitions a workspace keeps between parses
+
 // Literal string lengths
 const std::string LITERAL_TRUE = "true";
 const std::string LITERAL_FALSE = "false";
@@ -135,10 +165,57 @@ constexpr uint32_t SURROGATE_MASK = 0x3FF; // 10-bit mask for surrogate data
 constexpr int HEX_LETTER_OFFSET = 10; // A=10, B=11, ..., F=15
 } // namespace unicode_constants
 
+// Binary snapshot format (jsom compile)
+namespace snapshot_constants {
+constexpr std::size_t MAGIC_SIZE = 5;        // "JSOMB"
+constexpr std::uint8_t FORMAT_VERSION = 1;   // Bumped on any layout change
+constexpr std::size_t HEADER_SIZE = 16;      // Magic, version, byte-order mark, root offset
+constexpr std::size_t VERSION_OFFSET = 5;    // Header byte holding FORMAT_VERSION
+constexpr std::size_t BYTE_ORDER_OFFSET = 6; // Header u16 holding BYTE_ORDER_MARK
+constexpr std::uint16_t BYTE_ORDER_MARK = 0xFEFF; // Reads back swapped on foreign-endian hosts
+constexpr std::size_t ROOT_OFFSET = 8;       // Header field holding the root node offset
+constexpr std::size_t LENGTH_SIZE = 4;       // u32 string length / element count
+constexpr std::size_t OFFSET_SIZE = 8;       // u64 node offset
+} // namespace snapshot_constants
+
+// Content hashing shared by JsonDiff and JsonDocument::deduplicate() (see content_hash.hpp)
+namespace hash_constants {
+constexpr std::uint64_t FNV_OFFSET_BASIS = 0xcbf29ce484222325ULL; // FNV-1a 64-bit
+constexpr std::uint64_t FNV_PRIME = 0x100000001b3ULL;             // FNV-1a 64-bit
+constexpr std::uint64_t HASH_COMBINE_MULTIPLIER = 0x9e3779b97f4a7c15ULL; // 2^64 / phi
+constexpr int HASH_COMBINE_LEFT_SHIFT = 6;
+constexpr int HASH_COMBINE_RIGHT_SHIFT = 2;
+} // namespace hash_constants
+
+// Structural diff (jsom diff)
+namespace diff_constants {
+constexpr std::size_t MAX_EDIT_DISTANCE = 256; // Array alignment gives up beyond this
+} // namespace diff_constants
+
 // JSON Pointer Constants
 namespace pointer_constants {
 constexpr int SEGMENT_RESERVE_MULTIPLIER = 10; // segments.size() * 10 for reserve
 constexpr int ESCAPE_RESERVE_DIVISOR = 4;      // length / 4 for escape reserve
 } // namespace pointer_constants
 
+// Tracing hooks (JSOM_ENABLE_TRACING)
+namespace trace_constants {
+constexpr std::size_t RING_CAPACITY = 512; // Spans buffered per thread before a drain
+} // namespace trace_constants
+
+// Process-wide metrics (JSOM_ENABLE_METRICS)
+namespace metrics_constants {
+constexpr std::size_t SHARD_COUNT = 16;     // Threads are spread round-robin over shards
+constexpr std::size_t CACHE_LINE_SIZE = 64; // Shards are aligned to avoid false sharing
+} // namespace metrics_constants
+
+// JsonDocument::memory_usage estimates and teardown
+namespace memory_constants {
+constexpr std::size_t MAP_NODE_LINK_WORDS = 4; // Red-black tree color, parent, left, right
+constexpr std::size_t MAX_RECURSIVE_TEARDOWN_DEPTH = 128; // Deeper containers are freed from
+                                                          // a per-thread list, not the stack
+constexpr std::size_t SHARED_CONTROL_BLOCK_WORDS = 2; // make_shared header: vtable pointer,
+                                                     // use and weak counts
+} // namespace memory_constants
+
 } // namespace jsom
@@ -0,0 +1,29 @@
+#pragma once
+
+#include "constants.hpp"
+#include <cstdint>
+#include <string_view>
+
+namespace jsom::detail {
+
+// 64-bit hashing behind JsonDiff::hash() and JsonDocument::deduplicate(): FNV-1a over
+// text, folded together with a boost-style hash_combine. Not for use across processes.
+
+inline auto fnv1a(std::string_view bytes) -> std::uint64_t {
+    std::uint64_t result = hash_constants::FNV_OFFSET_BASIS;
+    // NOLINTNEXTLINE(readability-identifier-length)
+    for (char c : bytes) {
+        result ^= static_cast<unsigned char>(c);
+        result *= hash_constants::FNV_PRIME;
+    }
+    return result;
+}
+
+inline auto hash_combine(std::uint64_t seed, std::uint64_t value) -> std::uint64_t {
+    return seed
+           ^ (value + hash_constants::HASH_COMBINE_MULTIPLIER
+              + (seed << hash_constants::HASH_COMBINE_LEFT_SHIFT)
+              + (seed >> hash_constants::HASH_COMBINE_RIGHT_SHIFT));
+}
+
+} // namespace jsom::detail
@@ -1,8 +1,11 @@
 #pragma once
 
+#include "constants.hpp"
+#include "metrics.hpp"
+#include <array>
 #include <cstdint>
+#include <cstdio>
 #include <optional>
-#include <sstream>
 #include <stdexcept>
 #include <string>
 
@@ -41,6 +44,7 @@ public:
                 throw std::invalid_argument("Invalid number format");
             }
             cached_value_ = value;
+            JSOM_METRIC_ADD(metrics::Counter::LazyNumberConversions, 1);
             return value;
         } catch (const std::exception&) {
             throw TypeException("Cannot convert '" + *original_repr_ + "' to double");
@@ -77,25 +81,20 @@ public:
                 return std::to_string(static_cast<int>(*cached_value_));
             }
 
-            std::ostringstream oss;
-            oss << *cached_value_;
-            return oss.str();
+            // "%g" matches the default ostream formatting without pulling in <sstream>
+            std::array<char, parser_constants::NUMBER_BUFFER_SIZE> buf{};
+            std::snprintf(buf.data(), buf.size(), "%g", *cached_value_);
+            return buf.data();
         }
         throw TypeException("LazyNumber has no value to convert to string");
     }
 
-    void serialize(std::ostream& out) const {
-        if (original_repr_) {
-            out << *original_repr_;
-        } else if (cached_value_) {
-            if (*cached_value_ == static_cast<int>(*cached_value_)) {
-                out << static_cast<int>(*cached_value_);
-            } else {
-                out << *cached_value_;
-            }
-        } else {
+    // Templated on the stream so this header does not need <ostream>
+    template <typename OutputStream> void serialize(OutputStream& out) const {
+        if (!original_repr_ && !cached_value_) {
             throw TypeException("LazyNumber has no value to serialize");
         }
+        out << as_string();
     }
 
     [[nodiscard]] auto has_original_repr() const -> bool { return original_repr_.has_value(); }
@@ -133,4 +132,47 @@ public:
     }
 };
 
+// \u escape decoding shared by FastParser and StreamingParser
+namespace detail {
+
+// NOLINTNEXTLINE(readability-identifier-length)
+inline auto hex_to_int(char c) -> int {
+    if (c >= '0' && c <= '9') {
+        return c - '0';
+    }
+    if (c >= 'A' && c <= 'F') {
+        return c - 'A' + unicode_constants::HEX_LETTER_OFFSET;
+    }
+    if (c >= 'a' && c <= 'f') {
+        return c - 'a' + unicode_constants::HEX_LETTER_OFFSET;
+    }
+    return -1; // Invalid hex digit
+}
+
+inline void append_utf8(std::string& str, uint32_t codepoint) {
+    if (codepoint <= unicode_constants::UTF8_1_BYTE_MAX) {
+        // 1-byte UTF-8
+        str += static_cast<char>(codepoint);
+    } else if (codepoint <= unicode_constants::UTF8_2_BYTE_MAX) {
+        // 2-byte UTF-8
+        str += static_cast<char>(0xC0 | (codepoint >> 6));
+        str += static_cast<char>(0x80 | (codepoint & 0x3F));
+    } else if (codepoint <= unicode_constants::UTF8_3_BYTE_MAX) {
+        // 3-byte UTF-8
+        str += static_cast<char>(0xE0 | (codepoint >> 12));
+        str += static_cast<char>(0x80 | ((codepoint >> 6) & 0x3F));
+        str += static_cast<char>(0x80 | (codepoint & 0x3F));
+    } else if (codepoint <= unicode_constants::UTF8_MAX_CODEPOINT) {
+        // 4-byte UTF-8
+        str += static_cast<char>(0xF0 | (codepoint >> 18));
+        str += static_cast<char>(0x80 | ((codepoint >> 12) & 0x3F));
+        str += static_cast<char>(0x80 | ((codepoint >> 6) & 0x3F));
+        str += static_cast<char>(0x80 | (codepoint & 0x3F));
+    } else {
+        throw std::runtime_error("Invalid Unicode codepoint");
+    }
+}
+
+} // namespace detail
+
 } // namespace jsom
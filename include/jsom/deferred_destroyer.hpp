@@ -0,0 +1,100 @@
+#pragma once
+
+#include "json_document.hpp"
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace jsom {
+
+// Frees documents on a background thread, so replacing a large document does not put its
+// teardown on the caller's latency path. Opt-in: documents handed to destroy() are queued,
+// everything else is still freed where it goes out of scope.
+//
+//     DeferredDestroyer reclaimer;                // One thread, for the reclaimer's lifetime
+//     reclaimer.destroy(std::move(current));      // Returns once the tree is queued
+//     current = parse_document(next_payload);
+//
+// The destructor frees whatever is still queued, then joins the thread.
+class DeferredDestroyer {
+public:
+    DeferredDestroyer() : worker_([this]() { run(); }) {}
+
+    ~DeferredDestroyer() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        wake_.notify_one();
+        worker_.join();
+    }
+
+    DeferredDestroyer(const DeferredDestroyer&) = delete;
+    auto operator=(const DeferredDestroyer&) -> DeferredDestroyer& = delete;
+    DeferredDestroyer(DeferredDestroyer&&) = delete;
+    auto operator=(DeferredDestroyer&&) -> DeferredDestroyer& = delete;
+
+    // Take `doc` and free it on the background thread; `doc` is left null. Null, boolean and
+    // number values own next to nothing and are freed right here instead.
+    void destroy(JsonDocument&& doc) {
+        JsonDocument taken(std::move(doc));
+        doc = JsonDocument();
+        if (!taken.is_string() && !taken.is_object() && !taken.is_array()) {
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            queue_.push_back(std::move(taken));
+            ++pending_;
+        }
+        wake_.notify_one();
+    }
+
+    // Block until every document queued so far has been freed
+    void flush() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        idle_.wait(lock, [this]() { return pending_ == 0; });
+    }
+
+    // Documents queued and not yet freed
+    auto pending() const -> std::size_t {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return pending_;
+    }
+
+private:
+    mutable std::mutex mutex_;
+    std::condition_variable wake_; // Work queued, or stopping
+    std::condition_variable idle_; // pending_ dropped to zero
+    std::vector<JsonDocument> queue_;
+    std::size_t pending_{0};
+    bool stopping_{false};
+    std::thread worker_; // Declared last: starts once the members above exist
+
+    // Take the whole queue at once and free it outside the lock, so destroy() never waits
+    // behind a teardown
+    void run() {
+        std::vector<JsonDocument> batch;
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (true) {
+            wake_.wait(lock, [this]() { return stopping_ || !queue_.empty(); });
+            if (queue_.empty()) {
+                return; // Stopping, and nothing left to free
+            }
+            batch.swap(queue_);
+            lock.unlock();
+            std::size_t freed = batch.size();
+            batch.clear();
+            lock.lock();
+            pending_ -= freed;
+            if (pending_ == 0) {
+                idle_.notify_all();
+            }
+        }
+    }
+};
+
+} // namespace jsom
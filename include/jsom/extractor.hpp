@@ -0,0 +1,127 @@
+#pragma once
+
+#include "json_document.hpp"
+#include "json_pointer.hpp"
+#include "object_shape.hpp"
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace jsom {
+
+// One JSON Pointer read out of many documents, e.g. /user/id from every message of a stream.
+// at() and find() parse the pointer on each call and cache paths per document, so every new
+// document starts cold. An Extractor parses the pointer once and keeps an inline cache per
+// segment that carries over from one document to the next: for objects parsed with
+// JsonParseOptions::share_object_shapes it remembers the last shape met and the key's slot in
+// it, so a document with that shape is read with one pointer comparison per segment. Any
+// other shape, or a plain map, falls back to a key lookup and the cache moves to the new
+// shape.
+//
+// find() updates the caches, so an Extractor is used by one thread at a time; the documents
+// are only read.
+class Extractor {
+public:
+    struct Stats {
+        std::size_t cache_hits = 0; // Segments resolved from the inline cache
+        std::size_t lookups = 0;    // Segments resolved by a key lookup
+    };
+
+    // Throws InvalidJsonPointerException for a malformed pointer
+    explicit Extractor(std::string json_pointer) : pointer_(std::move(json_pointer)) {
+        for (auto& segment : JsonPointer::parse(pointer_)) {
+            Step step;
+            step.is_index = JsonPointer::parse_array_index(segment, step.index);
+            step.key = std::move(segment);
+            steps_.push_back(std::move(step));
+        }
+    }
+
+    [[nodiscard]] auto pointer() const -> const std::string& { return pointer_; }
+    [[nodiscard]] auto stats() const -> const Stats& { return stats_; }
+
+    // The value at the pointer in `doc`, or nullptr when there is none. Never throws.
+    auto find(const JsonDocument& doc) -> const JsonDocument* {
+        bool through_shared = false;
+        return walk(doc, through_shared);
+    }
+
+    auto find(JsonDocument& doc) -> JsonDocument* {
+        bool through_shared = false;
+        const JsonDocument* node = walk(doc, through_shared);
+        if (through_shared) {
+            // The value lies inside one shared by deduplicate(): JsonDocument::find() copies
+            // the shared values on the way, as a change needs
+            return doc.find(pointer_);
+        }
+        // Lookups never change the document, so handing back a mutable node is safe
+        return const_cast<JsonDocument*>(node);
+    }
+
+    // Throws JsonPointerNotFoundException when `doc` has no value at the pointer
+    auto at(const JsonDocument& doc) -> const JsonDocument& {
+        const JsonDocument* node = find(doc);
+        if (node == nullptr) {
+            throw JsonPointerNotFoundException(pointer_);
+        }
+        return *node;
+    }
+
+private:
+    struct Step {
+        std::string key;       // Unescaped segment
+        bool is_index = false; // The segment is also a valid array index
+        std::size_t index = 0;
+        std::shared_ptr<const ObjectShape> shape; // Last shape met; owned so it cannot be reused
+        std::size_t slot = 0;                     // Position of `key` in `shape`
+    };
+
+    // `through_shared` is set when the walk passes through a shared value
+    auto walk(const JsonDocument& doc, bool& through_shared) -> const JsonDocument* {
+        const JsonDocument* node = &doc;
+        for (auto& step : steps_) {
+            through_shared = through_shared || node->is_shared();
+            node = descend(*node, step);
+            if (node == nullptr) {
+                return nullptr;
+            }
+        }
+        return node;
+    }
+
+    auto descend(const JsonDocument& node, Step& step) -> const JsonDocument* {
+        if (const auto* shaped = node.get_if<ShapedObject>()) {
+            if (shaped->shape == step.shape) {
+                ++stats_.cache_hits;
+                return &shaped->values[step.slot];
+            }
+            ++stats_.lookups;
+            std::size_t slot = shaped->shape->slot(step.key);
+            if (slot == ObjectShape::npos) {
+                return nullptr;
+            }
+            step.shape = shaped->shape;
+            step.slot = slot;
+            return &shaped->values[slot];
+        }
+        if (const auto* object = node.get_if<JsonObject>()) {
+            ++stats_.lookups;
+            auto found = object->find(step.key);
+            return found == object->end() ? nullptr : &found->second;
+        }
+        if (const auto* array = node.get_if<std::vector<JsonDocument>>()) {
+            if (!step.is_index || step.index >= array->size()) {
+                return nullptr;
+            }
+            return &(*array)[step.index];
+        }
+        return nullptr;
+    }
+
+    std::string pointer_;
+    std::vector<Step> steps_;
+    Stats stats_;
+};
+
+} // namespace jsom
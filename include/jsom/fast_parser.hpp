@@ -3,13 +3,81 @@
 #include "constants.hpp"
 #include "json_document.hpp"
 #include "json_parse_options.hpp"
+#include "metrics.hpp"
+#include "object_shape.hpp"
+#include "parse_result.hpp"
+#include "trace_hooks.hpp"
 #include <cctype>
 #include <cstring>
+#include <iterator>
 #include <string>
 #include <vector>
 
 namespace jsom {
 
+// Scratch memory a FastParser keeps between parses: the string and number buffers, one
+// element buffer per nesting depth of arrays (and shaped objects), and the object shape
+// transitions. Reusing a workspace makes repeated parses skip the buffer setup and the
+// element-buffer regrowth of every array, and lets documents parsed one after another share
+// object shapes. parse_document() uses one per thread; buffers grown past
+// parser_constants::WORKSPACE_MAX_RETAINED_BYTES are freed after the parse. Not safe to
+// share between concurrent parses.
+class ParserWorkspace {
+public:
+    ParserWorkspace() = default;
+
+    // Free all retained scratch
+    void release() {
+        std::string().swap(string_buffer_);
+        std::string().swap(number_buffer_);
+        std::vector<std::vector<JsonDocument>>().swap(elements_);
+        shapes_.clear();
+    }
+
+private:
+    friend class FastParser;
+
+    // Called after every parse: drop elements a failed parse left behind, and scratch grown
+    // past the retention limits by an unusually large or deep document. Shape transitions
+    // that ran out of room start over, so later documents with new shapes can still share
+    // them.
+    void trim() {
+        if (string_buffer_.capacity() > parser_constants::WORKSPACE_MAX_RETAINED_BYTES) {
+            std::string().swap(string_buffer_);
+        }
+        if (elements_.size() > parser_constants::WORKSPACE_MAX_ELEMENT_DEPTHS) {
+            elements_.resize(parser_constants::WORKSPACE_MAX_ELEMENT_DEPTHS);
+        }
+        if (shapes_.full()) {
+            shapes_.clear();
+        }
+        for (auto& elements : elements_) {
+            elements.clear();
+            if (elements.capacity() * sizeof(JsonDocument)
+                > parser_constants::WORKSPACE_MAX_RETAINED_BYTES) {
+                std::vector<JsonDocument>().swap(elements);
+            }
+        }
+    }
+
+    std::string string_buffer_;
+    std::string number_buffer_;
+    // Elements of the arrays and values of the shaped objects being parsed, indexed by their
+    // nesting depth
+    std::vector<std::vector<JsonDocument>> elements_;
+    ShapeTransitions shapes_; // Used only with JsonParseOptions::share_object_shapes
+};
+
+// The calling thread's workspace, used by parse_document() and try_parse_document()
+inline auto thread_parser_workspace() -> ParserWorkspace& {
+    thread_local ParserWorkspace workspace;
+    return workspace;
+}
+
+// A failing parse step records the first error in error_ and returns early; callers check
+// failed() and unwind by returning too, so a rejected input costs a few returns instead of an
+// exception unwind. Values are still returned by value, keeping copy elision on the hot path.
+// parse() and try_parse() differ only in how they hand back a failure.
 class FastParser {
 private:
     const char* data_;
@@ -17,11 +85,26 @@ private:
     size_t pos_;
     JsonParseOptions options_;
 
-    // Pre-allocated buffers to avoid reallocations
-    std::string string_buffer_;
-    std::string number_buffer_;
+    // Scratch lives in a workspace: the parser's own, or one the caller keeps across parses
+    ParserWorkspace own_workspace_;
+    ParserWorkspace& workspace_;
+    std::string& string_buffer_;
+    std::string& number_buffer_;
+    size_t element_depth_ = 0; // Next free element buffer
+
+    size_t values_parsed_ = 0; // Counted only when tracing
+    ParseFailure error_;
+
+    // Record an error at `offset`; returns false so call sites can `return fail(...)`
+    auto fail(ParseErrorCode code, size_t offset, char found = '\0', char expected = '\0')
+        -> bool {
+        error_ = ParseFailure{code, offset, found, expected};
+        return false;
+    }
+
+    [[nodiscard]] auto failed() const -> bool { return static_cast<bool>(error_); }
 
-    void skip_whitespace() {
+    auto skip_whitespace() -> bool {
         while (pos_ < size_) {
             if (std::isspace(data_[pos_]) != 0) {
                 ++pos_;
@@ -42,7 +125,7 @@ private:
                     if (pos_ + 1 < size_) {
                         pos_ += 2; // skip */
                     } else {
-                        throw std::runtime_error("Unterminated block comment");
+                        return fail(ParseErrorCode::UnterminatedComment, size_);
                     }
                 } else {
                     break;
@@ -51,81 +134,48 @@ private:
                 break;
             }
         }
+        return true;
     }
 
     [[nodiscard]] auto peek() const -> char { return pos_ < size_ ? data_[pos_] : '\0'; }
 
     auto advance() -> char { return pos_ < size_ ? data_[pos_++] : '\0'; }
 
-    void expect(char expected) {
+    auto expect(char expected) -> bool {
+        size_t offset = pos_;
         // NOLINTNEXTLINE(readability-identifier-length)
         char c = advance();
         if (c != expected) {
-            throw std::runtime_error("Expected '" + std::string(1, expected) + "' but got '"
-                                     + std::string(1, c) + "'");
+            return fail(ParseErrorCode::ExpectedCharacter, offset, c, expected);
         }
+        return true;
     }
 
-    // Unicode escape sequence conversion helpers
-    static auto hex_to_int(char c) -> int {
-        if (c >= '0' && c <= '9') {
-            return c - '0';
-        }
-        if (c >= 'A' && c <= 'F') {
-            return c - 'A' + unicode_constants::HEX_LETTER_OFFSET;
-        }
-        if (c >= 'a' && c <= 'f') {
-            return c - 'a' + unicode_constants::HEX_LETTER_OFFSET;
-        }
-        return -1; // Invalid hex digit
-    }
-
-    auto parse_unicode_escape() -> uint16_t {
+    auto parse_unicode_escape(uint16_t& codepoint) -> bool {
         if (pos_ + parser_constants::UNICODE_ESCAPE_LENGTH > size_) {
-            throw std::runtime_error("Incomplete Unicode escape sequence");
+            return fail(ParseErrorCode::IncompleteUnicodeEscape, pos_);
         }
 
-        uint16_t codepoint = 0;
+        codepoint = 0;
         for (int i = 0; i < parser_constants::UNICODE_ESCAPE_LENGTH; ++i) {
             char c = advance();
-            int hex_val = hex_to_int(c);
+            int hex_val = detail::hex_to_int(c);
             if (hex_val == -1) {
-                throw std::runtime_error("Invalid hex digit in Unicode escape: "
-                                         + std::string(1, c));
+                return fail(ParseErrorCode::InvalidUnicodeEscape, pos_ - 1, c);
             }
             codepoint = (codepoint << 4) | static_cast<uint16_t>(hex_val);
         }
-        return codepoint;
+        return true;
     }
 
-    void append_utf8(std::string& str, uint32_t codepoint) {
-        if (codepoint <= unicode_constants::UTF8_1_BYTE_MAX) {
-            // 1-byte UTF-8
-            str += static_cast<char>(codepoint);
-        } else if (codepoint <= unicode_constants::UTF8_2_BYTE_MAX) {
-            // 2-byte UTF-8
-            str += static_cast<char>(0xC0 | (codepoint >> 6));
-            str += static_cast<char>(0x80 | (codepoint & 0x3F));
-        } else if (codepoint <= unicode_constants::UTF8_3_BYTE_MAX) {
-            // 3-byte UTF-8
-            str += static_cast<char>(0xE0 | (codepoint >> 12));
-            str += static_cast<char>(0x80 | ((codepoint >> 6) & 0x3F));
-            str += static_cast<char>(0x80 | (codepoint & 0x3F));
-        } else if (codepoint <= unicode_constants::UTF8_MAX_CODEPOINT) {
-            // 4-byte UTF-8
-            str += static_cast<char>(0xF0 | (codepoint >> 18));
-            str += static_cast<char>(0x80 | ((codepoint >> 12) & 0x3F));
-            str += static_cast<char>(0x80 | ((codepoint >> 6) & 0x3F));
-            str += static_cast<char>(0x80 | (codepoint & 0x3F));
-        } else {
-            throw std::runtime_error("Invalid Unicode codepoint");
-        }
-    }
 
-    // Fast string parsing with bulk operations
+    // Fast string parsing with bulk operations; the decoded string is left in string_buffer_
     // NOLINTBEGIN(readability-function-size)
-    auto parse_string() -> JsonDocument {
-        expect('"');
+    auto parse_string() -> bool {
+        size_t start_offset = pos_;
+        if (!expect('"')) {
+            return false;
+        }
         string_buffer_.clear();
         string_buffer_.reserve(
             parser_constants::STRING_BUFFER_INITIAL_SIZE); // Pre-allocate reasonable size
@@ -141,7 +191,7 @@ private:
                 // Bulk append everything we've scanned
                 string_buffer_.append(current, data_ + pos_ - current);
                 ++pos_; // Skip closing quote
-                return JsonDocument(std::move(string_buffer_));
+                return true;
             }
             if (c == '\\') {
                 // Append everything up to escape
@@ -180,7 +230,10 @@ private:
                 case 'u': {
                     if (options_.convert_unicode_escapes) {
                         // Convert Unicode escape to UTF-8
-                        uint16_t codepoint = parse_unicode_escape();
+                        uint16_t codepoint = 0;
+                        if (!parse_unicode_escape(codepoint)) {
+                            return false;
+                        }
 
                         // Check for surrogate pairs (high surrogate)
                         if (codepoint >= unicode_constants::HIGH_SURROGATE_START
@@ -188,7 +241,10 @@ private:
                             // High surrogate - look for low surrogate
                             if (pos_ + 1 < size_ && data_[pos_] == '\\' && data_[pos_ + 1] == 'u') {
                                 pos_ += 2; // Skip \u
-                                uint16_t low_surrogate = parse_unicode_escape();
+                                uint16_t low_surrogate = 0;
+                                if (!parse_unicode_escape(low_surrogate)) {
+                                    return false;
+                                }
                                 if (low_surrogate >= unicode_constants::LOW_SURROGATE_START
                                     && low_surrogate <= unicode_constants::LOW_SURROGATE_END) {
                                     // Valid surrogate pair - convert to full codepoint
@@ -199,19 +255,21 @@ private:
                                              << 10)
                                           + (static_cast<uint32_t>(low_surrogate)
                                              & unicode_constants::SURROGATE_MASK);
-                                    append_utf8(string_buffer_, full_codepoint);
+                                    detail::append_utf8(string_buffer_, full_codepoint);
                                 } else {
-                                    throw std::runtime_error("Invalid low surrogate pair");
+                                    return fail(ParseErrorCode::InvalidSurrogatePair,
+                                                pos_ - parser_constants::UNICODE_ESCAPE_LENGTH);
                                 }
                             } else {
-                                throw std::runtime_error("Incomplete surrogate pair");
+                                return fail(ParseErrorCode::IncompleteSurrogatePair, pos_);
                             }
                         } else if (codepoint >= unicode_constants::LOW_SURROGATE_START
                                    && codepoint <= unicode_constants::LOW_SURROGATE_END) {
-                            throw std::runtime_error("Unexpected low surrogate");
+                            return fail(ParseErrorCode::UnexpectedLowSurrogate,
+                                        pos_ - parser_constants::UNICODE_ESCAPE_LENGTH);
                         } else {
                             // Regular codepoint
-                            append_utf8(string_buffer_, codepoint);
+                            detail::append_utf8(string_buffer_, codepoint);
                         }
                     } else {
                         // Preserve Unicode escape as-is (current behavior)
@@ -235,7 +293,7 @@ private:
             }
         }
 
-        throw std::runtime_error("Unterminated string");
+        return fail(ParseErrorCode::UnterminatedString, start_offset);
     }
     // NOLINTEND(readability-function-size)
 
@@ -293,102 +351,214 @@ private:
             }
         }
 
-        throw std::runtime_error("Invalid literal");
+        fail(ParseErrorCode::InvalidLiteral, pos_);
+        return {};
     }
 
-    // Fast object parsing with direct building
+    // Index of a cleared element buffer for the array or shaped object about to be parsed;
+    // the caller hands it back with --element_depth_ once that container is complete
+    auto claim_element_buffer() -> size_t {
+        size_t depth = element_depth_++;
+        auto& buffers = workspace_.elements_;
+        if (buffers.size() == depth) {
+            buffers.emplace_back();
+        }
+        buffers[depth].clear();
+        return depth;
+    }
+
+    // Fast object parsing with direct building. On failure the partial object is returned
+    // (and discarded by the caller) so that every path returns `result`, keeping NRVO.
+    // With share_object_shapes the keys walk the workspace's shape transitions while the
+    // values collect in an element buffer; the object becomes a map as soon as the
+    // transitions give out, or at the end when a key repeats.
     // NOLINTBEGIN(readability-function-size)
     auto parse_object() -> JsonDocument {
-        expect('{');
-        skip_whitespace();
+        ++pos_; // '{', checked by parse_value()
 
         // Create the final object immediately
-        JsonDocument result(std::initializer_list<std::pair<const std::string, JsonDocument>>{});
+        JsonDocument result(JsonObject{});
+        if (!skip_whitespace()) {
+            return result;
+        }
 
         if (peek() == '}') {
             advance();
             return result;
         }
 
+        ShapeTransitions::Node* shape = nullptr;
+        size_t depth = 0;
+        if (options_.share_object_shapes) {
+            shape = workspace_.shapes_.root();
+            depth = claim_element_buffer();
+        }
+
         while (true) {
-            skip_whitespace();
+            if (!skip_whitespace()) {
+                return result;
+            }
 
             // Parse key
             if (peek() != '"') {
-                throw std::runtime_error("Expected string key in object");
+                fail(ParseErrorCode::ExpectedKey, pos_);
+                return result;
+            }
+            if (!parse_string()) {
+                return result;
             }
-            auto key_doc = parse_string();
-            auto key = key_doc.as<std::string>();
-
-            skip_whitespace();
-            expect(':');
-            skip_whitespace();
 
-            // Use move-optimized set method - eliminates intermediate vector!
-            result.set(std::move(key), parse_value());
+            if (shape != nullptr) {
+                shape = next_shape(result, shape, depth);
+            }
+            if (shape != nullptr) {
+                // The transition holds the key, so it is not copied
+                if (!skip_whitespace() || !expect(':') || !skip_whitespace()) {
+                    return result;
+                }
+                JsonDocument value = parse_value();
+                workspace_.elements_[depth].push_back(std::move(value));
+            } else {
+                std::string key(string_buffer_);
+                if (!skip_whitespace() || !expect(':') || !skip_whitespace()) {
+                    return result;
+                }
+                // Use move-optimized set method - eliminates intermediate vector!
+                result.set(std::move(key), parse_value());
+            }
+            if (failed() || !skip_whitespace()) {
+                return result;
+            }
 
-            skip_whitespace();
+            size_t offset = pos_;
             // NOLINTNEXTLINE(readability-identifier-length)
             char c = advance();
             if (c == '}') {
                 break;
             }
             if (c != ',') {
-                throw std::runtime_error("Expected ',' or '}' in object");
+                fail(ParseErrorCode::ExpectedObjectSeparator, offset, c);
+                return result;
             }
         }
 
+        if (shape != nullptr) {
+            finish_shaped_object(result, shape, depth);
+        }
         return result;
     }
     // NOLINTEND(readability-function-size)
 
-    // Fast array parsing with direct building
+    // The transition from `node` for the key in string_buffer_. When there is none, the
+    // members collected so far move into `result` as a map and nullptr is returned.
+    auto next_shape(JsonDocument& result, ShapeTransitions::Node* node, size_t depth)
+        -> ShapeTransitions::Node* {
+        ShapeTransitions::Node* next = workspace_.shapes_.next(node, string_buffer_);
+        if (next == nullptr) {
+            unshape_members(result, node, depth);
+        }
+        return next;
+    }
+
+    // Store the values collected in buffer `depth` in `result` against the shape of the key
+    // sequence ending at `node`; a map when that sequence repeats a key
+    void finish_shaped_object(JsonDocument& result, ShapeTransitions::Node* node, size_t depth) {
+        const auto& shape = ShapeTransitions::shape_at(node);
+        if (shape == nullptr) {
+            unshape_members(result, node, depth);
+            return;
+        }
+        --element_depth_;
+        auto& collected = workspace_.elements_[depth];
+        ShapedObject shaped{shape, {}};
+        shaped.values.reserve(collected.size());
+        for (auto index : node->order) {
+            shaped.values.push_back(std::move(collected[index]));
+        }
+        collected.clear();
+        result.storage_ = std::move(shaped);
+    }
+
+    // Move the values collected in buffer `depth` into `result` under the keys of the
+    // sequence ending at `node`, in arrival order so that a repeated key keeps its last value
+    void unshape_members(JsonDocument& result, const ShapeTransitions::Node* node,
+                         size_t depth) {
+        --element_depth_;
+        auto keys = ShapeTransitions::keys_of(node);
+        auto& collected = workspace_.elements_[depth];
+        for (size_t i = 0; i < keys.size(); ++i) {
+            result.set(std::move(keys[i]), std::move(collected[i]));
+        }
+        collected.clear();
+    }
+
+    // Fast array parsing with direct building; returns the partial array on failure, as
+    // parse_object() does
     // NOLINTBEGIN(readability-function-size)
     auto parse_array() -> JsonDocument {
-        expect('[');
-        skip_whitespace();
-
-        // Create the final array immediately
-        JsonDocument result(std::vector<JsonDocument>{});
+        ++pos_; // '[', checked by parse_value()
 
+        if (!skip_whitespace()) {
+            return {};
+        }
         if (peek() == ']') {
             advance();
-            return result;
+            return JsonDocument(std::vector<JsonDocument>{});
         }
 
-        // Use array index for direct insertion - eliminates intermediate vector
-        size_t index = 0;
+        // Elements collect in this depth's workspace buffer, which keeps its capacity between
+        // arrays and parses, and move into an exactly sized vector at the end. Looked up by
+        // index each time: a nested array may grow the list of buffers.
+        size_t depth = claim_element_buffer();
+        auto& buffers = workspace_.elements_;
 
         while (true) {
-            skip_whitespace();
+            if (!skip_whitespace()) {
+                return {};
+            }
 
-            // Set directly using index - no intermediate storage!
-            result.set(index++, parse_value());
+            JsonDocument element = parse_value();
+            buffers[depth].push_back(std::move(element));
+            if (failed() || !skip_whitespace()) {
+                return {};
+            }
 
-            skip_whitespace();
+            size_t offset = pos_;
             // NOLINTNEXTLINE(readability-identifier-length)
             char c = advance();
             if (c == ']') {
                 break;
             }
             if (c != ',') {
-                throw std::runtime_error("Expected ',' or ']' in array");
+                fail(ParseErrorCode::ExpectedArraySeparator, offset, c);
+                return {};
             }
         }
 
+        --element_depth_;
+        auto& elements = buffers[depth];
+        JsonDocument result(std::vector<JsonDocument>(std::make_move_iterator(elements.begin()),
+                                                      std::make_move_iterator(elements.end())));
+        elements.clear();
         return result;
     }
     // NOLINTEND(readability-function-size)
 
     // NOLINTBEGIN(readability-function-size)
     auto parse_value() -> JsonDocument {
-        skip_whitespace();
+        JSOM_TRACE_COUNT(values_parsed_);
+        if (!skip_whitespace()) {
+            return {};
+        }
         // NOLINTNEXTLINE(readability-identifier-length)
         char c = peek();
 
         switch (c) {
         case '"':
-            return parse_string();
+            if (!parse_string()) {
+                return {};
+            }
+            return JsonDocument(string_buffer_);
         case '{':
             return parse_object();
         case '[':
@@ -410,42 +580,118 @@ private:
         case '9':
             return parse_number();
         default:
-            throw std::runtime_error("Unexpected character: " + std::string(1, c));
+            fail(ParseErrorCode::UnexpectedCharacter, pos_, c);
+            return {};
         }
     }
     // NOLINTEND(readability-function-size)
 
-public:
-    explicit FastParser(const JsonParseOptions& options = {}) : options_(options) {}
+    // The whole document; failed() tells whether the input was rejected
+    auto parse_top_level() -> JsonDocument {
+        if (!skip_whitespace()) {
+            return {};
+        }
+        if (pos_ >= size_) {
+            fail(ParseErrorCode::EmptyInput, pos_);
+            return {};
+        }
+        auto result = parse_value();
+        if (!failed() && skip_whitespace() && pos_ < size_) {
+            fail(ParseErrorCode::TrailingCharacters, pos_, data_[pos_]);
+        }
+        return result;
+    }
 
-    auto parse(const std::string& json) -> JsonDocument {
+    // Parse the whole input; on failure error_ is set and the returned document is partial
+    auto run(const std::string& json) -> JsonDocument {
+        JSOM_TRACE_SPAN(span, trace::SpanKind::Parse, json.size());
+        JSOM_METRIC_ADD(metrics::Counter::BytesParsed, json.size());
         data_ = json.data();
         size_ = json.size();
         pos_ = 0;
+        values_parsed_ = 0;
+        element_depth_ = 0;
+        error_ = ParseFailure{};
 
         // Pre-allocate buffers
         string_buffer_.reserve(parser_constants::STRING_BUFFER_PARSE_SIZE);
         number_buffer_.reserve(parser_constants::NUMBER_BUFFER_PARSE_SIZE);
 
-        skip_whitespace();
-        if (pos_ >= size_) {
-            throw std::runtime_error("Empty JSON input");
+        JsonDocument result = parse_top_level();
+        workspace_.trim();
+        if (failed()) {
+            JSOM_METRIC_ADD(metrics::Counter::ParseErrors, 1);
+            return result;
         }
 
-        auto result = parse_value();
+        span.set_nodes(values_parsed_);
+        JSOM_METRIC_ADD(metrics::Counter::DocumentsParsed, 1);
+        return result;
+    }
 
-        skip_whitespace();
-        if (pos_ < size_) {
-            throw std::runtime_error("Unexpected characters after JSON");
+public:
+    explicit FastParser(const JsonParseOptions& options = {})
+        : FastParser(options, own_workspace_) {}
+
+    // Parse with `workspace`'s scratch; it must outlive the parser
+    FastParser(const JsonParseOptions& options, ParserWorkspace& workspace)
+        : options_(options), workspace_(workspace), string_buffer_(workspace.string_buffer_),
+          number_buffer_(workspace.number_buffer_) {}
+
+    // Refers to its workspace's buffers, so it is neither copied nor moved
+    FastParser(const FastParser&) = delete;
+    auto operator=(const FastParser&) -> FastParser& = delete;
+    FastParser(FastParser&&) = delete;
+    auto operator=(FastParser&&) -> FastParser& = delete;
+    ~FastParser() = default;
+
+    // Parse without throwing on invalid input: the document, or the error and its offset
+    auto try_parse(const std::string& json) -> ParseResult {
+        JsonDocument result = run(json);
+        if (failed()) {
+            return ParseResult(error_);
         }
+        return ParseResult(std::move(result));
+    }
 
+    // Throws ParseException, whose error() carries the same code and offset
+    auto parse(const std::string& json) -> JsonDocument {
+        JsonDocument result = run(json);
+        if (failed()) {
+            throw ParseException(error_);
+        }
         return result;
     }
 };
 
+inline auto parse_document(const std::string& json) -> JsonDocument {
+    // Use fast parser by default for better performance
+    FastParser parser({}, thread_parser_workspace());
+    return parser.parse(json);
+}
+
+inline auto parse_document(const std::string& json, const JsonParseOptions& options)
+    -> JsonDocument {
+    // Use fast parser with options for better performance
+    FastParser parser(options, thread_parser_workspace());
+    return parser.parse(json);
+}
+
+// Exception-free parse: check the result, then take value() or inspect error()
+inline auto try_parse_document(const std::string& json) -> ParseResult {
+    FastParser parser({}, thread_parser_workspace());
+    return parser.try_parse(json);
+}
+
+inline auto try_parse_document(const std::string& json, const JsonParseOptions& options)
+    -> ParseResult {
+    FastParser parser(options, thread_parser_workspace());
+    return parser.try_parse(json);
+}
+
 // Optimized parse function that replaces the slow streaming parser
 inline auto parse_document_fast(const std::string& json) -> JsonDocument {
-    FastParser parser;
+    FastParser parser({}, thread_parser_workspace());
     return parser.parse(json);
 }
 
@@ -0,0 +1,217 @@
+#pragma once
+
+#include "fast_parser.hpp"
+#include "json_document.hpp"
+#include "json_parse_options.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace jsom {
+
+// Outcome of IncrementalDocument::update()
+struct IncrementalUpdate {
+    bool incremental = false;      // True if at most one top-level value was reparsed
+    std::string member;            // Key of the reparsed member (empty if nothing changed)
+    std::size_t reparsed_bytes = 0; // Bytes handed to the parser
+};
+
+// A parsed document that keeps its source text and the byte span of every top-level
+// member's value, so that an edit confined to one value reparses only that value.
+//
+// update() compares the new text with the previous one (common prefix and suffix). If
+// the changed bytes lie inside a single top-level member's value, that value is parsed
+// on its own and swapped into the document; everything else, including edits to keys or
+// separators, falls back to a full parse. A failed update leaves the previous document
+// and source in place and rethrows the parser's error.
+//
+// Incremental updates need a top-level object without duplicate keys and are disabled
+// when comments are allowed; such documents are always reparsed in full.
+class IncrementalDocument {
+public:
+    explicit IncrementalDocument(const JsonParseOptions& options = {}) : options_(options) {}
+
+    auto update(std::string source) -> IncrementalUpdate {
+        IncrementalUpdate result;
+        if (parsed_ && source == source_) {
+            result.incremental = true;
+            return result;
+        }
+        if (indexed_ && try_incremental(source, result)) {
+            source_ = std::move(source);
+            return result;
+        }
+
+        FastParser parser(options_);
+        doc_ = parser.parse(source);
+        source_ = std::move(source);
+        parsed_ = true;
+        indexed_ = !options_.allow_comments && doc_.is_object() && index_members();
+        result.reparsed_bytes = source_.size();
+        return result;
+    }
+
+    [[nodiscard]] auto document() const -> const JsonDocument& { return doc_; }
+    [[nodiscard]] auto source() const -> const std::string& { return source_; }
+
+private:
+    // Byte span of one top-level member's value in source_
+    struct MemberSpan {
+        std::string key;
+        std::size_t value_start;
+        std::size_t value_end; // One past the last byte
+    };
+
+    JsonParseOptions options_;
+    std::string source_;
+    JsonDocument doc_;
+    std::vector<MemberSpan> members_; // In source order
+    bool parsed_ = false;  // source_ and doc_ hold a successful parse
+    bool indexed_ = false; // members_ is valid, so incremental updates are possible
+
+    // NOLINTBEGIN(readability-function-size)
+    auto try_incremental(const std::string& source, IncrementalUpdate& result) -> bool {
+        std::size_t limit = std::min(source.size(), source_.size());
+        std::size_t prefix = 0;
+        while (prefix < limit && source[prefix] == source_[prefix]) {
+            ++prefix;
+        }
+        std::size_t suffix = 0;
+        while (suffix < limit - prefix
+               && source[source.size() - 1 - suffix] == source_[source_.size() - 1 - suffix]) {
+            ++suffix;
+        }
+        std::size_t old_change_end = source_.size() - suffix;
+
+        // Find the value whose span contains the whole change (edits touching the
+        // boundary of a scalar, like appending a digit, still count as inside)
+        auto member = std::find_if(members_.begin(), members_.end(), [&](const MemberSpan& span) {
+            return span.value_start <= prefix && old_change_end <= span.value_end;
+        });
+        if (member == members_.end()) {
+            return false;
+        }
+
+        auto delta = static_cast<std::ptrdiff_t>(source.size())
+                     - static_cast<std::ptrdiff_t>(source_.size());
+        std::size_t new_end = static_cast<std::size_t>(
+            static_cast<std::ptrdiff_t>(member->value_end) + delta);
+        std::string value_text = source.substr(member->value_start, new_end - member->value_start);
+        if (value_text.empty() || is_json_whitespace(value_text.front())
+            || is_json_whitespace(value_text.back())) {
+            return false; // The value's boundaries moved; let a full parse sort it out
+        }
+
+        FastParser parser(options_);
+        ParseResult value = parser.try_parse(value_text);
+        if (!value) {
+            return false; // Full parse reports the error with its real context
+        }
+
+        doc_.set(member->key, std::move(*value));
+        member->value_end = new_end;
+        for (auto later = member + 1; later != members_.end(); ++later) {
+            later->value_start = static_cast<std::size_t>(
+                static_cast<std::ptrdiff_t>(later->value_start) + delta);
+            later->value_end = static_cast<std::size_t>(
+                static_cast<std::ptrdiff_t>(later->value_end) + delta);
+        }
+
+        result.incremental = true;
+        result.member = member->key;
+        result.reparsed_bytes = value_text.size();
+        return true;
+    }
+
+    // Record the value span of each top-level member. Runs only on text that has just
+    // parsed successfully, so it need not diagnose errors; it reports false for shapes
+    // it does not handle (duplicate keys).
+    auto index_members() -> bool {
+        members_.clear();
+        std::unordered_set<std::string> seen;
+        std::size_t pos = skip_whitespace(0);
+        ++pos; // '{'
+        while (true) {
+            pos = skip_whitespace(pos);
+            if (source_[pos] == '}') {
+                return true;
+            }
+            std::size_t key_start = pos;
+            pos = skip_string(pos);
+            FastParser key_parser(options_);
+            std::string key
+                = key_parser.parse(source_.substr(key_start, pos - key_start)).as<std::string>();
+            if (!seen.insert(key).second) {
+                members_.clear();
+                return false;
+            }
+
+            pos = skip_whitespace(pos) + 1; // ':'
+            std::size_t value_start = skip_whitespace(pos);
+            pos = skip_value(value_start);
+            members_.push_back({std::move(key), value_start, pos});
+
+            pos = skip_whitespace(pos);
+            if (source_[pos] == '}') {
+                return true;
+            }
+            ++pos; // ','
+        }
+    }
+    // NOLINTEND(readability-function-size)
+
+    static auto is_json_whitespace(char c) -> bool {
+        return c == ' ' || c == '\n' || c == '\r' || c == '\t';
+    }
+
+    [[nodiscard]] auto skip_whitespace(std::size_t pos) const -> std::size_t {
+        while (pos < source_.size() && is_json_whitespace(source_[pos])) {
+            ++pos;
+        }
+        return pos;
+    }
+
+    // Position just past the string starting at `pos`
+    [[nodiscard]] auto skip_string(std::size_t pos) const -> std::size_t {
+        ++pos; // Opening quote
+        while (source_[pos] != '"') {
+            pos += source_[pos] == '\\' ? 2 : 1;
+        }
+        return pos + 1;
+    }
+
+    // Position just past the value starting at `pos`
+    [[nodiscard]] auto skip_value(std::size_t pos) const -> std::size_t {
+        if (source_[pos] == '"') {
+            return skip_string(pos);
+        }
+        if (source_[pos] != '{' && source_[pos] != '[') {
+            while (pos < source_.size() && source_[pos] != ',' && source_[pos] != '}'
+                   && source_[pos] != ']' && !is_json_whitespace(source_[pos])) {
+                ++pos;
+            }
+            return pos;
+        }
+        std::size_t depth = 0;
+        do {
+            // NOLINTNEXTLINE(readability-identifier-length)
+            char c = source_[pos];
+            if (c == '"') {
+                pos = skip_string(pos);
+                continue;
+            }
+            if (c == '{' || c == '[') {
+                ++depth;
+            } else if (c == '}' || c == ']') {
+                --depth;
+            }
+            ++pos;
+        } while (depth > 0);
+        return pos;
+    }
+};
+
+} // namespace jsom
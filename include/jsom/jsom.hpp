@@ -1,24 +1,15 @@
 #pragma once
 
+#ifdef JSOM_PROFILE_CORE
+#error "jsom.hpp needs the full profile; include jsom/jsom_core.hpp in JSOM_PROFILE=core builds"
+#endif
+
 #include "batch_parser.hpp"
-#include "core_types.hpp"
-#include "fast_parser.hpp"
-#include "json_document.hpp"
+#include "deferred_destroyer.hpp"
+#include "extractor.hpp"
 #include "json_format_options.hpp"
 #include "json_formatter.hpp"
-#include "json_parse_options.hpp"
+#include "jsom_core.hpp"
 #include "parse_events.hpp"
 #include "path_node.hpp"
 #include "streaming_parser.hpp"
-
-namespace jsom {
-
-using Document = JsonDocument;
-
-namespace literals {
-inline auto operator""_jsom(const char* str, std::size_t len) -> JsonDocument {
-    return parse_document(std::string(str, len));
-}
-} // namespace literals
-
-} // namespace jsom
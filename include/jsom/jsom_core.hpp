@@ -0,0 +1,23 @@
+#pragma once
+
+// Minimal JSOM: parse, build, navigate with JSON Pointer and serialize. Leaves out the
+// streaming parser, JsonFormatter and the other utilities in jsom.hpp, so it compiles
+// noticeably faster; this is the public surface of the JSOM_PROFILE=core build.
+
+#include "core_types.hpp"
+#include "fast_parser.hpp"
+#include "json_document.hpp"
+#include "json_parse_options.hpp"
+#include "parse_result.hpp"
+
+namespace jsom {
+
+using Document = JsonDocument;
+
+namespace literals {
+inline auto operator""_jsom(const char* str, std::size_t len) -> JsonDocument {
+    return parse_document(std::string(str, len));
+}
+} // namespace literals
+
+} // namespace jsom
@@ -0,0 +1,549 @@
+#pragma once
+
+#include "constants.hpp"
+#include "content_hash.hpp"
+#include "json_document.hpp"
+#include "json_pointer.hpp"
+#include "parallel_for.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace jsom {
+
+// RFC 6902 operation kinds
+enum class PatchOp : std::uint8_t { Add, Remove, Replace, Move, Copy, Test };
+
+inline auto patch_op_name(PatchOp op) -> const char* {
+    switch (op) {
+    case PatchOp::Add:
+        return "add";
+    case PatchOp::Remove:
+        return "remove";
+    case PatchOp::Replace:
+        return "replace";
+    case PatchOp::Move:
+        return "move";
+    case PatchOp::Copy:
+        return "copy";
+    case PatchOp::Test:
+        return "test";
+    }
+    return "unknown";
+}
+
+// One difference found by JsonDiff. Values point into the compared documents, so entries
+// stay valid only while both documents are alive and unmodified.
+struct DiffEntry {
+    PatchOp op;                     // Add, Remove or Replace
+    std::string path;               // JSON Pointer into the "from" document
+    const JsonDocument* old_value;  // Removed or replaced value (nullptr for Add)
+    const JsonDocument* new_value;  // Added or replacement value (nullptr for Remove)
+};
+
+struct DiffOptions {
+    std::size_t threads = 0; // Workers for top-level members; 0 = hardware concurrency
+};
+
+// Structural diff producing an RFC 6902 patch that turns `from` into `to`.
+//
+// Every container's subtree hash is computed once and memoized. Subtrees with equal hashes
+// are confirmed equal with operator== before they are skipped, so a hash collision cannot
+// drop a change. Members of the root object (or elements of
+// the root array) are diffed on separate threads. Objects are diffed by key; arrays are
+// aligned by element hash (see plan_array), so an inserted or deleted element costs one
+// operation instead of shifting every later index.
+class JsonDiff {
+public:
+    static auto diff(const JsonDocument& from, const JsonDocument& to,
+                     const DiffOptions& options = {}) -> std::vector<DiffEntry> {
+        std::vector<DiffEntry> entries;
+        std::size_t threads = resolve_thread_count(options.threads);
+        if (from.is_object() && to.is_object()) {
+            diff_root_object(from, to, threads, entries);
+        } else if (from.is_array() && to.is_array()) {
+            diff_root_array(from, to, threads, entries);
+        } else {
+            HashCache cache;
+            diff_value(from, to, "", entries, cache);
+        }
+        return entries;
+    }
+
+    // Structural hash: equal documents hash equal. Numbers hash by their text, so values
+    // like 1 and 1.0 hash differently; diff still compares such leaves by value.
+    static auto hash(const JsonDocument& doc) -> std::uint64_t {
+        HashCache cache;
+        return cache.hash(doc);
+    }
+
+    // Build an RFC 6902 patch document from diff entries
+    static auto to_patch(const std::vector<DiffEntry>& entries) -> JsonDocument {
+        auto patch = JsonDocument::make_array();
+        for (const auto& entry : entries) {
+            auto operation = JsonDocument::make_object();
+            operation.set("op", JsonDocument(patch_op_name(entry.op)));
+            operation.set("path", JsonDocument(entry.path));
+            if (entry.new_value != nullptr) {
+                operation.set("value", *entry.new_value);
+            }
+            patch.push_back(std::move(operation));
+        }
+        return patch;
+    }
+
+    // Append one entry as a compact RFC 6902 operation object
+    static void append_operation(std::string& out, const DiffEntry& entry) {
+        out += R"({"op":")";
+        out += patch_op_name(entry.op);
+        out += R"(","path":")";
+        JsonDocument::escape_string_to_string(out, entry.path);
+        out += '"';
+        if (entry.new_value != nullptr) {
+            out += R"(,"value":)";
+            out += entry.new_value->to_json();
+        }
+        out += '}';
+    }
+
+    // Append one entry as a human-readable line: "+ path: new", "- path: old" or
+    // "~ path: old -> new", with long values abbreviated
+    static void append_summary(std::string& out, const DiffEntry& entry) {
+        switch (entry.op) {
+        case PatchOp::Add:
+            out += "+ ";
+            break;
+        case PatchOp::Remove:
+            out += "- ";
+            break;
+        default:
+            out += "~ ";
+            break;
+        }
+        out += entry.path.empty() ? "(root)" : entry.path;
+        out += ": ";
+        if (entry.old_value != nullptr) {
+            out += abbreviate(entry.old_value->to_json());
+        }
+        if (entry.old_value != nullptr && entry.new_value != nullptr) {
+            out += " -> ";
+        }
+        if (entry.new_value != nullptr) {
+            out += abbreviate(entry.new_value->to_json());
+        }
+    }
+
+private:
+    static constexpr std::size_t SUMMARY_VALUE_LIMIT = 60; // Characters shown per value
+
+    // Memoized subtree hashes for containers; scalars are cheap enough to rehash
+    class HashCache {
+    public:
+        // NOLINTBEGIN(readability-function-size)
+        auto hash(const JsonDocument& doc) -> std::uint64_t {
+            std::uint64_t result = detail::hash_combine(hash_constants::FNV_OFFSET_BASIS,
+                                                        static_cast<std::uint64_t>(doc.type_));
+            switch (doc.type_) {
+            case JsonType::Null:
+                return result;
+            case JsonType::Boolean:
+                return detail::hash_combine(result, std::get<bool>(doc.storage()) ? 1 : 0);
+            case JsonType::Number: {
+                const auto& number = std::get<LazyNumber>(doc.storage());
+                if (number.has_original_repr()) {
+                    return detail::hash_combine(result, detail::fnv1a(number.get_original_repr()));
+                }
+                return detail::hash_combine(result, detail::fnv1a(doc.to_json()));
+            }
+            case JsonType::String:
+                return detail::hash_combine(result,
+                                            detail::fnv1a(std::get<std::string>(doc.storage())));
+            case JsonType::Array:
+            case JsonType::Object:
+                break;
+            }
+
+            // NOLINTNEXTLINE(readability-identifier-length)
+            auto it = hashes_.find(&doc);
+            if (it != hashes_.end()) {
+                return it->second;
+            }
+            if (doc.type_ == JsonType::Array) {
+                for (const auto& element : std::get<std::vector<JsonDocument>>(doc.storage())) {
+                    result = detail::hash_combine(result, hash(element));
+                }
+            } else {
+                for (const auto& [key, value] : doc.members()) {
+                    result = detail::hash_combine(result, detail::fnv1a(key));
+                    result = detail::hash_combine(result, hash(value));
+                }
+            }
+            hashes_.emplace(&doc, result);
+            return result;
+        }
+        // NOLINTEND(readability-function-size)
+
+    private:
+        std::unordered_map<const JsonDocument*, std::uint64_t> hashes_;
+    };
+
+    // One step of an array edit: diff a pair of elements in place, remove an element of
+    // `from`, or add an element of `to`. `position` is the index in the array as it is
+    // after all earlier actions have been applied.
+    struct ArrayAction {
+        PatchOp op; // Replace (diff the pair), Remove or Add
+        std::size_t from_index;
+        std::size_t to_index;
+        std::size_t position;
+    };
+
+    enum class EditStep : std::uint8_t { Keep, Delete, Insert };
+
+    static auto abbreviate(std::string text) -> std::string {
+        if (text.size() > SUMMARY_VALUE_LIMIT) {
+            text.resize(SUMMARY_VALUE_LIMIT);
+            text += "...";
+        }
+        return text;
+    }
+
+    static auto child_path(const std::string& path, const std::string& key) -> std::string {
+        return path + "/" + JsonPointer::escape_segment(key);
+    }
+
+    static auto child_path(const std::string& path, std::size_t index) -> std::string {
+        return path + "/" + std::to_string(index);
+    }
+
+    // Shortest edit script between two hash sequences (Myers' O(ND) algorithm), or
+    // nullopt if more than MAX_EDIT_DISTANCE insertions and deletions are needed
+    // NOLINTBEGIN(readability-function-size)
+    static auto edit_script(const std::uint64_t* from, std::size_t from_size,
+                            const std::uint64_t* to, std::size_t to_size)
+        -> std::optional<std::vector<EditStep>> {
+        const auto max_distance = static_cast<std::ptrdiff_t>(diff_constants::MAX_EDIT_DISTANCE);
+        const auto n = static_cast<std::ptrdiff_t>(from_size);
+        const auto m = static_cast<std::ptrdiff_t>(to_size);
+        const std::ptrdiff_t offset = max_distance + 1;
+        std::vector<std::ptrdiff_t> furthest(static_cast<std::size_t>((2 * offset) + 1), 0);
+        std::vector<std::vector<std::ptrdiff_t>> trace;
+
+        auto at = [offset](std::vector<std::ptrdiff_t>& v, std::ptrdiff_t k) -> std::ptrdiff_t& {
+            return v[static_cast<std::size_t>(k + offset)];
+        };
+
+        for (std::ptrdiff_t d = 0; d <= max_distance; ++d) {
+            trace.push_back(furthest);
+            for (std::ptrdiff_t k = -d; k <= d; k += 2) {
+                std::ptrdiff_t x = (k == -d || (k != d && at(furthest, k - 1) < at(furthest, k + 1)))
+                                       ? at(furthest, k + 1)
+                                       : at(furthest, k - 1) + 1;
+                std::ptrdiff_t y = x - k;
+                while (x < n && y < m && from[x] == to[y]) {
+                    ++x;
+                    ++y;
+                }
+                at(furthest, k) = x;
+                if (x < n || y < m) {
+                    continue;
+                }
+
+                // Walk the trace back from (n, m) to recover the path
+                std::vector<EditStep> steps;
+                for (std::ptrdiff_t step = d; step >= 0; --step) {
+                    auto& previous = trace[static_cast<std::size_t>(step)];
+                    std::ptrdiff_t diagonal = x - y;
+                    std::ptrdiff_t previous_diagonal
+                        = (diagonal == -step
+                           || (diagonal != step
+                               && at(previous, diagonal - 1) < at(previous, diagonal + 1)))
+                              ? diagonal + 1
+                              : diagonal - 1;
+                    std::ptrdiff_t previous_x = at(previous, previous_diagonal);
+                    std::ptrdiff_t previous_y = previous_x - previous_diagonal;
+                    while (x > previous_x && y > previous_y) {
+                        steps.push_back(EditStep::Keep);
+                        --x;
+                        --y;
+                    }
+                    if (step > 0) {
+                        steps.push_back(x == previous_x ? EditStep::Insert : EditStep::Delete);
+                    }
+                    x = previous_x;
+                    y = previous_y;
+                }
+                std::reverse(steps.begin(), steps.end());
+                return steps;
+            }
+        }
+        return std::nullopt;
+    }
+    // NOLINTEND(readability-function-size)
+
+    // Plan the edits that turn one array into another. The common prefix and suffix are
+    // trimmed first; the middle is aligned with a bounded edit script so an insertion or
+    // deletion does not turn every later element into a change. Deletions and insertions
+    // between the same kept elements are paired up and diffed in place. If the middle
+    // differs too much to align cheaply, elements are simply paired by position.
+    // Alignment uses hashes; `equal(from_index, to_index)` confirms each pair kept for
+    // having the same hash, and a pair that differs (a collision) is diffed in place too.
+    // NOLINTBEGIN(readability-function-size)
+    template <typename Equal>
+    static auto plan_array(const std::vector<std::uint64_t>& from_hashes,
+                           const std::vector<std::uint64_t>& to_hashes, Equal&& equal)
+        -> std::vector<ArrayAction> {
+        std::size_t from_size = from_hashes.size();
+        std::size_t to_size = to_hashes.size();
+        std::size_t prefix = 0;
+        while (prefix < from_size && prefix < to_size
+               && from_hashes[prefix] == to_hashes[prefix]) {
+            ++prefix;
+        }
+        std::size_t suffix = 0;
+        while (suffix < from_size - prefix && suffix < to_size - prefix
+               && from_hashes[from_size - 1 - suffix] == to_hashes[to_size - 1 - suffix]) {
+            ++suffix;
+        }
+        std::size_t from_middle = from_size - prefix - suffix;
+        std::size_t to_middle = to_size - prefix - suffix;
+
+        auto script = edit_script(from_hashes.data() + prefix, from_middle,
+                                  to_hashes.data() + prefix, to_middle);
+        if (!script) {
+            script.emplace(from_middle, EditStep::Delete);
+            script->insert(script->end(), to_middle, EditStep::Insert);
+        }
+
+        std::vector<ArrayAction> actions;
+        auto keep = [&](std::size_t from_index, std::size_t to_index, std::size_t position) {
+            if (!equal(from_index, to_index)) {
+                actions.push_back({PatchOp::Replace, from_index, to_index, position});
+            }
+        };
+        for (std::size_t i = 0; i < prefix; ++i) {
+            keep(i, i, i);
+        }
+        std::vector<std::size_t> deleted;
+        std::vector<std::size_t> inserted;
+        std::size_t from_index = prefix;
+        std::size_t to_index = prefix;
+        std::size_t position = prefix;
+        auto flush = [&]() {
+            std::size_t paired = std::min(deleted.size(), inserted.size());
+            for (std::size_t i = 0; i < paired; ++i) {
+                if (from_hashes[deleted[i]] != to_hashes[inserted[i]]) {
+                    actions.push_back({PatchOp::Replace, deleted[i], inserted[i], position});
+                } else {
+                    keep(deleted[i], inserted[i], position);
+                }
+                ++position;
+            }
+            for (std::size_t i = paired; i < deleted.size(); ++i) {
+                actions.push_back({PatchOp::Remove, deleted[i], 0, position});
+            }
+            for (std::size_t i = paired; i < inserted.size(); ++i) {
+                actions.push_back({PatchOp::Add, 0, inserted[i], position++});
+            }
+            deleted.clear();
+            inserted.clear();
+        };
+        for (auto step : *script) {
+            if (step == EditStep::Delete) {
+                deleted.push_back(from_index++);
+            } else if (step == EditStep::Insert) {
+                inserted.push_back(to_index++);
+            } else {
+                flush();
+                keep(from_index++, to_index++, position++);
+            }
+        }
+        flush();
+        for (std::size_t i = 0; i < suffix; ++i) {
+            keep(from_size - suffix + i, to_size - suffix + i, position++);
+        }
+        return actions;
+    }
+    // NOLINTEND(readability-function-size)
+
+    // Emit an Add or Remove action; Replace actions are diffed by the caller
+    static void emit_array_action(const std::vector<JsonDocument>& from,
+                                  const std::vector<JsonDocument>& to, const std::string& path,
+                                  const ArrayAction& action, std::vector<DiffEntry>& out) {
+        if (action.op == PatchOp::Add) {
+            out.push_back(
+                {PatchOp::Add, child_path(path, action.position), nullptr, &to[action.to_index]});
+        } else {
+            out.push_back({PatchOp::Remove, child_path(path, action.position),
+                           &from[action.from_index], nullptr});
+        }
+    }
+
+    // NOLINTBEGIN(readability-function-size)
+    static void diff_value(const JsonDocument& from, const JsonDocument& to,
+                           const std::string& path, std::vector<DiffEntry>& out,
+                           HashCache& cache) {
+        if (from.type() != to.type()) {
+            out.push_back({PatchOp::Replace, path, &from, &to});
+            return;
+        }
+        switch (from.type()) {
+        case JsonType::Object: {
+            if (cache.hash(from) == cache.hash(to) && from == to) {
+                return; // Equal hashes are confirmed: a collision must not hide a change
+            }
+            auto from_members = from.members();
+            auto to_members = to.members();
+            auto from_it = from_members.begin();
+            auto to_it = to_members.begin();
+            // Both objects are key-ordered, so one merge pass classifies every key
+            while (from_it != from_members.end() || to_it != to_members.end()) {
+                if (to_it == to_members.end()
+                    || (from_it != from_members.end() && from_it->first < to_it->first)) {
+                    out.push_back(
+                        {PatchOp::Remove, child_path(path, from_it->first), &from_it->second,
+                         nullptr});
+                    ++from_it;
+                } else if (from_it == from_members.end() || to_it->first < from_it->first) {
+                    out.push_back(
+                        {PatchOp::Add, child_path(path, to_it->first), nullptr, &to_it->second});
+                    ++to_it;
+                } else {
+                    diff_value(from_it->second, to_it->second, child_path(path, from_it->first),
+                               out, cache);
+                    ++from_it;
+                    ++to_it;
+                }
+            }
+            return;
+        }
+        case JsonType::Array: {
+            if (cache.hash(from) == cache.hash(to) && from == to) {
+                return;
+            }
+            const auto& from_elements = from.as_array();
+            const auto& to_elements = to.as_array();
+            std::vector<std::uint64_t> from_hashes;
+            std::vector<std::uint64_t> to_hashes;
+            from_hashes.reserve(from_elements.size());
+            to_hashes.reserve(to_elements.size());
+            for (const auto& element : from_elements) {
+                from_hashes.push_back(cache.hash(element));
+            }
+            for (const auto& element : to_elements) {
+                to_hashes.push_back(cache.hash(element));
+            }
+
+            auto equal = [&](std::size_t from_index, std::size_t to_index) {
+                return from_elements[from_index] == to_elements[to_index];
+            };
+            for (const auto& action : plan_array(from_hashes, to_hashes, equal)) {
+                if (action.op == PatchOp::Replace) {
+                    diff_value(from_elements[action.from_index], to_elements[action.to_index],
+                               child_path(path, action.position), out, cache);
+                } else {
+                    emit_array_action(from_elements, to_elements, path, action, out);
+                }
+            }
+            return;
+        }
+        default:
+            if (!(from == to)) {
+                out.push_back({PatchOp::Replace, path, &from, &to});
+            }
+            return;
+        }
+    }
+
+    static void diff_root_object(const JsonDocument& from, const JsonDocument& to,
+                                 std::size_t threads, std::vector<DiffEntry>& out) {
+        struct MemberTask {
+            const std::string* key;
+            const JsonDocument* from;
+            const JsonDocument* to;
+        };
+
+        // Each slot holds either the add/remove for one key or the diff of a shared key,
+        // so output stays in key order no matter which thread finishes first
+        auto from_members = from.members();
+        auto to_members = to.members();
+        std::vector<std::vector<DiffEntry>> slots;
+        std::vector<std::pair<std::size_t, MemberTask>> tasks;
+        auto from_it = from_members.begin();
+        auto to_it = to_members.begin();
+        while (from_it != from_members.end() || to_it != to_members.end()) {
+            slots.emplace_back();
+            if (to_it == to_members.end()
+                || (from_it != from_members.end() && from_it->first < to_it->first)) {
+                slots.back().push_back(
+                    {PatchOp::Remove, child_path("", from_it->first), &from_it->second, nullptr});
+                ++from_it;
+            } else if (from_it == from_members.end() || to_it->first < from_it->first) {
+                slots.back().push_back(
+                    {PatchOp::Add, child_path("", to_it->first), nullptr, &to_it->second});
+                ++to_it;
+            } else {
+                tasks.push_back(
+                    {slots.size() - 1, {&from_it->first, &from_it->second, &to_it->second}});
+                ++from_it;
+                ++to_it;
+            }
+        }
+
+        parallel_for(tasks.size(), threads, [&](std::size_t task) {
+            const auto& [slot, member] = tasks[task];
+            HashCache cache;
+            diff_value(*member.from, *member.to, child_path("", *member.key), slots[slot], cache);
+        });
+
+        for (auto& slot : slots) {
+            out.insert(out.end(), std::make_move_iterator(slot.begin()),
+                       std::make_move_iterator(slot.end()));
+        }
+    }
+
+    static void diff_root_array(const JsonDocument& from, const JsonDocument& to,
+                                std::size_t threads, std::vector<DiffEntry>& out) {
+        const auto& from_elements = from.as_array();
+        const auto& to_elements = to.as_array();
+        std::vector<std::uint64_t> from_hashes(from_elements.size());
+        std::vector<std::uint64_t> to_hashes(to_elements.size());
+        parallel_for(from_elements.size() + to_elements.size(), threads, [&](std::size_t i) {
+            if (i < from_elements.size()) {
+                from_hashes[i] = hash(from_elements[i]);
+            } else {
+                to_hashes[i - from_elements.size()] = hash(to_elements[i - from_elements.size()]);
+            }
+        });
+
+        // Pairs are diffed in parallel; each action's output goes to its own slot so the
+        // operations stay in order
+        auto actions = plan_array(from_hashes, to_hashes, [&](std::size_t from_index,
+                                                              std::size_t to_index) {
+            return from_elements[from_index] == to_elements[to_index];
+        });
+        std::vector<std::vector<DiffEntry>> slots(actions.size());
+        parallel_for(actions.size(), threads, [&](std::size_t i) {
+            const auto& action = actions[i];
+            if (action.op == PatchOp::Replace) {
+                HashCache cache;
+                diff_value(from_elements[action.from_index], to_elements[action.to_index],
+                           child_path("", action.position), slots[i], cache);
+            } else {
+                emit_array_action(from_elements, to_elements, "", action, slots[i]);
+            }
+        });
+
+        for (auto& slot : slots) {
+            out.insert(out.end(), std::make_move_iterator(slot.begin()),
+                       std::make_move_iterator(slot.end()));
+        }
+    }
+    // NOLINTEND(readability-function-size)
+};
+
+} // namespace jsom
@@ -2,13 +2,19 @@
 
 #include "constants.hpp"
 #include "core_types.hpp"
+#include "object_shape.hpp"
+#include "trace_hooks.hpp"
+#include <algorithm>
 #include <array>
 #include <cstdio>
+#include <functional>
 #include <initializer_list>
-#include <iomanip>
+#include <iosfwd>
+#include <iterator>
 #include <map>
 #include <memory>
-#include <sstream>
+#include <string_view>
+#include <utility>
 #include <variant>
 #include <vector>
 
@@ -26,13 +32,35 @@ struct JsonFormatOptions;
 class JsonFormatter;
 
 class JsonDocument;
+struct PointerOperation;
+
+// Object storage. std::less<> makes lookups transparent, so string_view and const char* keys
+// are found without building a std::string.
+using JsonObject = std::map<std::string, JsonDocument, std::less<>>;
+
+// Object stored against a shared ObjectShape: values[i] belongs to shape->keys()[i]. Built by
+// the parser with JsonParseOptions::share_object_shapes; turns back into a JsonObject when a
+// key is added or removed, or when items() or as_object() need a map.
+struct ShapedObject {
+    std::shared_ptr<const ObjectShape> shape;
+    std::vector<JsonDocument> values;
+};
+
+// Value shared by identical subtrees after JsonDocument::deduplicate(). Never changed while
+// shared: const access reads it in place, and a holder gets its own copy before anything can
+// modify it (copy-on-write).
+struct SharedValue {
+    std::shared_ptr<const JsonDocument> value;
+};
 
-using JsonStorage = std::variant<std::monostate,                      // null
-                                 bool,                                // boolean
-                                 LazyNumber,                          // number with lazy evaluation
-                                 std::string,                         // string
-                                 std::map<std::string, JsonDocument>, // object
-                                 std::vector<JsonDocument>            // array
+using JsonStorage = std::variant<std::monostate,            // null
+                                 bool,                      // boolean
+                                 LazyNumber,                // number with lazy evaluation
+                                 std::string,               // string
+                                 JsonObject,                // object
+                                 std::vector<JsonDocument>, // array
+                                 ShapedObject,              // object with a shared shape
+                                 SharedValue                // value shared with identical ones
                                  >;
 
 class JsonDocument {
@@ -40,9 +68,12 @@ class JsonDocument {
     friend class NavigationEngine;
     friend class JsonFormatter;
     friend class FastParser;
+    friend class JsonDiff;
 
 private:
     JsonType type_;
+    // Only non-const access changes the form of the storage (unshape(), unshare()), so const
+    // reads never move values that earlier references point at
     JsonStorage storage_;
 
     // Path cache for this document instance (managed manually to avoid forward declaration issues)
@@ -76,7 +107,9 @@ private:
 public:
     JsonDocument() : type_(JsonType::Null), storage_(std::monostate{}), path_cache_(nullptr) {}
 
-    // Destructor
+    // Destructor. Stack use is bounded whatever the nesting depth: containers nested more
+    // than memory_constants::MAX_RECURSIVE_TEARDOWN_DEPTH levels below the one being destroyed
+    // are freed in a loop rather than by recursion.
     ~JsonDocument();
 
     // Copy constructor
@@ -124,13 +157,18 @@ public:
         : type_(JsonType::Null), storage_(std::monostate{}), path_cache_(nullptr) {}
 
     JsonDocument(std::initializer_list<std::pair<const std::string, JsonDocument>> init)
-        : type_(JsonType::Object), storage_(std::map<std::string, JsonDocument>(init)),
-          path_cache_(nullptr) {}
+        : type_(JsonType::Object), storage_(JsonObject(init)), path_cache_(nullptr) {}
 
     // Direct container constructors - efficient when you already have JsonDocument containers
-    explicit JsonDocument(std::map<std::string, JsonDocument> obj)
+    explicit JsonDocument(JsonObject obj)
         : type_(JsonType::Object), storage_(std::move(obj)), path_cache_(nullptr) {}
 
+    // Maps with the default comparator keep working; their nodes are spliced, not copied
+    explicit JsonDocument(std::map<std::string, JsonDocument> obj)
+        : type_(JsonType::Object), storage_(JsonObject()), path_cache_(nullptr) {
+        std::get<JsonObject>(storage_).merge(obj);
+    }
+
     explicit JsonDocument(std::vector<JsonDocument> arr)
         : type_(JsonType::Array), storage_(std::move(arr)), path_cache_(nullptr) {}
 
@@ -145,7 +183,7 @@ public:
     // Zero-overhead - converter is inlined by compiler
     template <typename T, typename Converter>
     static auto from_map(const std::map<std::string, T>& map, Converter converter) -> JsonDocument {
-        std::map<std::string, JsonDocument> result;
+        JsonObject result;
         for (const auto& [key, value] : map) {
             result.emplace(key, converter(value));
         }
@@ -185,25 +223,36 @@ public:
     template <typename T> auto as() const -> T {
         if constexpr (std::is_same_v<T, bool>) {
             validate_type(JsonType::Boolean);
-            return std::get<bool>(storage_);
+            return std::get<bool>(storage());
         } else if constexpr (std::is_same_v<T, int>) {
             validate_type(JsonType::Number);
-            return std::get<LazyNumber>(storage_).as_int();
+            return std::get<LazyNumber>(storage()).as_int();
         } else if constexpr (std::is_same_v<T, long long>) {
             validate_type(JsonType::Number);
-            return std::get<LazyNumber>(storage_).as_long_long();
+            return std::get<LazyNumber>(storage()).as_long_long();
         } else if constexpr (std::is_same_v<T, double>) {
             validate_type(JsonType::Number);
-            return std::get<LazyNumber>(storage_).as_double();
+            return std::get<LazyNumber>(storage()).as_double();
         } else if constexpr (std::is_same_v<T, std::string>) {
             validate_type(JsonType::String);
-            return std::get<std::string>(storage_);
-        } else if constexpr (std::is_same_v<T, std::map<std::string, JsonDocument>>) {
+            return std::get<std::string>(storage());
+        } else if constexpr (std::is_same_v<T, std::string_view>) {
+            return as_string_view();
+        } else if constexpr (std::is_same_v<T, JsonObject>) {
             validate_type(JsonType::Object);
-            return std::get<std::map<std::string, JsonDocument>>(storage_);
+            if (const auto* shaped = std::get_if<ShapedObject>(&storage())) {
+                return shaped_to_map(*shaped);
+            }
+            return std::get<JsonObject>(storage());
+        } else if constexpr (std::is_same_v<T, std::map<std::string, JsonDocument>>) {
+            T result;
+            for (const auto& [key, value] : members()) {
+                result.emplace_hint(result.end(), key, value);
+            }
+            return result;
         } else if constexpr (std::is_same_v<T, std::vector<JsonDocument>>) {
             validate_type(JsonType::Array);
-            return std::get<std::vector<JsonDocument>>(storage_);
+            return std::get<std::vector<JsonDocument>>(storage());
         } else {
             static_assert(std::is_same_v<T, void>, "Unsupported type for as<T>()");
         }
@@ -217,68 +266,268 @@ public:
         }
     }
 
+    // View of the stored string, valid until this value is modified or destroyed
+    auto as_string_view() const -> std::string_view {
+        validate_type(JsonType::String);
+        return std::get<std::string>(storage());
+    }
+
+    // Pointer to the stored value when it holds a T, nullptr otherwise; never throws.
+    // T is a storage type: bool, LazyNumber, std::string, JsonObject,
+    // std::vector<JsonDocument> or ShapedObject (objects parsed with shared shapes). The const
+    // overload reads a shared value in place; the other first copies it, as any change does.
+    template <typename T> auto get_if() const -> const T* { return std::get_if<T>(&storage()); }
+    template <typename T> auto get_if() -> T* { return std::get_if<T>(&own_storage()); }
+
     auto as_array() const -> const std::vector<JsonDocument>& {
         validate_type(JsonType::Array);
-        return std::get<std::vector<JsonDocument>>(storage_);
+        return std::get<std::vector<JsonDocument>>(storage());
     }
 
-    auto as_object() const -> const std::map<std::string, JsonDocument>& {
+    // The const overload never changes the object, so a shaped object, which has no map to
+    // return, throws TypeException; members() reads either form in place. The non-const
+    // overload turns a shaped object into a map first.
+    auto as_object() const -> const JsonObject& {
         validate_type(JsonType::Object);
-        return std::get<std::map<std::string, JsonDocument>>(storage_);
+        if (const auto* obj = std::get_if<JsonObject>(&storage())) {
+            return *obj;
+        }
+        throw TypeException("as_object() on a const object with a shared shape - use "
+                            "members(), or call it through a non-const reference");
     }
 
+    auto as_object() -> const JsonObject& {
+        validate_type(JsonType::Object);
+        return object_map();
+    }
+
+    // Shape shared by this object and others with the same keys; nullptr for objects stored
+    // as a map and for other values
+    auto object_shape() const -> const ObjectShape* {
+        const auto* shaped = std::get_if<ShapedObject>(&storage());
+        return shaped != nullptr ? shaped->shape.get() : nullptr;
+    }
+
+    // True when deduplicate() made this value share its storage with identical values
+    auto is_shared() const -> bool { return std::holds_alternative<SharedValue>(storage_); }
+
     // Array iteration (range-for support)
     using iterator = std::vector<JsonDocument>::iterator;
     using const_iterator = std::vector<JsonDocument>::const_iterator;
 
     auto begin() -> iterator {
         validate_type(JsonType::Array);
-        return std::get<std::vector<JsonDocument>>(storage_).begin();
+        return std::get<std::vector<JsonDocument>>(own_storage()).begin();
     }
 
     auto end() -> iterator {
         validate_type(JsonType::Array);
-        return std::get<std::vector<JsonDocument>>(storage_).end();
+        return std::get<std::vector<JsonDocument>>(own_storage()).end();
     }
 
     auto begin() const -> const_iterator {
         validate_type(JsonType::Array);
-        return std::get<std::vector<JsonDocument>>(storage_).begin();
+        return std::get<std::vector<JsonDocument>>(storage()).begin();
     }
 
     auto end() const -> const_iterator {
         validate_type(JsonType::Array);
-        return std::get<std::vector<JsonDocument>>(storage_).end();
+        return std::get<std::vector<JsonDocument>>(storage()).end();
     }
 
-    // Object iteration via items() (structured binding support)
-    auto items() -> std::map<std::string, JsonDocument>& {
+    // Object iteration via items() (structured binding support). Hands out the map itself,
+    // so a shaped object is turned into one first, and the const overload throws for it as
+    // as_object() does; members() iterates either form.
+    auto items() -> JsonObject& {
         validate_type(JsonType::Object);
-        return std::get<std::map<std::string, JsonDocument>>(storage_);
+        return object_map();
     }
 
-    auto items() const -> const std::map<std::string, JsonDocument>& {
+    auto items() const -> const JsonObject& { return as_object(); }
+
+    class KeyView;
+
+    // Position in either object form: a map entry, or a shape key and its value
+    class MemberCursor {
+    public:
+        MemberCursor() = default;
+        explicit MemberCursor(JsonObject::const_iterator entry) : entry_(entry) {}
+        MemberCursor(const std::string* key, const JsonDocument* value)
+            : key_(key), value_(value) {}
+
+        auto key() const -> const std::string& { return key_ != nullptr ? *key_ : entry_->first; }
+        auto value() const -> const JsonDocument& {
+            return key_ != nullptr ? *value_ : entry_->second;
+        }
+        void next() {
+            if (key_ != nullptr) {
+                ++key_;
+                ++value_;
+            } else {
+                ++entry_;
+            }
+        }
+        void previous() {
+            if (key_ != nullptr) {
+                --key_;
+                --value_;
+            } else {
+                --entry_;
+            }
+        }
+        auto operator==(const MemberCursor& other) const -> bool {
+            return key_ == other.key_ && entry_ == other.entry_;
+        }
+
+    private:
+        JsonObject::const_iterator entry_{};
+        const std::string* key_ = nullptr;
+        const JsonDocument* value_ = nullptr;
+    };
+
+    // Object members in key order as (key, value) pairs of references, read in place from
+    // either object form
+    class MemberView {
+    public:
+        using value_type = std::pair<const std::string&, const JsonDocument&>;
+
+        class iterator {
+        public:
+            using iterator_category = std::input_iterator_tag;
+            using value_type = MemberView::value_type;
+            using difference_type = std::ptrdiff_t;
+            using reference = value_type;
+
+            // it->first and it->second through a pair held by value
+            struct pointer {
+                value_type member;
+                auto operator->() const -> const value_type* { return &member; }
+            };
+
+            iterator() = default;
+            explicit iterator(MemberCursor cursor) : cursor_(cursor) {}
+
+            auto operator*() const -> reference { return {cursor_.key(), cursor_.value()}; }
+            auto operator->() const -> pointer { return {**this}; }
+            auto operator++() -> iterator& {
+                cursor_.next();
+                return *this;
+            }
+            auto operator++(int) -> iterator {
+                iterator previous = *this;
+                cursor_.next();
+                return previous;
+            }
+            auto operator==(const iterator& other) const -> bool {
+                return cursor_ == other.cursor_;
+            }
+            auto operator!=(const iterator& other) const -> bool { return !(*this == other); }
+
+        private:
+            MemberCursor cursor_;
+        };
+
+        MemberView(MemberCursor first, MemberCursor last, std::size_t size)
+            : first_(first), last_(last), size_(size) {}
+
+        auto begin() const -> iterator { return iterator(first_); }
+        auto end() const -> iterator { return iterator(last_); }
+        auto size() const -> std::size_t { return size_; }
+        auto empty() const -> bool { return size_ == 0; }
+
+    private:
+        friend class KeyView;
+        MemberCursor first_;
+        MemberCursor last_;
+        std::size_t size_;
+    };
+
+    auto members() const -> MemberView {
         validate_type(JsonType::Object);
-        return std::get<std::map<std::string, JsonDocument>>(storage_);
+        if (const auto* shaped = std::get_if<ShapedObject>(&storage())) {
+            const auto& keys = shaped->shape->keys();
+            std::size_t count = keys.size();
+            return MemberView(MemberCursor(keys.data(), shaped->values.data()),
+                              MemberCursor(keys.data() + count, shaped->values.data() + count),
+                              count);
+        }
+        const auto& obj = std::get<JsonObject>(storage());
+        return MemberView(MemberCursor(obj.begin()), MemberCursor(obj.end()), obj.size());
     }
 
+    // Object keys in order, read in place from the object (keys() copies them)
+    class KeyView {
+    public:
+        class iterator {
+        public:
+            using iterator_category = std::bidirectional_iterator_tag;
+            using value_type = std::string;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const std::string*;
+            using reference = const std::string&;
+
+            iterator() = default;
+            explicit iterator(MemberCursor cursor) : cursor_(cursor) {}
+            explicit iterator(JsonObject::const_iterator entry) : cursor_(entry) {}
+
+            auto operator*() const -> reference { return cursor_.key(); }
+            auto operator->() const -> pointer { return &cursor_.key(); }
+            auto operator++() -> iterator& {
+                cursor_.next();
+                return *this;
+            }
+            auto operator++(int) -> iterator {
+                iterator previous = *this;
+                cursor_.next();
+                return previous;
+            }
+            auto operator--() -> iterator& {
+                cursor_.previous();
+                return *this;
+            }
+            auto operator--(int) -> iterator {
+                iterator previous = *this;
+                cursor_.previous();
+                return previous;
+            }
+            auto operator==(const iterator& other) const -> bool {
+                return cursor_ == other.cursor_;
+            }
+            auto operator!=(const iterator& other) const -> bool { return !(*this == other); }
+
+        private:
+            MemberCursor cursor_;
+        };
+
+        explicit KeyView(const MemberView& members)
+            : first_(members.first_), last_(members.last_), size_(members.size_) {}
+        explicit KeyView(const JsonObject& obj)
+            : first_(obj.begin()), last_(obj.end()), size_(obj.size()) {}
+
+        auto begin() const -> iterator { return iterator(first_); }
+        auto end() const -> iterator { return iterator(last_); }
+        auto size() const -> std::size_t { return size_; }
+        auto empty() const -> bool { return size_ == 0; }
+
+    private:
+        MemberCursor first_;
+        MemberCursor last_;
+        std::size_t size_;
+    };
+
+    auto key_view() const -> KeyView { return KeyView(members()); }
+
     auto keys() const -> std::vector<std::string> {
-        validate_type(JsonType::Object);
-        const auto& obj = std::get<std::map<std::string, JsonDocument>>(storage_);
-        std::vector<std::string> result;
-        result.reserve(obj.size());
-        for (const auto& entry : obj) {
-            result.push_back(entry.first);
-        }
-        return result;
+        auto view = key_view();
+        return std::vector<std::string>(view.begin(), view.end());
     }
 
     auto size() const -> std::size_t {
         if (type_ == JsonType::Array) {
-            return std::get<std::vector<JsonDocument>>(storage_).size();
+            return std::get<std::vector<JsonDocument>>(storage()).size();
         }
         if (type_ == JsonType::Object) {
-            return std::get<std::map<std::string, JsonDocument>>(storage_).size();
+            return members().size();
         }
         throw TypeException("size() requires array or object, got " + type_name(type_));
     }
@@ -288,18 +537,17 @@ public:
             return true;
         }
         if (type_ == JsonType::Array) {
-            return std::get<std::vector<JsonDocument>>(storage_).empty();
+            return std::get<std::vector<JsonDocument>>(storage()).empty();
         }
         if (type_ == JsonType::Object) {
-            return std::get<std::map<std::string, JsonDocument>>(storage_).empty();
+            return members().empty();
         }
         throw TypeException("empty() requires null, array, or object, got " + type_name(type_));
     }
 
-    auto contains(const std::string& key) const -> bool {
+    auto contains(std::string_view key) const -> bool {
         validate_type(JsonType::Object);
-        const auto& obj = std::get<std::map<std::string, JsonDocument>>(storage_);
-        return obj.find(key) != obj.end();
+        return find_member(key) != nullptr;
     }
 
     // Mutation methods: set(), push_back()
@@ -307,21 +555,33 @@ public:
     // These invalidate the path cache (both this document's and the global epoch)
     // so that any ancestor's cache will detect the change and re-navigate.
     //
-    // References and pointers obtained from operator[], at(), as_array(), or
-    // as_object() follow standard C++ container rules: any mutation that causes
-    // reallocation (push_back, set with resize on arrays) invalidates them.
+    // References and pointers obtained from operator[], at(), as_array(), as_object(),
+    // as_string_view(), get_if() or key_view() follow standard C++ container rules: any
+    // mutation that causes reallocation (push_back, set with resize on arrays) invalidates
+    // them.
     // Prefer set_at()/remove_at() from the root document for safe structural
     // changes when using JSON Pointer navigation.
 
     void push_back(const JsonDocument& value) {
         validate_type(JsonType::Array);
-        std::get<std::vector<JsonDocument>>(storage_).push_back(value);
+        std::get<std::vector<JsonDocument>>(own_storage()).push_back(value);
         invalidate_cache();
     }
 
     void push_back(JsonDocument&& value) {
         validate_type(JsonType::Array);
-        std::get<std::vector<JsonDocument>>(storage_).push_back(std::move(value));
+        std::get<std::vector<JsonDocument>>(own_storage()).push_back(std::move(value));
+        invalidate_cache();
+    }
+
+    // Insert before `index`; index == size() appends (RFC 6902 "add" semantics)
+    void insert(std::size_t index, JsonDocument value) {
+        validate_type(JsonType::Array);
+        auto& arr = std::get<std::vector<JsonDocument>>(own_storage());
+        if (index > arr.size()) {
+            throw std::out_of_range("Array index " + std::to_string(index) + " out of range");
+        }
+        arr.insert(arr.begin() + static_cast<std::ptrdiff_t>(index), std::move(value));
         invalidate_cache();
     }
 
@@ -330,34 +590,30 @@ public:
     }
 
     static auto make_object() -> JsonDocument {
-        return JsonDocument(std::map<std::string, JsonDocument>{});
+        return JsonDocument(JsonObject{});
     }
 
-    auto operator[](const std::string& key) -> JsonDocument& {
+    auto operator[](std::string_view key) -> JsonDocument& {
         validate_type(JsonType::Object);
-        auto& obj = std::get<std::map<std::string, JsonDocument>>(storage_);
-        // NOLINTNEXTLINE(readability-identifier-length)
-        auto it = obj.find(key);
-        if (it == obj.end()) {
-            throw std::out_of_range("Key '" + key + "' not found in object");
+        JsonDocument* member = find_member(key);
+        if (member == nullptr) {
+            throw std::out_of_range("Key '" + std::string(key) + "' not found in object");
         }
-        return it->second;
+        return *member;
     }
 
-    auto operator[](const std::string& key) const -> const JsonDocument& {
+    auto operator[](std::string_view key) const -> const JsonDocument& {
         validate_type(JsonType::Object);
-        const auto& obj = std::get<std::map<std::string, JsonDocument>>(storage_);
-        // NOLINTNEXTLINE(readability-identifier-length)
-        auto it = obj.find(key);
-        if (it == obj.end()) {
-            throw std::out_of_range("Key '" + key + "' not found in object");
+        const JsonDocument* member = find_member(key);
+        if (member == nullptr) {
+            throw std::out_of_range("Key '" + std::string(key) + "' not found in object");
         }
-        return it->second;
+        return *member;
     }
 
     auto operator[](std::size_t index) -> JsonDocument& {
         validate_type(JsonType::Array);
-        auto& arr = std::get<std::vector<JsonDocument>>(storage_);
+        auto& arr = std::get<std::vector<JsonDocument>>(own_storage());
         if (index >= arr.size()) {
             throw std::out_of_range("Array index " + std::to_string(index) + " out of range");
         }
@@ -366,22 +622,22 @@ public:
 
     auto operator[](std::size_t index) const -> const JsonDocument& {
         validate_type(JsonType::Array);
-        const auto& arr = std::get<std::vector<JsonDocument>>(storage_);
+        const auto& arr = std::get<std::vector<JsonDocument>>(storage());
         if (index >= arr.size()) {
             throw std::out_of_range("Array index " + std::to_string(index) + " out of range");
         }
         return arr[index];
     }
 
-    void set(const std::string& key, const JsonDocument& value) {
+    void set(std::string_view key, const JsonDocument& value) {
         validate_type(JsonType::Object);
-        std::get<std::map<std::string, JsonDocument>>(storage_)[key] = value;
+        object_slot(key) = value;
         invalidate_cache();
     }
 
     void set(std::size_t index, const JsonDocument& value) {
         validate_type(JsonType::Array);
-        auto& arr = std::get<std::vector<JsonDocument>>(storage_);
+        auto& arr = std::get<std::vector<JsonDocument>>(own_storage());
         if (index >= arr.size()) {
             arr.resize(index + 1);
         }
@@ -389,35 +645,57 @@ public:
         invalidate_cache();
     }
 
-    void set(const std::string& key, JsonDocument&& value) {
+    void set(std::size_t index, JsonDocument&& value) {
+        validate_type(JsonType::Array);
+        auto& arr = std::get<std::vector<JsonDocument>>(own_storage());
+        if (index >= arr.size()) {
+            arr.resize(index + 1);
+        }
+        arr[index] = std::move(value);
+        invalidate_cache();
+    }
+
+    void set(std::string_view key, JsonDocument&& value) {
         validate_type(JsonType::Object);
-        std::get<std::map<std::string, JsonDocument>>(storage_)[key] = std::move(value);
+        object_slot(key) = std::move(value);
         invalidate_cache();
     }
 
+    // Literal keys would otherwise be ambiguous between the string_view and std::string&&
+    // overloads
+    void set(const char* key, JsonDocument&& value) {
+        set(std::string_view(key), std::move(value));
+    }
+
     void set(std::string&& key, JsonDocument&& value) {
         validate_type(JsonType::Object);
-        std::get<std::map<std::string, JsonDocument>>(storage_).insert_or_assign(
-            std::move(key), std::move(value));
+        if (JsonDocument* member = shaped_member(key)) {
+            *member = std::move(value);
+        } else {
+            object_map().insert_or_assign(std::move(key), std::move(value));
+        }
         invalidate_cache();
     }
 
     auto to_json() const -> std::string {
+        JSOM_TRACE_SPAN(span, trace::SpanKind::ToJson, 0);
         std::string result;
         result.reserve(
             parser_constants::JSON_DOCUMENT_INITIAL_SIZE); // Pre-allocate reasonable size
         serialize_compact_to_string(result);
+        span.set_bytes(result.size());
+        JSOM_METRIC_ADD(metrics::Counter::SerializeBytes, result.size());
         return result;
     }
 
-    auto to_json(bool pretty) const -> std::string {
-        std::ostringstream oss;
-        serialize_to(oss, pretty, 0);
-        return oss.str();
-    }
+    // Stream-based serialization lives in src/json_document_serialize.cpp so this header
+    // does not pull in <sstream>
+    auto to_json(bool pretty) const -> std::string;
 
-    // Advanced formatting with full options control
+#ifndef JSOM_PROFILE_CORE
+    // Advanced formatting with full options control (JsonFormatter is not in the core profile)
     auto to_json(const JsonFormatOptions& options) const -> std::string;
+#endif
 
     // JSON Pointer support (RFC 6901)
     // These methods activate path functionality lazily - zero cost if not used
@@ -432,7 +710,8 @@ public:
     // Navigate to path (non-const version)
     auto at(const std::string& json_pointer) -> JsonDocument&;
 
-    // Safe navigation (returns nullptr if not found)
+    // Safe navigation: nullptr if the path is missing or malformed; never throws, so misses
+    // cost no more than hits
     auto find(const std::string& json_pointer) const -> const JsonDocument*;
     auto find(const std::string& json_pointer) -> JsonDocument*;
 
@@ -446,6 +725,17 @@ public:
     auto remove_at(const std::string& json_pointer) -> bool;
     auto extract_at(const std::string& json_pointer) -> JsonDocument; // Remove and return
 
+    // Apply many set_at()/remove_at() operations in order, as one mutation: each operation
+    // walks only the part of its parent path it does not share with the previous one, so
+    // operations sorted by pointer (as a key/value store returns them) touch each node once,
+    // and the path cache is invalidated once at the end. Differences from calling
+    // set_at()/remove_at() one by one: a run of consecutive removals from the same array
+    // uses the indices from before the run (removing /a/1 then /a/3 removes both original
+    // elements), and invalid pointers throw before anything is applied. Otherwise throws
+    // like set_at(), keeping the operations applied before the failure.
+    // Returns the number of operations that changed the document.
+    auto apply_batch(std::vector<PointerOperation> operations) -> size_t;
+
     // Batch operations for efficiency
     auto at_multiple(const std::vector<std::string>& paths) const
         -> std::vector<const JsonDocument*>;
@@ -473,7 +763,135 @@ public:
 
     auto get_path_cache_stats() const -> PathCacheStats;
 
+    // Heap bytes held by this value and everything below it. Estimated from capacities and
+    // node sizes, without allocator bookkeeping or this object's own sizeof(JsonDocument).
+    // One pass over the values, no allocation.
+    // Object shapes are shared between objects and documents, so no document counts them.
+    // A value shared by deduplicate() is split evenly between its holders, wherever they are.
+    struct MemoryUsage {
+        size_t containers = 0;  // Array element buffers and shaped-object value buffers
+        size_t map_nodes = 0;   // Object tree nodes: links, key and value slots
+        size_t strings = 0;     // String values and object keys too long for SSO
+        size_t numbers = 0;     // Number text kept for lazy conversion, too long for SSO
+        size_t path_caches = 0; // Caches created by JSON Pointer navigation
+        size_t shared = 0;      // This value's part of the values shared by deduplicate()
+
+        auto total() const -> size_t {
+            return containers + map_nodes + strings + numbers + path_caches + shared;
+        }
+    };
+
+    auto memory_usage() const -> MemoryUsage;
+
+    // Hash-consing: objects and arrays below this value that serialize identically are
+    // stored once and shared. Every read works as before and reads the shared value in place.
+    // Non-const access (operator[], at(), begin(), items(), set() and the like) copies one
+    // level of a shared value into the node first (copy-on-write), so changes never reach
+    // the other holders; read through a const reference to keep values shared. Copies of
+    // the document share the values too. Invalidates pointers into the values and path
+    // caches. Costs a hash and, on a match, a comparison per container, plus a table entry
+    // per distinct container until it returns.
+    struct DedupStats {
+        size_t containers = 0; // Non-empty objects and arrays examined
+        size_t replaced = 0;   // Containers found identical to an earlier one and now shared
+        size_t distinct = 0;   // Shared values created
+    };
+
+    auto deduplicate() -> DedupStats;
+
 private:
+    void add_memory_usage(MemoryUsage& usage) const;
+    // Destroy this container's children, deferring the ones too deep to recurse into
+    void release_children() noexcept;
+    // Parses and walks the pointer once, then erases the target; when `removed` is given the
+    // target is moved into it first. False when the target does not exist.
+    auto take_at(const std::string& json_pointer, JsonDocument* removed) -> bool;
+    // Store `value` under `segment` of `parent` as set_at() does, without cache invalidation
+    static void set_child(JsonDocument& parent, std::string_view segment, JsonDocument&& value,
+                          const std::string& json_pointer);
+    // Value of `key` in this object, or nullptr; never converts a shaped object
+    auto find_member(std::string_view key) const -> const JsonDocument* {
+        if (const auto* shaped = std::get_if<ShapedObject>(&storage())) {
+            std::size_t slot = shaped->shape->slot(key);
+            return slot == ObjectShape::npos ? nullptr : &shaped->values[slot];
+        }
+        const auto& obj = std::get<JsonObject>(storage());
+        // NOLINTNEXTLINE(readability-identifier-length)
+        auto it = obj.find(key);
+        return it == obj.end() ? nullptr : &it->second;
+    }
+    auto find_member(std::string_view key) -> JsonDocument* {
+        own_storage();
+        return const_cast<JsonDocument*>(std::as_const(*this).find_member(key));
+    }
+    // Value of `key` when this object is shaped and has the key: assigning to it keeps the
+    // shape. nullptr otherwise.
+    auto shaped_member(std::string_view key) -> JsonDocument* {
+        return std::holds_alternative<ShapedObject>(own_storage()) ? find_member(key) : nullptr;
+    }
+    // This object as a map of its own, copying a shared value and converting a shaped object
+    // first
+    auto object_map() -> JsonObject& {
+        if (std::holds_alternative<SharedValue>(storage_)) {
+            unshare();
+        }
+        if (std::holds_alternative<ShapedObject>(storage_)) {
+            unshape();
+        }
+        return std::get<JsonObject>(storage_);
+    }
+    // Replace the ShapedObject with the equivalent JsonObject, defined in
+    // src/json_document_memory.cpp. Moves the values, so pointers to them (path caches
+    // included) are invalidated.
+    void unshape();
+    // The storage holding this value: the shared one for a SharedValue, else this document's
+    auto storage() const -> const JsonStorage& {
+        if (const auto* shared = std::get_if<SharedValue>(&storage_)) {
+            return shared->value->storage_;
+        }
+        return storage_;
+    }
+    // This document's own storage, for changes; a shared value is copied in first
+    auto own_storage() -> JsonStorage& {
+        if (std::holds_alternative<SharedValue>(storage_)) {
+            unshare();
+        }
+        return storage_;
+    }
+    // Replace the SharedValue with a copy of the value (its last holder takes the value
+    // itself), defined in src/json_document_memory.cpp. Children are copied one level deep,
+    // so shared ones stay shared. Path caches never hold nodes inside a shared value (see
+    // NavigationEngine), so none is invalidated.
+    void unshare();
+    static auto shaped_to_map(const ShapedObject& shaped) -> JsonObject {
+        JsonObject result;
+        const auto& keys = shaped.shape->keys();
+        for (std::size_t i = 0; i < keys.size(); ++i) {
+            result.emplace_hint(result.end(), keys[i], shaped.values[i]); // Keys are sorted
+        }
+        return result;
+    }
+    // Equality and ordering of two objects in either form, as std::map compares
+    static auto objects_equal(const JsonDocument& lhs, const JsonDocument& rhs) -> bool;
+    static auto objects_less(const JsonDocument& lhs, const JsonDocument& rhs) -> bool;
+    // Member slot for `key` in this object, inserting null when absent. The key is copied
+    // into a std::string only on insertion, which turns a shaped object into a map.
+    auto object_slot(std::string_view key) -> JsonDocument& {
+        if (JsonDocument* member = shaped_member(key)) {
+            return *member;
+        }
+        auto& obj = object_map();
+        // NOLINTNEXTLINE(readability-identifier-length)
+        auto it = obj.lower_bound(key);
+        if (it == obj.end() || it->first != key) {
+            it = obj.emplace_hint(it, std::string(key), JsonDocument());
+        }
+        return it->second;
+    }
+    // Shared-prefix walker behind apply_batch(), defined in src/json_document_batch.cpp
+    class BatchApplier;
+    // Hash-consing pass behind deduplicate(), defined in src/json_document_memory.cpp
+    class Deduplicator;
     // Get or create path cache for this document
     auto get_path_cache() const -> PathCache&;
     // Invalidate path cache after structural mutations
@@ -486,23 +904,21 @@ private:
             out += "null";
             break;
         case JsonType::Boolean:
-            out += std::get<bool>(storage_) ? "true" : "false";
+            out += std::get<bool>(storage()) ? "true" : "false";
             break;
         case JsonType::Number: {
-            const auto& num = std::get<LazyNumber>(storage_);
+            const auto& num = std::get<LazyNumber>(storage());
             if (num.has_original_repr()) {
                 out += num.get_original_repr();
             } else {
-                // Fallback to stream-based (rare case)
-                std::ostringstream oss;
-                num.serialize(oss);
-                out += oss.str();
+                // Fallback for numbers built from a double (rare case)
+                out += num.as_string();
             }
             break;
         }
         case JsonType::String:
             out += '"';
-            escape_string_to_string(out, std::get<std::string>(storage_));
+            escape_string_to_string(out, std::get<std::string>(storage()));
             out += '"';
             break;
         case JsonType::Object:
@@ -515,63 +931,10 @@ private:
     }
     // NOLINTEND(readability-function-size)
 
-    // Optimized compact serialization (no pretty printing overhead)
-    void serialize_compact(std::ostream& out) const {
-        switch (type_) {
-        case JsonType::Null:
-            out << "null";
-            break;
-        case JsonType::Boolean:
-            out << (std::get<bool>(storage_) ? "true" : "false");
-            break;
-        case JsonType::Number:
-            std::get<LazyNumber>(storage_).serialize(out);
-            break;
-        case JsonType::String:
-            out << '"';
-            escape_string(out, std::get<std::string>(storage_));
-            out << '"';
-            break;
-        case JsonType::Object:
-            serialize_object_compact(out);
-            break;
-        case JsonType::Array:
-            serialize_array_compact(out);
-            break;
-        }
-    }
-
-    void serialize_object_to(std::ostream& out, bool pretty, int indent) const {
-        const auto& obj = std::get<std::map<std::string, JsonDocument>>(storage_);
-        out << '{';
-        bool first = true;
-        for (const auto& [key, value] : obj) {
-            if (!first) {
-                out << ',';
-            }
-            if (pretty) {
-                out << '\n' << std::string(static_cast<size_t>((indent + 1) * 2), ' ');
-            }
-            out << '"';
-            escape_string(out, key);
-            out << "\":";
-            if (pretty) {
-                out << ' ';
-            }
-            value.serialize_to(out, pretty, indent + 1);
-            first = false;
-        }
-        if (pretty && !obj.empty()) {
-            out << '\n' << std::string(static_cast<size_t>(indent * 2), ' ');
-        }
-        out << '}';
-    }
-
     void serialize_object_compact_to_string(std::string& out) const {
-        const auto& obj = std::get<std::map<std::string, JsonDocument>>(storage_);
         out += '{';
         bool first = true;
-        for (const auto& [key, value] : obj) {
+        for (const auto& [key, value] : members()) {
             if (!first) {
                 out += ',';
             }
@@ -585,7 +948,7 @@ private:
     }
 
     void serialize_array_compact_to_string(std::string& out) const {
-        const auto& arr = std::get<std::vector<JsonDocument>>(storage_);
+        const auto& arr = std::get<std::vector<JsonDocument>>(storage());
         out += '[';
         bool first = true;
         for (const auto& value : arr) {
@@ -598,82 +961,14 @@ private:
         out += ']';
     }
 
-    void serialize_object_compact(std::ostream& out) const {
-        const auto& obj = std::get<std::map<std::string, JsonDocument>>(storage_);
-        out << '{';
-        bool first = true;
-        for (const auto& [key, value] : obj) {
-            if (!first) {
-                out << ',';
-            }
-            out << '"';
-            escape_string(out, key);
-            out << "\":";
-            value.serialize_compact(out);
-            first = false;
-        }
-        out << '}';
-    }
-
-    void serialize_array_compact(std::ostream& out) const {
-        const auto& arr = std::get<std::vector<JsonDocument>>(storage_);
-        out << '[';
-        bool first = true;
-        for (const auto& value : arr) {
-            if (!first) {
-                out << ',';
-            }
-            value.serialize_compact(out);
-            first = false;
-        }
-        out << ']';
-    }
-
-    void serialize_array_to(std::ostream& out, bool pretty, int indent) const {
-        const auto& arr = std::get<std::vector<JsonDocument>>(storage_);
-        out << '[';
-        bool first = true;
-        for (const auto& value : arr) {
-            if (!first) {
-                out << ',';
-            }
-            if (pretty) {
-                out << '\n' << std::string(static_cast<size_t>((indent + 1) * 2), ' ');
-            }
-            value.serialize_to(out, pretty, indent + 1);
-            first = false;
-        }
-        if (pretty && !arr.empty()) {
-            out << '\n' << std::string(static_cast<size_t>(indent * 2), ' ');
-        }
-        out << ']';
-    }
+    void serialize_compact(std::ostream& out) const;
+    void serialize_object_to(std::ostream& out, bool pretty, int indent) const;
+    void serialize_object_compact(std::ostream& out) const;
+    void serialize_array_compact(std::ostream& out) const;
+    void serialize_array_to(std::ostream& out, bool pretty, int indent) const;
 
 public:
-    void serialize_to(std::ostream& out, bool pretty, int indent = 0) const {
-        switch (type_) {
-        case JsonType::Null:
-            out << "null";
-            break;
-        case JsonType::Boolean:
-            out << (std::get<bool>(storage_) ? "true" : "false");
-            break;
-        case JsonType::Number:
-            std::get<LazyNumber>(storage_).serialize(out);
-            break;
-        case JsonType::String:
-            out << '"';
-            escape_string(out, std::get<std::string>(storage_));
-            out << '"';
-            break;
-        case JsonType::Object:
-            serialize_object_to(out, pretty, indent);
-            break;
-        case JsonType::Array:
-            serialize_array_to(out, pretty, indent);
-            break;
-        }
-    }
+    void serialize_to(std::ostream& out, bool pretty, int indent = 0) const;
 
     // NOLINTBEGIN(readability-function-size)
     static void escape_string_to_string(std::string& out, const std::string& str) {
@@ -735,62 +1030,7 @@ public:
     }
     // NOLINTEND(readability-function-size)
 
-    // NOLINTBEGIN(readability-function-size)
-    static void escape_string(std::ostream& out, const std::string& str) {
-        // Fast path: check if string needs escaping
-        bool needs_escaping = false;
-        // NOLINTNEXTLINE(readability-identifier-length)
-        for (char c : str) {
-            if (c == '"' || c == '\\'
-                || static_cast<unsigned char>(c) < character_constants::MIN_CONTROL_CHAR) {
-                needs_escaping = true;
-                break;
-            }
-        }
-
-        if (!needs_escaping) {
-            // Fast path: output directly
-            out << str;
-            return;
-        }
-
-        // Slow path: escape character by character
-        // NOLINTNEXTLINE(readability-identifier-length)
-        for (char c : str) {
-            switch (c) {
-            case '"':
-                out << "\\\"";
-                break;
-            case '\\':
-                out << "\\\\";
-                break;
-            case '\b':
-                out << "\\b";
-                break;
-            case '\f':
-                out << "\\f";
-                break;
-            case '\n':
-                out << "\\n";
-                break;
-            case '\r':
-                out << "\\r";
-                break;
-            case '\t':
-                out << "\\t";
-                break;
-            default:
-                if (static_cast<unsigned char>(c) < character_constants::MIN_CONTROL_CHAR) {
-                    out << "\\u" << std::hex << std::setfill('0') << std::setw(4)
-                        << static_cast<unsigned>(c);
-                } else {
-                    out << c;
-                }
-                break;
-            }
-        }
-    }
-    // NOLINTEND(readability-function-size)
+    static void escape_string(std::ostream& out, const std::string& str);
 
     // Comparison operators
     friend auto operator==(const JsonDocument& lhs, const JsonDocument& rhs) -> bool;
@@ -802,21 +1042,23 @@ inline auto operator==(const JsonDocument& lhs, const JsonDocument& rhs) -> bool
     if (lhs.type_ != rhs.type_) {
         return false;
     }
+    if (&lhs.storage() == &rhs.storage()) {
+        return true; // The same value, e.g. one shared by deduplicate()
+    }
     switch (lhs.type_) {
     case JsonType::Null:
         return true;
     case JsonType::Boolean:
-        return std::get<bool>(lhs.storage_) == std::get<bool>(rhs.storage_);
+        return std::get<bool>(lhs.storage()) == std::get<bool>(rhs.storage());
     case JsonType::Number:
-        return std::get<LazyNumber>(lhs.storage_) == std::get<LazyNumber>(rhs.storage_);
+        return std::get<LazyNumber>(lhs.storage()) == std::get<LazyNumber>(rhs.storage());
     case JsonType::String:
-        return std::get<std::string>(lhs.storage_) == std::get<std::string>(rhs.storage_);
+        return std::get<std::string>(lhs.storage()) == std::get<std::string>(rhs.storage());
     case JsonType::Array:
-        return std::get<std::vector<JsonDocument>>(lhs.storage_)
-               == std::get<std::vector<JsonDocument>>(rhs.storage_);
+        return std::get<std::vector<JsonDocument>>(lhs.storage())
+               == std::get<std::vector<JsonDocument>>(rhs.storage());
     case JsonType::Object:
-        return std::get<std::map<std::string, JsonDocument>>(lhs.storage_)
-               == std::get<std::map<std::string, JsonDocument>>(rhs.storage_);
+        return JsonDocument::objects_equal(lhs, rhs);
     }
     return false;
 }
@@ -833,22 +1075,56 @@ inline auto operator<(const JsonDocument& lhs, const JsonDocument& rhs) -> bool
     case JsonType::Null:
         return false; // null == null, never less
     case JsonType::Boolean:
-        return !std::get<bool>(lhs.storage_) && std::get<bool>(rhs.storage_); // false < true
+        return !std::get<bool>(lhs.storage()) && std::get<bool>(rhs.storage()); // false < true
     case JsonType::Number:
-        return std::get<LazyNumber>(lhs.storage_) < std::get<LazyNumber>(rhs.storage_);
+        return std::get<LazyNumber>(lhs.storage()) < std::get<LazyNumber>(rhs.storage());
     case JsonType::String:
-        return std::get<std::string>(lhs.storage_) < std::get<std::string>(rhs.storage_);
+        return std::get<std::string>(lhs.storage()) < std::get<std::string>(rhs.storage());
     case JsonType::Array:
-        return std::get<std::vector<JsonDocument>>(lhs.storage_)
-               < std::get<std::vector<JsonDocument>>(rhs.storage_);
+        return std::get<std::vector<JsonDocument>>(lhs.storage())
+               < std::get<std::vector<JsonDocument>>(rhs.storage());
     case JsonType::Object:
-        return std::get<std::map<std::string, JsonDocument>>(lhs.storage_)
-               < std::get<std::map<std::string, JsonDocument>>(rhs.storage_);
+        return JsonDocument::objects_less(lhs, rhs);
     }
     return false;
 }
 // NOLINTEND(readability-function-size)
 
+inline auto JsonDocument::objects_equal(const JsonDocument& lhs, const JsonDocument& rhs)
+    -> bool {
+    const auto* left = std::get_if<ShapedObject>(&lhs.storage());
+    const auto* right = std::get_if<ShapedObject>(&rhs.storage());
+    if (left == nullptr && right == nullptr) {
+        return std::get<JsonObject>(lhs.storage()) == std::get<JsonObject>(rhs.storage());
+    }
+    if (left != nullptr && right != nullptr && left->shape == right->shape) {
+        return left->values == right->values;
+    }
+    auto left_members = lhs.members();
+    auto right_members = rhs.members();
+    return left_members.size() == right_members.size()
+           && std::equal(left_members.begin(), left_members.end(), right_members.begin(),
+                         [](const auto& first, const auto& second) {
+                             return first.first == second.first && first.second == second.second;
+                         });
+}
+
+inline auto JsonDocument::objects_less(const JsonDocument& lhs, const JsonDocument& rhs)
+    -> bool {
+    if (!std::holds_alternative<ShapedObject>(lhs.storage())
+        && !std::holds_alternative<ShapedObject>(rhs.storage())) {
+        return std::get<JsonObject>(lhs.storage()) < std::get<JsonObject>(rhs.storage());
+    }
+    auto left_members = lhs.members();
+    auto right_members = rhs.members();
+    return std::lexicographical_compare(
+        left_members.begin(), left_members.end(), right_members.begin(), right_members.end(),
+        [](const auto& first, const auto& second) {
+            return first.first < second.first
+                   || (!(second.first < first.first) && first.second < second.second);
+        });
+}
+
 inline auto operator>(const JsonDocument& lhs, const JsonDocument& rhs) -> bool {
     return rhs < lhs;
 }
@@ -861,4 +1137,20 @@ inline auto operator>=(const JsonDocument& lhs, const JsonDocument& rhs) -> bool
     return !(lhs < rhs);
 }
 
+// One operation of JsonDocument::apply_batch()
+struct PointerOperation {
+    enum class Kind : uint8_t { Set, Remove };
+
+    Kind kind = Kind::Set;
+    std::string pointer;
+    JsonDocument value; // Set only
+
+    static auto set(std::string pointer, JsonDocument value) -> PointerOperation {
+        return {Kind::Set, std::move(pointer), std::move(value)};
+    }
+    static auto remove(std::string pointer) -> PointerOperation {
+        return {Kind::Remove, std::move(pointer), JsonDocument()};
+    }
+};
+
 } // namespace jsom
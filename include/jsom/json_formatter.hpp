@@ -3,6 +3,8 @@
 #include "constants.hpp"
 #include "json_document.hpp"
 #include "json_format_options.hpp"
+#include "metrics.hpp"
+#include "trace_hooks.hpp"
 #include <algorithm>
 #include <iomanip>
 #include <map>
@@ -24,15 +26,31 @@ public:
      * Format a JsonDocument to string using the configured options.
      */
     [[nodiscard]] auto format(const JsonDocument& doc) const -> std::string {
+        JSOM_TRACE_SPAN(span, trace::SpanKind::Format, 0);
+#ifdef JSOM_ENABLE_TRACING
+        values_formatted_ = 0;
+#endif
         std::ostringstream oss;
         format_value(oss, doc, 0);
-        return oss.str();
+        std::string result = oss.str();
+        span.set_bytes(result.size());
+#ifdef JSOM_ENABLE_TRACING
+        span.set_nodes(values_formatted_);
+#endif
+        JSOM_METRIC_ADD(metrics::Counter::SerializeBytes, result.size());
+        return result;
     }
 
 private:
     const JsonFormatOptions& options_;
+#ifdef JSOM_ENABLE_TRACING
+    // Values written by the current format() call; per thread, so concurrent calls on one
+    // formatter do not share it
+    static inline thread_local size_t values_formatted_ = 0;
+#endif
 
     void format_value(std::ostringstream& oss, const JsonDocument& doc, int depth) const {
+        JSOM_TRACE_COUNT(values_formatted_);
         if (depth > options_.max_depth) {
             throw std::runtime_error("Maximum formatting depth exceeded");
         }
@@ -45,7 +63,7 @@ private:
             oss << (doc.as<bool>() ? "true" : "false");
             break;
         case JsonType::Number:
-            oss << std::get<LazyNumber>(doc.storage_).as_string();
+            oss << std::get<LazyNumber>(doc.storage()).as_string();
             break;
         case JsonType::String:
             format_string(oss, doc.as<std::string>());
@@ -162,7 +180,7 @@ private:
         void start_new_line(std::ostringstream& oss) {
             if (is_multiline_mode) {
                 if (!current_line.empty()) {
-                    oss << "\n" << line_prefix;
+                    oss << ",\n" << line_prefix; // The wrapped line still needs its separator
                 }
             } else {
                 if (!current_line.empty()) {
@@ -213,14 +231,14 @@ private:
         std::string line_prefix
             = options_.indent_size.has_value() && is_multiline_mode ? indent(depth + 1) : "";
 
-        size_t available_width;
-        if (is_multiline_mode) {
-            available_width = options_.max_line_width - line_prefix.length();
-        } else {
-            size_t prefix_length
-                = options_.indent_size.has_value() ? indent(depth + 1).length() : 0;
-            available_width = options_.max_line_width - prefix_length;
+        size_t prefix_length = line_prefix.length();
+        if (!is_multiline_mode) {
+            prefix_length = options_.indent_size.has_value() ? indent(depth + 1).length() : 0;
         }
+        // Deep indentation can be wider than the line; clamp instead of wrapping around to a
+        // huge width (which then failed to reserve)
+        auto line_width = static_cast<size_t>(options_.max_line_width);
+        size_t available_width = prefix_length < line_width ? line_width - prefix_length : 0;
 
         ArrayLineFormatter formatter(available_width, line_prefix, is_multiline_mode);
 
@@ -372,7 +390,7 @@ public:
         }
     }
 
-    [[nodiscard]] auto prepare_object_keys(const std::map<std::string, JsonDocument>& obj) const
+    [[nodiscard]] auto prepare_object_keys(const JsonDocument::MemberView& obj) const
         -> std::vector<std::string> {
         std::vector<std::string> keys;
         keys.reserve(obj.size());
@@ -402,8 +420,7 @@ public:
         return max_key_width;
     }
 
-    void format_inline_object(std::ostringstream& oss,
-                              const std::map<std::string, JsonDocument>& obj,
+    void format_inline_object(std::ostringstream& oss, const JsonDocument& obj,
                               const std::vector<std::string>& keys, int depth) const {
         // Inline format
         for (size_t i = 0; i < keys.size(); ++i) {
@@ -412,12 +429,11 @@ public:
             }
             format_key(oss, keys[i]);
             format_colon_spacing(oss);
-            format_value(oss, obj.at(keys[i]), depth + 1);
+            format_value(oss, obj[keys[i]], depth + 1);
         }
     }
 
-    void format_multiline_object(std::ostringstream& oss,
-                                 const std::map<std::string, JsonDocument>& obj, int depth,
+    void format_multiline_object(std::ostringstream& oss, const JsonDocument& obj, int depth,
                                  const std::vector<std::string>& keys, size_t max_key_width) const {
         // Multiline format
         for (size_t i = 0; i < keys.size(); ++i) {
@@ -437,7 +453,7 @@ public:
             }
 
             format_colon_spacing(oss);
-            format_value(oss, obj.at(keys[i]), depth + 1);
+            format_value(oss, obj[keys[i]], depth + 1);
 
             if ((i < keys.size() - 1) || (options_.trailing_comma)) {
                 oss << ",";
@@ -449,7 +465,7 @@ public:
     }
 
     void format_object(std::ostringstream& oss, const JsonDocument& doc, int depth) const {
-        const auto& obj = doc.as<std::map<std::string, JsonDocument>>();
+        auto obj = doc.members();
 
         if (obj.empty()) {
             format_empty_object(oss);
@@ -464,9 +480,9 @@ public:
         add_opening_bracket_spacing(oss, should_inline);
 
         if (should_inline) {
-            format_inline_object(oss, obj, keys, depth);
+            format_inline_object(oss, doc, keys, depth);
         } else {
-            format_multiline_object(oss, obj, depth, keys, max_key_width);
+            format_multiline_object(oss, doc, depth, keys, max_key_width);
         }
 
         add_closing_bracket_spacing(oss, should_inline);
@@ -558,8 +574,7 @@ public:
         return true;
     }
 
-    [[nodiscard]] auto should_inline_object(const std::map<std::string, JsonDocument>& obj) const
-        -> bool {
+    [[nodiscard]] auto should_inline_object(const JsonDocument::MemberView& obj) const -> bool {
         if (!options_.indent_size.has_value()) {
             return true;
         }
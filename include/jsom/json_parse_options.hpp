@@ -18,6 +18,14 @@ struct JsonParseOptions {
     /// When false (default): Strict JSON parsing, comments are syntax errors
     /// When true: Skips // line comments and /* block comments */
     bool allow_comments = false;
+
+    /// Store objects that share their keys with other objects against one shared shape
+    /// When false (default): Every object is a std::map of its own keys and values
+    /// When true: Objects keep only their values; lookups find the key's position in the
+    /// shared ObjectShape. Pays off on arrays of records with the same keys. Adding or
+    /// removing a key, or non-const items() and as_object(), turn the object back into a
+    /// map; their const overloads throw for it, members() reads either form.
+    bool share_object_shapes = false;
 };
 
 /**
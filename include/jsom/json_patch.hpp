@@ -0,0 +1,129 @@
+#pragma once
+
+#include "json_document.hpp"
+#include "json_pointer.hpp"
+#include <stdexcept>
+#include <string>
+
+namespace jsom {
+
+class JsonPatchException : public std::runtime_error {
+public:
+    JsonPatchException(std::size_t operation_index, const std::string& message)
+        : std::runtime_error("Patch operation " + std::to_string(operation_index) + ": "
+                             + message),
+          operation_index_(operation_index) {}
+
+    [[nodiscard]] auto operation_index() const -> std::size_t { return operation_index_; }
+
+private:
+    std::size_t operation_index_;
+};
+
+// Applies RFC 6902 patches in place. Each operation edits only the container it names,
+// so untouched subtrees (and their original number text) are never copied or
+// re-serialized.
+//
+// Operations are applied in order. If one fails, the operations before it remain
+// applied; callers that need all-or-nothing semantics should patch a copy.
+class JsonPatch {
+public:
+    static void apply(JsonDocument& target, const JsonDocument& patch) {
+        if (!patch.is_array()) {
+            throw JsonPatchException(0, "patch must be an array of operations");
+        }
+        const auto& operations = patch.as_array();
+        for (std::size_t i = 0; i < operations.size(); ++i) {
+            try {
+                apply_operation(target, operations[i]);
+            } catch (const JsonPatchException&) {
+                throw;
+            } catch (const std::exception& e) {
+                throw JsonPatchException(i, e.what());
+            }
+        }
+    }
+
+    // NOLINTBEGIN(readability-function-size)
+    static void apply_operation(JsonDocument& target, const JsonDocument& operation) {
+        if (!operation.is_object()) {
+            throw std::runtime_error("operation must be an object");
+        }
+        std::string op = member_string(operation, "op");
+        std::string path = member_string(operation, "path");
+
+        if (op == "add") {
+            add(target, path, member_value(operation));
+        } else if (op == "remove") {
+            if (!target.remove_at(path)) {
+                throw JsonPointerNotFoundException(path);
+            }
+        } else if (op == "replace") {
+            if (!target.exists(path)) {
+                throw JsonPointerNotFoundException(path);
+            }
+            target.set_at(path, member_value(operation));
+        } else if (op == "move") {
+            std::string from = member_string(operation, "from");
+            if (from == path) {
+                return;
+            }
+            if (JsonPointer::is_prefix(from, path)) {
+                throw std::runtime_error("cannot move '" + from + "' into its own child '"
+                                         + path + "'");
+            }
+            add(target, path, target.extract_at(from));
+        } else if (op == "copy") {
+            std::string from = member_string(operation, "from");
+            add(target, path, target.at(from));
+        } else if (op == "test") {
+            if (!(target.at(path) == member_value(operation))) {
+                throw std::runtime_error("test failed at '" + path + "'");
+            }
+        } else {
+            throw std::runtime_error("unknown op '" + op + "'");
+        }
+    }
+    // NOLINTEND(readability-function-size)
+
+private:
+    static auto member_string(const JsonDocument& operation, const std::string& name)
+        -> std::string {
+        if (!operation.contains(name) || !operation[name].is_string()) {
+            throw std::runtime_error("missing string member '" + name + "'");
+        }
+        return operation[name].as<std::string>();
+    }
+
+    static auto member_value(const JsonDocument& operation) -> JsonDocument {
+        if (!operation.contains("value")) {
+            throw std::runtime_error("missing member 'value'");
+        }
+        return operation["value"];
+    }
+
+    // RFC 6902 "add": objects set the member, arrays insert before the index ("-" appends)
+    static void add(JsonDocument& target, const std::string& path, JsonDocument value) {
+        if (path.empty()) {
+            target = std::move(value);
+            return;
+        }
+        std::string parent_path = JsonPointer::get_parent(path);
+        std::string key = JsonPointer::get_last_segment(path);
+        JsonDocument& parent = parent_path.empty() ? target : target.at(parent_path);
+
+        if (parent.is_object()) {
+            parent.set(std::move(key), std::move(value));
+        } else if (parent.is_array()) {
+            if (key == "-") {
+                parent.push_back(std::move(value));
+            } else {
+                parent.insert(JsonPointer::to_array_index(key), std::move(value));
+            }
+        } else {
+            throw JsonPointerTypeException(path, "object or array", "scalar");
+        }
+    }
+};
+
+} // namespace jsom
@@ -2,9 +2,10 @@
 
 #include "constants.hpp"
 #include <algorithm>
-#include <sstream>
+#include <charconv>
 #include <stdexcept>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace jsom {
@@ -140,23 +141,33 @@ public:
         return result;
     }
 
-    // Validate JSON Pointer format
+    // Validate JSON Pointer format without parsing it into segments. Accepts exactly what
+    // parse() accepts: a ~ must be followed by 0 or 1 unless it ends its segment.
     static auto is_valid(const std::string& pointer) -> bool {
-        try {
-            parse(pointer);
+        if (pointer.empty()) {
             return true;
-        } catch (const JsonPointerException&) {
+        }
+        if (pointer[0] != '/') {
             return false;
         }
+        for (size_t i = pointer.find('~'); i != std::string::npos; i = pointer.find('~', i + 1)) {
+            if (i + 1 < pointer.length() && pointer[i + 1] != '0' && pointer[i + 1] != '1'
+                && pointer[i + 1] != '/') {
+                return false;
+            }
+        }
+        return true;
     }
 
     // Validate and throw if invalid
     static void validate(const std::string& pointer) {
-        parse(pointer); // Will throw if invalid
+        if (!is_valid(pointer)) {
+            parse(pointer); // Throws with the specific problem
+        }
     }
 
     // Check if pointer is array index
-    static auto is_array_index(const std::string& segment) -> bool {
+    static auto is_array_index(std::string_view segment) -> bool {
         if (segment.empty()) {
             return false;
         }
@@ -173,16 +184,25 @@ public:
     }
 
     // Convert segment to array index
-    static auto to_array_index(const std::string& segment) -> size_t {
+    static auto to_array_index(std::string_view segment) -> size_t {
         if (!is_array_index(segment)) {
-            throw InvalidJsonPointerException(segment, "not a valid array index");
+            throw InvalidJsonPointerException(std::string(segment), "not a valid array index");
         }
 
-        try {
-            return std::stoull(segment);
-        } catch (const std::exception&) {
-            throw InvalidJsonPointerException(segment, "array index out of range");
+        size_t index = 0;
+        if (!parse_array_index(segment, index)) {
+            throw InvalidJsonPointerException(std::string(segment), "array index out of range");
+        }
+        return index;
+    }
+
+    // Non-throwing to_array_index(): false when the segment is not an index or overflows
+    static auto parse_array_index(std::string_view segment, size_t& index) -> bool {
+        if (!is_array_index(segment)) {
+            return false;
         }
+        auto [end, error] = std::from_chars(segment.data(), segment.data() + segment.size(), index);
+        return error == std::errc();
     }
 
     // Get parent pointer
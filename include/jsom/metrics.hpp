@@ -0,0 +1,170 @@
+#pragma once
+
+#include "constants.hpp"
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+
+// Process-wide counters for parse, serialize, path cache and LazyNumber activity. Configure
+// with -DJSOM_ENABLE_METRICS=ON (which defines JSOM_ENABLE_METRICS) to count inside JSOM;
+// without it the hooks compile to nothing and snapshots stay at zero.
+//
+//   auto before = jsom::metrics::snapshot();
+//   ...
+//   auto delta = jsom::metrics::snapshot() - before;
+//   for (auto counter : jsom::metrics::ALL_COUNTERS) {
+//       export_gauge(jsom::metrics::counter_name(counter), delta[counter]);
+//   }
+//
+// Counters are relaxed atomics sharded by thread, so concurrent parsers do not contend on
+// one cache line; a snapshot sums the shards.
+
+namespace jsom {
+namespace metrics {
+
+enum class Counter : std::uint8_t {
+    DocumentsParsed,       // Successful FastParser::parse calls
+    BytesParsed,           // Input bytes handed to the parser, including failed parses
+    ParseErrors,           // Parses that threw
+    SerializeBytes,        // Output of to_json() and JsonFormatter::format
+    PathCacheHits,         // PathCache::get_exact found the path
+    PathCacheMisses,       // PathCache::get_exact did not
+    PathCacheEvictions,    // Exact entries evicted plus prefix entries pruned
+    EpochInvalidations,    // A PathCache was cleared because some document was mutated
+    LazyNumberConversions, // Numbers converted from their text on first access
+};
+
+constexpr std::size_t COUNTER_COUNT = 9;
+
+constexpr std::array<Counter, COUNTER_COUNT> ALL_COUNTERS = {
+    Counter::DocumentsParsed,    Counter::BytesParsed,     Counter::ParseErrors,
+    Counter::SerializeBytes,     Counter::PathCacheHits,   Counter::PathCacheMisses,
+    Counter::PathCacheEvictions, Counter::EpochInvalidations, Counter::LazyNumberConversions};
+
+#ifdef JSOM_ENABLE_METRICS
+constexpr bool ENABLED = true;
+#else
+constexpr bool ENABLED = false;
+#endif
+
+// Stable snake_case name for export
+inline auto counter_name(Counter counter) -> const char* {
+    switch (counter) {
+    case Counter::DocumentsParsed:
+        return "documents_parsed";
+    case Counter::BytesParsed:
+        return "bytes_parsed";
+    case Counter::ParseErrors:
+        return "parse_errors";
+    case Counter::SerializeBytes:
+        return "serialize_bytes";
+    case Counter::PathCacheHits:
+        return "path_cache_hits";
+    case Counter::PathCacheMisses:
+        return "path_cache_misses";
+    case Counter::PathCacheEvictions:
+        return "path_cache_evictions";
+    case Counter::EpochInvalidations:
+        return "epoch_invalidations";
+    case Counter::LazyNumberConversions:
+        return "lazy_number_conversions";
+    }
+    return "unknown";
+}
+
+struct Snapshot {
+    std::array<std::uint64_t, COUNTER_COUNT> values{};
+
+    auto operator[](Counter counter) const -> std::uint64_t {
+        return values[static_cast<std::size_t>(counter)];
+    }
+};
+
+// Activity between two snapshots
+inline auto operator-(const Snapshot& after, const Snapshot& before) -> Snapshot {
+    Snapshot delta;
+    for (std::size_t i = 0; i < COUNTER_COUNT; ++i) {
+        delta.values[i] = after.values[i] - before.values[i];
+    }
+    return delta;
+}
+
+namespace detail {
+
+struct alignas(metrics_constants::CACHE_LINE_SIZE) Shard {
+    std::array<std::atomic<std::uint64_t>, COUNTER_COUNT> counts{};
+};
+
+inline auto shards() -> std::array<Shard, metrics_constants::SHARD_COUNT>& {
+    static std::array<Shard, metrics_constants::SHARD_COUNT> registry;
+    return registry;
+}
+
+inline auto shard_index() -> std::size_t {
+    static std::atomic<std::size_t> next_thread{0};
+    thread_local std::size_t index
+        = next_thread.fetch_add(1, std::memory_order_relaxed) % metrics_constants::SHARD_COUNT;
+    return index;
+}
+
+} // namespace detail
+
+inline void add(Counter counter, std::uint64_t amount = 1) {
+    detail::shards()[detail::shard_index()]
+        .counts[static_cast<std::size_t>(counter)]
+        .fetch_add(amount, std::memory_order_relaxed);
+}
+
+// Sum of all shards; counters updated concurrently may be caught mid-way
+inline auto snapshot() -> Snapshot {
+    Snapshot result;
+    for (const auto& shard : detail::shards()) {
+        for (std::size_t i = 0; i < COUNTER_COUNT; ++i) {
+            result.values[i] += shard.counts[i].load(std::memory_order_relaxed);
+        }
+    }
+    return result;
+}
+
+// Zero every counter; prefer snapshot differences while other threads are counting
+inline void reset() {
+    for (auto& shard : detail::shards()) {
+        for (auto& count : shard.counts) {
+            count.store(0, std::memory_order_relaxed);
+        }
+    }
+}
+
+// Adds one to `counter` if its scope is left by an exception
+class ThrowCounter {
+public:
+    explicit ThrowCounter(Counter counter)
+        : counter_(counter), exceptions_(std::uncaught_exceptions()) {}
+    ThrowCounter(const ThrowCounter&) = delete;
+    auto operator=(const ThrowCounter&) -> ThrowCounter& = delete;
+    ThrowCounter(ThrowCounter&&) = delete;
+    auto operator=(ThrowCounter&&) -> ThrowCounter& = delete;
+    ~ThrowCounter() {
+        if (std::uncaught_exceptions() > exceptions_) {
+            add(counter_);
+        }
+    }
+
+private:
+    Counter counter_;
+    int exceptions_;
+};
+
+} // namespace metrics
+} // namespace jsom
+
+// Hooks used inside JSOM; arguments are not evaluated when metrics are compiled out
+#ifdef JSOM_ENABLE_METRICS
+#define JSOM_METRIC_ADD(counter, amount) ::jsom::metrics::add((counter), (amount))
+#define JSOM_METRIC_COUNT_THROW(name, counter) ::jsom::metrics::ThrowCounter name((counter))
+#else
+#define JSOM_METRIC_ADD(counter, amount) ((void)0)
+#define JSOM_METRIC_COUNT_THROW(name, counter) static_assert(true, "")
+#endif
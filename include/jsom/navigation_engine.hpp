@@ -3,7 +3,11 @@
 #include "json_document.hpp"
 #include "json_pointer.hpp"
 #include "path_cache.hpp"
+#include "trace_hooks.hpp"
+#include <algorithm>
+#include <cstdint>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace jsom {
@@ -14,45 +18,50 @@ struct NavigationResult {
     std::vector<std::pair<std::string, JsonDocument*>> intermediate_nodes;
     bool cache_hit{false};
     size_t steps_navigated{0};
+    size_t missing_prefix_length{0}; // When target is null: length of the pointer prefix
+                                     // naming the first node that does not exist
+    bool in_shared_value{false};     // Target lies inside a value shared by deduplicate()
 
     NavigationResult() = default;
 };
 
-// Core navigation engine with prefix optimization
+// Core navigation engine with prefix optimization.
+//
+// Path caches never hold a node inside a value shared by JsonDocument::deduplicate(), since a
+// change through such a pointer would reach every holder. Read walks step into shared values
+// but cache nothing past them; write walks copy each shared value they pass through
+// (copy-on-write), so all they reach is the document's own.
 class NavigationEngine {
 public:
-    // Navigate to JSON Pointer with caching
-    static auto navigate_with_cache(JsonDocument* root, const std::string& json_pointer,
-                                    PathCache& cache) -> NavigationResult {
+    enum class Access : std::uint8_t {
+        Read, // The caller only reads the result
+        Write // The caller may change the result: shared values on the way are copied
+    };
 
+    // Navigate to JSON Pointer with caching. Throws InvalidJsonPointerException for a
+    // malformed pointer and JsonPointerNotFoundException for a missing node.
+    static auto navigate_with_cache(JsonDocument* root, const std::string& json_pointer,
+                                    PathCache& cache, Access access = Access::Read)
+        -> NavigationResult {
         // Validate pointer
         JsonPointer::validate(json_pointer);
 
-        NavigationResult result;
-
-        // Try exact cache first
-        if (auto* cached = cache.get_exact(json_pointer)) {
-            result.target = cached;
-            result.cache_hit = true;
-            result.steps_navigated = 0;
-            return result;
-        }
-
-        // Find best cached prefix
-        auto [start_node, remaining_path] = cache.find_best_prefix(json_pointer);
-        if (start_node == nullptr) {
-            start_node = root;
+        auto result = navigate_valid_with_cache(root, json_pointer, cache, access);
+        if (result.target == nullptr) {
+            throw JsonPointerNotFoundException(
+                json_pointer.substr(0, result.missing_prefix_length));
         }
+        return result;
+    }
 
-        // Navigate remaining path
-        result = navigate_and_cache_intermediate(start_node, remaining_path, json_pointer, cache);
-
-        // Cache final result
-        if (result.target != nullptr) {
-            cache.put_exact(json_pointer, result.target);
+    // Exception-free lookup: nullptr for a malformed pointer or a missing node
+    static auto find_with_cache(JsonDocument* root, const std::string& json_pointer,
+                                PathCache& cache, Access access = Access::Read)
+        -> JsonDocument* {
+        if (!JsonPointer::is_valid(json_pointer)) {
+            return nullptr;
         }
-
-        return result;
+        return navigate_valid_with_cache(root, json_pointer, cache, access).target;
     }
 
     // Navigate without caching (for internal use)
@@ -78,18 +87,14 @@ public:
     // Check if path exists
     static auto exists(JsonDocument* root, const std::string& json_pointer, PathCache& cache)
         -> bool {
-        try {
-            auto result = navigate_with_cache(root, json_pointer, cache);
-            return result.target != nullptr;
-        } catch (const JsonPointerException&) {
-            return false; // Path not found
-        }
+        return find_with_cache(root, json_pointer, cache) != nullptr;
     }
 
     // Batch navigation for multiple paths (optimized)
     // NOLINTBEGIN(readability-function-size)
     static auto navigate_multiple(JsonDocument* root, const std::vector<std::string>& paths,
-                                  PathCache& cache) -> std::vector<JsonDocument*> {
+                                  PathCache& cache, Access access = Access::Read)
+        -> std::vector<JsonDocument*> {
 
         std::vector<JsonDocument*> results;
         results.reserve(paths.size());
@@ -110,7 +115,7 @@ public:
         sorted_results.reserve(paths.size());
 
         for (const auto& [path, _] : sorted_paths) {
-            auto result = navigate_with_cache(root, path, cache);
+            auto result = navigate_with_cache(root, path, cache, access);
             sorted_results.push_back(result.target);
         }
 
@@ -126,12 +131,46 @@ public:
     // NOLINTEND(readability-function-size)
 
 private:
+    // Cached navigation of an already validated pointer; a missing node gives a null target
+    static auto navigate_valid_with_cache(JsonDocument* root, const std::string& json_pointer,
+                                          PathCache& cache, Access access) -> NavigationResult {
+        JSOM_TRACE_SPAN(span, trace::SpanKind::Navigate, json_pointer.size());
+
+        NavigationResult result;
+
+        // Try exact cache first
+        if (auto* cached = cache.get_exact(json_pointer)) {
+            result.target = cached;
+            result.cache_hit = true;
+            result.steps_navigated = 0;
+            return result;
+        }
+
+        // Find best cached prefix
+        auto [start_node, remaining_path] = cache.find_best_prefix(json_pointer);
+        if (start_node == nullptr) {
+            start_node = root;
+        }
+
+        // Navigate remaining path
+        result = navigate_and_cache_intermediate(start_node, remaining_path, json_pointer, cache,
+                                                 access);
+
+        // Cache final result
+        if (result.target != nullptr && !result.in_shared_value) {
+            cache.put_exact(json_pointer, result.target);
+        }
+
+        span.set_nodes(result.steps_navigated);
+        return result;
+    }
+
     // Navigate remaining path and cache intermediate steps
     // NOLINTBEGIN(readability-function-size)
     static auto navigate_and_cache_intermediate(JsonDocument* start_node,
                                                 const std::string& remaining_path,
-                                                const std::string& full_path, PathCache& cache)
-        -> NavigationResult {
+                                                const std::string& full_path, PathCache& cache,
+                                                Access access) -> NavigationResult {
 
         NavigationResult result;
         result.target = start_node;
@@ -140,7 +179,6 @@ private:
             return result; // Already at target
         }
 
-        auto segments = JsonPointer::parse(remaining_path);
         JsonDocument* current = start_node;
 
         // Calculate base path (prefix that was already cached)
@@ -157,25 +195,41 @@ private:
         }
 
         std::string current_path = base_path;
-
-        for (size_t i = 0; i < segments.size(); ++i) {
-            const auto& segment = segments[i];
+        std::string unescaped;
+
+        // Segments are views into the (validated) pointer; only escaped ones are copied
+        size_t pos = 0;
+        while (pos < remaining_path.size()) {
+            size_t next = std::min(remaining_path.find('/', pos + 1), remaining_path.size());
+            std::string_view segment(remaining_path.data() + pos + 1, next - pos - 1);
+            if (segment.find('~') != std::string_view::npos) {
+                unescaped = JsonPointer::unescape_segment(std::string(segment));
+                segment = unescaped;
+            }
 
             // Build current path
-            current_path += "/" + JsonPointer::escape_segment(segment);
-
-            // Navigate one step
-            current = navigate_single_step(current, segment);
+            current_path.append(remaining_path, pos, next - pos);
+
+            // Navigate one step; a read past a shared value leaves the document's own storage
+            if (access == Access::Write) {
+                current = navigate_single_step(current, segment);
+            } else {
+                result.in_shared_value = result.in_shared_value || current->is_shared();
+                current = read_single_step(current, segment);
+            }
             if (current == nullptr) {
-                throw JsonPointerNotFoundException(current_path);
+                result.target = nullptr;
+                result.missing_prefix_length = current_path.size(); // A prefix of full_path
+                return result;
             }
 
             // Cache intermediate step (but not the final result - that's handled by caller)
-            if (i < segments.size() - 1) {
+            if (next < remaining_path.size() && !result.in_shared_value) {
                 result.intermediate_nodes.emplace_back(current_path, current);
             }
 
             result.steps_navigated++;
+            pos = next;
         }
 
         // Cache all intermediate steps
@@ -186,50 +240,68 @@ private:
     }
     // NOLINTEND(readability-function-size)
 
-    // Navigate a single step (one segment)
+    // One step of a read walk: reads a value shared by JsonDocument::deduplicate() in place,
+    // so the result may point into it
+    static auto read_single_step(JsonDocument* current, std::string_view segment)
+        -> JsonDocument* {
+        if (current->is_object()) {
+            return const_cast<JsonDocument*>(std::as_const(*current).find_member(segment));
+        }
+        if (current->is_array()) {
+            size_t index = 0;
+            if (!JsonPointer::parse_array_index(segment, index)) {
+                return nullptr;
+            }
+            const auto& arr = std::get<std::vector<JsonDocument>>(current->storage());
+            return index < arr.size() ? const_cast<JsonDocument*>(&arr[index]) : nullptr;
+        }
+        return nullptr;
+    }
+
+public:
+    // Navigate a single step (one segment) for a caller that may change the result; nullptr
+    // when it does not exist. A shared value at `current` is copied into it first.
     // NOLINTBEGIN(readability-function-size)
-    static auto navigate_single_step(JsonDocument* current, const std::string& segment)
+    static auto navigate_single_step(JsonDocument* current, std::string_view segment)
         -> JsonDocument* {
         if (current == nullptr) {
             return nullptr;
         }
 
-        try {
-            if (current->is_object()) {
-                // Object access
-                auto& obj = std::get<std::map<std::string, JsonDocument>>(current->storage_);
-                // NOLINTNEXTLINE(readability-identifier-length)
-                auto it = obj.find(segment);
-                if (it != obj.end()) {
-                    return &it->second;
-                }
-                return nullptr; // Key not found
+        if (current->is_object()) {
+            return current->find_member(segment); // nullptr when the key is not found
+        }
+        if (current->is_array()) {
+            // Array access
+            size_t index = 0;
+            if (!JsonPointer::parse_array_index(segment, index)) {
+                return nullptr; // Not an index, or too large for size_t
             }
-            if (current->is_array()) {
-                // Array access
-                if (!JsonPointer::is_array_index(segment)) {
-                    return nullptr; // Invalid array index
-                }
-
-                size_t index = JsonPointer::to_array_index(segment);
-                auto& arr = std::get<std::vector<JsonDocument>>(current->storage_);
 
-                if (index >= arr.size()) {
-                    return nullptr; // Index out of bounds
-                }
-
-                return &arr[index];
+            auto& arr = std::get<std::vector<JsonDocument>>(current->own_storage());
+            if (index >= arr.size()) {
+                return nullptr; // Index out of bounds
+            }
 
-            } // Cannot navigate into primitive types
-            return nullptr;
+            return &arr[index];
 
-        } catch (const std::exception&) {
-            return nullptr; // Navigation failed
-        }
+        } // Cannot navigate into primitive types
+        return nullptr;
     }
     // NOLINTEND(readability-function-size)
 
 public:
+    // Walk the first `count` already-parsed segments without touching any cache, for
+    // mutations that invalidate the cache anyway. Returns nullptr when a step is missing.
+    static auto navigate_segments(JsonDocument* root, const std::vector<std::string>& segments,
+                                  size_t count) -> JsonDocument* {
+        JsonDocument* current = root;
+        for (size_t i = 0; i < count && current != nullptr; ++i) {
+            current = navigate_single_step(current, segments[i]);
+        }
+        return current;
+    }
+
     // Utility: Enumerate all paths in a document
     static auto enumerate_paths(const JsonDocument& root, int max_depth = -1,
                                 const std::string& prefix = "") -> std::vector<std::string> {
@@ -253,13 +325,12 @@ private:
         }
 
         if (node.is_object()) {
-            const auto& obj = std::get<std::map<std::string, JsonDocument>>(node.storage_);
-            for (const auto& [key, value] : obj) {
+            for (const auto& [key, value] : node.members()) {
                 std::string child_path = current_path + "/" + JsonPointer::escape_segment(key);
                 enumerate_paths_recursive(value, child_path, paths, current_depth + 1, max_depth);
             }
         } else if (node.is_array()) {
-            const auto& arr = std::get<std::vector<JsonDocument>>(node.storage_);
+            const auto& arr = std::get<std::vector<JsonDocument>>(node.storage());
             for (size_t i = 0; i < arr.size(); ++i) {
                 std::string child_path = current_path + "/" + std::to_string(i);
                 enumerate_paths_recursive(arr[i], child_path, paths, current_depth + 1, max_depth);
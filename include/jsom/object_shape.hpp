@@ -0,0 +1,145 @@
+#pragma once
+
+#include "constants.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace jsom {
+
+// The sorted keys of an object stored as a ShapedObject. One shape is shared by every object
+// with the same keys, so each of them keeps only its values; immutable once built, so
+// documents on different threads can share it.
+class ObjectShape {
+public:
+    static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+    // `keys` must be sorted and unique
+    explicit ObjectShape(std::vector<std::string> keys) : keys_(std::move(keys)) {}
+
+    auto keys() const -> const std::vector<std::string>& { return keys_; }
+    auto size() const -> std::size_t { return keys_.size(); }
+
+    // Position of `key` among the keys, which is also the position of its value; npos when
+    // the shape has no such key
+    auto slot(std::string_view key) const -> std::size_t {
+        // NOLINTNEXTLINE(readability-identifier-length)
+        auto it = std::lower_bound(keys_.begin(), keys_.end(), key,
+                                   [](const std::string& entry, std::string_view wanted) {
+                                       return std::string_view(entry) < wanted;
+                                   });
+        if (it == keys_.end() || *it != key) {
+            return npos;
+        }
+        return static_cast<std::size_t>(it - keys_.begin());
+    }
+
+private:
+    std::vector<std::string> keys_;
+};
+
+// Hidden-class transitions: one node per key sequence the parser has met, each reached from
+// its parent by the next key. Objects whose keys arrive in the same order walk the same path
+// and end on the same node, whose shape is built once; finding it costs one key comparison
+// per member instead of building and comparing key lists. Bounded by
+// parser_constants::SHAPE_MAX_KEYS, SHAPE_MAX_TRANSITIONS and SHAPE_MAX_NODES: past them
+// objects are parsed into plain maps, and a transition or node limit marks the set full()
+// so its owner can start over.
+class ShapeTransitions {
+public:
+    struct Node {
+        std::string key;      // Last key of the sequence; empty at the root
+        Node* parent;         // nullptr at the root
+        std::size_t depth;    // Keys in the sequence
+        std::vector<std::unique_ptr<Node>> children;
+        std::shared_ptr<const ObjectShape> shape; // Built for the first object ending here
+        std::vector<std::uint32_t> order;         // Arrival position of each shape slot's key
+        bool repeats_key = false;                 // The sequence has a key twice: no shape
+    };
+
+    // The root is allocated on first use, so workspaces that never share shapes (every
+    // parse_document() without share_object_shapes) cost no allocation
+    ShapeTransitions() = default;
+
+    auto root() -> Node* {
+        if (root_ == nullptr) {
+            root_.reset(new Node{std::string(), nullptr, 0, {}, nullptr, {}, false});
+        }
+        return root_.get();
+    }
+    auto node_count() const -> std::size_t { return node_count_; }
+    // A new key sequence was refused for lack of room (not for its length)
+    auto full() const -> bool { return full_; }
+
+    // The node after `node` for `key`; nullptr when the limits rule out a new one
+    auto next(Node* node, std::string_view key) -> Node* {
+        for (auto& child : node->children) {
+            if (child->key == key) {
+                return child.get();
+            }
+        }
+        if (node->depth >= parser_constants::SHAPE_MAX_KEYS) {
+            return nullptr;
+        }
+        if (node->children.size() >= parser_constants::SHAPE_MAX_TRANSITIONS
+            || node_count_ >= parser_constants::SHAPE_MAX_NODES) {
+            full_ = true;
+            return nullptr;
+        }
+        node->children.push_back(std::unique_ptr<Node>(
+            new Node{std::string(key), node, node->depth + 1, {}, nullptr, {}, false}));
+        ++node_count_;
+        return node->children.back().get();
+    }
+
+    // Shape of the objects whose keys arrive as the sequence ending at `node`; nullptr when
+    // a key repeats, which only a map resolves (the last value wins)
+    static auto shape_at(Node* node) -> const std::shared_ptr<const ObjectShape>& {
+        if (node->shape == nullptr && !node->repeats_key) {
+            std::vector<std::string> keys = keys_of(node);
+            std::vector<std::string> sorted = keys;
+            std::sort(sorted.begin(), sorted.end());
+            if (std::adjacent_find(sorted.begin(), sorted.end()) != sorted.end()) {
+                node->repeats_key = true;
+            } else {
+                node->order.resize(keys.size());
+                for (std::size_t i = 0; i < keys.size(); ++i) {
+                    auto slot = std::lower_bound(sorted.begin(), sorted.end(), keys[i])
+                                - sorted.begin();
+                    node->order[static_cast<std::size_t>(slot)] = static_cast<std::uint32_t>(i);
+                }
+                node->shape = std::make_shared<const ObjectShape>(std::move(sorted));
+            }
+        }
+        return node->shape;
+    }
+
+    // The keys of the sequence ending at `node`, in arrival order
+    static auto keys_of(const Node* node) -> std::vector<std::string> {
+        std::vector<std::string> keys(node->depth);
+        for (; node->parent != nullptr; node = node->parent) {
+            keys[node->depth - 1] = node->key;
+        }
+        return keys;
+    }
+
+    // Forget every transition; shapes stay alive in the documents that use them
+    void clear() {
+        if (root_ != nullptr) {
+            root_->children.clear();
+        }
+        node_count_ = 0;
+        full_ = false;
+    }
+
+private:
+    std::unique_ptr<Node> root_;
+    std::size_t node_count_ = 0;
+    bool full_ = false;
+};
+
+} // namespace jsom
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace jsom {
+
+// Resolve a requested worker count: 0 means one per hardware thread
+inline auto resolve_thread_count(std::size_t requested) -> std::size_t {
+    if (requested != 0) {
+        return requested;
+    }
+    return std::max(1U, std::thread::hardware_concurrency());
+}
+
+// Run fn(task) for every task in [0, count) on up to `threads` worker threads. Workers
+// claim tasks from a shared counter, so uneven tasks balance themselves. The first
+// exception thrown by any task is rethrown on the calling thread after all workers stop.
+template <typename Fn> void parallel_for(std::size_t count, std::size_t threads, Fn&& fn) {
+    threads = std::max<std::size_t>(1, std::min(threads, count));
+    if (threads == 1) {
+        for (std::size_t task = 0; task < count; ++task) {
+            fn(task);
+        }
+        return;
+    }
+
+    std::atomic<std::size_t> next_task{0};
+    std::exception_ptr failure;
+    std::mutex failure_mutex;
+    auto worker = [&]() {
+        for (std::size_t task = next_task++; task < count; task = next_task++) {
+            try {
+                fn(task);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(failure_mutex);
+                if (!failure) {
+                    failure = std::current_exception();
+                }
+                next_task = count; // Stop handing out work
+            }
+        }
+    };
+
+    std::vector<std::thread> workers;
+    workers.reserve(threads - 1);
+    for (std::size_t i = 1; i < threads; ++i) {
+        workers.emplace_back(worker);
+    }
+    worker(); // The calling thread works too
+    for (auto& thread : workers) {
+        thread.join();
+    }
+    if (failure) {
+        std::rethrow_exception(failure);
+    }
+}
+
+} // namespace jsom
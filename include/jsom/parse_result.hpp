@@ -0,0 +1,138 @@
+#pragma once
+
+#include "json_document.hpp"
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace jsom {
+
+// Why a parse stopped
+enum class ParseErrorCode : uint8_t {
+    None,
+    EmptyInput,              // Nothing but whitespace (and comments, when allowed)
+    UnexpectedCharacter,     // No JSON value starts with this character
+    ExpectedCharacter,       // A specific character was required, e.g. ':'
+    ExpectedKey,             // Object member that does not start with a string key
+    ExpectedObjectSeparator, // Neither ',' nor '}' after an object member
+    ExpectedArraySeparator,  // Neither ',' nor ']' after an array element
+    InvalidLiteral,          // Misspelled true, false or null
+    UnterminatedString,
+    UnterminatedComment,
+    IncompleteUnicodeEscape, // Fewer than four hex digits after \u
+    InvalidUnicodeEscape,    // Non-hex digit after \u
+    IncompleteSurrogatePair, // High surrogate not followed by another \u escape
+    InvalidSurrogatePair,    // High surrogate followed by something other than a low one
+    UnexpectedLowSurrogate,  // Low surrogate without a high surrogate before it
+    TrailingCharacters,      // Input continues after the top-level value
+};
+
+// Where and why a parse failed. Named apart from the streaming parser's ParseError event,
+// which carries a message string and a JSON Pointer instead.
+struct ParseFailure {
+    ParseErrorCode code{ParseErrorCode::None};
+    std::size_t offset{0}; // Byte offset in the input where the error was detected
+    char found{'\0'};      // Offending character, for the codes whose message names one
+    char expected{'\0'};   // Required character, for ExpectedCharacter
+
+    explicit operator bool() const { return code != ParseErrorCode::None; }
+
+    // Built only when asked for, so failed parses that are never reported stay cheap
+    // NOLINTBEGIN(readability-function-size)
+    [[nodiscard]] auto message() const -> std::string {
+        switch (code) {
+        case ParseErrorCode::None:
+            return "No error";
+        case ParseErrorCode::EmptyInput:
+            return "Empty JSON input";
+        case ParseErrorCode::UnexpectedCharacter:
+            return "Unexpected character: " + std::string(1, found);
+        case ParseErrorCode::ExpectedCharacter:
+            return "Expected '" + std::string(1, expected) + "' but got '" + std::string(1, found)
+                   + "'";
+        case ParseErrorCode::ExpectedKey:
+            return "Expected string key in object";
+        case ParseErrorCode::ExpectedObjectSeparator:
+            return "Expected ',' or '}' in object";
+        case ParseErrorCode::ExpectedArraySeparator:
+            return "Expected ',' or ']' in array";
+        case ParseErrorCode::InvalidLiteral:
+            return "Invalid literal";
+        case ParseErrorCode::UnterminatedString:
+            return "Unterminated string";
+        case ParseErrorCode::UnterminatedComment:
+            return "Unterminated block comment";
+        case ParseErrorCode::IncompleteUnicodeEscape:
+            return "Incomplete Unicode escape sequence";
+        case ParseErrorCode::InvalidUnicodeEscape:
+            return "Invalid hex digit in Unicode escape: " + std::string(1, found);
+        case ParseErrorCode::IncompleteSurrogatePair:
+            return "Incomplete surrogate pair";
+        case ParseErrorCode::InvalidSurrogatePair:
+            return "Invalid low surrogate pair";
+        case ParseErrorCode::UnexpectedLowSurrogate:
+            return "Unexpected low surrogate";
+        case ParseErrorCode::TrailingCharacters:
+            return "Unexpected characters after JSON";
+        }
+        return "Unknown parse error";
+    }
+    // NOLINTEND(readability-function-size)
+};
+
+// Thrown by parse_document() and FastParser::parse(); what() is the failure's message()
+class ParseException : public std::runtime_error {
+public:
+    explicit ParseException(const ParseFailure& error)
+        : std::runtime_error(error.message()), error_(error) {}
+
+    [[nodiscard]] auto error() const -> const ParseFailure& { return error_; }
+
+private:
+    ParseFailure error_;
+};
+
+// Outcome of try_parse_document(): the document, or the error that stopped the parse.
+// Nothing is thrown until value() is called on a failed result.
+class ParseResult {
+public:
+    explicit ParseResult(JsonDocument&& value) : value_(std::move(value)) {}
+    explicit ParseResult(const ParseFailure& error) : error_(error) {}
+
+    [[nodiscard]] auto has_value() const -> bool { return !error_; }
+    explicit operator bool() const { return has_value(); }
+    [[nodiscard]] auto error() const -> const ParseFailure& { return error_; }
+
+    // The document; throws ParseException when the parse failed
+    auto value() & -> JsonDocument& {
+        check();
+        return value_;
+    }
+    [[nodiscard]] auto value() const& -> const JsonDocument& {
+        check();
+        return value_;
+    }
+    auto value() && -> JsonDocument {
+        check();
+        return std::move(value_);
+    }
+
+    // Unchecked access; null after a failed parse
+    auto operator*() -> JsonDocument& { return value_; }
+    auto operator*() const -> const JsonDocument& { return value_; }
+    auto operator->() -> JsonDocument* { return &value_; }
+    auto operator->() const -> const JsonDocument* { return &value_; }
+
+private:
+    JsonDocument value_;
+    ParseFailure error_;
+
+    void check() const {
+        if (error_) {
+            throw ParseException(error_);
+        }
+    }
+};
+
+} // namespace jsom
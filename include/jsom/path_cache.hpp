@@ -2,6 +2,8 @@
 
 #include "constants.hpp"
 #include "json_pointer.hpp"
+#include "metrics.hpp"
+#include "trace_hooks.hpp"
 #include <algorithm>
 #include <chrono>
 #include <deque>
@@ -70,6 +72,7 @@ private:
     // potentially stale. Clear everything and resync.
     void check_epoch() const {
         if (cached_epoch_ != s_mutation_epoch_) {
+            JSOM_METRIC_ADD(metrics::Counter::EpochInvalidations, 1);
             clear();
             cached_epoch_ = s_mutation_epoch_;
         }
@@ -99,8 +102,10 @@ public:
             exact_lru_order_.push_back(path);
 
             it->second.update_access();
+            JSOM_METRIC_ADD(metrics::Counter::PathCacheHits, 1);
             return it->second.document;
         }
+        JSOM_METRIC_ADD(metrics::Counter::PathCacheMisses, 1);
         return nullptr;
     }
 
@@ -224,6 +229,9 @@ private:
     // Evict least recently used exact cache entry
     void evict_exact_lru() const {
         if (!exact_lru_order_.empty()) {
+            JSOM_TRACE_SPAN(span, trace::SpanKind::CacheEvict, 0);
+            span.set_nodes(1);
+            JSOM_METRIC_ADD(metrics::Counter::PathCacheEvictions, 1);
             const std::string& oldest = exact_lru_order_.front();
             exact_cache_.erase(oldest);
             exact_lru_order_.pop_front();
@@ -233,6 +241,8 @@ private:
     // Prune old prefix cache entries
     // NOLINTBEGIN(readability-function-size)
     void prune_old_prefixes() const {
+        JSOM_TRACE_SPAN(span, trace::SpanKind::CacheEvict, 0);
+        size_t size_before = prefix_cache_.size();
         auto now = std::chrono::steady_clock::now();
         auto cutoff = now - MAX_PREFIX_AGE;
 
@@ -264,6 +274,8 @@ private:
                 prefix_cache_.erase(access_counts[i].first);
             }
         }
+        span.set_nodes(size_before - prefix_cache_.size());
+        JSOM_METRIC_ADD(metrics::Counter::PathCacheEvictions, size_before - prefix_cache_.size());
     }
     // NOLINTEND(readability-function-size)
 
@@ -41,28 +41,29 @@ public:
             return cached_pointer_;
         }
 
-        std::vector<std::string> segments;
+        // Extend the nearest cached ancestor rather than rebuilding every segment from the
+        // root, which allocated once per level for each new node of a deep document
+        std::vector<const PathNode*> uncached;
         const PathNode* current = this;
-
-        while ((current != nullptr) && (current->parent_ != nullptr)) {
-            if (current->container_type_ == ContainerType::Object) {
-                segments.push_back(escape_json_pointer(current->key_));
-            } else {
-                segments.push_back(std::to_string(current->array_index_));
-            }
+        while ((current->parent_ != nullptr) && !current->pointer_cached_) {
+            uncached.push_back(current);
             current = current->parent_;
         }
 
-        if (segments.empty()) {
-            cached_pointer_ = "";
-        } else {
-            std::string result;
-            for (auto it = segments.rbegin(); it != segments.rend(); ++it) {
-                result += "/" + *it;
+        std::string pointer = (current->parent_ != nullptr) ? current->cached_pointer_ : "";
+        for (auto it = uncached.rbegin(); it != uncached.rend(); ++it) {
+            const PathNode* node = *it;
+            pointer += '/';
+            if (node->container_type_ == ContainerType::Object) {
+                pointer += escape_json_pointer(node->key_);
+            } else {
+                pointer += std::to_string(node->array_index_);
             }
-            cached_pointer_ = result;
+            node->cached_pointer_ = pointer;
+            node->pointer_cached_ = true;
         }
 
+        cached_pointer_ = std::move(pointer);
         pointer_cached_ = true;
         return cached_pointer_;
     }
@@ -12,6 +12,7 @@ enum class ParseState : std::uint8_t {
     Start,
     InString,
     InStringEscape,
+    InUnicodeEscape,
     InNumber,
     InLiteral,
     ExpectingColon,
@@ -25,6 +26,7 @@ struct ParseContext {
     ContainerType type;
     bool expecting_key;
     std::size_t array_index;
+    bool seen_comma{false}; // Once set, a close bracket in Start state is a trailing comma
 
     // NOLINTNEXTLINE(readability-identifier-length)
     ParseContext(PathNode* n, ContainerType t, bool key = false, std::size_t idx = 0)
@@ -42,6 +44,11 @@ private:
     std::string literal_buffer_;
     std::size_t position_;
 
+    // \uXXXX being read, and a high surrogate still waiting for its low half
+    std::uint32_t unicode_value_{0};
+    int unicode_digits_{0};
+    std::uint32_t high_surrogate_{0};
+
     PathNode* current_path_node_;
 
 public:
@@ -56,6 +63,7 @@ public:
         }
         value_buffer_.clear();
         literal_buffer_.clear();
+        high_surrogate_ = 0;
         position_ = 0;
         path_manager_.reset();
         current_path_node_ = path_manager_.get_root();
@@ -76,6 +84,9 @@ public:
             case ParseState::InStringEscape:
                 handle_string_escape(c);
                 break;
+            case ParseState::InUnicodeEscape:
+                handle_unicode_escape(c);
+                break;
             case ParseState::InNumber:
                 handle_in_number(c);
                 break;
@@ -111,11 +122,18 @@ public:
     }
 
     void end_input() {
+        bool open_scalar = state_ == ParseState::InNumber || state_ == ParseState::InLiteral;
         if (state_ == ParseState::InNumber) {
             complete_number();
         } else if (state_ == ParseState::InLiteral) {
             complete_literal();
-        } else if (state_ != ParseState::Complete && state_ != ParseState::Start) {
+        }
+        if (state_ == ParseState::Error) {
+            return;
+        }
+        // Containers still open (`[`, `{"a": 1`) are truncated input too
+        if (!context_stack_.empty()
+            || (!open_scalar && state_ != ParseState::Complete && state_ != ParseState::Start)) {
             emit_error("Unexpected end of input");
         }
     }
@@ -137,6 +155,10 @@ private:
         case '[':
             start_array();
             break;
+        case '}':
+        case ']':
+            close_empty_container(c);
+            break;
         case 't':
         case 'f':
         case 'n':
@@ -162,6 +184,10 @@ private:
 
     // NOLINTNEXTLINE(readability-identifier-length)
     void handle_in_string(char c) {
+        if (high_surrogate_ != 0 && c != '\\') {
+            emit_error("Incomplete surrogate pair");
+            return;
+        }
         if (c == '"') {
             complete_string();
         } else if (c == '\\') {
@@ -173,6 +199,10 @@ private:
 
     // NOLINTNEXTLINE(readability-identifier-length)
     void handle_string_escape(char c) {
+        if (high_surrogate_ != 0 && c != 'u') {
+            emit_error("Incomplete surrogate pair");
+            return;
+        }
         switch (c) {
         case '"':
             value_buffer_ += '"';
@@ -199,7 +229,9 @@ private:
             value_buffer_ += '\t';
             break;
         case 'u':
-            emit_error("Unicode escape sequences not yet implemented");
+            unicode_value_ = 0;
+            unicode_digits_ = 0;
+            state_ = ParseState::InUnicodeEscape;
             return;
         default:
             emit_error("Invalid escape sequence");
@@ -208,6 +240,43 @@ private:
         state_ = ParseState::InString;
     }
 
+    // Same decoding as FastParser: surrogate pairs combine, lone surrogates are errors
+    // NOLINTNEXTLINE(readability-identifier-length)
+    void handle_unicode_escape(char c) {
+        int hex_val = detail::hex_to_int(c);
+        if (hex_val == -1) {
+            emit_error("Invalid hex digit in Unicode escape: " + std::string(1, c));
+            return;
+        }
+        unicode_value_ = (unicode_value_ << 4) | static_cast<std::uint32_t>(hex_val);
+        if (++unicode_digits_ < parser_constants::UNICODE_ESCAPE_LENGTH) {
+            return;
+        }
+
+        state_ = ParseState::InString;
+        bool is_high = unicode_value_ >= unicode_constants::HIGH_SURROGATE_START
+                       && unicode_value_ <= unicode_constants::HIGH_SURROGATE_END;
+        bool is_low = unicode_value_ >= unicode_constants::LOW_SURROGATE_START
+                      && unicode_value_ <= unicode_constants::LOW_SURROGATE_END;
+        if (high_surrogate_ != 0) {
+            if (!is_low) {
+                emit_error("Invalid low surrogate pair");
+                return;
+            }
+            detail::append_utf8(value_buffer_,
+                                unicode_constants::SURROGATE_OFFSET
+                                    + ((high_surrogate_ & unicode_constants::SURROGATE_MASK) << 10)
+                                    + (unicode_value_ & unicode_constants::SURROGATE_MASK));
+            high_surrogate_ = 0;
+        } else if (is_high) {
+            high_surrogate_ = unicode_value_;
+        } else if (is_low) {
+            emit_error("Unexpected low surrogate");
+        } else {
+            detail::append_utf8(value_buffer_, unicode_value_);
+        }
+    }
+
     // NOLINTNEXTLINE(readability-identifier-length)
     void handle_in_number(char c) {
         if ((std::isdigit(c) != 0) || c == '.' || c == 'e' || c == 'E' || c == '+' || c == '-') {
@@ -248,6 +317,7 @@ private:
             exit_container();
         } else if (c == ',') {
             ctx.expecting_key = true;
+            ctx.seen_comma = true;
             state_ = ParseState::Start;
         } else {
             emit_error("Expected ',' or '}'");
@@ -261,6 +331,7 @@ private:
             exit_container();
         } else if (c == ',') {
             ctx.array_index++;
+            ctx.seen_comma = true;
             current_path_node_ = ctx.node->get_array_child(ctx.array_index);
             state_ = ParseState::Start;
         } else {
@@ -306,6 +377,7 @@ private:
 
     void start_string() {
         value_buffer_.clear();
+        high_surrogate_ = 0;
         state_ = ParseState::InString;
     }
 
@@ -374,6 +446,23 @@ private:
         state_ = ParseState::Start;
     }
 
+    // `{}` and `[]`: the close comes straight after the open, while still in Start state
+    // NOLINTNEXTLINE(readability-identifier-length)
+    void close_empty_container(char c) {
+        if (context_stack_.empty() || context_stack_.top().seen_comma) {
+            emit_error("Unexpected character");
+            return;
+        }
+        const auto& ctx = context_stack_.top();
+        bool matches = (ctx.type == ContainerType::Object) ? (c == '}' && ctx.expecting_key)
+                                                           : (c == ']' && ctx.array_index == 0);
+        if (!matches) {
+            emit_error("Unexpected character");
+            return;
+        }
+        exit_container();
+    }
+
     void exit_container() {
         if (context_stack_.empty()) {
             emit_error("Unexpected container close");
@@ -0,0 +1,225 @@
+#pragma once
+
+#include "constants.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+// Lightweight tracing of JSOM hot paths. Configure with -DJSOM_ENABLE_TRACING=ON (which
+// defines JSOM_ENABLE_TRACING) and parse, format, to_json, cached navigation and path cache
+// eviction record timed spans into a per-thread ring buffer. Without it the hooks compile
+// to nothing; the API below still exists so callers build either way.
+//
+//   jsom::trace::set_drain_callback([](const jsom::trace::Span* spans, std::size_t count) {
+//       for (std::size_t i = 0; i < count; ++i) { /* export spans[i] */ }
+//   });
+//
+// A thread's buffer is drained to the callback when it fills up, on flush(), and when the
+// thread exits. Without a callback the buffer keeps the most recent spans (see snapshot()).
+
+namespace jsom {
+namespace trace {
+
+enum class SpanKind : std::uint8_t {
+    Parse,     // FastParser::parse: bytes of input, values parsed
+    Format,    // JsonFormatter::format: bytes of output, values formatted (incl. re-formats)
+    ToJson,    // JsonDocument::to_json(): bytes of output
+    Navigate,  // NavigationEngine::navigate_with_cache: pointer length, steps navigated
+    CacheEvict // PathCache eviction: entries evicted
+};
+
+inline auto kind_name(SpanKind kind) -> const char* {
+    switch (kind) {
+    case SpanKind::Parse:
+        return "parse";
+    case SpanKind::Format:
+        return "format";
+    case SpanKind::ToJson:
+        return "to_json";
+    case SpanKind::Navigate:
+        return "navigate";
+    case SpanKind::CacheEvict:
+        return "cache_evict";
+    }
+    return "unknown";
+}
+
+struct Span {
+    SpanKind kind = SpanKind::Parse;
+    std::uint64_t start_ns = 0;    // steady_clock time since its epoch
+    std::uint64_t duration_ns = 0;
+    std::size_t bytes = 0;
+    std::size_t nodes = 0;
+};
+
+// Receives a thread's buffered spans, oldest first. Calls are serialized across threads;
+// spans recorded inside the callback itself are dropped.
+using DrainCallback = std::function<void(const Span* spans, std::size_t count)>;
+
+#ifdef JSOM_ENABLE_TRACING
+constexpr bool ENABLED = true;
+#else
+constexpr bool ENABLED = false;
+#endif
+
+namespace detail {
+
+struct DrainState {
+    std::mutex mutex;
+    DrainCallback callback;
+    std::atomic<bool> installed{false};
+};
+
+inline auto drain_state() -> DrainState& {
+    static DrainState state;
+    return state;
+}
+
+class ThreadBuffer {
+public:
+    ThreadBuffer() = default;
+    ThreadBuffer(const ThreadBuffer&) = delete;
+    auto operator=(const ThreadBuffer&) -> ThreadBuffer& = delete;
+    ThreadBuffer(ThreadBuffer&&) = delete;
+    auto operator=(ThreadBuffer&&) -> ThreadBuffer& = delete;
+    ~ThreadBuffer() { flush(); }
+
+    void record(const Span& span) {
+        if (draining_) {
+            return;
+        }
+        if (count_ == spans_.size()) {
+            if (flush() == 0) {
+                // No callback: overwrite the oldest span
+                spans_[head_] = span;
+                head_ = (head_ + 1) % spans_.size();
+                return;
+            }
+        }
+        spans_[(head_ + count_) % spans_.size()] = span;
+        ++count_;
+    }
+
+    auto flush() -> std::size_t {
+        DrainState& state = drain_state();
+        if (count_ == 0 || draining_ || !state.installed.load(std::memory_order_acquire)) {
+            return 0;
+        }
+        contiguous();
+        std::size_t drained = count_;
+        draining_ = true;
+        {
+            std::lock_guard<std::mutex> lock(state.mutex);
+            if (state.callback) {
+                state.callback(spans_.data(), drained);
+            } else {
+                drained = 0;
+            }
+        }
+        draining_ = false;
+        if (drained > 0) {
+            count_ = 0;
+        }
+        return drained;
+    }
+
+    [[nodiscard]] auto snapshot() const -> std::vector<Span> {
+        std::vector<Span> result;
+        result.reserve(count_);
+        for (std::size_t i = 0; i < count_; ++i) {
+            result.push_back(spans_[(head_ + i) % spans_.size()]);
+        }
+        return result;
+    }
+
+    void clear() {
+        head_ = 0;
+        count_ = 0;
+    }
+
+private:
+    std::array<Span, trace_constants::RING_CAPACITY> spans_{};
+    std::size_t head_ = 0;
+    std::size_t count_ = 0;
+    bool draining_ = false;
+
+    // Rotate so the oldest span is at index 0
+    void contiguous() {
+        if (head_ != 0) {
+            std::rotate(spans_.begin(), spans_.begin() + static_cast<std::ptrdiff_t>(head_),
+                        spans_.end());
+            head_ = 0;
+        }
+    }
+};
+
+inline auto thread_buffer() -> ThreadBuffer& {
+    thread_local ThreadBuffer buffer;
+    return buffer;
+}
+
+inline auto now_ns() -> std::uint64_t {
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                          std::chrono::steady_clock::now().time_since_epoch())
+                                          .count());
+}
+
+} // namespace detail
+
+// Install the drain callback for all threads; pass nullptr to remove it. Must not be called
+// from inside the callback.
+inline void set_drain_callback(DrainCallback callback) {
+    detail::DrainState& state = detail::drain_state();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    state.installed.store(static_cast<bool>(callback), std::memory_order_release);
+    state.callback = std::move(callback);
+}
+
+// Append a span to the calling thread's buffer
+inline void record(const Span& span) { detail::thread_buffer().record(span); }
+
+// Drain the calling thread's buffer now; returns the number of spans delivered
+inline auto flush() -> std::size_t { return detail::thread_buffer().flush(); }
+
+// Spans buffered on the calling thread, oldest first
+inline auto snapshot() -> std::vector<Span> { return detail::thread_buffer().snapshot(); }
+
+// Discard the calling thread's buffered spans
+inline void clear() { detail::thread_buffer().clear(); }
+
+// Times its scope and records one span on destruction
+class ScopedSpan {
+public:
+    explicit ScopedSpan(SpanKind kind, std::size_t bytes = 0) {
+        span_.kind = kind;
+        span_.bytes = bytes;
+        span_.start_ns = detail::now_ns();
+    }
+    ScopedSpan(const ScopedSpan&) = delete;
+    auto operator=(const ScopedSpan&) -> ScopedSpan& = delete;
+    ScopedSpan(ScopedSpan&&) = delete;
+    auto operator=(ScopedSpan&&) -> ScopedSpan& = delete;
+    ~ScopedSpan() {
+        span_.duration_ns = detail::now_ns() - span_.start_ns;
+        record(span_);
+    }
+
+    void set_bytes(std::size_t bytes) { span_.bytes = bytes; }
+    void set_nodes(std::size_t nodes) { span_.nodes = nodes; }
+
+private:
+    Span span_;
+};
+
+} // namespace trace
+} // namespace jsom
+
+// NullSpan and the JSOM_TRACE_* hook macros
+#include "trace_hooks.hpp"
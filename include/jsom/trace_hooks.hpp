@@ -0,0 +1,32 @@
+#pragma once
+
+// The tracing hooks used inside JSOM. Library headers include this instead of trace.hpp,
+// so builds without JSOM_ENABLE_TRACING do not pay for <functional> and <mutex>; include
+// trace.hpp for the recording API itself.
+#ifdef JSOM_ENABLE_TRACING
+#include "trace.hpp"
+#endif
+
+#include <cstddef>
+
+namespace jsom {
+namespace trace {
+
+// Stand-in for ScopedSpan when tracing is compiled out
+struct NullSpan {
+    void set_bytes(std::size_t /*bytes*/) {}
+    void set_nodes(std::size_t /*nodes*/) {}
+};
+
+} // namespace trace
+} // namespace jsom
+
+// JSOM_TRACE_SPAN(name, kind, bytes) declares a span variable that lives to the end of the
+// enclosing scope; JSOM_TRACE_COUNT(counter) bumps a node counter only in tracing builds
+#ifdef JSOM_ENABLE_TRACING
+#define JSOM_TRACE_SPAN(name, kind, bytes) ::jsom::trace::ScopedSpan name((kind), (bytes))
+#define JSOM_TRACE_COUNT(counter) (++(counter))
+#else
+#define JSOM_TRACE_SPAN(name, kind, bytes) [[maybe_unused]] ::jsom::trace::NullSpan name
+#define JSOM_TRACE_COUNT(counter) ((void)0)
+#endif
@@ -0,0 +1,119 @@
+#include "jsom/allocation_counter.hpp"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+// Global operator new/delete replacements that count every heap allocation.
+//
+// Each block carries a small header holding its size, so frees know how many bytes they
+// release without relying on sized delete or a platform call. Counters are relaxed
+// atomics: totals are exact, but a snapshot taken while other threads allocate is only
+// approximately consistent. Over-aligned allocations (align_val_t overloads) keep the
+// standard library's implementation and are not counted.
+//
+// Counting can be switched off at run time (the jsom CLI does unless --profile is given):
+// blocks then only get the header, marked uncounted, and skip the shared counters.
+
+namespace {
+
+// Header size keeps the returned pointer aligned for any fundamental type
+constexpr std::size_t HEADER_SIZE = alignof(std::max_align_t);
+// Header of a block allocated while counting was off; its free is not counted either
+constexpr std::size_t UNCOUNTED = static_cast<std::size_t>(-1);
+
+std::atomic<bool> counting{true};
+
+std::atomic<std::size_t> allocations{0};
+std::atomic<std::size_t> deallocations{0};
+std::atomic<std::size_t> allocated_bytes{0};
+std::atomic<std::size_t> live_bytes{0};
+std::atomic<std::size_t> peak_bytes{0};
+
+auto counted_alloc(std::size_t size) noexcept -> void* {
+    void* block = std::malloc(size + HEADER_SIZE);
+    if (block == nullptr) {
+        return nullptr;
+    }
+    if (!counting.load(std::memory_order_relaxed)) {
+        *static_cast<std::size_t*>(block) = UNCOUNTED;
+        return static_cast<char*>(block) + HEADER_SIZE;
+    }
+    *static_cast<std::size_t*>(block) = size;
+
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    allocated_bytes.fetch_add(size, std::memory_order_relaxed);
+    std::size_t live = live_bytes.fetch_add(size, std::memory_order_relaxed) + size;
+    std::size_t peak = peak_bytes.load(std::memory_order_relaxed);
+    while (live > peak
+           && !peak_bytes.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {
+    }
+    return static_cast<char*>(block) + HEADER_SIZE;
+}
+
+auto counted_alloc_or_throw(std::size_t size) -> void* {
+    while (true) {
+        if (void* ptr = counted_alloc(size)) {
+            return ptr;
+        }
+        std::new_handler handler = std::get_new_handler();
+        if (handler == nullptr) {
+            throw std::bad_alloc();
+        }
+        handler();
+    }
+}
+
+void counted_free(void* ptr) noexcept {
+    if (ptr == nullptr) {
+        return;
+    }
+    void* block = static_cast<char*>(ptr) - HEADER_SIZE;
+    std::size_t size = *static_cast<std::size_t*>(block);
+    if (size != UNCOUNTED) {
+        deallocations.fetch_add(1, std::memory_order_relaxed);
+        live_bytes.fetch_sub(size, std::memory_order_relaxed);
+    }
+    std::free(block);
+}
+
+} // namespace
+
+namespace jsom {
+
+auto allocation_stats() -> AllocationStats {
+    AllocationStats stats;
+    stats.allocations = allocations.load(std::memory_order_relaxed);
+    stats.deallocations = deallocations.load(std::memory_order_relaxed);
+    stats.allocated_bytes = allocated_bytes.load(std::memory_order_relaxed);
+    stats.live_bytes = live_bytes.load(std::memory_order_relaxed);
+    stats.peak_bytes = peak_bytes.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void set_allocation_counting(bool enabled) {
+    counting.store(enabled, std::memory_order_relaxed);
+}
+
+void reset_allocation_peak() {
+    peak_bytes.store(live_bytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+}
+
+} // namespace jsom
+
+auto operator new(std::size_t size) -> void* { return counted_alloc_or_throw(size); }
+auto operator new[](std::size_t size) -> void* { return counted_alloc_or_throw(size); }
+auto operator new(std::size_t size, const std::nothrow_t& /*unused*/) noexcept -> void* {
+    return counted_alloc(size);
+}
+auto operator new[](std::size_t size, const std::nothrow_t& /*unused*/) noexcept -> void* {
+    return counted_alloc(size);
+}
+
+void operator delete(void* ptr) noexcept { counted_free(ptr); }
+void operator delete[](void* ptr) noexcept { counted_free(ptr); }
+void operator delete(void* ptr, std::size_t /*size*/) noexcept { counted_free(ptr); }
+void operator delete[](void* ptr, std::size_t /*size*/) noexcept { counted_free(ptr); }
+void operator delete(void* ptr, const std::nothrow_t& /*unused*/) noexcept { counted_free(ptr); }
+void operator delete[](void* ptr, const std::nothrow_t& /*unused*/) noexcept {
+    counted_free(ptr);
+}
@@ -1,37 +1,223 @@
 #include "jsom/jsom.hpp"
+#include "jsom/allocation_counter.hpp"
+#include "jsom/binary_snapshot.hpp"
+#include "jsom/compiled_query.hpp"
+#include "jsom/incremental_document.hpp"
+#include "jsom/json_diff.hpp"
+#include "jsom/json_patch.hpp"
 #include "jsom/json_pointer.hpp"
+#include "jsom/parallel_for.hpp"
 #include "jsom/constants.hpp"
+#include <algorithm>
+#include <array>
 #include <iostream>
 #include <fstream>
 #include <sstream>
 #include <vector>
 #include <string>
 #include <chrono>
+#include <filesystem>
 #include <iomanip>
+#include <optional>
+#include <utility>
+
+#ifdef __unix__
+#include <sys/resource.h>
+#endif
+
+#ifdef __linux__
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#else
+#include <thread>
+#endif
 
 using namespace jsom;
 
 // CLI Version
 const std::string VERSION = "1.0.0";
 
+// ================================
+// --profile support
+// ================================
+
+// Phases timed explicitly; everything else in a command counts as "process"
+// (diffing, patching, queries, ...)
+enum class ProfilePhase : std::uint8_t { Read, Parse, Navigate, Format, Write };
+constexpr std::size_t PROFILE_PHASE_COUNT = 5;
+
+struct PhaseTotals {
+    double ms = 0.0;
+    std::size_t bytes = 0;
+    AllocationStats allocations; // Only the count and byte deltas are meaningful
+};
+
+// Accumulates phase totals for the current command. Timers are used on the main thread
+// only; worker threads (query, diff) are attributed to "process".
+class Profiler {
+public:
+    static auto enabled() -> bool { return enabled_; }
+    static void enable() { enabled_ = true; }
+    static auto totals() -> std::array<PhaseTotals, PROFILE_PHASE_COUNT>& { return totals_; }
+    static auto active() -> bool& { return active_; }
+
+private:
+    static inline bool enabled_ = false;
+    static inline bool active_ = false; // A timer is running; nested timers are ignored
+    static inline std::array<PhaseTotals, PROFILE_PHASE_COUNT> totals_{};
+};
+
+// Adds the scope's wall time, allocations and `bytes` to a phase when profiling
+class ProfileTimer {
+public:
+    explicit ProfileTimer(ProfilePhase phase, std::size_t bytes = 0)
+        : phase_(phase), bytes_(bytes), counted_(Profiler::enabled() && !Profiler::active()) {
+        if (counted_) {
+            Profiler::active() = true;
+            allocations_ = allocation_stats();
+            start_ = std::chrono::steady_clock::now();
+        }
+    }
+    ProfileTimer(const ProfileTimer&) = delete;
+    auto operator=(const ProfileTimer&) -> ProfileTimer& = delete;
+    ProfileTimer(ProfileTimer&&) = delete;
+    auto operator=(ProfileTimer&&) -> ProfileTimer& = delete;
+
+    ~ProfileTimer() {
+        if (!counted_) {
+            return;
+        }
+        auto& totals = Profiler::totals()[static_cast<std::size_t>(phase_)];
+        totals.ms += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now()
+                                                               - start_)
+                         .count();
+        totals.bytes += bytes_;
+        AllocationStats delta = allocation_stats() - allocations_;
+        totals.allocations.allocations += delta.allocations;
+        totals.allocations.allocated_bytes += delta.allocated_bytes;
+        Profiler::active() = false;
+    }
+
+    void add_bytes(std::size_t bytes) { bytes_ += bytes; }
+
+private:
+    ProfilePhase phase_;
+    std::size_t bytes_;
+    bool counted_;
+    AllocationStats allocations_;
+    std::chrono::steady_clock::time_point start_;
+};
+
+// Forwards std::cout to its original buffer, timing every write as the "write" phase
+class ProfiledStreambuf : public std::streambuf {
+public:
+    explicit ProfiledStreambuf(std::streambuf* target) : target_(target) {}
+
+protected:
+    auto overflow(int_type ch) -> int_type override {
+        ProfileTimer timer(ProfilePhase::Write, traits_type::eq_int_type(ch, traits_type::eof())
+                                                    ? 0
+                                                    : 1);
+        return target_->sputc(traits_type::to_char_type(ch));
+    }
+    auto xsputn(const char* data, std::streamsize count) -> std::streamsize override {
+        ProfileTimer timer(ProfilePhase::Write, static_cast<std::size_t>(count));
+        return target_->sputn(data, count);
+    }
+    auto sync() -> int override {
+        ProfileTimer timer(ProfilePhase::Write);
+        return target_->pubsync();
+    }
+
+private:
+    std::streambuf* target_;
+};
+
+// Peak resident set size in KiB, or 0 where getrusage() is unavailable
+auto peak_rss_kib() -> long {
+#ifdef __unix__
+    rusage usage{};
+    if (getrusage(RUSAGE_SELF, &usage) == 0) {
+        return usage.ru_maxrss; // Linux reports KiB
+    }
+#endif
+    return 0;
+}
+
+// One row of the --profile table
+void print_profile_row(const std::string& name, double ms, std::size_t bytes,
+                       const AllocationStats& allocations) {
+    std::cerr << "[profile] " << std::left << std::setw(cli_constants::PROFILE_NAME_WIDTH) << name
+              << std::right << std::fixed << std::setprecision(cli_constants::PROFILE_PRECISION)
+              << std::setw(cli_constants::PROFILE_COLUMN_WIDTH) << ms;
+    if (bytes > 0 && ms > 0.0) {
+        double mib_per_s = static_cast<double>(bytes) / cli_constants::BYTES_PER_MIB
+                           / (ms / cli_constants::MS_PER_SECOND);
+        std::cerr << std::setw(cli_constants::PROFILE_COLUMN_WIDTH) << mib_per_s;
+    } else {
+        std::cerr << std::setw(cli_constants::PROFILE_COLUMN_WIDTH) << "-";
+    }
+    std::cerr << std::setw(cli_constants::PROFILE_COLUMN_WIDTH) << allocations.allocations
+              << std::setw(cli_constants::PROFILE_COLUMN_WIDTH) << allocations.allocated_bytes
+              << '\n';
+}
+
+// Print the --profile report for a command that ran for `total_ms`
+void print_profile(double total_ms, const AllocationStats& total_allocations) {
+    const std::array<std::string, PROFILE_PHASE_COUNT> names
+        = {"read", "parse", "navigate", "format", "write"};
+    const auto& totals = Profiler::totals();
+
+    std::cerr << "[profile] " << std::left << std::setw(cli_constants::PROFILE_NAME_WIDTH)
+              << "phase" << std::right << std::setw(cli_constants::PROFILE_COLUMN_WIDTH) << "ms"
+              << std::setw(cli_constants::PROFILE_COLUMN_WIDTH) << "MiB/s"
+              << std::setw(cli_constants::PROFILE_COLUMN_WIDTH) << "allocs"
+              << std::setw(cli_constants::PROFILE_COLUMN_WIDTH) << "alloc bytes" << '\n';
+
+    double process_ms = total_ms;
+    AllocationStats process_allocations = total_allocations;
+    for (std::size_t i = 0; i < PROFILE_PHASE_COUNT; ++i) {
+        print_profile_row(names[i], totals[i].ms, totals[i].bytes, totals[i].allocations);
+        process_ms -= totals[i].ms;
+        process_allocations.allocations -= totals[i].allocations.allocations;
+        process_allocations.allocated_bytes -= totals[i].allocations.allocated_bytes;
+    }
+    print_profile_row("process", std::max(0.0, process_ms), 0, process_allocations);
+
+    // Throughput of the whole command is measured against its input
+    auto input_bytes = totals[static_cast<std::size_t>(ProfilePhase::Read)].bytes;
+    print_profile_row("total", total_ms, input_bytes, total_allocations);
+
+    std::cerr << "[profile] peak heap: " << total_allocations.peak_bytes << " bytes, peak RSS: "
+              << peak_rss_kib() << " KiB" << '\n';
+}
+
 // Utility functions
 auto read_stdin() -> std::string {
+    ProfileTimer timer(ProfilePhase::Read);
     std::stringstream buffer;
     buffer << std::cin.rdbuf();
-    return buffer.str();
+    std::string content = buffer.str();
+    timer.add_bytes(content.size());
+    return content;
 }
 
 auto read_file(const std::string& filename) -> std::string {
+    ProfileTimer timer(ProfilePhase::Read);
     std::ifstream file(filename);
     if (!file.is_open()) {
         throw std::runtime_error("Cannot open file: " + filename);
     }
     std::stringstream buffer;
     buffer << file.rdbuf();
-    return buffer.str();
+    std::string content = buffer.str();
+    timer.add_bytes(content.size());
+    return content;
 }
 
 void write_file(const std::string& filename, const std::string& content) {
+    ProfileTimer timer(ProfilePhase::Write, content.size());
     std::ofstream file(filename);
     if (!file.is_open()) {
         throw std::runtime_error("Cannot write to file: " + filename);
@@ -39,6 +225,28 @@ void write_file(const std::string& filename, const std::string& content) {
     file << content;
 }
 
+// parse_document() timed as the "parse" phase
+auto profiled_parse(const std::string& json, const JsonParseOptions& options = {})
+    -> JsonDocument {
+    ProfileTimer timer(ProfilePhase::Parse, json.size());
+    return parse_document(json, options);
+}
+
+// JSON Pointer lookups, path listing and edits timed as the "navigate" phase
+template <typename Navigate> auto profiled_navigate(Navigate&& navigate) -> decltype(auto) {
+    ProfileTimer timer(ProfilePhase::Navigate);
+    return std::forward<Navigate>(navigate)();
+}
+
+// to_json() of a document or snapshot value timed as the "format" phase
+template <typename Value, typename... Options>
+auto profiled_to_json(const Value& value, const Options&... options) -> std::string {
+    ProfileTimer timer(ProfilePhase::Format);
+    std::string json = value.to_json(options...);
+    timer.add_bytes(json.size());
+    return json;
+}
+
 // Split string by delimiter
 auto split(const std::string& str, char delimiter) -> std::vector<std::string> {
     std::vector<std::string> tokens;
@@ -53,6 +261,20 @@ auto split(const std::string& str, char delimiter) -> std::vector<std::string> {
     return tokens;
 }
 
+// Binary snapshots are detected by their header, so any file argument may be either form
+auto is_snapshot_input(const std::string& input_file) -> bool {
+    return !input_file.empty() && BinarySnapshot::is_snapshot_file(input_file);
+}
+
+// Load a document for commands that need a mutable tree: JSON is parsed, binary
+// snapshots are materialized
+auto load_document(const std::string& input_file) -> JsonDocument {
+    if (is_snapshot_input(input_file)) {
+        return BinarySnapshot::open(input_file).root().to_document();
+    }
+    return profiled_parse(input_file.empty() ? read_stdin() : read_file(input_file));
+}
+
 // Dump preset settings in a readable format
 void dump_preset_settings(const jsom::JsonFormatOptions& options, const std::string& preset_name) {
     std::cout << "Preset '" << preset_name << "' configuration:\n";
@@ -126,10 +348,19 @@ COMMANDS:
     format      Format JSON with intelligent pretty printing (try --help for presets)
     validate    Validate JSON syntax and report errors
     pointer     JSON Pointer operations per RFC 6901 (try --help for subcommands)
+    query       Extract many paths from many files or NDJSON lines (CSV/TSV/NDJSON)
+    diff        Compare two documents, emitting an RFC 6902 patch or a summary
+    patch       Apply an RFC 6902 patch
+    compile     Precompile JSON into a memory-mappable binary snapshot
+    decompile   Convert a binary snapshot back to JSON
     benchmark   Performance testing and optimization
     help        Show this help message
     version     Show version information
 
+GLOBAL OPTIONS:
+    --profile   Report time, throughput and allocations per phase (read, parse,
+                process, write) plus peak heap and RSS on stderr
+
 Use 'jsom <COMMAND> --help' for more information on a specific command.
 )";
 }
@@ -141,6 +372,9 @@ void show_pointer_usage() {
 USAGE:
     jsom pointer <SUBCOMMAND> [OPTIONS] [FILE]
 
+FILE may be JSON or a binary snapshot from 'jsom compile'. Snapshots are
+navigated in place through mmap; set, remove and extract materialize them.
+
 SUBCOMMANDS:
     get <path>              Get value at JSON Pointer path
     exists <path>           Check if path exists
@@ -169,6 +403,142 @@ EXAMPLES:
 }
 // NOLINTEND(readability-function-size)
 
+// Blocks until a watched file changes. On Linux this uses inotify on the parent
+// directory, since editors often save by writing a temporary file and renaming it over
+// the original; elsewhere it polls the modification time.
+class FileWatcher {
+public:
+    explicit FileWatcher(const std::string& path) : path_(path) {
+#ifdef __linux__
+        std::filesystem::path file(path);
+        name_ = file.filename().string();
+        std::string directory = file.has_parent_path() ? file.parent_path().string() : ".";
+        fd_ = inotify_init1(IN_CLOEXEC);
+        if (fd_ < 0 || inotify_add_watch(fd_, directory.c_str(),
+                                         IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE) < 0) {
+            throw std::runtime_error("Cannot watch directory: " + directory);
+        }
+#else
+        last_write_ = modification_time();
+#endif
+    }
+
+    FileWatcher(const FileWatcher&) = delete;
+    auto operator=(const FileWatcher&) -> FileWatcher& = delete;
+    FileWatcher(FileWatcher&&) = delete;
+    auto operator=(FileWatcher&&) -> FileWatcher& = delete;
+
+    ~FileWatcher() {
+#ifdef __linux__
+        if (fd_ >= 0) {
+            close(fd_);
+        }
+#endif
+    }
+
+    void wait_for_change() {
+#ifdef __linux__
+        while (!read_events(-1)) {
+        }
+        // Coalesce the burst of events a single save produces
+        while (read_events(cli_constants::WATCH_DEBOUNCE_MS)) {
+        }
+#else
+        while (true) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(cli_constants::WATCH_POLL_MS));
+            auto current = modification_time();
+            if (current != last_write_) {
+                last_write_ = current;
+                return;
+            }
+        }
+#endif
+    }
+
+private:
+    std::string path_;
+#ifdef __linux__
+    std::string name_;
+    int fd_ = -1;
+
+    // Wait up to timeout_ms (-1 = forever) for events; true if one named our file
+    auto read_events(int timeout_ms) -> bool {
+        pollfd request{fd_, POLLIN, 0};
+        if (poll(&request, 1, timeout_ms) <= 0) {
+            return false;
+        }
+        alignas(inotify_event) std::array<char, cli_constants::WATCH_EVENT_BUFFER_SIZE> buffer{};
+        ssize_t length = read(fd_, buffer.data(), buffer.size());
+        bool matched = false;
+        for (ssize_t offset = 0; offset < length;) {
+            const auto* event = reinterpret_cast<const inotify_event*>(buffer.data() + offset);
+            if (event->len > 0 && name_ == event->name) {
+                matched = true;
+            }
+            offset += static_cast<ssize_t>(sizeof(inotify_event) + event->len);
+        }
+        return matched;
+    }
+#else
+    std::filesystem::file_time_type last_write_;
+
+    auto modification_time() const -> std::filesystem::file_time_type {
+        std::error_code error;
+        return std::filesystem::last_write_time(path_, error);
+    }
+#endif
+};
+
+// Re-run `on_update` each time `input_file` changes, keeping the previous document so
+// localized edits reparse only the affected top-level value. Status lines go to stderr
+// so stdout carries only command output. Runs until interrupted.
+template <typename OnUpdate>
+auto watch_file(const std::string& input_file, const jsom::JsonParseOptions& parse_options,
+                OnUpdate on_update) -> int {
+    using Clock = std::chrono::high_resolution_clock;
+    IncrementalDocument doc(parse_options);
+    FileWatcher watcher(input_file);
+    std::cerr << "Watching " << input_file << " (Ctrl-C to stop)\n";
+
+    bool last_failed = false;
+    for (bool first = true;; first = false) {
+        if (!first) {
+            watcher.wait_for_change();
+        }
+        std::string source;
+        try {
+            source = read_file(input_file);
+        } catch (const std::exception&) {
+            continue; // Mid-rename or deleted; wait for the next event
+        }
+        if (!first && !last_failed && source == doc.source()) {
+            continue; // Touched but unchanged
+        }
+
+        auto start = Clock::now();
+        try {
+            auto update = doc.update(std::move(source));
+            on_update(doc.document());
+            double elapsed = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+            std::cerr << "[watch] " << input_file << ": ok in " << std::fixed
+                      << std::setprecision(cli_constants::BENCHMARK_PRECISION) << elapsed << " ms";
+            if (update.incremental && update.member.empty()) {
+                std::cerr << " (unchanged)";
+            } else if (update.incremental) {
+                std::cerr << " (reparsed /" << JsonPointer::escape_segment(update.member) << ", "
+                          << update.reparsed_bytes << " bytes)";
+            } else {
+                std::cerr << " (full parse, " << update.reparsed_bytes << " bytes)";
+            }
+            std::cerr << '\n';
+            last_failed = false;
+        } catch (const std::exception& e) {
+            std::cerr << "[watch] " << input_file << ": Invalid JSON - " << e.what() << '\n';
+            last_failed = true;
+        }
+    }
+}
+
 // Format command with advanced formatting options
 auto format_command(const std::vector<std::string>& args) -> int {
     const std::string PRESET_SWITCH = "--preset=";
@@ -182,6 +552,7 @@ auto format_command(const std::vector<std::string>& args) -> int {
     std::string input_file;
     bool dump_settings = false;
     std::string preset_name = "pretty";
+    bool watch = false;
     
     // Parse arguments
     for (size_t i = 2; i < args.size(); ++i) {
@@ -215,6 +586,7 @@ CUSTOM OPTIONS:
     --intelligent-wrap  Enable intelligent array wrapping (multiple elements per line)
     --no-intelligent-wrap  Disable intelligent array wrapping
     --comments          Allow // and /* */ comments in input
+    --watch             Re-format FILE every time it is saved
 
 INSPECTION:
     --dump              Show all settings for the selected preset
@@ -286,6 +658,8 @@ EXAMPLES:
             parse_options.allow_comments = true;
         } else if (arg == "--dump") {
             dump_settings = true;
+        } else if (arg == "--watch") {
+            watch = true;
         } else if (arg[0] != '-') {
             input_file = arg;
         } else {
@@ -300,13 +674,28 @@ EXAMPLES:
         return 0;
     }
     
+    if (watch) {
+        if (input_file.empty()) {
+            std::cerr << "--watch requires a file\n";
+            return 1;
+        }
+        try {
+            return watch_file(input_file, parse_options, [&](const JsonDocument& doc) {
+                std::cout << doc.to_json(options) << std::endl;
+            });
+        } catch (const std::exception& e) {
+            std::cerr << "Error: " << e.what() << '\n';
+            return 1;
+        }
+    }
+
     try {
         // Read JSON
         std::string json = input_file.empty() ? read_stdin() : read_file(input_file);
 
         // Parse and format
-        auto doc = parse_document(json, parse_options);
-        std::cout << doc.to_json(options) << '\n';
+        auto doc = profiled_parse(json, parse_options);
+        std::cout << profiled_to_json(doc, options) << '\n';
 
         return 0;
     } catch (const std::exception& e) {
@@ -319,29 +708,56 @@ EXAMPLES:
 auto validate_command(const std::vector<std::string>& args) -> int {
     if (args.size() < 3) {
         std::cerr << "Usage: jsom validate [--comments] <file1> [file2] ...\n";
+        std::cerr << "       jsom validate [--comments] --watch <file>\n";
         return 1;
     }
 
-    bool all_valid = true;
     jsom::JsonParseOptions parse_options;
+    bool watch = false;
+    std::vector<std::string> files;
 
     for (size_t i = cli_constants::FIRST_OPTION_INDEX; i < args.size(); ++i) {
-        const auto& filename = args[i];
-        if (filename == "--help") {
+        const auto& arg = args[i];
+        if (arg == "--help") {
             std::cout << "Validate JSON files\n\n";
             std::cout << "USAGE: jsom validate [--comments] <file1> [file2] ...\n";
+            std::cout << "       jsom validate [--comments] --watch <file>\n";
             std::cout << "\nOPTIONS:\n";
             std::cout << "    --comments    Allow // and /* */ comments\n";
+            std::cout << "    --watch       Re-validate the file every time it is saved\n";
             return 0;
         }
-        if (filename == "--comments") {
+        if (arg == "--comments") {
             parse_options.allow_comments = true;
-            continue;
+        } else if (arg == "--watch") {
+            watch = true;
+        } else {
+            files.push_back(arg);
         }
+    }
 
+    if (watch) {
+        // One watcher blocks until interrupted, so further files would never be checked
+        if (files.size() != 1) {
+            std::cerr << "--watch requires exactly one file\n";
+            return 1;
+        }
+        const auto& filename = files.front();
+        try {
+            return watch_file(filename, parse_options, [&](const JsonDocument&) {
+                std::cout << filename << ": Valid JSON" << std::endl;
+            });
+        } catch (const std::exception& e) {
+            std::cerr << "Error: " << e.what() << '\n';
+            return 1;
+        }
+    }
+
+    bool all_valid = true;
+    for (const auto& filename : files) {
         try {
             std::string json = read_file(filename);
-            parse_document(json, parse_options);
+            profiled_parse(json, parse_options);
             std::cout << filename << ": Valid JSON" << '\n';
         } catch (const std::exception& e) {
             std::cerr << filename << ": Invalid JSON - " << e.what() << '\n';
@@ -355,11 +771,20 @@ auto validate_command(const std::vector<std::string>& args) -> int {
 // Pointer get subcommand
 auto pointer_get(const std::string& path, const std::string& input_file) -> int {
     try {
+        if (is_snapshot_input(input_file)) {
+            auto snapshot = BinarySnapshot::open(input_file);
+            auto value = profiled_navigate([&] { return snapshot.root().at(path); });
+            std::cout << profiled_to_json(value) << '\n';
+            return 0;
+        }
+
         std::string json = input_file.empty() ? read_stdin() : read_file(input_file);
-        auto doc = parse_document(json);
+        auto doc = profiled_parse(json);
         
-        const auto& value = doc.at(path);
-        std::cout << value.to_json() << '\n';
+        const auto& value = profiled_navigate([&]() -> const JsonDocument& {
+            return doc.at(path);
+        });
+        std::cout << profiled_to_json(value) << '\n';
         
         return 0;
     } catch (const std::exception& e) {
@@ -371,10 +796,15 @@ auto pointer_get(const std::string& path, const std::string& input_file) -> int
 // Pointer exists subcommand
 auto pointer_exists(const std::string& path, const std::string& input_file) -> int {
     try {
-        std::string json = input_file.empty() ? read_stdin() : read_file(input_file);
-        auto doc = parse_document(json);
-        
-        bool exists = doc.exists(path);
+        bool exists = false;
+        if (is_snapshot_input(input_file)) {
+            auto snapshot = BinarySnapshot::open(input_file);
+            exists = profiled_navigate([&] { return snapshot.root().find(path).has_value(); });
+        } else {
+            std::string json = input_file.empty() ? read_stdin() : read_file(input_file);
+            auto doc = profiled_parse(json);
+            exists = profiled_navigate([&] { return doc.exists(path); });
+        }
         std::cout << (exists ? "true" : "false") << '\n';
         
         return exists ? 0 : 1;
@@ -400,16 +830,17 @@ auto pointer_list(const std::vector<std::string>& args, const std::string& input
     }
     
     try {
-        std::string json = input_file.empty() ? read_stdin() : read_file(input_file);
-        auto doc = parse_document(json);
+        auto doc = load_document(input_file);
         
-        auto paths = doc.list_paths(max_depth);
+        auto paths = profiled_navigate([&] { return doc.list_paths(max_depth); });
         
         for (const auto& path : paths) {
             if (include_values && !path.empty()) {
                 try {
-                    const auto& value = doc.at(path);
-                    std::cout << path << ": " << value.to_json() << '\n';
+                    const auto& value = profiled_navigate([&]() -> const JsonDocument& {
+                        return doc.at(path);
+                    });
+                    std::cout << path << ": " << profiled_to_json(value) << '\n';
                 } catch (...) {
                     std::cout << path << '\n';
                 }
@@ -428,10 +859,9 @@ auto pointer_list(const std::vector<std::string>& args, const std::string& input
 // Pointer find subcommand
 auto pointer_find(const std::string& pattern, const std::string& input_file) -> int {
     try {
-        std::string json = input_file.empty() ? read_stdin() : read_file(input_file);
-        auto doc = parse_document(json);
+        auto doc = load_document(input_file);
         
-        auto paths = doc.find_paths(pattern);
+        auto paths = profiled_navigate([&] { return doc.find_paths(pattern); });
         
         for (const auto& path : paths) {
             std::cout << path << '\n';
@@ -447,20 +877,19 @@ auto pointer_find(const std::string& pattern, const std::string& input_file) ->
 // Pointer set subcommand
 auto pointer_set(const std::string& path, const std::string& value_str, const std::string& input_file) -> int {
     try {
-        std::string json = input_file.empty() ? read_stdin() : read_file(input_file);
-        auto doc = parse_document(json);
+        auto doc = load_document(input_file);
         
         // Try to parse value as JSON first
         JsonDocument value;
         try {
-            value = parse_document(value_str);
+            value = profiled_parse(value_str);
         } catch (...) {
             // If not valid JSON, treat as string
             value = JsonDocument(value_str);
         }
         
-        doc.set_at(path, value);
-        std::cout << doc.to_json(true) << '\n';
+        profiled_navigate([&] { doc.set_at(path, value); });
+        std::cout << profiled_to_json(doc, true) << '\n';
         
         return 0;
     } catch (const std::exception& e) {
@@ -472,16 +901,15 @@ auto pointer_set(const std::string& path, const std::string& value_str, const st
 // Pointer remove subcommand
 auto pointer_remove(const std::string& path, const std::string& input_file) -> int {
     try {
-        std::string json = input_file.empty() ? read_stdin() : read_file(input_file);
-        auto doc = parse_document(json);
+        auto doc = load_document(input_file);
         
-        bool removed = doc.remove_at(path);
+        bool removed = profiled_navigate([&] { return doc.remove_at(path); });
         if (!removed) {
             std::cerr << "Path not found: " << path << '\n';
             return 1;
         }
         
-        std::cout << doc.to_json(true) << '\n';
+        std::cout << profiled_to_json(doc, true) << '\n';
         
         return 0;
     } catch (const std::exception& e) {
@@ -493,11 +921,10 @@ auto pointer_remove(const std::string& path, const std::string& input_file) -> i
 // Pointer extract subcommand
 auto pointer_extract(const std::string& path, const std::string& input_file) -> int {
     try {
-        std::string json = input_file.empty() ? read_stdin() : read_file(input_file);
-        auto doc = parse_document(json);
+        auto doc = load_document(input_file);
         
-        auto extracted = doc.extract_at(path);
-        std::cout << extracted.to_json(true) << '\n';
+        auto extracted = profiled_navigate([&] { return doc.extract_at(path); });
+        std::cout << profiled_to_json(extracted, true) << '\n';
         
         return 0;
     } catch (const std::exception& e) {
@@ -509,17 +936,32 @@ auto pointer_extract(const std::string& path, const std::string& input_file) ->
 // Pointer bulk-get subcommand
 auto pointer_bulk_get(const std::string& paths_str, const std::string& input_file) -> int {
     try {
-        std::string json = input_file.empty() ? read_stdin() : read_file(input_file);
-        auto doc = parse_document(json);
-        
         auto paths = split(paths_str, ',');
-        auto results = doc.at_multiple(paths);
+        std::vector<std::optional<std::string>> results;
+        results.reserve(paths.size());
+
+        if (is_snapshot_input(input_file)) {
+            auto snapshot = BinarySnapshot::open(input_file);
+            auto root = snapshot.root();
+            for (const auto& path : paths) {
+                auto value = profiled_navigate([&] { return root.find(path); });
+                results.push_back(value ? std::optional(profiled_to_json(*value)) : std::nullopt);
+            }
+        } else {
+            std::string json = input_file.empty() ? read_stdin() : read_file(input_file);
+            auto doc = profiled_parse(json);
+            auto values = profiled_navigate([&] { return doc.at_multiple(paths); });
+            for (const auto* value : values) {
+                results.push_back(value != nullptr ? std::optional(profiled_to_json(*value))
+                                                   : std::nullopt);
+            }
+        }
         
         std::cout << "{" << '\n';
         for (size_t i = 0; i < paths.size(); ++i) {
             std::cout << "  \"" << paths[i] << "\": ";
-            if (results[i] != nullptr) {
-                std::cout << results[i]->to_json();
+            if (results[i]) {
+                std::cout << *results[i];
             } else {
                 std::cout << "null";
             }
@@ -537,11 +979,43 @@ auto pointer_bulk_get(const std::string& paths_str, const std::string& input_fil
     }
 }
 
+// Pointer benchmark over a binary snapshot: navigation reads the mapped file directly,
+// so there is no path cache to warm or report
+auto snapshot_benchmark(const std::string& paths_str, const std::string& input_file) -> int {
+    auto snapshot = BinarySnapshot::open(input_file);
+    auto root = snapshot.root();
+    auto paths = split(paths_str, ',');
+
+    std::cout << "Path Access Benchmarks (binary snapshot):" << '\n';
+    std::cout << std::string(cli_constants::SEPARATOR_LINE_WIDTH, '-') << '\n';
+    for (const auto& path : paths) {
+        auto start = std::chrono::high_resolution_clock::now();
+        for (int i = 0; i < cli_constants::BENCHMARK_ITERATIONS; ++i) {
+            volatile bool found = root.find(path).has_value();
+            (void)found; // Prevent optimization
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+
+        auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start);
+        double avg_ns = duration.count() / cli_constants::BENCHMARK_DIVISOR;
+
+        std::cout << std::left << std::setw(cli_constants::BENCHMARK_PATH_COLUMN_WIDTH) << path
+                  << std::right << std::setw(cli_constants::BENCHMARK_TIME_COLUMN_WIDTH)
+                  << std::fixed << std::setprecision(cli_constants::BENCHMARK_PRECISION) << avg_ns
+                  << " ns/access" << '\n';
+    }
+    return 0;
+}
+
 // Pointer benchmark subcommand
 auto pointer_benchmark(const std::string& paths_str, const std::string& input_file, bool warm_cache) -> int {
     try {
+        if (is_snapshot_input(input_file)) {
+            return snapshot_benchmark(paths_str, input_file);
+        }
+
         std::string json = input_file.empty() ? read_stdin() : read_file(input_file);
-        auto doc = parse_document(json);
+        auto doc = profiled_parse(json);
         
         auto paths = split(paths_str, ',');
         
@@ -718,7 +1192,7 @@ auto benchmark_command(const std::vector<std::string>& args) -> int {
         
         // Parse benchmark
         auto parse_start = std::chrono::high_resolution_clock::now();
-        auto doc = parse_document(json);
+        auto doc = profiled_parse(json);
         auto parse_end = std::chrono::high_resolution_clock::now();
         
         // Serialize benchmark
@@ -742,15 +1216,749 @@ auto benchmark_command(const std::vector<std::string>& args) -> int {
     }
 }
 
-auto main(int argc, char* argv[]) -> int {
-    if (argc < 2) {
-        show_usage();
+// Compile command: JSON -> binary snapshot
+// NOLINTBEGIN(readability-function-size)
+auto compile_command(const std::vector<std::string>& args) -> int {
+    jsom::JsonParseOptions parse_options;
+    std::vector<std::string> files;
+
+    for (size_t i = cli_constants::FIRST_OPTION_INDEX; i < args.size(); ++i) {
+        const auto& arg = args[i];
+        if (arg == "--help") {
+            std::cout << R"(Precompile JSON into a binary snapshot
+
+USAGE:
+    jsom compile [--comments] <input.json> <output.jsomb>
+
+A snapshot is memory-mapped and navigated in place, so 'jsom pointer' and
+'jsom decompile' can use it without parsing. Prints parse time for the JSON
+next to load time for the snapshot.
+
+OPTIONS:
+    --comments    Allow // and /* */ comments in input
+)";
+            return 0;
+        }
+        if (arg == "--comments") {
+            parse_options.allow_comments = true;
+        } else if (arg[0] != '-') {
+            files.push_back(arg);
+        } else {
+            std::cerr << "Unknown option: " << arg << "\n";
+            return 1;
+        }
+    }
+
+    if (files.size() != 2) {
+        std::cerr << "Usage: jsom compile [--comments] <input.json> <output.jsomb>\n";
         return 1;
     }
-    
-    std::vector<std::string> args(argv, argv + argc);
+
+    try {
+        using Clock = std::chrono::high_resolution_clock;
+        std::string json = read_file(files[0]);
+
+        auto parse_start = Clock::now();
+        auto doc = profiled_parse(json, parse_options);
+        auto parse_end = Clock::now();
+
+        std::string snapshot_bytes = SnapshotWriter::write(doc);
+        {
+            ProfileTimer write_timer(ProfilePhase::Write, snapshot_bytes.size());
+            std::ofstream out(files[1], std::ios::binary);
+            if (!out.is_open()) {
+                throw std::runtime_error("Cannot write to file: " + files[1]);
+            }
+            out.write(snapshot_bytes.data(), static_cast<std::streamsize>(snapshot_bytes.size()));
+        }
+
+        // Load = map the file, check the header and resolve the root: all a reader pays
+        // before it can navigate
+        auto load_start = Clock::now();
+        auto snapshot = BinarySnapshot::open(files[1]);
+        volatile auto root_type = snapshot.root().type();
+        (void)root_type;
+        auto load_end = Clock::now();
+
+        auto micros = [](auto duration) {
+            return std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+        };
+        auto parse_us = micros(parse_end - parse_start);
+        auto load_us = micros(load_end - load_start);
+
+        std::cout << "Compiled " << files[0] << " -> " << files[1] << '\n';
+        std::cout << "  JSON size:     " << json.size() << " bytes" << '\n';
+        std::cout << "  Snapshot size: " << snapshot_bytes.size() << " bytes" << '\n';
+        std::cout << "  Parse time:    " << parse_us << " us" << '\n';
+        std::cout << "  Load time:     " << load_us << " us" << '\n';
+        if (load_us > 0) {
+            std::cout << "  Speedup:       " << std::fixed
+                      << std::setprecision(cli_constants::BENCHMARK_PRECISION)
+                      << static_cast<double>(parse_us) / static_cast<double>(load_us) << "x"
+                      << '\n';
+        }
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << '\n';
+        return 1;
+    }
+}
+// NOLINTEND(readability-function-size)
+
+// Decompile command: binary snapshot -> JSON
+auto decompile_command(const std::vector<std::string>& args) -> int {
+    bool compact = false;
+    std::vector<std::string> files;
+
+    for (size_t i = cli_constants::FIRST_OPTION_INDEX; i < args.size(); ++i) {
+        const auto& arg = args[i];
+        if (arg == "--help") {
+            std::cout << "Convert a binary snapshot back to JSON\n\n";
+            std::cout << "USAGE: jsom decompile [--compact] <input.jsomb> [output.json]\n";
+            std::cout << "\nOPTIONS:\n";
+            std::cout << "    --compact    Write compact JSON straight from the snapshot\n";
+            return 0;
+        }
+        if (arg == "--compact") {
+            compact = true;
+        } else if (arg[0] != '-') {
+            files.push_back(arg);
+        } else {
+            std::cerr << "Unknown option: " << arg << "\n";
+            return 1;
+        }
+    }
+
+    if (files.empty() || files.size() > 2) {
+        std::cerr << "Usage: jsom decompile [--compact] <input.jsomb> [output.json]\n";
+        return 1;
+    }
+
+    try {
+        auto snapshot = BinarySnapshot::open(files[0]);
+        std::string json = compact ? profiled_to_json(snapshot.root())
+                                   : profiled_to_json(snapshot.root().to_document(),
+                                                      FormatPresets::Pretty);
+        if (files.size() == 2) {
+            write_file(files[1], json + '\n');
+        } else {
+            std::cout << json << '\n';
+        }
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << '\n';
+        return 1;
+    }
+}
+
+// Milliseconds elapsed since `start`, for --stats output
+auto elapsed_ms(std::chrono::high_resolution_clock::time_point start) -> double {
+    return std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now()
+                                                     - start)
+        .count();
+}
+
+enum class DiffOutputFormat : std::uint8_t { Patch, Ndjson, Summary };
+
+// Diff command: structural comparison emitting RFC 6902 operations
+// NOLINTBEGIN(readability-function-size)
+auto diff_command(const std::vector<std::string>& args) -> int {
+    const std::string FORMAT_SWITCH = "--format=";
+    const std::string THREADS_SWITCH = "--threads=";
+    DiffOutputFormat format = DiffOutputFormat::Patch;
+    DiffOptions diff_options;
+    bool show_stats = false;
+    std::vector<std::string> files;
+
+    for (size_t i = cli_constants::FIRST_OPTION_INDEX; i < args.size(); ++i) {
+        const auto& arg = args[i];
+        if (arg == "--help") {
+            std::cout << R"(Compare two JSON documents
+
+USAGE:
+    jsom diff [OPTIONS] <from.json> <to.json>
+
+Emits the RFC 6902 patch that turns <from> into <to>. Identical subtrees are
+detected by hash and skipped; top-level members are compared in parallel.
+Exits 0 if the documents are equal, 1 if they differ, 2 on error.
+
+OPTIONS:
+    --format=patch      RFC 6902 JSON array, one operation per line (default)
+    --format=ndjson     One operation object per line, no enclosing array
+    --format=summary    One "+ path", "- path" or "~ path" line per change
+    --threads=<n>       Worker threads (default: hardware concurrency)
+    --stats             Print timings to stderr
+
+EXAMPLES:
+    jsom diff nightly-01.json nightly-02.json > changes.patch.json
+    jsom diff --format=summary --stats old.json new.json
+)";
+            return 0;
+        }
+        if (arg.substr(0, FORMAT_SWITCH.length()) == FORMAT_SWITCH) {
+            std::string value = arg.substr(FORMAT_SWITCH.length());
+            if (value == "patch") {
+                format = DiffOutputFormat::Patch;
+            } else if (value == "ndjson") {
+                format = DiffOutputFormat::Ndjson;
+            } else if (value == "summary") {
+                format = DiffOutputFormat::Summary;
+            } else {
+                std::cerr << "Unknown diff format: " << value << " (use patch, ndjson or summary)\n";
+                return cli_constants::DIFF_EXIT_ERROR;
+            }
+        } else if (arg.substr(0, THREADS_SWITCH.length()) == THREADS_SWITCH) {
+            diff_options.threads = std::stoul(arg.substr(THREADS_SWITCH.length()));
+        } else if (arg == "--stats") {
+            show_stats = true;
+        } else if (arg[0] != '-') {
+            files.push_back(arg);
+        } else {
+            std::cerr << "Unknown option: " << arg << "\n";
+            return cli_constants::DIFF_EXIT_ERROR;
+        }
+    }
+
+    if (files.size() != 2) {
+        std::cerr << "Usage: jsom diff [OPTIONS] <from.json> <to.json>\n";
+        return cli_constants::DIFF_EXIT_ERROR;
+    }
+
+    try {
+        auto start = std::chrono::high_resolution_clock::now();
+        std::string from_json = read_file(files[0]);
+        std::string to_json = read_file(files[1]);
+        double read_ms = elapsed_ms(start);
+
+        start = std::chrono::high_resolution_clock::now();
+        auto from = profiled_parse(from_json);
+        auto to = profiled_parse(to_json);
+        double parse_ms = elapsed_ms(start);
+
+        start = std::chrono::high_resolution_clock::now();
+        auto entries = JsonDiff::diff(from, to, diff_options);
+        double diff_ms = elapsed_ms(start);
+
+        // Write as we go so large diffs never sit in memory twice
+        start = std::chrono::high_resolution_clock::now();
+        std::string line;
+        if (format == DiffOutputFormat::Patch) {
+            std::cout << (entries.empty() ? "[]\n" : "[\n");
+        }
+        for (std::size_t i = 0; i < entries.size(); ++i) {
+            line.clear();
+            if (format == DiffOutputFormat::Summary) {
+                JsonDiff::append_summary(line, entries[i]);
+            } else {
+                JsonDiff::append_operation(line, entries[i]);
+                if (format == DiffOutputFormat::Patch && i + 1 < entries.size()) {
+                    line += ',';
+                }
+            }
+            line += '\n';
+            std::cout << line;
+        }
+        if (format == DiffOutputFormat::Patch && !entries.empty()) {
+            std::cout << "]\n";
+        }
+        std::cout.flush();
+        double write_ms = elapsed_ms(start);
+
+        if (show_stats) {
+            std::cerr << std::fixed << std::setprecision(cli_constants::BENCHMARK_PRECISION);
+            std::cerr << "Diff statistics:\n";
+            std::cerr << "  Input size:  " << from_json.size() << " + " << to_json.size()
+                      << " bytes\n";
+            std::cerr << "  Read time:   " << read_ms << " ms\n";
+            std::cerr << "  Parse time:  " << parse_ms << " ms\n";
+            std::cerr << "  Diff time:   " << diff_ms << " ms ("
+                      << resolve_thread_count(diff_options.threads) << " threads)\n";
+            std::cerr << "  Write time:  " << write_ms << " ms\n";
+            std::cerr << "  Operations:  " << entries.size() << "\n";
+        }
+        return entries.empty() ? 0 : cli_constants::DIFF_EXIT_DIFFERENT;
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << '\n';
+        return cli_constants::DIFF_EXIT_ERROR;
+    }
+}
+// NOLINTEND(readability-function-size)
+
+// Patch command: apply an RFC 6902 patch in place
+// NOLINTBEGIN(readability-function-size)
+auto patch_command(const std::vector<std::string>& args) -> int {
+    bool pretty = false;
+    bool show_stats = false;
+    std::vector<std::string> files;
+
+    for (size_t i = cli_constants::FIRST_OPTION_INDEX; i < args.size(); ++i) {
+        const auto& arg = args[i];
+        if (arg == "--help") {
+            std::cout << R"(Apply an RFC 6902 JSON Patch
+
+USAGE:
+    jsom patch [OPTIONS] <document.json> <patch.json> [output.json]
+
+Operations edit the parsed document in place, so untouched values keep their
+original number formatting. Output goes to stdout unless a file is given.
+
+OPTIONS:
+    --pretty      Pretty-print the result (default: compact)
+    --stats       Print timings to stderr
+
+EXAMPLES:
+    jsom diff old.json new.json > changes.json
+    jsom patch old.json changes.json rebuilt.json
+)";
+            return 0;
+        }
+        if (arg == "--pretty") {
+            pretty = true;
+        } else if (arg == "--stats") {
+            show_stats = true;
+        } else if (arg[0] != '-') {
+            files.push_back(arg);
+        } else {
+            std::cerr << "Unknown option: " << arg << "\n";
+            return 1;
+        }
+    }
+
+    if (files.size() < 2 || files.size() > 3) {
+        std::cerr << "Usage: jsom patch [OPTIONS] <document.json> <patch.json> [output.json]\n";
+        return 1;
+    }
+
+    try {
+        auto start = std::chrono::high_resolution_clock::now();
+        auto doc = profiled_parse(read_file(files[0]));
+        auto patch = profiled_parse(read_file(files[1]));
+        double parse_ms = elapsed_ms(start);
+
+        start = std::chrono::high_resolution_clock::now();
+        JsonPatch::apply(doc, patch);
+        double apply_ms = elapsed_ms(start);
+
+        start = std::chrono::high_resolution_clock::now();
+        std::string output = pretty ? doc.to_json(FormatPresets::Pretty) : doc.to_json();
+        output += '\n';
+        if (files.size() == 3) {
+            write_file(files[2], output);
+        } else {
+            std::cout << output;
+        }
+        double write_ms = elapsed_ms(start);
+
+        if (show_stats) {
+            std::cerr << std::fixed << std::setprecision(cli_constants::BENCHMARK_PRECISION);
+            std::cerr << "Patch statistics:\n";
+            std::cerr << "  Operations:  " << patch.size() << "\n";
+            std::cerr << "  Parse time:  " << parse_ms << " ms\n";
+            std::cerr << "  Apply time:  " << apply_ms << " ms\n";
+            std::cerr << "  Write time:  " << write_ms << " ms\n";
+        }
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << '\n';
+        return 1;
+    }
+}
+// NOLINTEND(readability-function-size)
+
+// Query command: compiled multi-path extraction over many documents
+enum class QueryOutputFormat : std::uint8_t { Ndjson, Csv, Tsv };
+
+struct QueryOptions {
+    QueryOutputFormat format = QueryOutputFormat::Ndjson;
+    bool ndjson_input = false;
+    bool header = true;
+    bool with_filename = false;
+    std::size_t threads = 0; // 0 = hardware concurrency
+};
+
+// One input document: a whole file, or one line of an NDJSON file
+struct QueryRecord {
+    std::string_view text;
+    const std::string* source;
+    std::size_t line; // 1-based line for NDJSON input, 0 for whole documents
+};
+
+// Append a CSV field, quoting it when it contains a delimiter, quote or line break
+void append_csv_field(std::string& out, std::string_view field) {
+    if (field.find_first_of(",\"\r\n") == std::string_view::npos) {
+        out += field;
+        return;
+    }
+    out += '"';
+    // NOLINTNEXTLINE(readability-identifier-length)
+    for (char c : field) {
+        if (c == '"') {
+            out += '"';
+        }
+        out += c;
+    }
+    out += '"';
+}
+
+// Append a TSV field, escaping tabs, line breaks and backslashes
+void append_tsv_field(std::string& out, std::string_view field) {
+    // NOLINTNEXTLINE(readability-identifier-length)
+    for (char c : field) {
+        switch (c) {
+        case '\t':
+            out += "\\t";
+            break;
+        case '\n':
+            out += "\\n";
+            break;
+        case '\r':
+            out += "\\r";
+            break;
+        case '\\':
+            out += "\\\\";
+            break;
+        default:
+            out += c;
+            break;
+        }
+    }
+}
+
+void append_query_field(std::string& out, std::string_view field, QueryOutputFormat format) {
+    if (format == QueryOutputFormat::Csv) {
+        append_csv_field(out, field);
+    } else {
+        append_tsv_field(out, field);
+    }
+}
+
+// Render the value column for one pattern: raw JSON for NDJSON; for CSV/TSV a single
+// string match is unquoted, several matches (from wildcards) become a JSON array.
+auto render_query_value(std::string_view text, const std::vector<QueryMatch>& matches,
+                        QueryOutputFormat format) -> std::string {
+    if (matches.empty()) {
+        return format == QueryOutputFormat::Ndjson ? "null" : "";
+    }
+    if (matches.size() == 1) {
+        std::string_view value = text.substr(matches[0].offset, matches[0].length);
+        if (format != QueryOutputFormat::Ndjson && !value.empty() && value[0] == '"') {
+            return parse_document(std::string(value)).as<std::string>();
+        }
+        return std::string(value);
+    }
+    std::string array = "[";
+    for (std::size_t i = 0; i < matches.size(); ++i) {
+        if (i > 0) {
+            array += ',';
+        }
+        array += text.substr(matches[i].offset, matches[i].length);
+    }
+    array += ']';
+    return array;
+}
+
+// Format one record's matches as an output line
+// NOLINTBEGIN(readability-function-size)
+void render_query_record(std::string& out, const QueryRecord& record, const CompiledQuery& query,
+                         std::vector<std::vector<QueryMatch>>& by_pattern,
+                         const QueryOptions& options) {
+    const auto& patterns = query.patterns();
+    if (options.format == QueryOutputFormat::Ndjson) {
+        out += '{';
+        if (options.with_filename) {
+            out += "\"file\":\"";
+            JsonDocument::escape_string_to_string(out, *record.source);
+            out += "\",";
+        }
+        for (std::size_t i = 0; i < patterns.size(); ++i) {
+            if (i > 0) {
+                out += ',';
+            }
+            out += '"';
+            JsonDocument::escape_string_to_string(out, patterns[i]);
+            out += "\":";
+            out += render_query_value(record.text, by_pattern[i], options.format);
+        }
+        out += "}\n";
+        return;
+    }
+
+    char separator = options.format == QueryOutputFormat::Csv ? ',' : '\t';
+    if (options.with_filename) {
+        append_query_field(out, *record.source, options.format);
+        out += separator;
+    }
+    for (std::size_t i = 0; i < patterns.size(); ++i) {
+        if (i > 0) {
+            out += separator;
+        }
+        append_query_field(out, render_query_value(record.text, by_pattern[i], options.format),
+                           options.format);
+    }
+    out += '\n';
+}
+// NOLINTEND(readability-function-size)
+
+// Extract and render a batch of records in parallel, writing output in input order. Each
+// worker claims `records_per_task` records at a time: many small NDJSON lines, or one whole
+// document. Returns false if any record failed to scan.
+// NOLINTBEGIN(readability-function-size)
+auto run_query_batch(const CompiledQuery& query, const std::vector<QueryRecord>& records,
+                     const QueryOptions& options, std::size_t records_per_task) -> bool {
+    std::size_t task_count = (records.size() + records_per_task - 1) / records_per_task;
+    std::vector<std::string> outputs(task_count);
+    std::vector<std::string> errors(task_count);
+
+    parallel_for(task_count, options.threads, [&](std::size_t task) {
+        std::vector<QueryMatch> matches;
+        std::vector<std::vector<QueryMatch>> by_pattern(query.patterns().size());
+        std::size_t first = task * records_per_task;
+        std::size_t last = std::min(records.size(), first + records_per_task);
+
+        for (std::size_t r = first; r < last; ++r) {
+            const auto& record = records[r];
+            try {
+                matches.clear();
+                query.extract(record.text, matches);
+                for (auto& group : by_pattern) {
+                    group.clear();
+                }
+                for (const auto& match : matches) {
+                    by_pattern[match.pattern].push_back(match);
+                }
+                render_query_record(outputs[task], record, query, by_pattern, options);
+            } catch (const std::exception& e) {
+                errors[task] += *record.source;
+                if (record.line > 0) {
+                    errors[task] += ":" + std::to_string(record.line);
+                }
+                errors[task] += ": " + std::string(e.what()) + "\n";
+            }
+        }
+    });
+
+    bool ok = true;
+    for (std::size_t task = 0; task < task_count; ++task) {
+        std::cout << outputs[task];
+        if (!errors[task].empty()) {
+            std::cerr << errors[task];
+            ok = false;
+        }
+    }
+    return ok;
+}
+// NOLINTEND(readability-function-size)
+
+// Run the NDJSON lines of `content` in batches (blank lines are skipped). `line` counts the
+// lines before `content` and is advanced past them.
+auto run_query_lines(const CompiledQuery& query, std::string_view content,
+                     const std::string& source, std::size_t& line, const QueryOptions& options)
+    -> bool {
+    bool ok = true;
+    std::vector<QueryRecord> records;
+    records.reserve(cli_constants::QUERY_RECORDS_PER_BATCH);
+
+    std::size_t start = 0;
+    while (start < content.size()) {
+        std::size_t end = content.find('\n', start);
+        if (end == std::string_view::npos) {
+            end = content.size();
+        }
+        ++line;
+        std::string_view text = content.substr(start, end - start);
+        if (text.find_first_not_of(" \t\r") != std::string_view::npos) {
+            records.push_back({text, &source, line});
+        }
+        if (records.size() == cli_constants::QUERY_RECORDS_PER_BATCH) {
+            ok = run_query_batch(query, records, options, cli_constants::QUERY_RECORDS_PER_TASK)
+                 && ok;
+            records.clear();
+        }
+        start = end + 1;
+    }
+    if (!records.empty()) {
+        ok = run_query_batch(query, records, options, cli_constants::QUERY_RECORDS_PER_TASK) && ok;
+    }
+    return ok;
+}
+
+// Stream NDJSON from `input`: read a chunk, run its complete lines and carry the partial
+// last line over to the next chunk. Memory stays bounded by the chunk size (or the longest
+// line), however long the stream is.
+auto run_query_ndjson(const CompiledQuery& query, std::istream& input, const std::string& source,
+                      const QueryOptions& options) -> bool {
+    bool ok = true;
+    std::string buffer;
+    std::size_t line = 0;
+    bool finished = false;
+    while (!finished) {
+        std::size_t carried = buffer.size();
+        buffer.resize(carried + cli_constants::QUERY_READ_CHUNK_BYTES);
+        {
+            ProfileTimer timer(ProfilePhase::Read);
+            input.read(buffer.data() + carried,
+                       static_cast<std::streamsize>(cli_constants::QUERY_READ_CHUNK_BYTES));
+            auto count = static_cast<std::size_t>(input.gcount());
+            timer.add_bytes(count);
+            buffer.resize(carried + count);
+        }
+        if (input.bad()) {
+            throw std::runtime_error("Cannot read " + source);
+        }
+        finished = !input; // A short read: end of input
+
+        std::size_t complete = buffer.size();
+        if (!finished) {
+            std::size_t last_newline = buffer.rfind('\n');
+            complete = last_newline == std::string::npos ? 0 : last_newline + 1;
+        }
+        ok = run_query_lines(query, std::string_view(buffer).substr(0, complete), source, line,
+                             options)
+             && ok;
+        buffer.erase(0, complete);
+    }
+    return ok;
+}
+
+// NOLINTBEGIN(readability-function-size)
+auto query_command(const std::vector<std::string>& args) -> int {
+    const std::string FORMAT_SWITCH = "--format=";
+    const std::string THREADS_SWITCH = "--threads=";
+    QueryOptions options;
+    std::string patterns_arg;
+    std::vector<std::string> input_files;
+
+    for (size_t i = cli_constants::FIRST_OPTION_INDEX; i < args.size(); ++i) {
+        const auto& arg = args[i];
+        if (arg == "--help") {
+            std::cout << R"(Extract values at many JSON Pointer paths from many documents
+
+USAGE:
+    jsom query [OPTIONS] <patterns> [FILES...]
+
+Patterns are comma-separated JSON Pointers; a "*" segment matches any object key
+or array index. Patterns are compiled once and matched while scanning, so only
+the matched values are ever materialized. Input is read from stdin if no files
+are given.
+
+OPTIONS:
+    --ndjson            Treat each input line as a separate document
+    --format=<fmt>      Output format: ndjson (default), csv, tsv
+    --no-header         Omit the header row for csv/tsv output
+    --with-filename     Add the source file as the first column
+    --threads=<n>       Worker threads (default: hardware concurrency)
+
+EXAMPLES:
+    jsom query "/user/id,/metrics/likes" --ndjson --format=csv logs.ndjson
+    jsom query "/users/*/email" a.json b.json c.json
+    cat events.ndjson | jsom query --ndjson --format=tsv "/type,/payload/status"
+)";
+            return 0;
+        }
+        if (arg.substr(0, FORMAT_SWITCH.length()) == FORMAT_SWITCH) {
+            std::string format = arg.substr(FORMAT_SWITCH.length());
+            if (format == "ndjson") {
+                options.format = QueryOutputFormat::Ndjson;
+            } else if (format == "csv") {
+                options.format = QueryOutputFormat::Csv;
+            } else if (format == "tsv") {
+                options.format = QueryOutputFormat::Tsv;
+            } else {
+                std::cerr << "Unknown query format: " << format << " (use ndjson, csv or tsv)\n";
+                return 1;
+            }
+        } else if (arg.substr(0, THREADS_SWITCH.length()) == THREADS_SWITCH) {
+            options.threads = std::stoul(arg.substr(THREADS_SWITCH.length()));
+        } else if (arg == "--ndjson") {
+            options.ndjson_input = true;
+        } else if (arg == "--no-header") {
+            options.header = false;
+        } else if (arg == "--with-filename") {
+            options.with_filename = true;
+        } else if (arg[0] != '-') {
+            if (patterns_arg.empty()) {
+                patterns_arg = arg;
+            } else {
+                input_files.push_back(arg);
+            }
+        } else {
+            std::cerr << "Unknown option: " << arg << "\n";
+            return 1;
+        }
+    }
+
+    if (patterns_arg.empty()) {
+        std::cerr << "Usage: jsom query [OPTIONS] <patterns> [FILES...]\n";
+        return 1;
+    }
+    options.threads = resolve_thread_count(options.threads);
+
+    try {
+        CompiledQuery query(split(patterns_arg, ','));
+
+        if (options.header && options.format != QueryOutputFormat::Ndjson) {
+            std::string header;
+            char separator = options.format == QueryOutputFormat::Csv ? ',' : '\t';
+            if (options.with_filename) {
+                header += "file";
+                header += separator;
+            }
+            for (std::size_t i = 0; i < query.patterns().size(); ++i) {
+                if (i > 0) {
+                    header += separator;
+                }
+                append_query_field(header, query.patterns()[i], options.format);
+            }
+            std::cout << header << '\n';
+        }
+
+        const std::string STDIN_NAME = "<stdin>";
+        bool ok = true;
+        if (input_files.empty()) {
+            if (options.ndjson_input) {
+                ok = run_query_ndjson(query, std::cin, STDIN_NAME, options);
+            } else {
+                std::string content = read_stdin();
+                ok = run_query_batch(query, {{content, &STDIN_NAME, 0}}, options, 1);
+            }
+        } else if (options.ndjson_input) {
+            for (const auto& file : input_files) {
+                std::ifstream input(file, std::ios::binary);
+                if (!input.is_open()) {
+                    throw std::runtime_error("Cannot open file: " + file);
+                }
+                ok = run_query_ndjson(query, input, file, options) && ok;
+            }
+        } else {
+            // Whole documents: read a thread's worth of files at a time
+            for (std::size_t first = 0; first < input_files.size(); first += options.threads) {
+                std::size_t last = std::min(input_files.size(), first + options.threads);
+                std::vector<std::string> contents;
+                contents.reserve(last - first);
+                for (std::size_t i = first; i < last; ++i) {
+                    contents.push_back(read_file(input_files[i]));
+                }
+                std::vector<QueryRecord> records;
+                records.reserve(contents.size());
+                for (std::size_t i = 0; i < contents.size(); ++i) {
+                    records.push_back({contents[i], &input_files[first + i], 0});
+                }
+                ok = run_query_batch(query, records, options, 1) && ok; // A file per task
+            }
+        }
+
+        return ok ? 0 : 1;
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << '\n';
+        return 1;
+    }
+}
+// NOLINTEND(readability-function-size)
+
+// Dispatch to a command
+auto run_command(const std::vector<std::string>& args) -> int {
     const std::string& command = args[1];
-    
+
     if (command == "help" || command == "--help" || command == "-h") {
         show_usage();
         return 0;
@@ -763,6 +1971,16 @@ auto main(int argc, char* argv[]) -> int {
         return validate_command(args);
     } else if (command == "pointer") {
         return pointer_command(args);
+    } else if (command == "diff") {
+        return diff_command(args);
+    } else if (command == "patch") {
+        return patch_command(args);
+    } else if (command == "compile") {
+        return compile_command(args);
+    } else if (command == "decompile") {
+        return decompile_command(args);
+    } else if (command == "query") {
+        return query_command(args);
     } else if (command == "benchmark") {
         return benchmark_command(args);
     } else {
@@ -771,3 +1989,40 @@ auto main(int argc, char* argv[]) -> int {
         return 1;
     }
 }
+
+auto main(int argc, char* argv[]) -> int {
+    std::vector<std::string> args(argv, argv + argc);
+
+    // --profile is global: accepted anywhere and removed before the command sees it
+    auto profile_flag = std::remove(args.begin() + 1, args.end(), std::string("--profile"));
+    if (profile_flag != args.end()) {
+        args.erase(profile_flag, args.end());
+        Profiler::enable();
+    }
+    // Counting allocations costs shared atomics on every new and delete: only for --profile
+    set_allocation_counting(Profiler::enabled());
+
+    if (args.size() < static_cast<std::size_t>(cli_constants::MINIMUM_ARGC)) {
+        show_usage();
+        return 1;
+    }
+    if (!Profiler::enabled()) {
+        return run_command(args);
+    }
+
+    ProfiledStreambuf profiled_cout(std::cout.rdbuf());
+    std::streambuf* original_cout = std::cout.rdbuf(&profiled_cout);
+    AllocationStats start_allocations = allocation_stats();
+    reset_allocation_peak();
+    auto start = std::chrono::steady_clock::now();
+
+    int status = run_command(args);
+    std::cout.flush();
+
+    double total_ms
+        = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start)
+              .count();
+    std::cout.rdbuf(original_cout);
+    print_profile(total_ms, allocation_stats() - start_allocations);
+    return status;
+}
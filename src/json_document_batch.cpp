@@ -0,0 +1,194 @@
+#include "jsom/json_document.hpp"
+#include "jsom/json_pointer.hpp"
+#include "jsom/navigation_engine.hpp"
+#include <algorithm>
+#include <string_view>
+
+namespace jsom {
+
+// Keeps the nodes along the previous operation's parent path. The next operation walks only
+// the segments its parent path does not share with it, so a run of operations under one
+// object costs one map insert each instead of a walk from the root.
+class JsonDocument::BatchApplier {
+public:
+    explicit BatchApplier(JsonDocument& root) : path_{&root} {}
+
+    auto apply(std::vector<PointerOperation>& operations) -> size_t {
+        size_t applied = 0;
+        for (size_t i = 0; i < operations.size();) {
+            auto& operation = operations[i];
+            if (operation.pointer.empty()) {
+                if (operation.kind == PointerOperation::Kind::Set) {
+                    *path_.front() = std::move(operation.value);
+                    reset();
+                    ++applied;
+                }
+                ++i; // The root cannot be removed, as with remove_at()
+                continue;
+            }
+
+            std::string_view parent_path = parent_of(operation.pointer);
+            JsonDocument* parent = resolve(parent_path);
+            if (operation.kind == PointerOperation::Kind::Set) {
+                if (parent == nullptr) {
+                    throw JsonPointerNotFoundException(std::string(parent_path));
+                }
+                set_child(*parent, last_segment(operation.pointer, scratch_),
+                          std::move(operation.value), operation.pointer);
+                ++applied;
+                ++i;
+            } else if (parent != nullptr && parent->is_array()) {
+                size_t end = end_of_removal_run(operations, i, parent_path);
+                applied += remove_elements(*parent, operations, i, end);
+                i = end;
+            } else {
+                if (parent != nullptr && parent->is_object()) {
+                    auto& obj = parent->object_map();
+                    // NOLINTNEXTLINE(readability-identifier-length)
+                    auto it = obj.find(last_segment(operation.pointer, scratch_));
+                    if (it != obj.end()) {
+                        obj.erase(it);
+                        ++applied;
+                    }
+                }
+                ++i;
+            }
+        }
+        return applied;
+    }
+
+private:
+    std::vector<JsonDocument*> path_; // Root, then the node after each resolved segment
+    std::vector<size_t> ends_;        // End offset in resolved_ of each resolved segment
+    std::string resolved_;            // Parent path of the previous operation, as resolved
+    std::string scratch_;             // Unescaped copy of the current segment, when it has escapes
+
+    void reset() {
+        path_.resize(1);
+        ends_.clear();
+        resolved_.clear();
+    }
+
+    static auto parent_of(const std::string& pointer) -> std::string_view {
+        return std::string_view(pointer).substr(0, pointer.rfind('/'));
+    }
+
+    static auto last_segment(const std::string& pointer, std::string& scratch)
+        -> std::string_view {
+        return unescape(std::string_view(pointer).substr(pointer.rfind('/') + 1), scratch);
+    }
+
+    // The segment itself, or its unescaped copy in `scratch` when it contains escapes
+    static auto unescape(std::string_view raw, std::string& scratch) -> std::string_view {
+        if (raw.find('~') == std::string_view::npos) {
+            return raw;
+        }
+        scratch = JsonPointer::unescape_segment(std::string(raw));
+        return scratch;
+    }
+
+    // Walk to `parent_path`, reusing the nodes it shares with the previous parent path.
+    // Returns nullptr when a step is missing.
+    auto resolve(std::string_view parent_path) -> JsonDocument* {
+        size_t common = static_cast<size_t>(
+            std::mismatch(resolved_.begin(), resolved_.end(), parent_path.begin(),
+                          parent_path.end())
+                .first
+            - resolved_.begin());
+        size_t depth = 0;
+        while (depth < ends_.size() && ends_[depth] <= common
+               && (ends_[depth] == parent_path.size() || parent_path[ends_[depth]] == '/')) {
+            ++depth;
+        }
+        path_.resize(depth + 1);
+        ends_.resize(depth);
+        resolved_.resize(depth == 0 ? 0 : ends_.back());
+
+        size_t pos = resolved_.size();
+        while (pos < parent_path.size()) {
+            size_t next = std::min(parent_path.find('/', pos + 1), parent_path.size());
+            JsonDocument* child = NavigationEngine::navigate_single_step(
+                path_.back(), unescape(parent_path.substr(pos + 1, next - pos - 1), scratch_));
+            if (child == nullptr) {
+                return nullptr;
+            }
+            path_.push_back(child);
+            ends_.push_back(next);
+            resolved_.append(parent_path.substr(pos, next - pos));
+            pos = next;
+        }
+        return path_.back();
+    }
+
+    // Consecutive removals from the same array form one run
+    static auto end_of_removal_run(const std::vector<PointerOperation>& operations,
+                                   size_t begin, std::string_view parent_path) -> size_t {
+        size_t end = begin + 1;
+        while (end < operations.size() && operations[end].kind == PointerOperation::Kind::Remove
+               && !operations[end].pointer.empty()
+               && parent_of(operations[end].pointer) == parent_path) {
+            ++end;
+        }
+        return end;
+    }
+
+    // Remove a run's elements in one compaction pass. Indices refer to the array before the
+    // run, which is what removing them in descending index order would give.
+    static auto remove_elements(JsonDocument& parent,
+                                const std::vector<PointerOperation>& operations, size_t begin,
+                                size_t end) -> size_t {
+        auto& arr = std::get<std::vector<JsonDocument>>(parent.own_storage());
+        std::vector<size_t> removed;
+        std::string scratch;
+        for (size_t i = begin; i < end; ++i) {
+            std::string_view segment = last_segment(operations[i].pointer, scratch);
+            if (JsonPointer::is_array_index(segment)) {
+                size_t index = JsonPointer::to_array_index(segment);
+                if (index < arr.size()) {
+                    removed.push_back(index);
+                }
+            }
+        }
+        if (removed.empty()) {
+            return 0;
+        }
+        std::sort(removed.begin(), removed.end());
+        removed.erase(std::unique(removed.begin(), removed.end()), removed.end());
+
+        size_t write = removed.front();
+        size_t next_removed = 0;
+        for (size_t read = removed.front(); read < arr.size(); ++read) {
+            if (next_removed < removed.size() && removed[next_removed] == read) {
+                ++next_removed;
+                continue;
+            }
+            arr[write++] = std::move(arr[read]);
+        }
+        arr.erase(arr.begin() + static_cast<std::ptrdiff_t>(write), arr.end());
+        return removed.size();
+    }
+};
+
+auto JsonDocument::apply_batch(std::vector<PointerOperation> operations) -> size_t {
+    for (const auto& operation : operations) {
+        if (!operation.pointer.empty() && operation.pointer[0] != '/') {
+            throw InvalidJsonPointerException(operation.pointer, "must start with '/'");
+        }
+        if (operation.pointer.find('~') != std::string::npos) {
+            JsonPointer::validate(operation.pointer);
+        }
+    }
+
+    BatchApplier applier(*this);
+    size_t applied = 0;
+    try {
+        applied = applier.apply(operations);
+    } catch (...) {
+        invalidate_cache();
+        throw;
+    }
+    invalidate_cache();
+    return applied;
+}
+
+} // namespace jsom
@@ -0,0 +1,364 @@
+#include "jsom/content_hash.hpp"
+#include "jsom/json_document.hpp"
+#include "jsom/path_cache.hpp"
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace jsom {
+
+namespace {
+
+// Heap bytes behind a string; short strings live in the small-string buffer
+auto string_heap_bytes(const std::string& str) -> size_t {
+    static const size_t inline_capacity = std::string().capacity();
+    return str.capacity() > inline_capacity ? str.capacity() + 1 : 0;
+}
+
+constexpr size_t MAP_NODE_BYTES = memory_constants::MAP_NODE_LINK_WORDS * sizeof(void*)
+                                  + sizeof(std::pair<const std::string, JsonDocument>);
+
+// Container nesting of the destructors running on this thread. `deferred` belongs to the
+// outermost one; kept trivially destructible so documents destroyed during thread or
+// program exit can still use it.
+struct Teardown {
+    size_t depth = 0;
+    std::vector<JsonDocument>* deferred = nullptr;
+};
+thread_local Teardown teardown;
+
+// Allocation behind a SharedValue: make_shared's control block and the value
+constexpr size_t SHARED_NODE_BYTES =
+    memory_constants::SHARED_CONTROL_BLOCK_WORDS * sizeof(void*) + sizeof(JsonDocument);
+
+// The text a number serializes to. Sharing goes by this rather than by operator==, which
+// finds 1 and 1.0 equal: a shared value must print the same for every holder.
+auto number_text(const LazyNumber& number) -> std::string {
+    return number.has_original_repr() ? number.get_original_repr() : number.as_string();
+}
+
+} // namespace
+
+JsonDocument::~JsonDocument() {
+    delete path_cache_;
+    if (type_ == JsonType::Object || type_ == JsonType::Array) {
+        path_cache_ = nullptr; // Not freed twice if this node is moved to the deferred list
+        release_children();
+    }
+}
+
+// Children are destroyed here, inside the depth count, instead of by the variant destructor
+// afterwards. A container reached at the depth limit is moved, contents and all, to the
+// outermost destructor's list; that destructor frees the list in a loop, each entry starting
+// again from the bottom of the depth budget.
+void JsonDocument::release_children() noexcept {
+    bool empty = true;
+    if (const auto* elements = std::get_if<std::vector<JsonDocument>>(&storage_)) {
+        empty = elements->empty();
+    } else if (const auto* shaped = std::get_if<ShapedObject>(&storage_)) {
+        empty = shaped->values.empty();
+    } else if (const auto* shared = std::get_if<SharedValue>(&storage_)) {
+        empty = shared->value == nullptr; // The last holder frees the value below this depth
+    } else {
+        empty = std::get<JsonObject>(storage_).empty();
+    }
+    if (empty) {
+        return; // Also every moved-from container, e.g. while `deferred` itself reallocates
+    }
+    if (teardown.depth >= memory_constants::MAX_RECURSIVE_TEARDOWN_DEPTH) {
+        teardown.deferred->push_back(std::move(*this));
+        return;
+    }
+    if (teardown.depth != 0) {
+        ++teardown.depth;
+        storage_ = std::monostate{};
+        --teardown.depth;
+        return;
+    }
+
+    std::vector<JsonDocument> deferred;
+    teardown.deferred = &deferred;
+    teardown.depth = 1;
+    storage_ = std::monostate{};
+    while (!deferred.empty()) {
+        JsonDocument node = std::move(deferred.back());
+        deferred.pop_back();
+    }
+    teardown.depth = 0;
+    teardown.deferred = nullptr;
+}
+
+void JsonDocument::unshape() {
+    auto& shaped = std::get<ShapedObject>(storage_);
+    JsonObject members;
+    const auto& keys = shaped.shape->keys();
+    for (size_t i = 0; i < keys.size(); ++i) {
+        members.emplace_hint(members.end(), keys[i], std::move(shaped.values[i]));
+    }
+    storage_ = std::move(members);
+    PathCache::notify_mutation(); // Caches may point at the values just moved
+}
+
+void JsonDocument::unshare() {
+    std::shared_ptr<const JsonDocument> shared = std::move(std::get<SharedValue>(storage_).value);
+    if (shared.use_count() == 1) {
+        // No other holder can see it any more: take the value instead of copying it. The
+        // value was made non-const by share(); only the pointer to it is const.
+        storage_ = std::move(const_cast<JsonDocument&>(*shared).storage_);
+    } else {
+        storage_ = shared->storage_;
+    }
+    // No path cache holds a node inside a shared value, so none is invalidated
+}
+
+// Post-order walk: a container is hashed from its children's hashes once they are interned,
+// so two identical containers already hold the same shared children and compare cheaply.
+// The first container with a given content stays in place until a second one turns up; its
+// storage then moves into a shared allocation, which keeps the addresses of everything below
+// it.
+class JsonDocument::Deduplicator {
+public:
+    auto run(JsonDocument& root) -> DedupStats {
+        root_ = &root;
+        visit(root);
+        return stats_;
+    }
+
+private:
+    struct Candidate {
+        JsonDocument* first;                        // First container seen with this content
+        std::shared_ptr<const JsonDocument> shared; // Its shared value, once there is one
+    };
+
+    JsonDocument* root_ = nullptr;
+    std::unordered_map<std::uint64_t, std::vector<Candidate>> candidates_;
+    std::unordered_map<const JsonDocument*, std::uint64_t> shared_hashes_; // Shared before
+    DedupStats stats_;
+
+    // Hash of `node` after interning everything below it
+    auto visit(JsonDocument& node) -> std::uint64_t {
+        if (node.is_shared()) {
+            std::uint64_t hash = read_hash(node);
+            offer_shared(node, hash);
+            return hash;
+        }
+        // Not shared, so the children are this document's own
+        std::uint64_t hash = hash_node(node, [this](const JsonDocument& child) {
+            return visit(const_cast<JsonDocument&>(child));
+        });
+        if (&node != root_ && (node.is_object() || node.is_array()) && !node.empty()) {
+            intern(node, hash);
+        }
+        return hash;
+    }
+
+    // Hash of a value without changing it, for values shared before this pass
+    auto read_hash(const JsonDocument& node) -> std::uint64_t {
+        if (!node.is_shared()) {
+            return hash_node(node, [this](const JsonDocument& child) { return read_hash(child); });
+        }
+        const JsonDocument* value = std::get<SharedValue>(node.storage_).value.get();
+        // NOLINTNEXTLINE(readability-identifier-length)
+        auto it = shared_hashes_.find(value);
+        if (it == shared_hashes_.end()) {
+            it = shared_hashes_.emplace(value, read_hash(*value)).first;
+        }
+        return it->second;
+    }
+
+    template <typename ChildHash>
+    static auto hash_node(const JsonDocument& node, ChildHash&& child_hash) -> std::uint64_t {
+        std::uint64_t hash = detail::hash_combine(hash_constants::FNV_OFFSET_BASIS,
+                                                  static_cast<std::uint64_t>(node.type_));
+        const JsonStorage& storage = node.storage();
+        switch (node.type_) {
+        case JsonType::Null:
+            break;
+        case JsonType::Boolean:
+            hash = detail::hash_combine(hash, std::get<bool>(storage) ? 1 : 0);
+            break;
+        case JsonType::Number:
+            hash = detail::hash_combine(hash,
+                                        detail::fnv1a(number_text(std::get<LazyNumber>(storage))));
+            break;
+        case JsonType::String:
+            hash = detail::hash_combine(hash, detail::fnv1a(std::get<std::string>(storage)));
+            break;
+        case JsonType::Array:
+            for (const auto& element : std::get<std::vector<JsonDocument>>(storage)) {
+                hash = detail::hash_combine(hash, child_hash(element));
+            }
+            break;
+        case JsonType::Object:
+            for (const auto& [key, value] : node.members()) {
+                hash = detail::hash_combine(hash, detail::fnv1a(key));
+                hash = detail::hash_combine(hash, child_hash(value));
+            }
+            break;
+        }
+        return hash;
+    }
+
+    // Same serialized text; values already shared by both sides compare by address
+    // NOLINTBEGIN(readability-function-size)
+    static auto same_value(const JsonDocument& lhs, const JsonDocument& rhs) -> bool {
+        if (&lhs.storage() == &rhs.storage()) {
+            return true;
+        }
+        if (lhs.type_ != rhs.type_) {
+            return false;
+        }
+        switch (lhs.type_) {
+        case JsonType::Null:
+            return true;
+        case JsonType::Boolean:
+            return std::get<bool>(lhs.storage()) == std::get<bool>(rhs.storage());
+        case JsonType::Number:
+            return number_text(std::get<LazyNumber>(lhs.storage()))
+                   == number_text(std::get<LazyNumber>(rhs.storage()));
+        case JsonType::String:
+            return std::get<std::string>(lhs.storage()) == std::get<std::string>(rhs.storage());
+        case JsonType::Array: {
+            const auto& left = std::get<std::vector<JsonDocument>>(lhs.storage());
+            const auto& right = std::get<std::vector<JsonDocument>>(rhs.storage());
+            return std::equal(left.begin(), left.end(), right.begin(), right.end(), same_value);
+        }
+        case JsonType::Object: {
+            auto left = lhs.members();
+            auto right = rhs.members();
+            return left.size() == right.size()
+                   && std::equal(left.begin(), left.end(), right.begin(),
+                                 [](const auto& first, const auto& second) {
+                                     return first.first == second.first
+                                            && same_value(first.second, second.second);
+                                 });
+        }
+        }
+        return false;
+    }
+    // NOLINTEND(readability-function-size)
+
+    // Share `node` with an earlier container of the same content, or remember it as the
+    // first of its content
+    void intern(JsonDocument& node, std::uint64_t hash) {
+        ++stats_.containers;
+        auto& candidates = candidates_[hash];
+        for (auto& candidate : candidates) {
+            if (!same_value(candidate.shared ? *candidate.shared : *candidate.first, node)) {
+                continue;
+            }
+            if (candidate.shared == nullptr) {
+                candidate.shared = share(*candidate.first);
+            }
+            node.storage_ = SharedValue{candidate.shared}; // Frees this copy
+            ++stats_.replaced;
+            return;
+        }
+        candidates.push_back({&node, nullptr});
+    }
+
+    // A value that was already shared, e.g. copied from another deduplicated document: kept
+    // as the one to share, or replaced by an earlier one of the same content. It is always
+    // this node that is replaced: the earlier one's children may be candidates themselves,
+    // so its storage only ever moves into a shared value, which keeps their addresses.
+    void offer_shared(JsonDocument& node, std::uint64_t hash) {
+        ++stats_.containers;
+        const auto& existing = std::get<SharedValue>(node.storage_).value;
+        auto& candidates = candidates_[hash];
+        for (auto& candidate : candidates) {
+            if (candidate.shared == existing) {
+                return;
+            }
+            if (!same_value(candidate.shared ? *candidate.shared : *candidate.first, *existing)) {
+                continue;
+            }
+            if (candidate.shared == nullptr) {
+                candidate.shared = share(*candidate.first);
+            }
+            if (existing.use_count() == 1) {
+                shared_hashes_.erase(existing.get()); // Freed below; the address may be reused
+            }
+            node.storage_ = SharedValue{candidate.shared};
+            ++stats_.replaced;
+            return;
+        }
+        candidates.push_back({&node, existing});
+    }
+
+    // Move `first`'s storage into a new shared value and make `first` its first holder
+    auto share(JsonDocument& first) -> std::shared_ptr<const JsonDocument> {
+        JsonDocument value;
+        value.type_ = first.type_;
+        value.storage_ = std::move(first.storage_);
+        std::shared_ptr<const JsonDocument> shared
+            = std::make_shared<JsonDocument>(std::move(value)); // Non-const: see unshare()
+        first.storage_ = SharedValue{shared};
+        ++stats_.distinct;
+        return shared;
+    }
+};
+
+auto JsonDocument::deduplicate() -> DedupStats {
+    DedupStats stats = Deduplicator().run(*this);
+    invalidate_cache(); // Cached pointers may lead into storage that moved or was freed
+    return stats;
+}
+
+auto JsonDocument::memory_usage() const -> MemoryUsage {
+    MemoryUsage usage;
+    add_memory_usage(usage);
+    return usage;
+}
+
+void JsonDocument::add_memory_usage(MemoryUsage& usage) const {
+    if (path_cache_ != nullptr) {
+        usage.path_caches += sizeof(PathCache) + path_cache_->get_stats().memory_usage_estimate;
+    }
+    if (const auto* shared = std::get_if<SharedValue>(&storage_)) {
+        MemoryUsage value;
+        shared->value->add_memory_usage(value);
+        usage.shared += (value.total() + SHARED_NODE_BYTES)
+                        / static_cast<size_t>(shared->value.use_count());
+        return;
+    }
+
+    switch (type_) {
+    case JsonType::Null:
+    case JsonType::Boolean:
+        break;
+    case JsonType::Number: {
+        const auto& number = std::get<LazyNumber>(storage_);
+        if (number.has_original_repr()) {
+            usage.numbers += string_heap_bytes(number.get_original_repr());
+        }
+        break;
+    }
+    case JsonType::String:
+        usage.strings += string_heap_bytes(std::get<std::string>(storage_));
+        break;
+    case JsonType::Object:
+        if (const auto* shaped = std::get_if<ShapedObject>(&storage_)) {
+            usage.containers += shaped->values.capacity() * sizeof(JsonDocument);
+            for (const auto& value : shaped->values) {
+                value.add_memory_usage(usage);
+            }
+            break;
+        }
+        for (const auto& [key, value] : std::get<JsonObject>(storage_)) {
+            usage.map_nodes += MAP_NODE_BYTES;
+            usage.strings += string_heap_bytes(key);
+            value.add_memory_usage(usage);
+        }
+        break;
+    case JsonType::Array: {
+        const auto& elements = std::get<std::vector<JsonDocument>>(storage_);
+        usage.containers += elements.capacity() * sizeof(JsonDocument);
+        for (const auto& element : elements) {
+            element.add_memory_usage(usage);
+        }
+        break;
+    }
+    }
+}
+
+} // namespace jsom
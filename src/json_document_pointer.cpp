@@ -6,11 +6,6 @@
 
 namespace jsom {
 
-// Destructor implementation
-JsonDocument::~JsonDocument() {
-    delete path_cache_;
-}
-
 // Copy assignment operator
 auto JsonDocument::operator=(const JsonDocument& other) -> JsonDocument& {
     if (this != &other) {
@@ -63,7 +58,8 @@ auto JsonDocument::at(const std::string& json_pointer) const -> const JsonDocume
 
 auto JsonDocument::at(const std::string& json_pointer) -> JsonDocument& {
     auto& cache = this->get_path_cache();
-    auto result = NavigationEngine::navigate_with_cache(this, json_pointer, cache);
+    auto result = NavigationEngine::navigate_with_cache(this, json_pointer, cache,
+                                                        NavigationEngine::Access::Write);
     
     if (result.target == nullptr) {
         throw JsonPointerNotFoundException(json_pointer);
@@ -73,24 +69,14 @@ auto JsonDocument::at(const std::string& json_pointer) -> JsonDocument& {
 }
 
 auto JsonDocument::find(const std::string& json_pointer) const -> const JsonDocument* {
-    try {
-        auto& cache = this->get_path_cache();
-        auto result = NavigationEngine::navigate_with_cache(
-            const_cast<JsonDocument*>(this), json_pointer, cache);
-        return result.target;
-    } catch (const JsonPointerException&) {
-        return nullptr;
-    }
+    auto& cache = this->get_path_cache();
+    return NavigationEngine::find_with_cache(const_cast<JsonDocument*>(this), json_pointer, cache);
 }
 
 auto JsonDocument::find(const std::string& json_pointer) -> JsonDocument* {
-    try {
-        auto& cache = this->get_path_cache();
-        auto result = NavigationEngine::navigate_with_cache(this, json_pointer, cache);
-        return result.target;
-    } catch (const JsonPointerException&) {
-        return nullptr;
-    }
+    auto& cache = this->get_path_cache();
+    return NavigationEngine::find_with_cache(this, json_pointer, cache,
+                                             NavigationEngine::Access::Write);
 }
 
 auto JsonDocument::exists(const std::string& json_pointer) const -> bool {
@@ -109,87 +95,103 @@ void JsonDocument::set_at(const std::string& json_pointer, JsonDocument&& value)
         return;
     }
     
-    // Parse the pointer
+    // Parse once and walk to the parent without the cache, which the mutation clears anyway
     auto segments = JsonPointer::parse(json_pointer);
-    if (segments.empty()) {
-        *this = std::move(value);
-        return;
+    JsonDocument* parent = NavigationEngine::navigate_segments(this, segments, segments.size() - 1);
+    if (parent == nullptr) {
+        throw JsonPointerNotFoundException(JsonPointer::get_parent(json_pointer));
     }
     
-    // Navigate to parent and set the final segment
-    std::string parent_path = JsonPointer::get_parent(json_pointer);
-    std::string final_segment = JsonPointer::get_last_segment(json_pointer);
+    set_child(*parent, segments.back(), std::move(value), json_pointer);
     
-    JsonDocument* parent = this;
-    if (!parent_path.empty()) {
-        parent = &at(parent_path);
+    // Clear path caches since structure changed
+    parent->invalidate_cache();
+    if (parent != this) {
+        invalidate_cache();
     }
-    
-    // Set the value based on parent type
-    if (parent->is_object()) {
-        parent->set(final_segment, value);
-    } else if (parent->is_array()) {
-        if (!JsonPointer::is_array_index(final_segment)) {
+}
+
+void JsonDocument::set_child(JsonDocument& parent, std::string_view segment,
+                             JsonDocument&& value, const std::string& json_pointer) {
+    // Move the value into place based on parent type
+    if (parent.is_object()) {
+        parent.object_slot(segment) = std::move(value);
+    } else if (parent.is_array()) {
+        if (!JsonPointer::is_array_index(segment)) {
             throw JsonPointerTypeException(json_pointer, "array", "object");
         }
-        size_t index = JsonPointer::to_array_index(final_segment);
-        parent->set(index, value);
+        size_t index = JsonPointer::to_array_index(segment);
+        auto& arr = std::get<std::vector<JsonDocument>>(parent.own_storage());
+        if (index >= arr.size()) {
+            arr.resize(index + 1);
+        }
+        arr[index] = std::move(value);
     } else {
         throw JsonPointerTypeException(json_pointer, "object or array", 
-                                     parent->is_null() ? "null" : 
-                                     parent->is_bool() ? "boolean" :
-                                     parent->is_number() ? "number" : "string");
+                                     parent.is_null() ? "null" : 
+                                     parent.is_bool() ? "boolean" :
+                                     parent.is_number() ? "number" : "string");
     }
-    
-    // Clear path cache since structure changed
-    if (path_cache_ != nullptr) { path_cache_->clear(); }
 }
 
-auto JsonDocument::remove_at(const std::string& json_pointer) -> bool {
+auto JsonDocument::take_at(const std::string& json_pointer, JsonDocument* removed) -> bool {
     if (json_pointer.empty()) {
         // Cannot remove root
         return false;
     }
     
-    try {
-        std::string parent_path = JsonPointer::get_parent(json_pointer);
-        std::string final_segment = JsonPointer::get_last_segment(json_pointer);
-        
-        JsonDocument* parent = this;
-        if (!parent_path.empty()) {
-            parent = &at(parent_path);
+    auto segments = JsonPointer::parse(json_pointer);
+    JsonDocument* parent = NavigationEngine::navigate_segments(this, segments, segments.size() - 1);
+    if (parent == nullptr) {
+        return false;
+    }
+    
+    const std::string& final_segment = segments.back();
+    if (parent->is_object()) {
+        auto& obj = parent->object_map();
+        auto it = obj.find(final_segment);
+        if (it == obj.end()) {
+            return false;
         }
-        
-        if (parent->is_object()) {
-            auto& obj = std::get<std::map<std::string, JsonDocument>>(parent->storage_);
-            auto it = obj.find(final_segment);
-            if (it != obj.end()) {
-                obj.erase(it);
-                if (path_cache_ != nullptr) { path_cache_->clear(); }
-                return true;
-            }
-        } else if (parent->is_array()) {
-            if (!JsonPointer::is_array_index(final_segment)) {
-                return false;
-            }
-            size_t index = JsonPointer::to_array_index(final_segment);
-            auto& arr = std::get<std::vector<JsonDocument>>(parent->storage_);
-            if (index < arr.size()) {
-                arr.erase(arr.begin() + index);
-                if (path_cache_ != nullptr) { path_cache_->clear(); }
-                return true;
-            }
+        if (removed != nullptr) {
+            *removed = std::move(it->second);
         }
-        
+        obj.erase(it);
+    } else if (parent->is_array()) {
+        if (!JsonPointer::is_array_index(final_segment)) {
+            return false;
+        }
+        size_t index = JsonPointer::to_array_index(final_segment);
+        auto& arr = std::get<std::vector<JsonDocument>>(parent->own_storage());
+        if (index >= arr.size()) {
+            return false;
+        }
+        if (removed != nullptr) {
+            *removed = std::move(arr[index]);
+        }
+        arr.erase(arr.begin() + static_cast<std::ptrdiff_t>(index));
+    } else {
         return false;
+    }
+    
+    parent->invalidate_cache();
+    if (parent != this) {
+        invalidate_cache();
+    }
+    return true;
+}
+
+auto JsonDocument::remove_at(const std::string& json_pointer) -> bool {
+    try {
+        return take_at(json_pointer, nullptr);
     } catch (const JsonPointerException&) {
         return false;
     }
 }
 
 auto JsonDocument::extract_at(const std::string& json_pointer) -> JsonDocument {
-    JsonDocument result = at(json_pointer);
-    if (!remove_at(json_pointer)) {
+    JsonDocument result;
+    if (!take_at(json_pointer, &result)) {
         throw JsonPointerNotFoundException(json_pointer);
     }
     return result;
@@ -212,7 +214,7 @@ auto JsonDocument::at_multiple(const std::vector<std::string>& paths) const -> s
 
 auto JsonDocument::at_multiple(const std::vector<std::string>& paths) -> std::vector<JsonDocument*> {
     auto& cache = this->get_path_cache();
-    return NavigationEngine::navigate_multiple(this, paths, cache);
+    return NavigationEngine::navigate_multiple(this, paths, cache, NavigationEngine::Access::Write);
 }
 
 auto JsonDocument::exists_multiple(const std::vector<std::string>& paths) const -> std::vector<bool> {
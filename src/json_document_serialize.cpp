@@ -0,0 +1,196 @@
+#include "jsom/json_document.hpp"
+#include <iomanip>
+#include <sstream>
+
+namespace jsom {
+
+auto JsonDocument::to_json(bool pretty) const -> std::string {
+    std::ostringstream oss;
+    serialize_to(oss, pretty, 0);
+    std::string result = oss.str();
+    JSOM_METRIC_ADD(metrics::Counter::SerializeBytes, result.size());
+    return result;
+}
+
+void JsonDocument::serialize_to(std::ostream& out, bool pretty, int indent) const {
+    switch (type_) {
+    case JsonType::Null:
+        out << "null";
+        break;
+    case JsonType::Boolean:
+        out << (std::get<bool>(storage()) ? "true" : "false");
+        break;
+    case JsonType::Number:
+        std::get<LazyNumber>(storage()).serialize(out);
+        break;
+    case JsonType::String:
+        out << '"';
+        escape_string(out, std::get<std::string>(storage()));
+        out << '"';
+        break;
+    case JsonType::Object:
+        serialize_object_to(out, pretty, indent);
+        break;
+    case JsonType::Array:
+        serialize_array_to(out, pretty, indent);
+        break;
+    }
+}
+
+void JsonDocument::serialize_compact(std::ostream& out) const {
+    switch (type_) {
+    case JsonType::Null:
+        out << "null";
+        break;
+    case JsonType::Boolean:
+        out << (std::get<bool>(storage()) ? "true" : "false");
+        break;
+    case JsonType::Number:
+        std::get<LazyNumber>(storage()).serialize(out);
+        break;
+    case JsonType::String:
+        out << '"';
+        escape_string(out, std::get<std::string>(storage()));
+        out << '"';
+        break;
+    case JsonType::Object:
+        serialize_object_compact(out);
+        break;
+    case JsonType::Array:
+        serialize_array_compact(out);
+        break;
+    }
+}
+
+void JsonDocument::serialize_object_to(std::ostream& out, bool pretty, int indent) const {
+    auto obj = members();
+    out << '{';
+    bool first = true;
+    for (const auto& [key, value] : obj) {
+        if (!first) {
+            out << ',';
+        }
+        if (pretty) {
+            out << '\n' << std::string(static_cast<size_t>((indent + 1) * 2), ' ');
+        }
+        out << '"';
+        escape_string(out, key);
+        out << "\":";
+        if (pretty) {
+            out << ' ';
+        }
+        value.serialize_to(out, pretty, indent + 1);
+        first = false;
+    }
+    if (pretty && !obj.empty()) {
+        out << '\n' << std::string(static_cast<size_t>(indent * 2), ' ');
+    }
+    out << '}';
+}
+
+void JsonDocument::serialize_object_compact(std::ostream& out) const {
+    out << '{';
+    bool first = true;
+    for (const auto& [key, value] : members()) {
+        if (!first) {
+            out << ',';
+        }
+        out << '"';
+        escape_string(out, key);
+        out << "\":";
+        value.serialize_compact(out);
+        first = false;
+    }
+    out << '}';
+}
+
+void JsonDocument::serialize_array_compact(std::ostream& out) const {
+    const auto& arr = std::get<std::vector<JsonDocument>>(storage());
+    out << '[';
+    bool first = true;
+    for (const auto& value : arr) {
+        if (!first) {
+            out << ',';
+        }
+        value.serialize_compact(out);
+        first = false;
+    }
+    out << ']';
+}
+
+void JsonDocument::serialize_array_to(std::ostream& out, bool pretty, int indent) const {
+    const auto& arr = std::get<std::vector<JsonDocument>>(storage());
+    out << '[';
+    bool first = true;
+    for (const auto& value : arr) {
+        if (!first) {
+            out << ',';
+        }
+        if (pretty) {
+            out << '\n' << std::string(static_cast<size_t>((indent + 1) * 2), ' ');
+        }
+        value.serialize_to(out, pretty, indent + 1);
+        first = false;
+    }
+    if (pretty && !arr.empty()) {
+        out << '\n' << std::string(static_cast<size_t>(indent * 2), ' ');
+    }
+    out << ']';
+}
+
+void JsonDocument::escape_string(std::ostream& out, const std::string& str) {
+    // Fast path: check if string needs escaping
+    bool needs_escaping = false;
+    // NOLINTNEXTLINE(readability-identifier-length)
+    for (char c : str) {
+        if (c == '"' || c == '\\'
+            || static_cast<unsigned char>(c) < character_constants::MIN_CONTROL_CHAR) {
+            needs_escaping = true;
+            break;
+        }
+    }
+
+    if (!needs_escaping) {
+        // Fast path: output directly
+        out << str;
+        return;
+    }
+
+    // Slow path: escape character by character
+    // NOLINTNEXTLINE(readability-identifier-length)
+    for (char c : str) {
+        switch (c) {
+        case '"':
+            out << "\\\"";
+            break;
+        case '\\':
+            out << "\\\\";
+            break;
+        case '\b':
+            out << "\\b";
+            break;
+        case '\f':
+            out << "\\f";
+            break;
+        case '\n':
+            out << "\\n";
+            break;
+        case '\r':
+            out << "\\r";
+            break;
+        case '\t':
+            out << "\\t";
+            break;
+        default:
+            if (static_cast<unsigned char>(c) < character_constants::MIN_CONTROL_CHAR) {
+                out << "\\u" << std::hex << std::setfill('0') << std::setw(4)
+                    << static_cast<unsigned>(c);
+            } else {
+                out << c;
+            }
+            break;
+        }
+    }
+}
+
+} // namespace jsom
@@ -0,0 +1,180 @@
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "benchmarks/corpus_generators.hpp"
+#include "fuzz_support.hpp"
+
+// Replays inputs through one fuzz target without libFuzzer, so the targets run in every
+// build (including GCC, without sanitizers) and double as a throughput benchmark.
+//
+//   fuzz_replay_<target> [--synthetic] [--history=FILE] [FILE|DIR]...
+//
+// Files and directories (seed corpora, libFuzzer corpora, crash artifacts) are replayed
+// once each. --synthetic adds generated shapes at two sizes and flags any shape whose time
+// per byte grows by more than SCALING_LIMIT as the input grows, which is how algorithmic
+// blowups show up long before an input gets slow enough for the per-input detector.
+// --history appends one JSON line per shape so throughput can be tracked across runs.
+// Exits non-zero when any input was slow or any shape scaled badly.
+
+#ifndef JSOM_FUZZ_TARGET
+#define JSOM_FUZZ_TARGET "fuzz_target"
+#endif
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size);
+
+namespace {
+
+constexpr std::size_t SMALL_BYTES = 16 * 1024;
+constexpr std::size_t SCALE_FACTOR = 8;
+constexpr double SCALING_LIMIT = 4.0;
+constexpr int TIMING_RUNS = 3;
+constexpr std::size_t SMALL_NESTING_DEPTH = 128;
+constexpr double BYTES_PER_MB = 1024.0 * 1024.0;
+
+std::size_t slow_inputs = 0; // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+void count_slow_input(const char* what, std::size_t bytes, double elapsed_ns) {
+    std::fprintf(stderr, "slow input: %s took %.0f ns for %zu bytes (%.1f ns/byte)\n", what,
+                 elapsed_ns, bytes, elapsed_ns / static_cast<double>(bytes == 0 ? 1 : bytes));
+    ++slow_inputs;
+}
+
+// Best of TIMING_RUNS, in nanoseconds
+auto time_input(const std::string& input) -> double {
+    double best = 0.0;
+    for (int run = 0; run < TIMING_RUNS; ++run) {
+        auto start = std::chrono::steady_clock::now();
+        LLVMFuzzerTestOneInput(reinterpret_cast<const uint8_t*>(input.data()), input.size());
+        double elapsed = std::chrono::duration<double, std::nano>(
+                             std::chrono::steady_clock::now() - start)
+                             .count();
+        best = (run == 0) ? elapsed : std::min(best, elapsed);
+    }
+    return best;
+}
+
+auto mb_per_second(std::size_t bytes, double ns) -> double {
+    return ns <= 0.0 ? 0.0 : (static_cast<double>(bytes) / BYTES_PER_MB) / (ns / 1e9);
+}
+
+struct Shape {
+    const char* name;
+    std::string (*generate)(std::size_t target_bytes);
+};
+
+// Nesting grows with the input, so builders that revisit ancestors show up as superlinear
+auto nested_arrays(std::size_t target_bytes) -> std::string {
+    std::size_t depth = SMALL_NESTING_DEPTH * target_bytes / SMALL_BYTES;
+    return std::string(depth, '[') + "1" + std::string(depth, ']');
+}
+
+const std::vector<Shape> SHAPES = {
+    {"geojson", [](std::size_t bytes) { return corpus::geojson(bytes); }},
+    {"twitter", [](std::size_t bytes) { return corpus::twitter(bytes); }},
+    {"deep_config", [](std::size_t bytes) { return corpus::deep_config(bytes); }},
+    {"unicode", [](std::size_t bytes) { return corpus::unicode_strings(bytes); }},
+    {"wide_object", [](std::size_t bytes) { return corpus::wide_object(bytes); }},
+    {"nested_arrays", nested_arrays},
+};
+
+void append_history(const std::string& history, const char* shape, std::size_t bytes,
+                    double mb_per_s) {
+    if (history.empty()) {
+        return;
+    }
+    std::ofstream out(history, std::ios::app);
+    out << R"({"target": ")" << JSOM_FUZZ_TARGET << R"(", "shape": ")" << shape
+        << R"(", "bytes": )" << bytes << R"(, "mb_per_s": )" << mb_per_s
+        << R"(, "time": )" << std::time(nullptr) << "}\n";
+}
+
+auto read_file(const std::filesystem::path& path) -> std::string {
+    std::ifstream in(path, std::ios::binary);
+    return {std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()};
+}
+
+void collect_inputs(const std::filesystem::path& path, std::vector<std::filesystem::path>& out) {
+    if (std::filesystem::is_directory(path)) {
+        for (const auto& entry : std::filesystem::directory_iterator(path)) {
+            if (entry.is_regular_file()) {
+                out.push_back(entry.path());
+            }
+        }
+    } else {
+        out.push_back(path);
+    }
+}
+
+// Returns the number of shapes that scaled badly
+auto run_synthetic(const std::string& history) -> int {
+    int bad_shapes = 0;
+    for (const auto& shape : SHAPES) {
+        std::string small = shape.generate(SMALL_BYTES);
+        std::string large = shape.generate(SMALL_BYTES * SCALE_FACTOR);
+        double small_ns_per_byte = time_input(small) / static_cast<double>(small.size());
+        double large_ns = time_input(large);
+        double growth = (large_ns / static_cast<double>(large.size())) / small_ns_per_byte;
+        double throughput = mb_per_second(large.size(), large_ns);
+
+        bool scaled_badly = growth > SCALING_LIMIT;
+        bad_shapes += scaled_badly ? 1 : 0;
+        std::printf("  %-14s %8.1f MB/s  ns/byte x%.2f at %zux size%s\n", shape.name, throughput,
+                    growth, SCALE_FACTOR, scaled_badly ? "  <-- superlinear" : "");
+        append_history(history, shape.name, large.size(), throughput);
+    }
+    return bad_shapes;
+}
+
+} // namespace
+
+auto main(int argc, char** argv) -> int {
+    fuzz_utils::slow_input_handler() = count_slow_input;
+
+    bool synthetic = false;
+    std::string history;
+    std::vector<std::filesystem::path> inputs;
+    const std::string history_flag = "--history=";
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--synthetic") {
+            synthetic = true;
+        } else if (arg.rfind(history_flag, 0) == 0) {
+            history = arg.substr(history_flag.size());
+        } else {
+            collect_inputs(arg, inputs);
+        }
+    }
+    std::sort(inputs.begin(), inputs.end());
+
+    std::printf("%s\n", JSOM_FUZZ_TARGET);
+    std::size_t total_bytes = 0;
+    double total_ns = 0.0;
+    for (const auto& path : inputs) {
+        std::string input = read_file(path);
+        total_bytes += input.size();
+        total_ns += time_input(input);
+    }
+    if (!inputs.empty()) {
+        double throughput = mb_per_second(total_bytes, total_ns);
+        std::printf("  %-14s %8.1f MB/s  %zu inputs, %zu bytes\n", "corpus", throughput,
+                    inputs.size(), total_bytes);
+        append_history(history, "corpus", total_bytes, throughput);
+    }
+
+    int bad_shapes = synthetic ? run_synthetic(history) : 0;
+    if (slow_inputs > 0 || bad_shapes > 0) {
+        std::printf("  %zu slow inputs, %d superlinear shapes\n", slow_inputs, bad_shapes);
+        return 1;
+    }
+    return 0;
+}
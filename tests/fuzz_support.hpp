@@ -0,0 +1,84 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+// Shared pieces of the libFuzzer targets in tests/fuzzer*.cpp. The same targets also link
+// against tests/fuzz_replay.cpp, which replays a seed corpus through them without libFuzzer.
+namespace fuzz_utils {
+
+// Larger inputs are skipped so one input cannot time out a fuzzing run
+constexpr std::size_t MAX_INPUT_BYTES = 1024 * 1024;
+
+// An input is slow when it takes longer than a fixed allowance plus a per-byte budget. The
+// budget is loose enough for sanitizer builds; linear work stays far below it, while a
+// quadratic path (per-element resize, O(n * depth) building) crosses it within kilobytes.
+constexpr double DEFAULT_SLOW_NS_PER_BYTE = 5000.0;
+constexpr double SLOW_FIXED_ALLOWANCE_NS = 50e6;
+
+// JSOM_FUZZ_SLOW_NS_PER_BYTE overrides the budget; 0 disables the detector
+inline auto slow_ns_per_byte() -> double {
+    static const double budget = []() {
+        const char* value = std::getenv("JSOM_FUZZ_SLOW_NS_PER_BYTE");
+        return (value != nullptr) ? std::strtod(value, nullptr) : DEFAULT_SLOW_NS_PER_BYTE;
+    }();
+    return budget;
+}
+
+using SlowInputHandler = void (*)(const char* what, std::size_t bytes, double elapsed_ns);
+
+// Under libFuzzer a slow input is a finding: abort so the input is saved as a crash artifact
+inline void abort_on_slow_input(const char* what, std::size_t bytes, double elapsed_ns) {
+    std::fprintf(stderr, "slow input: %s took %.0f ns for %zu bytes (%.1f ns/byte)\n", what,
+                 elapsed_ns, bytes, elapsed_ns / static_cast<double>(bytes == 0 ? 1 : bytes));
+    std::abort();
+}
+
+inline auto slow_input_handler() -> SlowInputHandler& {
+    static SlowInputHandler handler = abort_on_slow_input;
+    return handler;
+}
+
+// Times its scope and reports it to the slow input handler when over budget. Exceptions
+// leaving the scope are timed too, so slow error paths are caught as well.
+class SlowInputDetector {
+public:
+    SlowInputDetector(const char* what, std::size_t bytes)
+        : what_(what), bytes_(bytes), start_(std::chrono::steady_clock::now()) {}
+    SlowInputDetector(const SlowInputDetector&) = delete;
+    auto operator=(const SlowInputDetector&) -> SlowInputDetector& = delete;
+    SlowInputDetector(SlowInputDetector&&) = delete;
+    auto operator=(SlowInputDetector&&) -> SlowInputDetector& = delete;
+
+    ~SlowInputDetector() {
+        double budget = slow_ns_per_byte();
+        if (budget <= 0.0) {
+            return;
+        }
+        auto elapsed = std::chrono::duration<double, std::nano>(
+                           std::chrono::steady_clock::now() - start_)
+                           .count();
+        if (elapsed > SLOW_FIXED_ALLOWANCE_NS + (budget * static_cast<double>(bytes_))) {
+            slow_input_handler()(what_, bytes_, elapsed);
+        }
+    }
+
+private:
+    const char* what_;
+    std::size_t bytes_;
+    std::chrono::steady_clock::time_point start_;
+};
+
+// Invariant violations are crashes, so libFuzzer minimises and keeps the input
+inline void check(bool condition, const char* invariant) {
+    if (!condition) {
+        std::fprintf(stderr, "invariant violated: %s\n", invariant);
+        std::abort();
+    }
+}
+
+} // namespace fuzz_utils
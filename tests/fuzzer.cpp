@@ -5,9 +5,11 @@
 #include <iostream>
 #include <jsom/jsom.hpp>
 
+#include "fuzz_support.hpp"
+
 extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
     // Skip very large inputs to avoid timeout
-    if (size > 1024 * 1024) { // 1MB limit
+    if (size > fuzz_utils::MAX_INPUT_BYTES) {
         return 0;
     }
 
@@ -16,7 +18,11 @@ extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
 
     try {
         // Test parsing - this is the primary target
-        auto doc = jsom::parse_document(json_input);
+        jsom::JsonDocument doc;
+        {
+            fuzz_utils::SlowInputDetector timer("parse_document", size);
+            doc = jsom::parse_document(json_input);
+        }
 
         // Test serialization (if parse succeeded)
         std::string output = doc.to_json();
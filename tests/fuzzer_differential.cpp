@@ -0,0 +1,53 @@
+#include <cstddef>
+#include <cstdint>
+#include <jsom/jsom.hpp>
+#include <string>
+
+#include "fuzz_support.hpp"
+
+// FastParser against the event-driven StreamingParser. Whatever the fast parser accepts
+// the streaming parser must accept too, and both must build equal documents. The
+// streaming parser is more lenient about some malformed input, so inputs only it
+// accepts are not findings. It always decodes \u escapes, so the fast parser runs with
+// ParsePresets::Unicode rather than its escape-preserving default. The fast parser with
+// shared object shapes must build the same document as without them.
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+    if (size > fuzz_utils::MAX_INPUT_BYTES) {
+        return 0;
+    }
+    std::string json(reinterpret_cast<const char*>(data), size);
+
+    jsom::JsonDocument fast;
+    bool fast_ok = true;
+    try {
+        fuzz_utils::SlowInputDetector timer("parse_document", size);
+        fast = jsom::parse_document(json, jsom::ParsePresets::Unicode);
+    } catch (const std::exception&) {
+        fast_ok = false;
+    }
+
+    jsom::JsonDocument streamed;
+    bool streamed_ok = true;
+    try {
+        fuzz_utils::SlowInputDetector timer("parse_document_streaming", size);
+        streamed = jsom::parse_document_streaming(json);
+    } catch (const std::exception&) {
+        streamed_ok = false;
+    }
+
+    if (fast_ok) {
+        fuzz_utils::check(streamed_ok, "streaming parser rejected input the fast parser accepted");
+        fuzz_utils::check(fast == streamed, "parsers built different documents");
+        fuzz_utils::check(fast.to_json() == streamed.to_json(),
+                          "parsers serialize differently");
+
+        jsom::JsonParseOptions shaped_options = jsom::ParsePresets::Unicode;
+        shaped_options.share_object_shapes = true;
+        jsom::JsonDocument shaped = jsom::parse_document(json, shaped_options);
+        fuzz_utils::check(shaped == fast, "shared object shapes changed the document");
+        fuzz_utils::check(shaped.to_json() == fast.to_json(),
+                          "shared object shapes serialize differently");
+    }
+    return 0;
+}
@@ -0,0 +1,97 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <jsom/jsom.hpp>
+#include <string>
+#include <vector>
+
+#include "fuzz_support.hpp"
+
+// JSON Pointer navigation. The first line of the input is a pointer and the rest is the
+// document; without a newline the whole input is the document. The fuzzed pointer and the
+// document's own paths are looked up through every entry point, which must agree with each
+// other, with a cache-free copy and with themselves once cached.
+
+namespace {
+
+constexpr std::size_t MAX_LISTED_PATHS = 64;
+constexpr int LIST_DEPTH = 4;
+
+void check_lookup(jsom::JsonDocument& doc, const jsom::JsonDocument& uncached,
+                  const std::string& pointer) {
+    const jsom::JsonDocument* found = doc.find(pointer);
+    fuzz_utils::check(doc.exists(pointer) == (found != nullptr), "exists() disagrees with find()");
+    fuzz_utils::check(doc.find(pointer) == found, "cached find() returned another node");
+
+    const jsom::JsonDocument* fresh = uncached.find(pointer);
+    fuzz_utils::check((fresh != nullptr) == (found != nullptr),
+                      "cached and uncached lookups disagree");
+    if (found != nullptr) {
+        fuzz_utils::check(*fresh == *found, "cached and uncached lookups found different values");
+        fuzz_utils::check(&doc.at(pointer) == found, "at() returned another node than find()");
+    } else {
+        bool threw = false;
+        try {
+            (void)doc.at(pointer);
+        } catch (const std::exception&) {
+            threw = true;
+        }
+        fuzz_utils::check(threw, "at() did not throw for a missing path");
+    }
+
+    if (jsom::JsonPointer::is_valid(pointer)) {
+        fuzz_utils::check(jsom::JsonPointer::build(jsom::JsonPointer::parse(pointer)) == pointer,
+                          "pointer does not survive parse and build");
+    }
+}
+
+} // namespace
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+    if (size > fuzz_utils::MAX_INPUT_BYTES) {
+        return 0;
+    }
+    std::string input(reinterpret_cast<const char*>(data), size);
+    std::string pointer;
+    std::size_t newline = input.find('\n');
+    if (newline != std::string::npos) {
+        pointer = input.substr(0, newline);
+        input.erase(0, newline + 1);
+    }
+
+    jsom::JsonDocument doc;
+    try {
+        doc = jsom::parse_document(input);
+    } catch (const std::exception&) {
+        return 0;
+    }
+    const jsom::JsonDocument uncached = doc;
+
+    try {
+        fuzz_utils::SlowInputDetector timer("pointer navigation", size);
+
+        check_lookup(doc, uncached, pointer);
+
+        auto paths = doc.list_paths(LIST_DEPTH);
+        paths.resize(std::min(paths.size(), MAX_LISTED_PATHS));
+        for (const auto& path : paths) {
+            fuzz_utils::check(doc.exists(path), "listed path does not exist");
+            check_lookup(doc, uncached, path);
+        }
+        auto found = doc.at_multiple(paths);
+        for (std::size_t i = 0; i < paths.size(); ++i) {
+            fuzz_utils::check(found[i] == doc.find(paths[i]), "at_multiple() disagrees with find()");
+        }
+
+        // Removing an object member must make it unreachable, with no stale cache entry
+        if (!pointer.empty() && doc.exists(pointer)) {
+            std::string parent = jsom::JsonPointer::get_parent(pointer);
+            if (doc.at(parent).is_object() && doc.remove_at(pointer)) {
+                fuzz_utils::check(!doc.exists(pointer), "removed member still reachable");
+            }
+        }
+    } catch (const jsom::JsonPointerException&) {
+        // Malformed fuzzed pointers are rejected; that is the expected outcome
+    }
+    return 0;
+}
@@ -0,0 +1,117 @@
+#include <cstddef>
+#include <cstdint>
+#include <jsom/jsom.hpp>
+#include <string>
+#include <vector>
+
+#include "fuzz_support.hpp"
+
+// StreamingParser fed in chunks. The first input byte picks the chunk sizes; the events
+// must match feeding the same text in one piece, and containers must open and close in
+// matching pairs with every value inside the innermost open container.
+
+namespace {
+
+struct EventLog {
+    std::vector<std::string> events;
+    std::vector<std::string> open_paths;
+    bool failed = false;
+
+    auto make_events() -> jsom::ParseEvents {
+        jsom::ParseEvents handlers;
+        handlers.on_value = [this](const jsom::JsonDocument& value, const std::string& path) {
+            if (failed) {
+                return;
+            }
+            fuzz_utils::check(is_child_of_open_container(path),
+                              "value path outside the open container");
+            events.push_back("value " + path + " " + value.to_json());
+        };
+        handlers.on_enter_object = [this](const std::string& path) { enter("object", path); };
+        handlers.on_enter_array = [this](const std::string& path) { enter("array", path); };
+        handlers.on_exit_container = [this](const std::string& path) {
+            if (failed) {
+                return;
+            }
+            fuzz_utils::check(!open_paths.empty() && open_paths.back() == path,
+                              "exit does not match the innermost enter");
+            open_paths.pop_back();
+            events.push_back("exit " + path);
+        };
+        // After the first error the parser keeps reporting trailing input, differently
+        // per chunking, so only the first one is compared
+        handlers.on_error = [this](const jsom::ParseError& error) {
+            if (!failed) {
+                events.push_back("error " + std::to_string(error.position) + " "
+                                 + error.message);
+                failed = true;
+            }
+        };
+        return handlers;
+    }
+
+    void enter(const char* kind, const std::string& path) {
+        if (failed) {
+            return;
+        }
+        fuzz_utils::check(is_child_of_open_container(path),
+                          "container path outside the open container");
+        open_paths.push_back(path);
+        events.push_back(std::string("enter ") + kind + " " + path);
+    }
+
+    [[nodiscard]] auto is_child_of_open_container(const std::string& path) const -> bool {
+        if (open_paths.empty()) {
+            return path.empty();
+        }
+        const std::string& parent = open_paths.back();
+        return path.size() > parent.size() && path.compare(0, parent.size(), parent) == 0
+               && path[parent.size()] == '/'
+               && path.find('/', parent.size() + 1) == std::string::npos;
+    }
+};
+
+} // namespace
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+    if (size < 1 || size > fuzz_utils::MAX_INPUT_BYTES) {
+        return 0;
+    }
+
+    constexpr std::size_t CHUNK_PATTERN_BITS = 4;
+    std::uint8_t chunk_seed = data[0];
+    std::string json(reinterpret_cast<const char*>(data) + 1, size - 1);
+
+    EventLog whole;
+    {
+        fuzz_utils::SlowInputDetector timer("StreamingParser::parse_string", json.size());
+        jsom::StreamingParser parser;
+        parser.set_events(whole.make_events());
+        parser.parse_string(json);
+        parser.end_input();
+    }
+
+    EventLog chunked;
+    {
+        jsom::StreamingParser parser;
+        parser.set_events(chunked.make_events());
+        std::size_t offset = 0;
+        std::size_t round = 0;
+        while (offset < json.size()) {
+            // Chunk sizes 1..16 cycle through a pattern chosen by the seed byte
+            std::size_t chunk
+                = 1 + ((chunk_seed >> (round % CHUNK_PATTERN_BITS)) + round) % 16;
+            parser.parse_string(json.substr(offset, chunk));
+            offset += chunk;
+            ++round;
+        }
+        parser.end_input();
+    }
+
+    fuzz_utils::check(whole.events == chunked.events,
+                      "chunked feeding produced different events");
+    if (!whole.failed) {
+        fuzz_utils::check(whole.open_paths.empty(), "input accepted with containers left open");
+    }
+    return 0;
+}
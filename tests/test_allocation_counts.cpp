@@ -0,0 +1,165 @@
+#include <gtest/gtest.h>
+#include "jsom/jsom.hpp"
+
+#ifdef JSOM_COUNT_ALLOCATIONS
+#include "jsom/allocation_counter.hpp"
+#endif
+
+using namespace jsom;
+
+// Allocation budgets for core operations. Heap allocations are the main cost of a parse,
+// so these fail when a change adds allocations per value. They only run when the counting
+// allocator is linked in (-DJSOM_COUNT_ALLOCATIONS=ON) and skip otherwise.
+
+#ifdef JSOM_COUNT_ALLOCATIONS
+
+namespace {
+
+// Allocations made while running fn
+template <typename Fn> auto count_allocations(Fn&& fn) -> AllocationStats {
+    AllocationStats before = allocation_stats();
+    fn();
+    return allocation_stats() - before;
+}
+
+auto int_array(int count) -> std::string {
+    std::string json = "[";
+    for (int i = 0; i < count; ++i) {
+        json += (i > 0 ? "," : "") + std::to_string(i);
+    }
+    return json + "]";
+}
+
+} // namespace
+
+TEST(AllocationCountsTest, CounterTracksNewAndDelete) {
+    constexpr std::size_t COUNT = 100;
+    static int* volatile values = nullptr; // Volatile so the pair is not optimized away
+    AllocationStats before = allocation_stats();
+    values = new int[COUNT];
+    AllocationStats during = allocation_stats() - before;
+    delete[] values;
+    AllocationStats after = allocation_stats() - before;
+
+    EXPECT_EQ(during.allocations, 1U);
+    EXPECT_EQ(during.allocated_bytes, COUNT * sizeof(int));
+    EXPECT_EQ(after.deallocations, 1U);
+    EXPECT_EQ(after.live_bytes, before.live_bytes);
+}
+
+TEST(AllocationCountsTest, ParseAllocationsScaleWithValues) {
+    std::string small = int_array(100);
+    std::string large = int_array(1000);
+    JsonDocument doc = parse_document(large); // Grow this thread's ParserWorkspace first
+
+    auto small_stats = count_allocations([&]() { doc = parse_document(small); });
+    auto large_stats = count_allocations([&]() { doc = parse_document(large); });
+
+    // At most one allocation per short number, plus a fixed overhead
+    std::size_t per_value = (large_stats.allocations - small_stats.allocations) / 900;
+    EXPECT_LE(per_value, 1U) << "small: " << small_stats.allocations
+                             << ", large: " << large_stats.allocations;
+}
+
+TEST(AllocationCountsTest, MoveDoesNotAllocate) {
+    auto doc = parse_document(R"({"a": [1, 2, 3], "b": {"c": "a string longer than SSO"}})");
+    auto stats = count_allocations([&]() {
+        JsonDocument moved = std::move(doc);
+        doc = std::move(moved);
+    });
+    EXPECT_EQ(stats.allocations, 0U);
+}
+
+TEST(AllocationCountsTest, ScalarAccessDoesNotAllocate) {
+    auto doc = parse_document(R"({"n": 42, "flag": true})");
+    const auto& number = doc["n"];
+    const auto& flag = doc["flag"];
+    auto stats = count_allocations([&]() {
+        EXPECT_EQ(number.as<int>(), 42);
+        EXPECT_TRUE(flag.as<bool>());
+    });
+    EXPECT_EQ(stats.allocations, 0U);
+}
+
+TEST(AllocationCountsTest, KeyLookupDoesNotAllocate) {
+    auto doc = parse_document(R"({"a key longer than the SSO buffer": 1})");
+    const std::string_view key = "a key longer than the SSO buffer";
+    auto stats = count_allocations([&]() {
+        EXPECT_TRUE(doc.contains(key));
+        EXPECT_FALSE(doc.contains("another key longer than the SSO buffer"));
+        EXPECT_EQ(doc["a key longer than the SSO buffer"].as<int>(), 1);
+        doc.set(key, JsonDocument(2)); // Overwriting an existing member keeps its key
+    });
+    EXPECT_EQ(stats.allocations, 0U);
+}
+
+TEST(AllocationCountsTest, ViewAccessorsDoNotAllocate) {
+    auto doc = parse_document(R"({"name": "a string longer than the SSO buffer", "n": 1})");
+    auto stats = count_allocations([&]() {
+        EXPECT_EQ(doc["name"].as_string_view().size(), 35U);
+        EXPECT_NE(doc["name"].get_if<std::string>(), nullptr);
+        std::size_t key_bytes = 0;
+        for (const auto& key : doc.key_view()) {
+            key_bytes += key.size();
+        }
+        EXPECT_EQ(key_bytes, 5U);
+    });
+    EXPECT_EQ(stats.allocations, 0U);
+}
+
+TEST(AllocationCountsTest, WarmWorkspaceAllocatesOnlyTheDocument) {
+    ParserWorkspace workspace;
+    FastParser parser({}, workspace);
+    const std::string json = R"({"key": "short", "rows": [[1, 2], [3, 4, 5]]})";
+    JsonDocument doc = parser.parse(json); // Grows the workspace buffers
+
+    auto stats = count_allocations([&]() { doc = parser.parse(json); });
+    // Two map nodes and three array buffers; keys and strings fit the SSO buffer
+    EXPECT_EQ(stats.allocations, 5U);
+}
+
+TEST(AllocationCountsTest, WarmParseDocumentAllocatesOnlyTheDocument) {
+    JsonDocument doc = parse_document("[1, 2, 3]"); // Grows this thread's ParserWorkspace
+
+    // The parser's unused own workspace and its shape transitions cost nothing
+    EXPECT_EQ(count_allocations([&]() { doc = parse_document("1"); }).allocations, 0U);
+    EXPECT_EQ(count_allocations([&]() { doc = parse_document("[1, 2, 3]"); }).allocations, 1U);
+}
+
+TEST(AllocationCountsTest, MemoryUsageMatchesRetainedHeap) {
+    std::string json = R"({"users": [{"name": "a name longer than the SSO buffer", "id": )"
+                       R"(12345678901234567890123}, {"name": "b", "tags": [1, 2, 3]}]})";
+    parse_document(json); // This thread's ParserWorkspace keeps its scratch, not the document
+    AllocationStats before = allocation_stats();
+    auto doc = parse_document(json);
+    std::size_t retained = allocation_stats().live_bytes - before.live_bytes;
+    EXPECT_EQ(doc.memory_usage().total(), retained);
+}
+
+TEST(AllocationCountsTest, DeepAndDeferredTeardownFreeEverything) {
+    constexpr std::size_t DEPTH = 10000; // Well past the recursive teardown depth
+    AllocationStats before = allocation_stats();
+    {
+        DeferredDestroyer reclaimer;
+        for (int round = 0; round < 2; ++round) {
+            JsonDocument doc = JsonDocument::make_array();
+            for (std::size_t i = 0; i < DEPTH; ++i) {
+                JsonDocument parent = JsonDocument::make_object();
+                parent.set("child", std::move(doc));
+                doc = std::move(parent);
+            }
+            if (round == 0) {
+                reclaimer.destroy(std::move(doc));
+            }
+        }
+    }
+    EXPECT_EQ(allocation_stats().live_bytes, before.live_bytes);
+}
+
+#else
+
+TEST(AllocationCountsTest, RequiresCountingAllocator) {
+    GTEST_SKIP() << "Configure with -DJSOM_COUNT_ALLOCATIONS=ON to run allocation budgets";
+}
+
+#endif
@@ -0,0 +1,147 @@
+#include <gtest/gtest.h>
+#include "jsom/jsom.hpp"
+
+using namespace jsom;
+
+namespace {
+
+auto set_op(const std::string& pointer, JsonDocument value) -> PointerOperation {
+    return PointerOperation::set(pointer, std::move(value));
+}
+
+auto remove_op(const std::string& pointer) -> PointerOperation {
+    return PointerOperation::remove(pointer);
+}
+
+} // namespace
+
+TEST(ApplyBatchTest, MatchesSequentialSetAndRemove) {
+    const std::string json = R"({"a": {"x": 1, "y": 2}, "b": [1, 2], "c": "keep"})";
+    auto batched = parse_document(json);
+    auto sequential = parse_document(json);
+
+    std::vector<PointerOperation> ops;
+    ops.push_back(set_op("/a/z", JsonDocument(3)));
+    ops.push_back(remove_op("/a/x"));
+    ops.push_back(set_op("/b/1", JsonDocument("two")));
+    ops.push_back(set_op("/d", JsonDocument::make_object()));
+    ops.push_back(set_op("/d/nested", JsonDocument(true)));
+    ops.push_back(remove_op("/missing"));
+
+    for (const auto& op : ops) {
+        if (op.kind == PointerOperation::Kind::Set) {
+            sequential.set_at(op.pointer, op.value);
+        } else {
+            sequential.remove_at(op.pointer);
+        }
+    }
+    EXPECT_EQ(batched.apply_batch(std::move(ops)), 5U);
+    EXPECT_EQ(batched, sequential);
+}
+
+TEST(ApplyBatchTest, ArrayRemovalRunsUseIndicesFromBeforeTheRun) {
+    auto doc = parse_document(R"({"items": [0, 1, 2, 3, 4, 5]})");
+    std::vector<PointerOperation> ops;
+    ops.push_back(set_op("/items/5", JsonDocument(50)));
+    ops.push_back(remove_op("/items/1"));
+    ops.push_back(remove_op("/items/4"));
+    ops.push_back(remove_op("/items/3"));
+    ops.push_back(remove_op("/items/9"));
+
+    EXPECT_EQ(doc.apply_batch(std::move(ops)), 4U);
+    EXPECT_EQ(doc.to_json(), R"({"items":[0,2,50]})");
+}
+
+TEST(ApplyBatchTest, SeparateRemovalRunsApplyInOrder) {
+    auto doc = parse_document(R"({"items": [0, 1, 2, 3], "other": 1})");
+    std::vector<PointerOperation> ops;
+    ops.push_back(remove_op("/items/0"));
+    ops.push_back(set_op("/other", JsonDocument(2)));
+    ops.push_back(remove_op("/items/0"));
+
+    EXPECT_EQ(doc.apply_batch(std::move(ops)), 3U);
+    EXPECT_EQ(doc.to_json(), R"({"items":[2,3],"other":2})");
+}
+
+TEST(ApplyBatchTest, SharedPrefixesFollowEarlierMutations) {
+    auto doc = parse_document(R"({"a": {"b": {"old": true}}, "list": [{"x": 1}, {"x": 2}]})");
+    std::vector<PointerOperation> ops;
+    ops.push_back(set_op("/a/b/c", JsonDocument(1)));
+    ops.push_back(set_op("/a/b", JsonDocument::make_object())); // Replaces the node walked above
+    ops.push_back(set_op("/a/b/d", JsonDocument(2)));
+    ops.push_back(set_op("/list/0/y", JsonDocument(3)));
+    ops.push_back(set_op("/list/5", JsonDocument::make_object())); // Reallocates the array
+    ops.push_back(set_op("/list/1/y", JsonDocument(4)));
+    ops.push_back(set_op("/a~1b", JsonDocument(5)));
+
+    doc.apply_batch(std::move(ops));
+    EXPECT_EQ(doc.to_json(), R"({"a":{"b":{"d":2}},"a/b":5,)"
+                             R"("list":[{"x":1,"y":3},{"x":2,"y":4},null,null,null,{}]})");
+}
+
+TEST(ApplyBatchTest, LaterOperationsWin) {
+    auto doc = parse_document(R"({"a": {"b": 1}})");
+    std::vector<PointerOperation> ops;
+    ops.push_back(set_op("/a/b", JsonDocument(2)));
+    ops.push_back(set_op("/a/c", JsonDocument(3)));
+    ops.push_back(set_op("/a", JsonDocument::make_object())); // Replaces both sets above
+    ops.push_back(set_op("/a/d", JsonDocument(4)));           // Lands in the new object
+    ops.push_back(remove_op("/e"));
+    ops.push_back(set_op("/e", JsonDocument(5)));
+
+    EXPECT_EQ(doc.apply_batch(std::move(ops)), 5U);
+    EXPECT_EQ(doc.to_json(), R"({"a":{"d":4},"e":5})");
+}
+
+TEST(ApplyBatchTest, SetsRootAndBuildsBelowIt) {
+    JsonDocument doc(42);
+    std::vector<PointerOperation> ops;
+    ops.push_back(set_op("", JsonDocument::make_array()));
+    ops.push_back(set_op("/0", JsonDocument("first")));
+    ops.push_back(remove_op("")); // The root cannot be removed
+
+    EXPECT_EQ(doc.apply_batch(std::move(ops)), 2U);
+    EXPECT_EQ(doc.to_json(), R"(["first"])");
+}
+
+TEST(ApplyBatchTest, ThrowsLikeSetAt) {
+    auto doc = parse_document(R"({"a": {"b": 1}, "list": [1]})");
+
+    std::vector<PointerOperation> missing_parent;
+    missing_parent.push_back(set_op("/x/y", JsonDocument(1)));
+    EXPECT_THROW(doc.apply_batch(std::move(missing_parent)), JsonPointerNotFoundException);
+
+    std::vector<PointerOperation> scalar_parent;
+    scalar_parent.push_back(set_op("/a/b/c", JsonDocument(1)));
+    EXPECT_THROW(doc.apply_batch(std::move(scalar_parent)), JsonPointerTypeException);
+
+    std::vector<PointerOperation> key_in_array;
+    key_in_array.push_back(set_op("/list/key", JsonDocument(1)));
+    EXPECT_THROW(doc.apply_batch(std::move(key_in_array)), JsonPointerTypeException);
+
+    // Invalid pointers are rejected before anything is applied
+    std::vector<PointerOperation> invalid;
+    invalid.push_back(set_op("/a/b", JsonDocument(2)));
+    invalid.push_back(set_op("no-slash", JsonDocument(1)));
+    EXPECT_THROW(doc.apply_batch(std::move(invalid)), InvalidJsonPointerException);
+    EXPECT_EQ(doc.at("/a/b").as<int>(), 1);
+
+    std::vector<PointerOperation> below_removed;
+    below_removed.push_back(remove_op("/a"));
+    below_removed.push_back(set_op("/a/b", JsonDocument(1)));
+    EXPECT_THROW(doc.apply_batch(std::move(below_removed)), JsonPointerNotFoundException);
+}
+
+TEST(ApplyBatchTest, InvalidatesPathCache) {
+    auto doc = parse_document(R"({"a": {"b": [1, 2, 3]}})");
+    EXPECT_EQ(doc.at("/a/b/2").as<int>(), 3);
+
+    std::vector<PointerOperation> ops;
+    ops.push_back(remove_op("/a/b/0"));
+    ops.push_back(set_op("/a/c", JsonDocument(7)));
+    doc.apply_batch(std::move(ops));
+
+    EXPECT_EQ(doc.at("/a/b/1").as<int>(), 3);
+    EXPECT_FALSE(doc.exists("/a/b/2"));
+    EXPECT_EQ(doc.at("/a/c").as<int>(), 7);
+}
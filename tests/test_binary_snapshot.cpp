@@ -0,0 +1,129 @@
+#include <gtest/gtest.h>
+#include "jsom/binary_snapshot.hpp"
+#include "jsom/jsom.hpp"
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+using namespace jsom;
+
+namespace {
+
+auto snapshot_of(const std::string& json) -> BinarySnapshot {
+    return BinarySnapshot::from_bytes(SnapshotWriter::write(parse_document(json)));
+}
+
+const std::string SAMPLE = R"({
+    "users": [
+        {"name": "Alice", "age": 30, "email": "alice@example.com"},
+        {"name": "Bob", "age": 25.50, "tags": ["x", "y\n\"z\""]}
+    ],
+    "config": {"debug": true, "verbose": false, "level": null, "a/b": 1, "m~n": 2},
+    "empty_object": {},
+    "empty_array": [],
+    "": "empty key"
+})";
+
+} // namespace
+
+TEST(BinarySnapshotTest, RoundTripsToEqualDocument) {
+    auto doc = parse_document(SAMPLE);
+    auto snapshot = BinarySnapshot::from_bytes(SnapshotWriter::write(doc));
+
+    EXPECT_EQ(snapshot.root().to_document(), doc);
+    EXPECT_EQ(snapshot.root().to_json(), doc.to_json());
+}
+
+TEST(BinarySnapshotTest, ScalarRoots) {
+    for (const std::string json : {"null", "true", "false", "42", "-1.5e10", "\"text\""}) {
+        auto snapshot = snapshot_of(json);
+        EXPECT_EQ(snapshot.root().to_json(), json);
+    }
+}
+
+TEST(BinarySnapshotTest, NumbersKeepOriginalText) {
+    auto snapshot = snapshot_of(R"({"n": 25.50, "big": 12345678901234567890})");
+    EXPECT_EQ(snapshot.root().at("/n").text(), "25.50");
+    EXPECT_EQ(snapshot.root().at("/big").text(), "12345678901234567890");
+    EXPECT_EQ(snapshot.root().at("/n").to_document().as<double>(), 25.5);
+}
+
+TEST(BinarySnapshotTest, NavigatesWithJsonPointer) {
+    auto snapshot = snapshot_of(SAMPLE);
+    auto root = snapshot.root();
+
+    EXPECT_EQ(root.at("/users/0/name").text(), "Alice");
+    EXPECT_EQ(root.at("/users/1/tags/1").text(), "y\n\"z\"");
+    EXPECT_TRUE(root.at("/config/debug").as_bool());
+    EXPECT_EQ(root.at("/config/level").type(), JsonType::Null);
+    EXPECT_EQ(root.at("/config/a~1b").text(), "1");
+    EXPECT_EQ(root.at("/config/m~0n").text(), "2");
+    EXPECT_EQ(root.at("/").text(), "empty key");
+    EXPECT_EQ(root.at("").size(), 5);
+}
+
+TEST(BinarySnapshotTest, MissingPaths) {
+    auto snapshot = snapshot_of(SAMPLE);
+    auto root = snapshot.root();
+
+    EXPECT_FALSE(root.find("/nope").has_value());
+    EXPECT_FALSE(root.find("/users/2").has_value());
+    EXPECT_FALSE(root.find("/users/name").has_value());
+    EXPECT_FALSE(root.find("/users/0/name/first").has_value());
+    EXPECT_FALSE(root.find("/empty_array/0").has_value());
+    EXPECT_THROW((void)root.at("/nope"), JsonPointerNotFoundException);
+    EXPECT_THROW((void)root.find("no-slash"), InvalidJsonPointerException);
+}
+
+TEST(BinarySnapshotTest, ObjectMembersAreSorted) {
+    auto snapshot = snapshot_of(R"({"zeta": 1, "alpha": 2, "mid": 3})");
+    auto root = snapshot.root();
+
+    ASSERT_EQ(root.size(), 3);
+    EXPECT_EQ(root.key_at(0), "alpha");
+    EXPECT_EQ(root.key_at(1), "mid");
+    EXPECT_EQ(root.key_at(2), "zeta");
+    EXPECT_EQ(root.member("mid")->text(), "3");
+    EXPECT_FALSE(root.member("beta").has_value());
+}
+
+TEST(BinarySnapshotTest, RejectsInvalidInput) {
+    EXPECT_THROW(BinarySnapshot::from_bytes("{\"a\": 1}"), SnapshotException);
+    EXPECT_THROW(BinarySnapshot::from_bytes("JSOMB"), SnapshotException);
+
+    std::string bytes = SnapshotWriter::write(parse_document(SAMPLE));
+    std::string wrong_version = bytes;
+    wrong_version[snapshot_constants::VERSION_OFFSET] = 99;
+    EXPECT_THROW(BinarySnapshot::from_bytes(wrong_version), SnapshotException);
+
+    // Truncating the body leaves the root offset pointing past the end
+    std::string truncated = bytes.substr(0, bytes.size() / 2);
+    EXPECT_THROW(BinarySnapshot::from_bytes(truncated).root().to_json(), SnapshotException);
+
+    // An element pointing back at its own array would recurse forever
+    std::string cyclic = SnapshotWriter::write(parse_document("[1]"));
+    std::uint64_t root = 0;
+    std::memcpy(&root, &cyclic[snapshot_constants::ROOT_OFFSET], sizeof(root));
+    std::memcpy(&cyclic[root + 1 + snapshot_constants::LENGTH_SIZE], &root, sizeof(root));
+    auto snapshot = BinarySnapshot::from_bytes(cyclic);
+    EXPECT_THROW(snapshot.root().to_json(), SnapshotException);
+    EXPECT_THROW(snapshot.root().to_document(), SnapshotException);
+    EXPECT_THROW(static_cast<void>(snapshot.root().element(0)), SnapshotException);
+}
+
+TEST(BinarySnapshotTest, OpensMappedFile) {
+    std::string path = testing::TempDir() + "jsom_snapshot_test.jsomb";
+    {
+        std::ofstream out(path, std::ios::binary);
+        out << SnapshotWriter::write(parse_document(SAMPLE));
+    }
+
+    EXPECT_TRUE(BinarySnapshot::is_snapshot_file(path));
+    auto snapshot = BinarySnapshot::open(path);
+    EXPECT_EQ(snapshot.root().at("/users/1/name").text(), "Bob");
+    EXPECT_EQ(snapshot.root().to_document(), parse_document(SAMPLE));
+
+    std::remove(path.c_str());
+    EXPECT_FALSE(BinarySnapshot::is_snapshot_file(path));
+    EXPECT_THROW(BinarySnapshot::open(path), std::runtime_error);
+}
@@ -0,0 +1,165 @@
+#include <gtest/gtest.h>
+#include "jsom/compiled_query.hpp"
+#include "jsom/jsom.hpp"
+
+using namespace jsom;
+
+namespace {
+
+// Collect the matched text for one pattern, in match order
+auto values_for(const std::string& json, const CompiledQuery& query, std::size_t pattern)
+    -> std::vector<std::string> {
+    std::vector<std::string> values;
+    for (const auto& match : query.extract(json)) {
+        if (match.pattern == pattern) {
+            values.push_back(json.substr(match.offset, match.length));
+        }
+    }
+    return values;
+}
+
+} // namespace
+
+TEST(CompiledQueryTest, ExactPaths) {
+    CompiledQuery query({"/user/id", "/user/name", "/active"});
+    std::string json = R"({"user": {"id": 42, "name": "Alice", "tags": [1, 2]}, "active": true})";
+
+    EXPECT_EQ(values_for(json, query, 0), std::vector<std::string>{"42"});
+    EXPECT_EQ(values_for(json, query, 1), std::vector<std::string>{"\"Alice\""});
+    EXPECT_EQ(values_for(json, query, 2), std::vector<std::string>{"true"});
+}
+
+TEST(CompiledQueryTest, ContainerValuesAreRawSpans) {
+    CompiledQuery query({"/user"});
+    std::string json = R"({"user": {"id": 1, "roles": ["a", "b"]}, "x": 0})";
+
+    auto values = values_for(json, query, 0);
+    ASSERT_EQ(values.size(), 1);
+    EXPECT_EQ(values[0], R"({"id": 1, "roles": ["a", "b"]})");
+    EXPECT_EQ(parse_document(values[0]), parse_document(json)["user"]);
+}
+
+TEST(CompiledQueryTest, ArrayIndices) {
+    CompiledQuery query({"/items/1/name", "/items/10"});
+    std::string json = R"({"items": [{"name": "zero"}, {"name": "one"}, {"name": "two"}]})";
+
+    EXPECT_EQ(values_for(json, query, 0), std::vector<std::string>{"\"one\""});
+    EXPECT_TRUE(values_for(json, query, 1).empty());
+}
+
+TEST(CompiledQueryTest, WildcardMatchesKeysAndIndices) {
+    CompiledQuery query({"/users/*/email", "/meta/*"});
+    std::string json = R"({
+        "users": [{"email": "a@x"}, {"name": "no email"}, {"email": "c@x"}],
+        "meta": {"version": 2, "source": "api"}
+    })";
+
+    EXPECT_EQ(values_for(json, query, 0), (std::vector<std::string>{"\"a@x\"", "\"c@x\""}));
+    EXPECT_EQ(values_for(json, query, 1), (std::vector<std::string>{"2", "\"api\""}));
+}
+
+TEST(CompiledQueryTest, WildcardAndExactOverlap) {
+    CompiledQuery query({"/a/*/v", "/a/b/v"});
+    std::string json = R"({"a": {"b": {"v": 1}, "c": {"v": 2}}})";
+
+    EXPECT_EQ(values_for(json, query, 0), (std::vector<std::string>{"1", "2"}));
+    EXPECT_EQ(values_for(json, query, 1), std::vector<std::string>{"1"});
+}
+
+TEST(CompiledQueryTest, SharedPrefixesAndNestedMatches) {
+    CompiledQuery query({"/a", "/a/b", "/a/b/c"});
+    std::string json = R"({"a": {"b": {"c": 3}}})";
+
+    auto matches = query.extract(json);
+    ASSERT_EQ(matches.size(), 3);
+    // Inner values finish scanning first
+    EXPECT_EQ(matches[0].pattern, 2);
+    EXPECT_EQ(matches[1].pattern, 1);
+    EXPECT_EQ(matches[2].pattern, 0);
+}
+
+TEST(CompiledQueryTest, EscapedPointerSegments) {
+    CompiledQuery query({"/a~1b", "/m~0n"});
+    std::string json = R"({"a/b": 1, "m~n": 2})";
+
+    EXPECT_EQ(values_for(json, query, 0), std::vector<std::string>{"1"});
+    EXPECT_EQ(values_for(json, query, 1), std::vector<std::string>{"2"});
+}
+
+TEST(CompiledQueryTest, EscapedJsonKeys) {
+    CompiledQuery query({"/say \"hi\"", "/line\nbreak"});
+    std::string json = R"({"say \"hi\"": 1, "line\nbreak": 2})";
+
+    EXPECT_EQ(values_for(json, query, 0), std::vector<std::string>{"1"});
+    EXPECT_EQ(values_for(json, query, 1), std::vector<std::string>{"2"});
+}
+
+TEST(CompiledQueryTest, RootPattern) {
+    CompiledQuery query({""});
+    std::string json = R"(  [1, 2, 3]  )";
+
+    EXPECT_EQ(values_for(json, query, 0), std::vector<std::string>{"[1, 2, 3]"});
+}
+
+TEST(CompiledQueryTest, NoMatches) {
+    CompiledQuery query({"/missing", "/a/b"});
+    EXPECT_TRUE(query.extract(R"({"a": 1, "b": {"c": [true, null]}})").empty());
+    EXPECT_TRUE(query.extract(R"([1, 2, 3])").empty());
+    EXPECT_TRUE(query.extract(R"("scalar")").empty());
+}
+
+TEST(CompiledQueryTest, SkipsStringsContainingBrackets) {
+    CompiledQuery query({"/after"});
+    std::string json = R"({"noise": {"s": "}]\"[{"}, "after": "ok"})";
+
+    EXPECT_EQ(values_for(json, query, 0), std::vector<std::string>{"\"ok\""});
+}
+
+TEST(CompiledQueryTest, MalformedInputThrows) {
+    CompiledQuery query({"/a"});
+    EXPECT_THROW(query.extract(R"({"a": 1)"), std::runtime_error);
+    EXPECT_THROW(query.extract(R"({"a" 1})"), std::runtime_error);
+    EXPECT_THROW(query.extract(R"({"x": [1, 2})"), std::runtime_error);
+    EXPECT_THROW(query.extract(R"({"a": 1} trailing)"), std::runtime_error);
+    EXPECT_THROW(query.extract(R"({"a": "unterminated)"), std::runtime_error);
+}
+
+TEST(CompiledQueryTest, InvalidLiteralsThrow) {
+    CompiledQuery query({"/a"});
+    for (const char* json : {"bad", R"({"a": tru})", R"({"b": nul, "a": 1})", R"({"a": 01})",
+                             R"({"a": 1.})", R"({"a": -})", R"({"a": 1e+})", R"({"a": 0x1})"}) {
+        EXPECT_THROW(query.extract(json), std::runtime_error) << json;
+    }
+    for (const char* json : {"null", R"({"a": -0.5e+3})", R"({"a": false, "b": 1E2})"}) {
+        EXPECT_NO_THROW(query.extract(json)) << json;
+    }
+}
+
+TEST(CompiledQueryTest, MalformedSkippedContainersThrow) {
+    CompiledQuery query({"/a"});
+    for (const char* json :
+         {R"({"b": [tru :: x, {"k" 1}], "a": 1})", R"({"b": [1 2], "a": 1})",
+          R"({"b": {"k": 1 "j": 2}, "a": 1})", R"({"b": {1: 2}, "a": 1})",
+          R"({"b": [1,], "a": 1})", R"({"b": {"k": 1,}, "a": 1})", R"({"b": [:], "a": 1})",
+          R"({"b": {"k"}, "a": 1})", R"({"b": [1}, "a": 1})", R"({"b": [nul], "a": 1})"}) {
+        EXPECT_THROW(query.extract(json), std::runtime_error) << json;
+    }
+    std::string valid = R"({"b": [[], {}, {"k": [true, null, -1.5e3, "s"]}, [{"j": {}}]], "a": 1})";
+    EXPECT_EQ(values_for(valid, query, 0), std::vector<std::string>{"1"});
+}
+
+TEST(CompiledQueryTest, InvalidPatternThrows) {
+    EXPECT_THROW(CompiledQuery({"no-leading-slash"}), std::exception);
+}
+
+TEST(CompiledQueryTest, ReusableAcrossDocuments) {
+    CompiledQuery query({"/id"});
+    std::vector<QueryMatch> matches;
+    for (int i = 0; i < 3; ++i) {
+        std::string json = R"({"id": )" + std::to_string(i) + "}";
+        matches.clear();
+        query.extract(json, matches);
+        ASSERT_EQ(matches.size(), 1);
+        EXPECT_EQ(json.substr(matches[0].offset, matches[0].length), std::to_string(i));
+    }
+}
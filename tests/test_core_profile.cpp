@@ -0,0 +1,39 @@
+#include <gtest/gtest.h>
+#include "jsom/jsom_core.hpp"
+
+// Only jsom_core.hpp is included: everything here must keep working in JSOM_PROFILE=core
+// builds, which leave out the formatter and streaming parser headers.
+
+using namespace jsom;
+using namespace jsom::literals;
+
+TEST(CoreProfileTest, ParsesAndSerializesCompact) {
+    auto doc = parse_document(R"({"name": "jsom", "tags": ["a", "b"], "size": 3})");
+    EXPECT_EQ(doc.to_json(), R"({"name":"jsom","size":3,"tags":["a","b"]})");
+}
+
+TEST(CoreProfileTest, PrettyPrintsWithoutFormatter) {
+    auto doc = parse_document(R"({"a": [1, 2]})");
+    EXPECT_EQ(doc.to_json(true), "{\n  \"a\": [\n    1,\n    2\n  ]\n}");
+}
+
+TEST(CoreProfileTest, NavigatesWithJsonPointer) {
+    auto doc = R"({"a": {"b": [10, 20]}})"_jsom;
+    EXPECT_EQ(doc.at("/a/b/1").as<int>(), 20);
+    EXPECT_TRUE(doc.exists("/a/b/0"));
+    EXPECT_EQ(doc.find("/a/c"), nullptr);
+}
+
+TEST(CoreProfileTest, SerializesComputedNumbers) {
+    Document doc = Document::make_array();
+    doc.push_back(Document(2.5));
+    doc.push_back(Document(1e-7));
+    doc.push_back(Document(42));
+    EXPECT_EQ(doc.to_json(), "[2.5,1e-07,42]");
+    EXPECT_EQ(doc.to_json(true), "[\n  2.5,\n  1e-07,\n  42\n]");
+}
+
+TEST(CoreProfileTest, ParsesWithOptions) {
+    auto doc = parse_document(R"(["é"])", ParsePresets::Unicode);
+    EXPECT_EQ(doc[0].as<std::string>(), "\xC3\xA9");
+}
@@ -0,0 +1,287 @@
+#include <gtest/gtest.h>
+#include "jsom/jsom.hpp"
+#include "jsom/json_diff.hpp"
+#include <utility>
+
+using namespace jsom;
+
+namespace {
+
+// Posts by two authors; each author's object appears once per post
+const std::string POSTS = R"([
+    {"id": 1, "user": {"name": "ann", "roles": ["admin", "dev"]}, "tags": ["a", "b"]},
+    {"id": 2, "user": {"name": "bob", "roles": ["dev"]}, "tags": ["a", "b"]},
+    {"id": 3, "user": {"name": "ann", "roles": ["admin", "dev"]}, "tags": []},
+    {"id": 4, "user": {"name": "ann", "roles": ["admin", "dev"]}, "tags": ["a", "b"]}
+])";
+
+auto deduplicated(const std::string& json) -> JsonDocument {
+    auto doc = parse_document(json);
+    doc.deduplicate();
+    return doc;
+}
+
+} // namespace
+
+TEST(DeduplicateTest, IdenticalSubtreesShareOneValue) {
+    auto doc = parse_document(POSTS);
+    auto stats = doc.deduplicate();
+    const auto& posts = doc;
+
+    EXPECT_TRUE(posts[0]["user"].is_shared());
+    EXPECT_EQ(&posts[0]["user"]["name"], &posts[2]["user"]["name"]);
+    EXPECT_EQ(&posts[0]["user"]["name"], &posts[3]["user"]["name"]);
+    EXPECT_NE(&posts[0]["user"]["name"], &posts[1]["user"]["name"]);
+    EXPECT_EQ(&posts[0]["tags"][0], &posts[3]["tags"][0]);
+    EXPECT_FALSE(posts[2]["tags"].is_shared()); // Empty containers own nothing to share
+    EXPECT_FALSE(posts[0].is_shared());         // Differs by id
+
+    // ann's object and her roles twice more each, ["a", "b"] twice more
+    EXPECT_EQ(stats.replaced, 6U);
+    // ann, her roles and ["a", "b"]; bob's ["dev"] differs from ann's roles
+    EXPECT_EQ(stats.distinct, 3U);
+    EXPECT_EQ(stats.containers, 15U);
+}
+
+TEST(DeduplicateTest, ReadsAreUnchanged) {
+    auto plain = parse_document(POSTS);
+    auto doc = deduplicated(POSTS);
+    const auto& view = doc;
+
+    EXPECT_EQ(view.to_json(), plain.to_json());
+    EXPECT_EQ(view.to_json(true), plain.to_json(true));
+    EXPECT_EQ(view.to_json(FormatPresets::Pretty), plain.to_json(FormatPresets::Pretty));
+    EXPECT_EQ(view, plain);
+    EXPECT_TRUE(JsonDiff::diff(plain, view).empty());
+    EXPECT_EQ(JsonDiff::hash(view), JsonDiff::hash(plain));
+    EXPECT_EQ(view.list_paths(), plain.list_paths());
+
+    EXPECT_EQ(view.at("/3/user/roles/1").as<std::string>(), "dev");
+    EXPECT_EQ(view.find("/2/user/missing"), nullptr);
+    EXPECT_TRUE(view.exists("/0/tags/1"));
+    EXPECT_EQ(view[2]["user"].size(), 2U);
+    EXPECT_EQ(view[2]["user"].keys(), (std::vector<std::string>{"name", "roles"}));
+    EXPECT_EQ(view[2]["user"].as_object().size(), 2U);
+    EXPECT_EQ(view[2]["user"]["roles"].as_array().size(), 2U);
+
+    std::vector<std::string> names;
+    for (const auto& post : view) {
+        for (const auto& [key, value] : post["user"].items()) {
+            if (key == "name") {
+                names.push_back(value.as<std::string>());
+            }
+        }
+    }
+    EXPECT_EQ(names, (std::vector<std::string>{"ann", "bob", "ann", "ann"}));
+    EXPECT_TRUE(view[2]["user"].is_shared()); // Const reads never copy
+}
+
+TEST(DeduplicateTest, NumbersShareOnlyWhenTheTextMatches) {
+    auto doc = deduplicated(R"([[1.0, 2], [1, 2], [1.0, 2]])");
+    const auto& view = doc;
+    EXPECT_EQ(&view[0][0], &view[2][0]);
+    EXPECT_NE(&view[0][0], &view[1][0]); // Equal under operator==, but printed differently
+    EXPECT_EQ(view.to_json(), "[[1.0,2],[1,2],[1.0,2]]");
+}
+
+TEST(DeduplicateTest, ChangesCopyOnWrite) {
+    auto doc = deduplicated(POSTS);
+
+    doc[2]["user"].set("name", JsonDocument("cy"));
+    EXPECT_FALSE(doc[2]["user"].is_shared());
+    EXPECT_TRUE(doc[2]["user"]["roles"].is_shared()); // Copied one level: children stay shared
+    EXPECT_EQ(doc.at("/0/user/name").as<std::string>(), "ann");
+    EXPECT_EQ(doc.at("/2/user/name").as<std::string>(), "cy");
+
+    doc.set_at("/3/user/roles/0", JsonDocument("owner"));
+    doc.at("/0/tags/1") = JsonDocument("z");
+    *doc.find("/3/tags/0") = JsonDocument("y");
+    EXPECT_TRUE(doc.remove_at("/0/user/roles/1"));
+    doc.apply_batch({PointerOperation::set("/2/user/roles/0", "lead")});
+    for (auto& post : doc) {
+        if (post["id"].as<int>() == 4) {
+            post["user"]["roles"].push_back(JsonDocument("ops"));
+        }
+    }
+    EXPECT_EQ(doc.to_json(),
+              R"([{"id":1,"tags":["a","z"],"user":{"name":"ann","roles":["admin"]}},)"
+              R"({"id":2,"tags":["a","b"],"user":{"name":"bob","roles":["dev"]}},)"
+              R"({"id":3,"tags":[],"user":{"name":"cy","roles":["lead","dev"]}},)"
+              R"({"id":4,"tags":["y","b"],"user":{"name":"ann","roles":["owner","dev","ops"]}}])");
+}
+
+TEST(DeduplicateTest, MapAccessCopiesOnlyWhenWriting) {
+    auto doc = deduplicated(POSTS);
+    for (auto& [key, value] : doc[3]["user"].items()) {
+        if (key == "name") {
+            value = JsonDocument("dee");
+        }
+    }
+    EXPECT_EQ(doc.at("/3/user/name").as<std::string>(), "dee");
+    EXPECT_EQ(doc.at("/0/user/name").as<std::string>(), "ann");
+
+    auto* roles = doc[0]["user"]["roles"].get_if<std::vector<JsonDocument>>();
+    ASSERT_NE(roles, nullptr);
+    roles->clear();
+    EXPECT_EQ(doc.at("/2/user/roles").size(), 2U);
+}
+
+TEST(DeduplicateTest, CopiesShareAndStayIndependent) {
+    auto doc = deduplicated(POSTS);
+    auto copy = doc;
+    const auto& original = doc;
+    const auto& duplicate = copy;
+    EXPECT_EQ(&original[0]["user"]["name"], &duplicate[0]["user"]["name"]);
+
+    copy[0]["user"].set("name", JsonDocument("changed"));
+    EXPECT_EQ(doc.at("/0/user/name").as<std::string>(), "ann");
+    EXPECT_EQ(copy.at("/0/user/name").as<std::string>(), "changed");
+    EXPECT_EQ(copy.at("/2/user/name").as<std::string>(), "ann");
+}
+
+TEST(DeduplicateTest, PathCachesNeverLeadIntoSharedValues) {
+    auto doc = parse_document(POSTS);
+    EXPECT_EQ(doc.at("/2/user/name").as<std::string>(), "ann"); // Cached before the pass
+    doc.deduplicate();
+    const auto& view = doc;
+    EXPECT_EQ(view.at("/2/user/name").as<std::string>(), "ann");
+    // The walk cached /2 and the holder /2/user, but nothing inside the shared value
+    EXPECT_EQ(doc.get_path_cache_stats().exact_cache_size, 0U);
+    EXPECT_EQ(doc.get_path_cache_stats().prefix_cache_size, 2U);
+
+    doc.at("/2/user/name") = JsonDocument("cy"); // Copies /2/user, then caches its own name
+    EXPECT_EQ(doc.get_path_cache_stats().exact_cache_size, 1U);
+    EXPECT_EQ(view.at("/2/user/name").as<std::string>(), "cy");
+    EXPECT_EQ(view.at("/0/user/name").as<std::string>(), "ann");
+    EXPECT_EQ(view.at("/3/user/name").as<std::string>(), "ann");
+    EXPECT_THROW(doc.at("/2/user/missing"), JsonPointerNotFoundException);
+    EXPECT_THROW(doc.at("bad"), InvalidJsonPointerException);
+    EXPECT_EQ(doc.find("/9"), nullptr);
+}
+
+TEST(DeduplicateTest, OtherDocumentsKeepTheirCaches) {
+    auto plain = parse_document(R"({"a": {"b": {"c": 1}}})");
+    auto doc = deduplicated(POSTS); // Shared values elsewhere change nothing for `plain`
+    plain.at("/a/b/c") = JsonDocument(2);
+    EXPECT_EQ(plain.get_path_cache_stats().exact_cache_size, 1U);
+    EXPECT_EQ(plain.find("/a/b/c")->as<int>(), 2);
+    EXPECT_TRUE(doc[0]["user"].is_shared());
+}
+
+TEST(DeduplicateTest, MemoryUsageCountsSharedValuesOnce) {
+    std::string json = "[";
+    for (int i = 0; i < 100; ++i) {
+        json += (i == 0 ? "" : ",");
+        json += R"({"post": )" + std::to_string(i)
+                + R"(, "author": {"display_name": "a long display name", "id": 12345678901234,)"
+                + R"( "groups": ["administrators", "developers"]}})";
+    }
+    json += "]";
+    auto plain = parse_document(json);
+    auto doc = deduplicated(json);
+    auto usage = doc.memory_usage();
+    EXPECT_GT(usage.shared, 0U);
+    EXPECT_LT(usage.total() * 2, plain.memory_usage().total()); // One author instead of 100
+
+    // A copy of the document holds every value twice as often: each pays half
+    auto copy = doc;
+    EXPECT_LT(doc.memory_usage().shared, usage.shared);
+}
+
+TEST(DeduplicateTest, WorksWithSharedShapes) {
+    JsonParseOptions options;
+    options.share_object_shapes = true;
+    ParserWorkspace workspace; // Fresh shape transitions, whatever other tests left
+    auto doc = FastParser(options, workspace).parse(POSTS);
+    doc.deduplicate();
+    const auto& view = doc;
+    EXPECT_EQ(&view[0]["user"]["name"], &view[3]["user"]["name"]);
+    EXPECT_EQ(view, parse_document(POSTS));
+    EXPECT_NE(view[0]["user"].object_shape(), nullptr);
+
+    doc[3]["user"].set("email", JsonDocument("ann@example.com"));
+    EXPECT_FALSE(view[0]["user"].contains("email"));
+}
+
+TEST(DeduplicateTest, SecondPassJoinsValuesSharedSeparately) {
+    auto first = deduplicated(POSTS);
+    auto second = deduplicated(POSTS);
+    auto joined = JsonDocument::make_array();
+    joined.push_back(first[0]["user"]);
+    joined.push_back(second[0]["user"]);
+    const auto& view = joined;
+    EXPECT_NE(&view[0]["name"], &view[1]["name"]);
+
+    auto stats = joined.deduplicate();
+    EXPECT_EQ(stats.replaced, 1U);
+    EXPECT_EQ(stats.distinct, 0U);
+    EXPECT_EQ(&view[0]["name"], &view[1]["name"]);
+    EXPECT_EQ(first.deduplicate().replaced, 0U); // Nothing left to share
+    EXPECT_EQ(first, parse_document(POSTS));
+}
+
+TEST(DeduplicateTest, MixesValuesSharedBeforeWithNewOnes) {
+    auto other = deduplicated(R"({"a": {"p": {"q": 1}}, "b": {"p": {"q": 1}}})");
+    auto doc = parse_document(R"({"x": {"p": {"q": 1}}, "z": {"q": 1}})");
+    doc.set("y", other["a"]); // Copied one level: "p" is still shared with `other`
+
+    auto stats = doc.deduplicate();
+    EXPECT_EQ(stats.replaced, 2U);
+    const auto& view = doc;
+    EXPECT_EQ(view.to_json(), R"({"x":{"p":{"q":1}},"y":{"p":{"q":1}},"z":{"q":1}})");
+    EXPECT_EQ(&view["y"]["p"]["q"], &view["x"]["p"]["q"]);
+    EXPECT_EQ(&view["z"]["q"], &view["x"]["p"]["q"]);
+    EXPECT_EQ(std::as_const(other)["b"]["p"].to_json(), R"({"q":1})");
+}
+
+TEST(DeduplicateTest, ConstReadsNeverRewriteSharedShapedValues) {
+    JsonParseOptions options;
+    options.share_object_shapes = true;
+    ParserWorkspace workspace;
+    auto doc = FastParser(options, workspace)
+                   .parse(R"({"a": {"u": {"id": 1, "k": 2}}, "b": {"u": {"id": 1, "k": 2}}})");
+    doc.deduplicate();
+    const auto& view = doc;
+    const JsonDocument& id = view["b"]["u"]["id"];
+    ASSERT_TRUE(view["a"].is_shared());
+    ASSERT_NE(view["a"]["u"].object_shape(), nullptr);
+
+    EXPECT_THROW(static_cast<void>(view["a"]["u"].as_object()), TypeException);
+    EXPECT_THROW(static_cast<void>(view["a"]["u"].items()), TypeException);
+    EXPECT_NE(view["b"]["u"].object_shape(), nullptr); // The shared value is untouched
+    EXPECT_EQ(&view["b"]["u"]["id"], &id);
+    EXPECT_EQ(id.as<int>(), 1);
+    EXPECT_TRUE(view["a"].is_shared());
+}
+
+TEST(DeduplicateTest, DeepSharedValuesTearDown) {
+    auto nested = [](int depth) {
+        std::string json;
+        for (int i = 0; i < depth; ++i) {
+            json += R"({"level": )" + std::to_string(i % 3) + R"(, "next": )";
+        }
+        json += "null";
+        json.append(static_cast<std::size_t>(depth), '}');
+        return json;
+    };
+    std::string inner = nested(400);
+    auto doc = deduplicated("[" + inner + "," + inner + "]");
+    const auto& view = doc;
+    EXPECT_EQ(&view[0]["next"], &view[1]["next"]);
+    EXPECT_EQ(view[1].to_json(), parse_document(inner).to_json());
+    doc = JsonDocument(); // Frees both holders and then the shared chain
+    EXPECT_TRUE(doc.is_null());
+}
+
+TEST(DeduplicateTest, ExtractorWritesCopyOnWrite) {
+    auto doc = deduplicated(POSTS);
+    const auto& view = doc;
+    Extractor name("/3/user/name");
+    EXPECT_EQ(name.find(view), &view[0]["user"]["name"]); // Reads share
+
+    auto* value = name.find(doc);
+    ASSERT_NE(value, nullptr);
+    *value = JsonDocument("dee");
+    EXPECT_EQ(doc.at("/3/user/name").as<std::string>(), "dee");
+    EXPECT_EQ(doc.at("/0/user/name").as<std::string>(), "ann");
+}
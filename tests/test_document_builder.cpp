@@ -71,4 +71,48 @@ TEST(ParseDocumentTest, NumberFormatPreservation) {
 TEST(ParseDocumentTest, ErrorHandling) {
     EXPECT_THROW(parse_document("{invalid json}"), std::runtime_error);
     EXPECT_THROW(parse_document("[1, 2,]"), std::runtime_error);
-}
\ No newline at end of file
+}
+TEST(ParseDocumentTest, StreamingMatchesFastParser) {
+    std::string json = R"({"a": [1, {"b": [true, null]}, "x"], "c~/d": {"e": 2.50}})";
+    EXPECT_EQ(parse_document_streaming(json), parse_document(json));
+}
+
+TEST(ParseDocumentTest, StreamingKeepsEmptyKeys) {
+    std::string json = R"({"": 1, "a": {"": [2, {"": 3}]}})";
+    auto doc = parse_document_streaming(json);
+    EXPECT_EQ(doc, parse_document(json));
+    EXPECT_EQ(doc[""].as<int>(), 1);
+    EXPECT_EQ(doc.at("/a//1/").as<int>(), 3);
+}
+
+TEST(ParseDocumentTest, StreamingDeepNesting) {
+    constexpr int DEPTH = 2000;
+    std::string json = std::string(DEPTH, '[') + "1" + std::string(DEPTH, ']');
+    EXPECT_EQ(parse_document_streaming(json), parse_document(json));
+}
+
+TEST(ParseDocumentTest, StreamingEmptyContainers) {
+    for (const char* json : {"[]", "{}", " [ ] ", R"([[], {}, [{}]])", R"({"a": {}, "b": []})"}) {
+        EXPECT_EQ(parse_document_streaming(json), parse_document(json)) << json;
+    }
+}
+
+TEST(ParseDocumentTest, StreamingRejectsMisplacedCloses) {
+    for (const char* json : {"[1,]", R"({"a": 1,})", R"({"a":})", "[}", "{]", "]"}) {
+        EXPECT_THROW(parse_document_streaming(json), std::runtime_error) << json;
+    }
+}
+
+TEST(ParseDocumentTest, StreamingUnicodeEscapes) {
+    std::string json = R"(["café", "日本", "😀", "A\/"])";
+    EXPECT_EQ(parse_document_streaming(json), parse_document(json));
+    for (const char* bad : {R"("\ud83d")", R"("\ud83dx")", R"("\ude00")", R"("\u12g4")"}) {
+        EXPECT_THROW(parse_document_streaming(bad), std::runtime_error) << bad;
+    }
+}
+
+TEST(ParseDocumentTest, StreamingRejectsTruncatedInput) {
+    for (const char* json : {"[", R"({"a": )", "[1", "[true", R"({"a": [])"}) {
+        EXPECT_THROW(parse_document_streaming(json), std::runtime_error) << json;
+    }
+}
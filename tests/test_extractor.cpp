@@ -0,0 +1,115 @@
+#include <gtest/gtest.h>
+#include "jsom/jsom.hpp"
+
+using namespace jsom;
+
+namespace {
+
+auto message(int id) -> std::string {
+    return R"({"user": {"id": )" + std::to_string(id)
+           + R"(, "name": "u"}, "tags": ["a", "b"], "ok": true})";
+}
+
+} // namespace
+
+// Documents parsed through one workspace of the fixture's own, so which shapes they share does
+// not depend on what earlier tests left in the thread's transitions
+class ExtractorTest : public ::testing::Test {
+protected:
+    auto parse_shaped(const std::string& json) -> JsonDocument {
+        JsonParseOptions options;
+        options.share_object_shapes = true;
+        return FastParser(options, workspace_).parse(json);
+    }
+
+private:
+    ParserWorkspace workspace_;
+};
+
+TEST_F(ExtractorTest, FindsWhatAtFinds) {
+    auto doc = parse_document(R"({"a": {"b": [10, {"c": "x"}]}, "a/b": 1, "m~n": 2, "": 3})");
+    for (const std::string pointer :
+         {"", "/a", "/a/b", "/a/b/0", "/a/b/1/c", "/a~1b", "/m~0n", "/"}) {
+        Extractor extractor(pointer);
+        EXPECT_EQ(extractor.pointer(), pointer);
+        ASSERT_NE(extractor.find(doc), nullptr) << pointer;
+        EXPECT_EQ(extractor.find(doc), &doc.at(pointer)) << pointer;
+        EXPECT_EQ(&extractor.at(doc), &doc.at(pointer)) << pointer;
+    }
+}
+
+TEST_F(ExtractorTest, MissesReturnNullOrThrow) {
+    auto doc = parse_document(R"({"a": {"b": [10, 20]}, "s": "text"})");
+    for (const std::string pointer : {"/x", "/a/x", "/a/b/2", "/a/b/-", "/a/b/01", "/a/b/x",
+                                      "/s/0", "/a/b/0/c"}) {
+        Extractor extractor(pointer);
+        EXPECT_EQ(extractor.find(doc), nullptr) << pointer;
+        EXPECT_THROW(extractor.at(doc), JsonPointerNotFoundException) << pointer;
+    }
+    EXPECT_THROW(Extractor("no-slash"), InvalidJsonPointerException);
+    EXPECT_THROW(Extractor("/bad~2escape"), InvalidJsonPointerException);
+}
+
+TEST_F(ExtractorTest, NumericSegmentsNameObjectKeys) {
+    auto doc = parse_shaped(R"({"0": "zero", "list": [{"1": "one"}]})");
+    EXPECT_EQ(Extractor("/0").at(doc).as<std::string>(), "zero");
+    EXPECT_EQ(Extractor("/list/0/1").at(doc).as<std::string>(), "one");
+}
+
+TEST_F(ExtractorTest, SimilarDocumentsHitTheInlineCache) {
+    Extractor user_id("/user/id");
+    int sum = 0;
+    for (int i = 0; i < 10; ++i) {
+        sum += user_id.at(parse_shaped(message(i))).as<int>();
+    }
+    EXPECT_EQ(sum, 45);
+    // The first document fills both segments' caches; every later one hits them
+    EXPECT_EQ(user_id.stats().lookups, 2U);
+    EXPECT_EQ(user_id.stats().cache_hits, 18U);
+}
+
+TEST_F(ExtractorTest, OtherShapesAndMapsFallBack) {
+    Extractor user_id("/user/id");
+    auto first = parse_shaped(message(1));
+    auto other = parse_shaped(R"({"extra": 0, "user": {"id": 2}})");
+    auto plain = parse_document(message(3));
+    auto missing = parse_shaped(R"({"user": {"name": "n"}})");
+
+    EXPECT_EQ(user_id.at(first).as<int>(), 1);
+    EXPECT_EQ(user_id.at(other).as<int>(), 2);
+    EXPECT_EQ(user_id.at(plain).as<int>(), 3);
+    EXPECT_EQ(user_id.find(missing), nullptr);
+    EXPECT_EQ(user_id.stats().lookups, 8U);
+    EXPECT_EQ(user_id.stats().cache_hits, 0U);
+
+    // The miss left /user's cache on the inner shape of `other`
+    EXPECT_EQ(user_id.at(other).as<int>(), 2);
+    EXPECT_EQ(user_id.stats().lookups, 9U);
+    EXPECT_EQ(user_id.stats().cache_hits, 1U);
+}
+
+TEST_F(ExtractorTest, FollowsConversionToAMap) {
+    Extractor name("/user/name");
+    auto doc = parse_shaped(message(1));
+    EXPECT_EQ(name.at(doc).as<std::string>(), "u");
+
+    doc["user"].set("email", JsonDocument("u@example.com")); // Adding a key leaves the shape
+    EXPECT_EQ(doc["user"].object_shape(), nullptr);
+    EXPECT_EQ(name.at(doc).as<std::string>(), "u");
+
+    auto* value = name.find(doc);
+    ASSERT_NE(value, nullptr);
+    *value = JsonDocument("renamed");
+    EXPECT_EQ(doc.at("/user/name").as<std::string>(), "renamed");
+}
+
+TEST_F(ExtractorTest, CachedShapeOutlivesItsDocument) {
+    Extractor user_id("/user/id");
+    {
+        auto doc = parse_shaped(message(1));
+        EXPECT_EQ(user_id.at(doc).as<int>(), 1);
+    }
+    // A new shape cannot reuse the address of the one cached, since the cache still owns it
+    auto doc = parse_shaped(R"({"user": {"zzz": 0, "id": 7}})");
+    EXPECT_EQ(user_id.at(doc).as<int>(), 7);
+}
@@ -80,3 +80,25 @@ TEST(FormatPreservationTest, ZeroFormats) {
     EXPECT_NE(zero_decimal_pos, std::string::npos);
     EXPECT_NE(zero_double_decimal_pos, std::string::npos);
 }
+
+TEST(FormatPreservationTest, WrappedArraysRoundTrip) {
+    // Long arrays of numbers wrap across lines; every line break needs its comma
+    std::string json = R"({"samples": [)";
+    for (int i = 0; i < 40; ++i) {
+        json += (i > 0 ? ", " : "") + std::to_string(1000000 + i * 7919);
+    }
+    json += "]}";
+    auto doc = parse_document(json);
+
+    std::string pretty = doc.to_json(FormatPresets::Pretty);
+    EXPECT_NE(pretty.find(",\n"), std::string::npos);
+    EXPECT_EQ(parse_document(pretty), doc);
+}
+
+TEST(FormatPreservationTest, IndentWiderThanLineWidth) {
+    constexpr int DEPTH = 64; // 2-space indent passes 80 columns at depth 40
+    std::string json = std::string(DEPTH, '[') + "1, 2" + std::string(DEPTH, ']');
+    auto doc = parse_document(json);
+    std::string pretty = doc.to_json(FormatPresets::Pretty);
+    EXPECT_EQ(parse_document(pretty), doc);
+}
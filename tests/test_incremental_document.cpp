@@ -0,0 +1,143 @@
+#include <gtest/gtest.h>
+#include "jsom/incremental_document.hpp"
+#include "jsom/jsom.hpp"
+
+using namespace jsom;
+
+namespace {
+
+const std::string BASE = R"({
+    "name": "service",
+    "limits": {"cpu": 2, "memory": "512Mi"},
+    "ports": [80, 443],
+    "debug": false
+})";
+
+auto replace_once(std::string text, const std::string& from, const std::string& to)
+    -> std::string {
+    text.replace(text.find(from), from.size(), to);
+    return text;
+}
+
+} // namespace
+
+TEST(IncrementalDocumentTest, FirstUpdateParsesFully) {
+    IncrementalDocument doc;
+    auto update = doc.update(BASE);
+    EXPECT_FALSE(update.incremental);
+    EXPECT_EQ(update.reparsed_bytes, BASE.size());
+    EXPECT_EQ(doc.document(), parse_document(BASE));
+    EXPECT_EQ(doc.source(), BASE);
+}
+
+TEST(IncrementalDocumentTest, EditInsideOneValueReparsesOnlyThatValue) {
+    IncrementalDocument doc;
+    doc.update(BASE);
+
+    std::string edited = replace_once(BASE, R"("cpu": 2)", R"("cpu": 4, "gpu": 1)");
+    auto update = doc.update(edited);
+    EXPECT_TRUE(update.incremental);
+    EXPECT_EQ(update.member, "limits");
+    EXPECT_EQ(update.reparsed_bytes,
+              std::string(R"({"cpu": 4, "gpu": 1, "memory": "512Mi"})").size());
+    EXPECT_EQ(doc.document(), parse_document(edited));
+}
+
+TEST(IncrementalDocumentTest, ScalarEditsAtValueBoundaries) {
+    IncrementalDocument doc;
+    doc.update(R"({"a": 1, "b": "x"})");
+
+    auto update = doc.update(R"({"a": 12, "b": "x"})");
+    EXPECT_TRUE(update.incremental);
+    EXPECT_EQ(update.member, "a");
+
+    update = doc.update(R"({"a": 12, "b": "xyz"})");
+    EXPECT_TRUE(update.incremental);
+    EXPECT_EQ(update.member, "b");
+    EXPECT_EQ(doc.document(), parse_document(R"({"a": 12, "b": "xyz"})"));
+}
+
+TEST(IncrementalDocumentTest, SuccessiveEditsShiftLaterSpans) {
+    IncrementalDocument doc;
+    doc.update(BASE);
+
+    std::string edited = replace_once(BASE, R"("service")", R"("a-much-longer-service-name")");
+    EXPECT_TRUE(doc.update(edited).incremental);
+    edited = replace_once(edited, "[80, 443]", "[8080]");
+    EXPECT_EQ(doc.update(edited).member, "ports");
+    edited = replace_once(edited, "false", "true");
+    EXPECT_EQ(doc.update(edited).member, "debug");
+
+    EXPECT_EQ(doc.document(), parse_document(edited));
+}
+
+TEST(IncrementalDocumentTest, StructuralEditsFallBackToFullParse) {
+    IncrementalDocument doc;
+    doc.update(BASE);
+
+    // Renamed key
+    std::string edited = replace_once(BASE, R"("debug")", R"("verbose")");
+    EXPECT_FALSE(doc.update(edited).incremental);
+    EXPECT_EQ(doc.document(), parse_document(edited));
+
+    // Added member
+    edited = replace_once(edited, R"("verbose": false)", R"("verbose": false, "extra": 1)");
+    EXPECT_FALSE(doc.update(edited).incremental);
+    EXPECT_EQ(doc.document(), parse_document(edited));
+
+    // Still incremental afterwards
+    edited = replace_once(edited, R"("extra": 1)", R"("extra": 2)");
+    EXPECT_EQ(doc.update(edited).member, "extra");
+    EXPECT_EQ(doc.document(), parse_document(edited));
+}
+
+TEST(IncrementalDocumentTest, UnchangedSourceDoesNoWork) {
+    IncrementalDocument doc;
+    doc.update(BASE);
+    auto update = doc.update(BASE);
+    EXPECT_TRUE(update.incremental);
+    EXPECT_TRUE(update.member.empty());
+    EXPECT_EQ(update.reparsed_bytes, 0U);
+}
+
+TEST(IncrementalDocumentTest, FailedUpdateKeepsPreviousState) {
+    IncrementalDocument doc;
+    doc.update(BASE);
+
+    std::string broken = replace_once(BASE, R"("cpu": 2)", R"("cpu": )");
+    EXPECT_THROW(doc.update(broken), std::exception);
+    EXPECT_EQ(doc.source(), BASE);
+    EXPECT_EQ(doc.document(), parse_document(BASE));
+
+    // Restoring the text the document already holds is a no-op
+    EXPECT_TRUE(doc.update(BASE).incremental);
+}
+
+TEST(IncrementalDocumentTest, UnsupportedShapesAlwaysParseFully) {
+    IncrementalDocument array_doc;
+    array_doc.update("[1, 2, 3]");
+    EXPECT_FALSE(array_doc.update("[1, 2, 4]").incremental);
+    EXPECT_EQ(array_doc.document(), parse_document("[1, 2, 4]"));
+
+    IncrementalDocument duplicate_doc;
+    duplicate_doc.update(R"({"a": 1, "a": 2})");
+    EXPECT_FALSE(duplicate_doc.update(R"({"a": 1, "a": 3})").incremental);
+
+    JsonParseOptions options;
+    options.allow_comments = true;
+    IncrementalDocument comment_doc(options);
+    comment_doc.update("{\"a\": 1 // one\n}");
+    EXPECT_FALSE(comment_doc.update("{\"a\": 2 // one\n}").incremental);
+}
+
+TEST(IncrementalDocumentTest, EscapedKeysAndNestedStrings) {
+    IncrementalDocument doc;
+    std::string source = R"({"a\"b": {"s": "}]{["}, "c": [1, "]"]})";
+    doc.update(source);
+
+    std::string edited = replace_once(source, R"([1, "]"])", R"([1, "]", 2])");
+    auto update = doc.update(edited);
+    EXPECT_TRUE(update.incremental);
+    EXPECT_EQ(update.member, "c");
+    EXPECT_EQ(doc.document(), parse_document(edited));
+}
@@ -130,3 +130,18 @@ TEST(IterationTest, KeysOnNonObjectThrows) {
     auto arr = JsonDocument(std::vector<JsonDocument>{1});
     EXPECT_THROW(arr.keys(), TypeException);
 }
+
+TEST(IterationTest, KeyViewReadsKeysInPlace) {
+    JsonDocument obj{{"c", 3}, {"a", 1}, {"b", 2}};
+    auto view = obj.key_view();
+    EXPECT_EQ(view.size(), 3);
+    EXPECT_FALSE(view.empty());
+    EXPECT_EQ(std::vector<std::string>(view.begin(), view.end()), obj.keys());
+
+    // The view refers to the stored keys, not copies
+    EXPECT_EQ(&*view.begin(), &obj.items().begin()->first);
+    EXPECT_EQ(*std::prev(view.end()), "c");
+
+    EXPECT_TRUE(JsonDocument::make_object().key_view().empty());
+    EXPECT_THROW(JsonDocument(1).key_view(), TypeException);
+}
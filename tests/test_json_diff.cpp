@@ -0,0 +1,194 @@
+#include <gtest/gtest.h>
+#include "jsom/jsom.hpp"
+#include "jsom/json_diff.hpp"
+#include "jsom/json_patch.hpp"
+
+using namespace jsom;
+
+namespace {
+
+auto patch_text(const std::vector<DiffEntry>& entries) -> std::vector<std::string> {
+    std::vector<std::string> lines;
+    for (const auto& entry : entries) {
+        std::string line;
+        JsonDiff::append_operation(line, entry);
+        lines.push_back(line);
+    }
+    return lines;
+}
+
+// Diff, then check the patch rebuilds the target
+void expect_round_trip(const std::string& from_json, const std::string& to_json,
+                       std::size_t threads = 1) {
+    auto from = parse_document(from_json);
+    auto to = parse_document(to_json);
+    auto entries = JsonDiff::diff(from, to, DiffOptions{threads});
+
+    auto patched = from;
+    JsonPatch::apply(patched, JsonDiff::to_patch(entries));
+    EXPECT_EQ(patched, to) << "from: " << from_json << "\nto: " << to_json;
+}
+
+} // namespace
+
+TEST(JsonDiffTest, IdenticalDocumentsHaveNoOperations) {
+    auto doc = parse_document(R"({"a": [1, 2, {"b": null}], "c": "text"})");
+    EXPECT_TRUE(JsonDiff::diff(doc, doc).empty());
+    EXPECT_EQ(JsonDiff::hash(doc), JsonDiff::hash(parse_document(doc.to_json())));
+}
+
+TEST(JsonDiffTest, ObjectMembers) {
+    auto from = parse_document(R"({"keep": 1, "change": 2, "drop": 3})");
+    auto to = parse_document(R"({"keep": 1, "change": 20, "add": 4})");
+
+    EXPECT_EQ(patch_text(JsonDiff::diff(from, to)),
+              (std::vector<std::string>{R"({"op":"add","path":"/add","value":4})",
+                                        R"({"op":"replace","path":"/change","value":20})",
+                                        R"({"op":"remove","path":"/drop"})"}));
+}
+
+TEST(JsonDiffTest, NestedChangesUseEscapedPaths) {
+    auto from = parse_document(R"({"a/b": {"m~n": [1, 2]}})");
+    auto to = parse_document(R"({"a/b": {"m~n": [1, 3]}})");
+
+    EXPECT_EQ(patch_text(JsonDiff::diff(from, to)),
+              std::vector<std::string>{R"({"op":"replace","path":"/a~1b/m~0n/1","value":3})"});
+}
+
+TEST(JsonDiffTest, TypeChangeReplacesWholeValue) {
+    auto from = parse_document(R"({"v": {"x": 1}})");
+    auto to = parse_document(R"({"v": [1]})");
+
+    EXPECT_EQ(patch_text(JsonDiff::diff(from, to)),
+              std::vector<std::string>{R"({"op":"replace","path":"/v","value":[1]})"});
+}
+
+TEST(JsonDiffTest, ArrayInsertionIsOneOperation) {
+    auto from = parse_document(R"([{"id": 1}, {"id": 2}, {"id": 3}, {"id": 4}])");
+    auto to = parse_document(R"([{"id": 1}, {"id": 2}, {"id": 99}, {"id": 3}, {"id": 4}])");
+
+    EXPECT_EQ(patch_text(JsonDiff::diff(from, to)),
+              std::vector<std::string>{R"({"op":"add","path":"/2","value":{"id":99}})"});
+}
+
+TEST(JsonDiffTest, ArrayShiftDoesNotCascade) {
+    // Insert near the front and drop the last element: same length, shifted middle
+    auto from = parse_document(R"({"list": [0, 1, 2, 3, 4, 5, 6, 7]})");
+    auto to = parse_document(R"({"list": [0, 100, 1, 2, 3, 4, 5, 6]})");
+
+    EXPECT_EQ(patch_text(JsonDiff::diff(from, to)),
+              (std::vector<std::string>{R"({"op":"add","path":"/list/1","value":100})",
+                                        R"({"op":"remove","path":"/list/8"})"}));
+}
+
+TEST(JsonDiffTest, ModifiedArrayElementIsDiffedInPlace) {
+    auto from = parse_document(R"([{"id": 1, "n": "a"}, {"id": 2, "n": "b"}])");
+    auto to = parse_document(R"([{"id": 1, "n": "a"}, {"id": 2, "n": "B"}])");
+
+    EXPECT_EQ(patch_text(JsonDiff::diff(from, to)),
+              std::vector<std::string>{R"({"op":"replace","path":"/1/n","value":"B"})"});
+}
+
+TEST(JsonDiffTest, EqualNumbersWithDifferentTextAreNotChanges) {
+    auto from = parse_document(R"({"n": 1.0, "list": [1.50]})");
+    auto to = parse_document(R"({"n": 1, "list": [1.5]})");
+    EXPECT_TRUE(JsonDiff::diff(from, to).empty());
+}
+
+TEST(JsonDiffTest, ScalarRoots) {
+    EXPECT_TRUE(JsonDiff::diff(parse_document("1"), parse_document("1")).empty());
+    EXPECT_EQ(patch_text(JsonDiff::diff(parse_document("1"), parse_document("\"x\""))),
+              std::vector<std::string>{R"({"op":"replace","path":"","value":"x"})"});
+}
+
+TEST(JsonDiffTest, SummaryLines) {
+    auto from = parse_document(R"({"a": 1, "b": 2})");
+    auto to = parse_document(R"({"a": 5, "c": 3})");
+
+    std::vector<std::string> lines;
+    for (const auto& entry : JsonDiff::diff(from, to)) {
+        std::string line;
+        JsonDiff::append_summary(line, entry);
+        lines.push_back(line);
+    }
+    EXPECT_EQ(lines, (std::vector<std::string>{"~ /a: 1 -> 5", "- /b: 2", "+ /c: 3"}));
+}
+
+TEST(JsonDiffTest, RoundTripsThroughPatch) {
+    expect_round_trip(R"({"a": [1, 2, 3], "b": {"c": true}})", R"({"a": [3, 2], "b": {}})");
+    expect_round_trip(R"([1, 2, 3, 4, 5])", R"([0, 1, 3, 5, 6, 7])");
+    expect_round_trip(R"([[1, 2], [3, 4]])", R"([[1], [3, 4, 5], []])");
+    expect_round_trip(R"({"x": []})", R"({"x": [{"deep": [1, {"k": null}]}]})");
+    expect_round_trip(R"("a")", R"({"now": "object"})");
+}
+
+TEST(JsonDiffTest, ParallelMatchesSequential) {
+    std::string from = "{";
+    std::string to = "{";
+    for (int i = 0; i < 50; ++i) {
+        std::string key = "\"k" + std::to_string(i) + "\"";
+        from += (i > 0 ? "," : "") + key + R"(: {"v": [)" + std::to_string(i) + ", 1]}";
+        to += (i > 0 ? "," : "") + key + R"(: {"v": [)" + std::to_string(i % 7 == 0 ? -i : i)
+              + ", 1]}";
+    }
+    from += "}";
+    to += "}";
+
+    auto from_doc = parse_document(from);
+    auto to_doc = parse_document(to);
+    EXPECT_EQ(patch_text(JsonDiff::diff(from_doc, to_doc, DiffOptions{1})),
+              patch_text(JsonDiff::diff(from_doc, to_doc, DiffOptions{4})));
+    expect_round_trip(from, to, 4);
+    expect_round_trip("[" + from + "," + to + "]", "[" + to + "]", 4);
+}
+
+TEST(JsonPatchTest, AddInsertsIntoArrays) {
+    auto doc = parse_document(R"({"list": [1, 3]})");
+    JsonPatch::apply(doc, parse_document(R"([
+        {"op": "add", "path": "/list/1", "value": 2},
+        {"op": "add", "path": "/list/-", "value": 4},
+        {"op": "add", "path": "/obj", "value": {}}
+    ])"));
+    EXPECT_EQ(doc, parse_document(R"({"list": [1, 2, 3, 4], "obj": {}})"));
+}
+
+TEST(JsonPatchTest, MoveCopyAndTest) {
+    auto doc = parse_document(R"({"a": {"b": 1}, "list": [10, 20]})");
+    JsonPatch::apply(doc, parse_document(R"([
+        {"op": "test", "path": "/a/b", "value": 1},
+        {"op": "copy", "from": "/a", "path": "/copy"},
+        {"op": "move", "from": "/list/0", "path": "/list/-"},
+        {"op": "move", "from": "/a/b", "path": "/moved"}
+    ])"));
+    EXPECT_EQ(doc, parse_document(
+                       R"({"a": {}, "copy": {"b": 1}, "list": [20, 10], "moved": 1})"));
+}
+
+TEST(JsonPatchTest, KeepsUntouchedNumberText) {
+    auto doc = parse_document(R"({"price": 1.50, "qty": 2})");
+    JsonPatch::apply(doc, parse_document(R"([{"op": "replace", "path": "/qty", "value": 3}])"));
+    EXPECT_EQ(doc.to_json(), R"({"price":1.50,"qty":3})");
+}
+
+TEST(JsonPatchTest, ErrorsReportOperationIndex) {
+    auto doc = parse_document(R"({"a": 1})");
+    auto expect_failure = [&](const std::string& patch, std::size_t index) {
+        try {
+            JsonPatch::apply(doc, parse_document(patch));
+            FAIL() << "expected failure for " << patch;
+        } catch (const JsonPatchException& e) {
+            EXPECT_EQ(e.operation_index(), index) << e.what();
+        }
+    };
+
+    expect_failure(R"([{"op": "remove", "path": "/missing"}])", 0);
+    expect_failure(R"([{"op": "test", "path": "/a", "value": 1},
+                       {"op": "test", "path": "/a", "value": 2}])",
+                   1);
+    expect_failure(R"([{"op": "replace", "path": "/nope", "value": 1}])", 0);
+    expect_failure(R"([{"op": "add", "path": "/a/x", "value": 1}])", 0);
+    expect_failure(R"([{"op": "frobnicate", "path": "/a"}])", 0);
+    expect_failure(R"([{"op": "add", "path": "/b"}])", 0);
+    expect_failure(R"([{"op": "move", "from": "/a", "path": "/a/b"}])", 0);
+    expect_failure(R"({"op": "add"})", 0);
+}
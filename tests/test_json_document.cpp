@@ -110,6 +110,56 @@ TEST(JsonDocumentTest, AsObject) {
     EXPECT_THROW(num.as_object(), TypeException);
 }
 
+TEST(JsonDocumentTest, HeterogeneousKeyLookup) {
+    JsonDocument doc{{"id", 1}, {"name", "jsom"}};
+    const std::string_view id_key = "id";
+    const std::string name_key = "name";
+
+    EXPECT_EQ(doc[id_key].as<int>(), 1);
+    EXPECT_EQ(doc[name_key].as<std::string>(), "jsom");
+    EXPECT_TRUE(doc.contains(id_key));
+    EXPECT_FALSE(doc.contains(std::string_view("i")));
+    EXPECT_THROW(doc[std::string_view("missing")], std::out_of_range);
+
+    doc.set(id_key, JsonDocument(2));
+    doc.set("tag", JsonDocument("new"));
+    doc.set(std::string("owner"), JsonDocument("me"));
+    EXPECT_EQ(doc["id"].as<int>(), 2);
+    EXPECT_EQ(doc["tag"].as<std::string>(), "new");
+    EXPECT_EQ(doc.size(), 4);
+
+    // Maps with the default comparator still convert both ways
+    std::map<std::string, JsonDocument> plain = doc.as<std::map<std::string, JsonDocument>>();
+    EXPECT_EQ(JsonDocument(std::move(plain)), doc);
+
+    // Index 0 still selects the array overload
+    JsonDocument arr = JsonDocument::make_array();
+    arr.push_back(JsonDocument(7));
+    EXPECT_EQ(arr[0].as<int>(), 7);
+}
+
+TEST(JsonDocumentTest, NonCopyingAccessors) {
+    JsonDocument doc{{"name", "a string longer than the SSO buffer"}, {"flag", true}};
+    const auto& name = doc["name"];
+
+    std::string_view view = name.as_string_view();
+    EXPECT_EQ(view, "a string longer than the SSO buffer");
+    EXPECT_EQ(view.data(), name.get_if<std::string>()->data()); // No copy
+    EXPECT_EQ(name.try_as<std::string_view>(), view);
+    EXPECT_THROW(doc["flag"].as_string_view(), TypeException);
+
+    EXPECT_EQ(name.get_if<bool>(), nullptr);
+    ASSERT_NE(doc["flag"].get_if<bool>(), nullptr);
+    EXPECT_TRUE(*doc["flag"].get_if<bool>());
+    EXPECT_NE(doc.get_if<JsonObject>(), nullptr);
+    EXPECT_EQ(doc.get_if<std::vector<JsonDocument>>(), nullptr);
+    EXPECT_EQ(JsonDocument().get_if<std::string>(), nullptr);
+
+    // The mutable overload gives write access in place
+    *doc["name"].get_if<std::string>() += "!";
+    EXPECT_EQ(doc["name"].as_string_view().back(), '!');
+}
+
 TEST(JsonDocumentTest, Size) {
     auto arr = JsonDocument(std::vector<JsonDocument>{1, 2});
     EXPECT_EQ(arr.size(), 2);
@@ -173,6 +173,31 @@ TEST_F(JsonPointerTest, PathRemoval) {
     EXPECT_FALSE(fresh_doc.remove_at("/nonexistent"));
 }
 
+TEST_F(JsonPointerTest, ExtractAndSetMoveSubtrees) {
+    // Subtrees change owners without copying: element addresses survive both moves
+    const JsonDocument* first_user = &doc.at("/users/0");
+    JsonDocument users = doc.extract_at("/users");
+    EXPECT_FALSE(doc.exists("/users"));
+    EXPECT_EQ(&users[0], first_user);
+
+    JsonDocument target = JsonDocument::make_object();
+    target.set_at("/people", std::move(users));
+    EXPECT_EQ(&target.at("/people/0"), first_user);
+    EXPECT_EQ(target.at("/people/1/name").as<std::string>(), "Bob");
+
+    target.set_at("/people/0", target.extract_at("/people/1"));
+    EXPECT_EQ(target.at("/people/0/name").as<std::string>(), "Bob");
+    EXPECT_EQ(target.at("/people").size(), 1U);
+}
+
+TEST_F(JsonPointerTest, ExtractMissingPathThrows) {
+    EXPECT_THROW(doc.extract_at("/users/9"), JsonPointerNotFoundException);
+    EXPECT_THROW(doc.extract_at("/missing/child"), JsonPointerNotFoundException);
+    EXPECT_THROW(doc.extract_at(""), JsonPointerNotFoundException);
+    EXPECT_FALSE(doc.remove_at("/config/database/host/deeper"));
+    EXPECT_THROW(doc.set_at("/missing/child", JsonDocument(1)), JsonPointerNotFoundException);
+}
+
 // Test JSON Pointer utility functions
 TEST(JsonPointerUtilTest, Parsing) {
     // Test pointer parsing
@@ -0,0 +1,79 @@
+#include <gtest/gtest.h>
+#include "jsom/jsom.hpp"
+
+using namespace jsom;
+
+namespace {
+
+const std::string LONG_TEXT = "a string well beyond any small-string buffer";
+
+} // namespace
+
+TEST(MemoryUsageTest, ShortScalarsUseNoHeap) {
+    EXPECT_EQ(JsonDocument().memory_usage().total(), 0U);
+    EXPECT_EQ(JsonDocument(true).memory_usage().total(), 0U);
+    EXPECT_EQ(parse_document("42").memory_usage().total(), 0U);
+    EXPECT_EQ(JsonDocument("short").memory_usage().total(), 0U);
+}
+
+TEST(MemoryUsageTest, LongStringsAndNumbersCounted) {
+    auto text = JsonDocument(LONG_TEXT).memory_usage();
+    EXPECT_GT(text.strings, LONG_TEXT.size());
+    EXPECT_EQ(text.total(), text.strings);
+
+    auto number = parse_document("3.14159265358979323846264338327950288").memory_usage();
+    EXPECT_GT(number.numbers, 0U);
+    EXPECT_EQ(number.total(), number.numbers);
+}
+
+TEST(MemoryUsageTest, ArrayBufferFollowsCapacity) {
+    auto doc = parse_document("[1, 2, 3, 4, 5]");
+    auto usage = doc.memory_usage();
+    EXPECT_EQ(usage.containers, doc.as_array().capacity() * sizeof(JsonDocument));
+    EXPECT_EQ(usage.map_nodes, 0U);
+}
+
+TEST(MemoryUsageTest, ObjectNodesAndLongKeysCounted) {
+    auto small = parse_document(R"({"a": 1})").memory_usage();
+    auto large = parse_document(R"({"a": 1, "b": 2, "c": 3})").memory_usage();
+    EXPECT_GT(small.map_nodes, sizeof(JsonDocument));
+    EXPECT_EQ(large.map_nodes, 3 * small.map_nodes);
+
+    auto long_key = parse_document("{\"" + LONG_TEXT + "\": null}").memory_usage();
+    EXPECT_EQ(long_key.map_nodes, small.map_nodes);
+    EXPECT_GT(long_key.strings, LONG_TEXT.size());
+}
+
+TEST(MemoryUsageTest, SubtreeIsPartOfWhole) {
+    auto doc = parse_document(R"({"items": [")" + LONG_TEXT + R"(", 2], "other": {"x": 1}})");
+    auto whole = doc.memory_usage();
+    auto items = doc["items"].memory_usage();
+    EXPECT_GT(items.total(), 0U);
+    EXPECT_LT(items.total(), whole.total());
+    EXPECT_EQ(items.strings, whole.strings); // The only long string is inside items
+}
+
+TEST(MemoryUsageTest, PathCacheCountedAfterNavigation) {
+    auto doc = parse_document(R"({"a": {"b": [1, 2, 3]}})");
+    auto before = doc.memory_usage();
+    EXPECT_EQ(before.path_caches, 0U);
+
+    ASSERT_NE(doc.find("/a/b/1"), nullptr);
+    auto after = doc.memory_usage();
+    EXPECT_GT(after.path_caches, 0U);
+    EXPECT_EQ(after.total() - after.path_caches, before.total());
+
+    doc.clear_path_cache();
+    EXPECT_LE(doc.memory_usage().path_caches, after.path_caches);
+}
+
+TEST(MemoryUsageTest, CopyReportsSameDataWithoutCache) {
+    auto doc = parse_document(R"({"list": [")" + LONG_TEXT + R"("], "n": 1.25})");
+    doc.find("/list/0");
+    JsonDocument copy = doc;
+    auto original = doc.memory_usage();
+    auto copied = copy.memory_usage();
+    EXPECT_EQ(copied.path_caches, 0U);
+    EXPECT_EQ(copied.map_nodes, original.map_nodes);
+    EXPECT_EQ(copied.strings, original.strings);
+}
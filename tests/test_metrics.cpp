@@ -0,0 +1,144 @@
+#include <gtest/gtest.h>
+#include "jsom/jsom.hpp"
+#include "jsom/metrics.hpp"
+#include "jsom/navigation_engine.hpp"
+#include <thread>
+#include <vector>
+
+using namespace jsom;
+using metrics::Counter;
+
+// The registry works in every build; counting inside JSOM only happens when
+// JSOM_ENABLE_METRICS is defined. Tests compare snapshots rather than resetting, so they
+// do not depend on what ran before them.
+
+TEST(MetricsTest, AddShowsUpInSnapshot) {
+    auto before = metrics::snapshot();
+    metrics::add(Counter::BytesParsed, 10);
+    metrics::add(Counter::ParseErrors);
+    auto delta = metrics::snapshot() - before;
+    EXPECT_EQ(delta[Counter::BytesParsed], 10U);
+    EXPECT_EQ(delta[Counter::ParseErrors], 1U);
+    EXPECT_EQ(delta[Counter::DocumentsParsed], 0U);
+}
+
+TEST(MetricsTest, ShardsSumAcrossThreads) {
+    constexpr int THREADS = 20; // More threads than shards
+    constexpr int ADDS = 1000;
+    auto before = metrics::snapshot();
+    std::vector<std::thread> workers;
+    for (int t = 0; t < THREADS; ++t) {
+        workers.emplace_back([]() {
+            for (int i = 0; i < ADDS; ++i) {
+                metrics::add(Counter::SerializeBytes);
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    auto delta = metrics::snapshot() - before;
+    EXPECT_EQ(delta[Counter::SerializeBytes], static_cast<std::uint64_t>(THREADS * ADDS));
+}
+
+TEST(MetricsTest, ResetZeroesCounters) {
+    metrics::add(Counter::PathCacheHits, 3);
+    metrics::reset();
+    auto current = metrics::snapshot();
+    for (auto counter : metrics::ALL_COUNTERS) {
+        EXPECT_EQ(current[counter], 0U) << metrics::counter_name(counter);
+    }
+}
+
+TEST(MetricsTest, CounterNamesAreDistinct) {
+    for (std::size_t i = 0; i < metrics::COUNTER_COUNT; ++i) {
+        for (std::size_t j = i + 1; j < metrics::COUNTER_COUNT; ++j) {
+            EXPECT_STRNE(metrics::counter_name(metrics::ALL_COUNTERS[i]),
+                         metrics::counter_name(metrics::ALL_COUNTERS[j]));
+        }
+    }
+}
+
+TEST(MetricsTest, ThrowCounterCountsOnlyExceptions) {
+    auto before = metrics::snapshot();
+    { metrics::ThrowCounter quiet(Counter::ParseErrors); }
+    try {
+        metrics::ThrowCounter loud(Counter::ParseErrors);
+        throw std::runtime_error("boom");
+    } catch (const std::runtime_error&) {
+    }
+    EXPECT_EQ((metrics::snapshot() - before)[Counter::ParseErrors], 1U);
+}
+
+#ifdef JSOM_ENABLE_METRICS
+
+TEST(MetricsTest, ParseCountsDocumentsBytesAndErrors) {
+    std::string good = R"({"a": [1, 2, 3]})";
+    std::string bad = R"({"a": )";
+    auto before = metrics::snapshot();
+    auto doc = parse_document(good);
+    EXPECT_THROW(parse_document(bad), std::runtime_error);
+    auto delta = metrics::snapshot() - before;
+    EXPECT_EQ(delta[Counter::DocumentsParsed], 1U);
+    EXPECT_EQ(delta[Counter::BytesParsed], good.size() + bad.size());
+    EXPECT_EQ(delta[Counter::ParseErrors], 1U);
+}
+
+TEST(MetricsTest, SerializeCountsOutputBytes) {
+    auto doc = parse_document(R"({"a": [1, 2, 3]})");
+    auto before = metrics::snapshot();
+    std::string compact = doc.to_json();
+    std::string pretty = doc.to_json(FormatPresets::Pretty);
+    auto delta = metrics::snapshot() - before;
+    EXPECT_EQ(delta[Counter::SerializeBytes], compact.size() + pretty.size());
+}
+
+TEST(MetricsTest, LazyNumberConversionsCountedOnce) {
+    auto doc = parse_document("[1.5, 2.5]");
+    const auto& values = doc.as_array();
+    auto before = metrics::snapshot();
+    EXPECT_DOUBLE_EQ(values[0].as<double>(), 1.5);
+    EXPECT_DOUBLE_EQ(values[0].as<double>(), 1.5); // Cached after the first conversion
+    EXPECT_DOUBLE_EQ(values[1].as<double>(), 2.5);
+    EXPECT_EQ((metrics::snapshot() - before)[Counter::LazyNumberConversions], 2U);
+}
+
+TEST(MetricsTest, PathCacheHitsMissesAndEpochInvalidations) {
+    auto doc = parse_document(R"({"a": {"b": 1}, "c": []})");
+    PathCache cache;
+    auto before = metrics::snapshot();
+    NavigationEngine::navigate_with_cache(&doc, "/a/b", cache); // Miss
+    NavigationEngine::navigate_with_cache(&doc, "/a/b", cache); // Hit
+    doc["c"].push_back(JsonDocument(1));                        // Bumps the global epoch
+    NavigationEngine::navigate_with_cache(&doc, "/a/b", cache); // Invalidated, then miss
+    auto delta = metrics::snapshot() - before;
+    EXPECT_EQ(delta[Counter::PathCacheHits], 1U);
+    EXPECT_EQ(delta[Counter::PathCacheMisses], 2U);
+    EXPECT_EQ(delta[Counter::EpochInvalidations], 1U);
+}
+
+TEST(MetricsTest, PathCacheEvictionsCounted) {
+    auto doc = parse_document(R"({"a": 1})");
+    PathCache cache;
+    auto before = metrics::snapshot();
+    for (std::size_t i = 0; i <= cache_constants::MAX_EXACT_CACHE_SIZE; ++i) {
+        cache.put_exact("/" + std::to_string(i), &doc);
+    }
+    EXPECT_EQ((metrics::snapshot() - before)[Counter::PathCacheEvictions], 1U);
+}
+
+#else
+
+TEST(MetricsTest, HooksCompiledOutByDefault) {
+    auto before = metrics::snapshot();
+    auto doc = parse_document(R"({"a": [1.5, 2]})");
+    auto output = doc.to_json();
+    EXPECT_DOUBLE_EQ(doc["a"].as_array()[0].as<double>(), 1.5);
+    EXPECT_FALSE(metrics::ENABLED);
+    auto delta = metrics::snapshot() - before;
+    for (auto counter : metrics::ALL_COUNTERS) {
+        EXPECT_EQ(delta[counter], 0U) << metrics::counter_name(counter);
+    }
+}
+
+#endif
@@ -0,0 +1,279 @@
+#include <gtest/gtest.h>
+#include "jsom/jsom.hpp"
+#include "jsom/json_diff.hpp"
+#include <thread>
+
+using namespace jsom;
+
+namespace {
+
+const std::string RECORDS = R"([
+    {"name": "ann", "id": 1, "tags": ["a"], "address": {"city": "Oslo", "zip": "0150"}},
+    {"name": "bob", "id": 2, "tags": [], "address": {"city": "Rome", "zip": "00100"}},
+    {"name": "cy", "id": 3, "tags": ["b", "c"], "address": {"city": "Lima", "zip": "15001"}}
+])";
+
+auto shaped_options() -> JsonParseOptions {
+    JsonParseOptions options;
+    options.share_object_shapes = true;
+    return options;
+}
+
+// A fresh workspace per document, so shape transitions left by other tests cannot run out
+auto parse_shaped(const std::string& json) -> JsonDocument {
+    ParserWorkspace workspace;
+    return FastParser(shaped_options(), workspace).parse(json);
+}
+
+} // namespace
+
+TEST(ObjectShapeTest, RecordsShareOneShape) {
+    auto doc = parse_shaped(RECORDS);
+    const ObjectShape* shape = doc[0].object_shape();
+    ASSERT_NE(shape, nullptr);
+    EXPECT_EQ(doc[1].object_shape(), shape);
+    EXPECT_EQ(doc[2].object_shape(), shape);
+    EXPECT_EQ(shape->keys(), (std::vector<std::string>{"address", "id", "name", "tags"}));
+    EXPECT_NE(doc[0]["address"].object_shape(), nullptr);
+
+    EXPECT_EQ(parse_document(RECORDS)[0].object_shape(), nullptr); // Off by default
+}
+
+TEST(ObjectShapeTest, ReadsMatchAPlainParse) {
+    auto shaped = parse_shaped(RECORDS);
+    auto plain = parse_document(RECORDS);
+
+    EXPECT_EQ(shaped.to_json(), plain.to_json());
+    EXPECT_EQ(shaped.to_json(true), plain.to_json(true));
+    EXPECT_EQ(shaped.to_json(FormatPresets::Pretty), plain.to_json(FormatPresets::Pretty));
+    EXPECT_EQ(shaped, plain);
+    EXPECT_FALSE(shaped < plain || plain < shaped);
+
+    const auto& record = shaped[1];
+    EXPECT_EQ(record["name"].as<std::string>(), "bob");
+    EXPECT_EQ(record.size(), 4U);
+    EXPECT_TRUE(record.contains("tags"));
+    EXPECT_FALSE(record.contains("missing"));
+    EXPECT_THROW(record["missing"], std::out_of_range);
+    EXPECT_EQ(record.keys(), plain[1].keys());
+    EXPECT_EQ(shaped.at("/2/address/city").as<std::string>(), "Lima");
+    EXPECT_EQ(shaped.find("/0/nothing"), nullptr);
+    EXPECT_EQ(shaped.list_paths(), plain.list_paths());
+
+    std::vector<std::string> keys;
+    for (const auto& [key, value] : record.members()) {
+        keys.push_back(key + "=" + value.to_json());
+    }
+    EXPECT_EQ(keys, (std::vector<std::string>{R"(address={"city":"Rome","zip":"00100"})",
+                                              "id=2", R"(name="bob")", "tags=[]"}));
+    auto view = record.key_view();
+    EXPECT_EQ(std::vector<std::string>(view.begin(), view.end()), record.keys());
+    EXPECT_EQ(record.object_shape(), shaped[0].object_shape()); // Reading kept the shape
+}
+
+TEST(ObjectShapeTest, ComparesByContentAcrossForms) {
+    auto shaped = parse_shaped(R"({"a": 1, "b": 2})");
+    EXPECT_EQ(shaped, parse_document(R"({"b": 2, "a": 1})"));
+    EXPECT_NE(shaped, parse_shaped(R"({"a": 1, "b": 3})"));
+    EXPECT_NE(shaped, parse_shaped(R"({"a": 1, "c": 2})"));
+    EXPECT_LT(shaped, parse_document(R"({"a": 1, "b": 3})"));
+    EXPECT_LT(parse_document(R"({"a": 1})"), shaped);
+    EXPECT_EQ(JsonDiff::hash(shaped), JsonDiff::hash(parse_document(R"({"a": 1, "b": 2})")));
+}
+
+TEST(ObjectShapeTest, ReplacingAValueKeepsTheShape) {
+    auto doc = parse_shaped(RECORDS);
+    doc[0].set("name", JsonDocument("anne"));
+    doc.set_at("/1/id", JsonDocument(20));
+    doc[2]["tags"].push_back(JsonDocument("d"));
+
+    EXPECT_NE(doc[0].object_shape(), nullptr);
+    EXPECT_EQ(doc[1].object_shape(), doc[0].object_shape());
+    EXPECT_EQ(doc.at("/0/name").as<std::string>(), "anne");
+    EXPECT_EQ(doc.at("/1/id").as<int>(), 20);
+    EXPECT_EQ(doc.at("/2/tags/2").as<std::string>(), "d");
+    EXPECT_EQ(doc.at("/1/name").as<std::string>(), "bob"); // Values are never shared
+}
+
+TEST(ObjectShapeTest, AddingOrRemovingAKeyFallsBackToAMap) {
+    auto doc = parse_shaped(RECORDS);
+    EXPECT_EQ(doc.at("/0/id").as<int>(), 1); // Warm the path cache first
+
+    doc[0].set("email", JsonDocument("ann@example.com"));
+    EXPECT_EQ(doc[0].object_shape(), nullptr);
+    EXPECT_EQ(doc.at("/0/email").as<std::string>(), "ann@example.com");
+    EXPECT_EQ(doc.at("/0/id").as<int>(), 1);
+
+    EXPECT_TRUE(doc.remove_at("/1/tags"));
+    EXPECT_EQ(doc[1].object_shape(), nullptr);
+    EXPECT_FALSE(doc[1].contains("tags"));
+
+    auto removed = doc.extract_at("/2/address/zip");
+    EXPECT_EQ(removed.as<std::string>(), "15001");
+    EXPECT_EQ(doc[2]["address"].object_shape(), nullptr);
+    EXPECT_NE(doc[2].object_shape(), nullptr); // Its parent keeps the shape
+
+    auto batch = parse_shaped(RECORDS);
+    batch.apply_batch({PointerOperation::remove("/0/id"), PointerOperation::set("/1/x", 1)});
+    EXPECT_FALSE(batch[0].contains("id"));
+    EXPECT_EQ(batch.at("/1/x").as<int>(), 1);
+}
+
+TEST(ObjectShapeTest, MapAccessConvertsToAMap) {
+    auto doc = parse_shaped(RECORDS);
+    const auto& record = doc[0];
+    EXPECT_EQ(doc.at("/0/address/city").as<std::string>(), "Oslo");
+
+    const JsonObject& members = doc[0].as_object();
+    EXPECT_EQ(record.object_shape(), nullptr);
+    EXPECT_EQ(members.size(), 4U);
+    EXPECT_EQ(doc.at("/0/address/city").as<std::string>(), "Oslo"); // Cache noticed the move
+
+    for (auto& [key, value] : doc[1].items()) {
+        if (key == "id") {
+            value = JsonDocument(200);
+        }
+    }
+    EXPECT_EQ(doc[1]["id"].as<int>(), 200);
+    EXPECT_NE(doc[2].object_shape(), nullptr);
+    EXPECT_EQ(doc[2].as<JsonObject>().size(), 4U); // A copy: the shape stays
+    EXPECT_NE(doc[2].object_shape(), nullptr);
+    EXPECT_EQ(doc, parse_document(doc.to_json()));
+}
+
+TEST(ObjectShapeTest, ConstAccessNeverConverts) {
+    auto doc = parse_shaped(RECORDS);
+    const auto& view = doc;
+    const JsonDocument& name = view[0]["name"];
+
+    EXPECT_THROW(static_cast<void>(view[0].as_object()), TypeException);
+    EXPECT_THROW(static_cast<void>(view[0].items()), TypeException);
+    EXPECT_EQ(view[0]["address"].members().size(), 2U);
+    EXPECT_NE(view[0].object_shape(), nullptr);
+    EXPECT_EQ(&view[0]["name"], &name); // Earlier references stay valid
+    EXPECT_EQ(name.as<std::string>(), "ann");
+}
+
+TEST(ObjectShapeTest, ConcurrentConstReadsLeaveTheDocumentAlone) {
+    const auto doc = parse_shaped(RECORDS);
+    const std::string expected = doc.to_json();
+
+    // Each reader goes through every const accessor; none may change the shared storage
+    std::vector<std::string> results(4);
+    std::vector<std::thread> readers;
+    for (auto& result : results) {
+        readers.emplace_back([&doc, &result] {
+            for (const auto& record : doc) {
+                for (const auto& [key, value] : record.members()) {
+                    result += key;
+                }
+                EXPECT_THROW(static_cast<void>(record.as_object()), TypeException);
+                result += record["address"]["city"].as<std::string>();
+            }
+            result += doc.to_json();
+        });
+    }
+    for (auto& reader : readers) {
+        reader.join();
+    }
+    for (const auto& result : results) {
+        EXPECT_EQ(result, results.front());
+    }
+    EXPECT_NE(results.front().find(expected), std::string::npos);
+    EXPECT_NE(doc[2].object_shape(), nullptr);
+}
+
+TEST(ObjectShapeTest, CopiesAndMovesKeepTheShape) {
+    auto doc = parse_shaped(RECORDS);
+    auto copy = doc;
+    EXPECT_EQ(copy[0].object_shape(), doc[0].object_shape());
+    copy[0].set("extra", JsonDocument(true));
+    EXPECT_FALSE(doc[0].contains("extra"));
+
+    JsonDocument moved = std::move(doc);
+    EXPECT_EQ(moved[1].object_shape(), copy[1].object_shape());
+    EXPECT_EQ(moved.at("/1/name").as<std::string>(), "bob");
+}
+
+TEST(ObjectShapeTest, RepeatedKeysKeepTheLastValue) {
+    auto doc = parse_shaped(R"([{"a": 1, "b": 2, "a": 3}, {"a": 1, "b": 2}])");
+    EXPECT_EQ(doc[0].object_shape(), nullptr);
+    EXPECT_EQ(doc[0], parse_document(R"({"a": 1, "b": 2, "a": 3})"));
+    EXPECT_EQ(doc[0]["a"].as<int>(), 3);
+    EXPECT_NE(doc[1].object_shape(), nullptr);
+}
+
+TEST(ObjectShapeTest, ObjectsPastTheLimitsAreMaps) {
+    std::string wide = "{";
+    for (std::size_t i = 0; i <= parser_constants::SHAPE_MAX_KEYS; ++i) {
+        wide += (i == 0 ? "\"k" : ",\"k") + std::to_string(i) + "\":" + std::to_string(i);
+    }
+    wide += "}";
+    auto wide_doc = parse_shaped(wide);
+    EXPECT_EQ(wide_doc.object_shape(), nullptr);
+    EXPECT_EQ(wide_doc, parse_document(wide));
+
+    // A dictionary keyed by id: every first key differs, so transitions run out
+    std::string varied = "[";
+    for (int i = 0; i < 100; ++i) {
+        varied += (i == 0 ? "{\"id" : ",{\"id") + std::to_string(i) + "\": {\"x\": 1}}";
+    }
+    varied += "]";
+    auto varied_doc = parse_shaped(varied);
+    EXPECT_EQ(varied_doc, parse_document(varied));
+    EXPECT_EQ(varied_doc.at("/99/id99/x").as<int>(), 1);
+    EXPECT_EQ(varied_doc[99].object_shape(), nullptr);
+    EXPECT_EQ(varied_doc[99]["id99"].object_shape(), varied_doc[0]["id0"].object_shape());
+}
+
+TEST(ObjectShapeTest, DocumentsFromOneWorkspaceShareShapes) {
+    ParserWorkspace workspace;
+    FastParser parser(shaped_options(), workspace);
+    auto first = parser.parse(R"({"user": 1, "likes": 2})");
+    auto second = parser.parse(R"({"user": 3, "likes": 4})");
+    EXPECT_EQ(first.object_shape(), second.object_shape());
+
+    workspace.release();
+    auto third = parser.parse(R"({"user": 5, "likes": 6})");
+    EXPECT_NE(third.object_shape(), nullptr);
+    EXPECT_NE(third.object_shape(), first.object_shape());
+    EXPECT_EQ(third.object_shape()->keys(), first.object_shape()->keys());
+}
+
+TEST(ObjectShapeTest, FullTransitionsStartOver) {
+    ParserWorkspace workspace;
+    FastParser parser(shaped_options(), workspace);
+    for (std::size_t i = 0; i <= parser_constants::SHAPE_MAX_TRANSITIONS; ++i) {
+        parser.parse("{\"key" + std::to_string(i) + "\": 1}"); // A new first key each time
+    }
+    // The parse that ran out of room emptied the transitions for the ones after it
+    auto doc = parser.parse(R"([{"newkey": 1, "b": 2}, {"newkey": 3, "b": 4}])");
+    EXPECT_NE(doc[0].object_shape(), nullptr);
+    EXPECT_EQ(doc[1].object_shape(), doc[0].object_shape());
+}
+
+TEST(ObjectShapeTest, FailedParsesLeaveTheWorkspaceUsable) {
+    ParserWorkspace workspace;
+    FastParser parser(shaped_options(), workspace);
+    EXPECT_FALSE(parser.try_parse(R"([{"a": 1, "b": [1, {"c": )"));
+    EXPECT_FALSE(parser.try_parse(R"({"a": 1 "b": 2})"));
+    auto doc = parser.parse(R"([{"a": 1, "b": [1, {"c": 2}]}, {"a": 3, "b": []}])");
+    EXPECT_EQ(doc.to_json(), R"([{"a":1,"b":[1,{"c":2}]},{"a":3,"b":[]}])");
+    EXPECT_EQ(doc[0].object_shape(), doc[1].object_shape());
+}
+
+TEST(ObjectShapeTest, RecordsUseLessMemory) {
+    std::string records = "[";
+    for (int i = 0; i < 200; ++i) {
+        records += (i == 0 ? "" : ",");
+        records += R"({"identifier": )" + std::to_string(i)
+                   + R"(, "display_name": "user", "is_active": true, "score": 1.5})";
+    }
+    records += "]";
+    auto shaped = parse_shaped(records);
+    auto plain = parse_document(records);
+    EXPECT_EQ(shaped, plain);
+    // Four values per record instead of four map nodes holding a key and a value each
+    EXPECT_EQ(shaped.memory_usage().map_nodes, 0U);
+    EXPECT_LT(shaped.memory_usage().total() * 3, plain.memory_usage().total() * 2);
+}
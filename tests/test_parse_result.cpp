@@ -0,0 +1,117 @@
+#include <gtest/gtest.h>
+#include "jsom/jsom.hpp"
+
+using namespace jsom;
+
+namespace {
+
+auto failure_of(const std::string& json, const JsonParseOptions& options = {}) -> ParseFailure {
+    auto result = try_parse_document(json, options);
+    EXPECT_FALSE(result.has_value()) << json;
+    return result.error();
+}
+
+} // namespace
+
+TEST(ParseResultTest, ValidInputGivesDocument) {
+    auto result = try_parse_document(R"({"a": [1, "two", null]})");
+    ASSERT_TRUE(result);
+    EXPECT_FALSE(result.error());
+    EXPECT_EQ(result->at("/a/1").as<std::string>(), "two");
+    EXPECT_EQ(std::move(result).value(), parse_document(R"({"a": [1, "two", null]})"));
+}
+
+TEST(ParseResultTest, ErrorsCarryCodeAndOffset) {
+    struct Case {
+        std::string json;
+        ParseErrorCode code;
+        std::size_t offset;
+    };
+    const std::vector<Case> cases = {
+        {"", ParseErrorCode::EmptyInput, 0},
+        {"   ", ParseErrorCode::EmptyInput, 3},
+        {"[1, @]", ParseErrorCode::UnexpectedCharacter, 4},
+        {R"({"key" 1})", ParseErrorCode::ExpectedCharacter, 7},
+        {"{1: 2}", ParseErrorCode::ExpectedKey, 1},
+        {R"({"a": 1 "b": 2})", ParseErrorCode::ExpectedObjectSeparator, 8},
+        {"[1 2]", ParseErrorCode::ExpectedArraySeparator, 3},
+        {"[tru]", ParseErrorCode::InvalidLiteral, 1},
+        {R"(["abc)", ParseErrorCode::UnterminatedString, 1},
+        {"[1] x", ParseErrorCode::TrailingCharacters, 4},
+    };
+    for (const auto& test_case : cases) {
+        auto failure = failure_of(test_case.json);
+        EXPECT_EQ(failure.code, test_case.code) << test_case.json;
+        EXPECT_EQ(failure.offset, test_case.offset) << test_case.json;
+    }
+}
+
+TEST(ParseResultTest, EscapeAndCommentErrors) {
+    JsonParseOptions convert;
+    convert.convert_unicode_escapes = true;
+    EXPECT_EQ(failure_of(R"("\u12)", convert).code, ParseErrorCode::IncompleteUnicodeEscape);
+    EXPECT_EQ(failure_of(R"(["\u12G4"])", convert).code, ParseErrorCode::InvalidUnicodeEscape);
+    EXPECT_EQ(failure_of(R"(["\uD800x"])", convert).code,
+              ParseErrorCode::IncompleteSurrogatePair);
+    EXPECT_EQ(failure_of(R"(["\uD800\u0041"])", convert).code,
+              ParseErrorCode::InvalidSurrogatePair);
+    EXPECT_EQ(failure_of(R"(["\uDC00"])", convert).code, ParseErrorCode::UnexpectedLowSurrogate);
+
+    auto comment = failure_of("[1 /* never closed", ParsePresets::Comments);
+    EXPECT_EQ(comment.code, ParseErrorCode::UnterminatedComment);
+    EXPECT_EQ(comment.offset, 18U);
+}
+
+TEST(ParseResultTest, ThrowingApiIsLayeredOnTop) {
+    auto failure = failure_of(R"({"key" 1})");
+    EXPECT_EQ(failure.message(), "Expected ':' but got '1'");
+
+    try {
+        parse_document(R"({"key" 1})");
+        FAIL() << "parse_document() accepted invalid input";
+    } catch (const ParseException& error) {
+        EXPECT_EQ(error.error().code, failure.code);
+        EXPECT_EQ(error.error().offset, failure.offset);
+        EXPECT_EQ(std::string(error.what()), failure.message());
+    }
+
+    // Still a std::runtime_error for existing callers, and value() throws the same way
+    EXPECT_THROW(parse_document("[1,"), std::runtime_error);
+    auto result = try_parse_document("[1,");
+    EXPECT_THROW(result.value(), ParseException);
+    EXPECT_TRUE(result->is_null());
+}
+
+TEST(ParseResultTest, FindAndExistsReportMissesWithoutThrowing) {
+    auto doc = parse_document(R"({"a": {"b": [1, 2]}, "s": "text"})");
+    const std::vector<std::string> misses = {"/missing", "/a/missing", "/a/b/2", "/a/b/-",
+                                             "/a/b/01", "/a/b/99999999999999999999999",
+                                             "/s/0", "no-slash", "/a~2b"};
+    for (const auto& path : misses) {
+        EXPECT_EQ(doc.find(path), nullptr) << path;
+        EXPECT_FALSE(doc.exists(path)) << path;
+    }
+    EXPECT_NE(doc.find("/a/b/1"), nullptr);
+
+    // at() keeps throwing, naming the first missing prefix
+    try {
+        doc.at("/a/missing/deeper");
+        FAIL() << "at() found a missing path";
+    } catch (const JsonPointerNotFoundException& error) {
+        EXPECT_EQ(error.get_pointer(), "/a/missing");
+    }
+    EXPECT_THROW(doc.at("no-slash"), InvalidJsonPointerException);
+}
+
+TEST(ParseResultTest, PointerValidationMatchesParse) {
+    for (const std::string pointer : {"", "/", "//", "/a~0b", "/a~1b", "/a~", "/a~/b", "/a~2",
+                                      "a", "/~x/y", "/ok/~01"}) {
+        bool parses = true;
+        try {
+            JsonPointer::parse(pointer);
+        } catch (const JsonPointerException&) {
+            parses = false;
+        }
+        EXPECT_EQ(JsonPointer::is_valid(pointer), parses) << pointer;
+    }
+}
@@ -0,0 +1,75 @@
+#include <gtest/gtest.h>
+#include "jsom/jsom.hpp"
+#include <thread>
+
+using namespace jsom;
+
+TEST(ParserWorkspaceTest, ReusedWorkspaceParsesLikeAFreshParser) {
+    const std::vector<std::string> inputs = {
+        R"({"id": 1, "tags": ["a", "b"], "nested": {"list": [1, [2, [3, []]], 4]}})",
+        R"([[1, 2], [], [[3]], {"k": [5, 6, 7]}])",
+        R"("a string well beyond any small-string buffer")",
+        R"([1, 2, 3])",
+        R"({})",
+    };
+
+    ParserWorkspace workspace;
+    for (int round = 0; round < 2; ++round) {
+        for (const auto& input : inputs) {
+            FastParser parser({}, workspace);
+            EXPECT_EQ(parser.parse(input), FastParser().parse(input)) << input;
+        }
+    }
+}
+
+TEST(ParserWorkspaceTest, ArraysAreSizedToTheirElements) {
+    auto doc = parse_document(R"([1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17])");
+    EXPECT_EQ(doc.size(), 17U);
+    EXPECT_EQ(doc.memory_usage().containers, 17U * sizeof(JsonDocument));
+}
+
+TEST(ParserWorkspaceTest, FailedParseLeavesWorkspaceUsable) {
+    ParserWorkspace workspace;
+    FastParser parser({}, workspace);
+    EXPECT_FALSE(parser.try_parse(R"([1, [2, [3, "unterminated)"));
+    EXPECT_FALSE(parser.try_parse(R"({"a": [1, 2 3]})"));
+
+    auto doc = parser.parse(R"([[10], [20, 30]])");
+    EXPECT_EQ(doc.to_json(), "[[10],[20,30]]");
+}
+
+TEST(ParserWorkspaceTest, ReleaseAndLargeInputsKeepWorking) {
+    ParserWorkspace workspace;
+    FastParser parser({}, workspace);
+
+    std::string big = "[";
+    for (int i = 0; i < 100000; ++i) {
+        big += (i > 0 ? "," : "") + std::to_string(i); // Element buffer past the retention limit
+    }
+    big += "]";
+    EXPECT_EQ(parser.parse(big).size(), 100000U);
+
+    workspace.release();
+    EXPECT_EQ(parser.parse(R"({"a": [1]})").to_json(), R"({"a":[1]})");
+}
+
+TEST(ParserWorkspaceTest, EachThreadHasItsOwnWorkspace) {
+    std::vector<std::thread> threads;
+    std::vector<int> matched(4, 0); // Not vector<bool>: threads write neighbouring elements
+    for (std::size_t t = 0; t < matched.size(); ++t) {
+        threads.emplace_back([&matched, t]() {
+            bool all = true;
+            for (int i = 0; i < 200; ++i) {
+                std::string json = "[" + std::to_string(t) + ", [" + std::to_string(i) + "]]";
+                all = all && parse_document(json)[1][0].as<int>() == i;
+            }
+            matched[t] = all ? 1 : 0;
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    for (int thread_matched : matched) {
+        EXPECT_EQ(thread_matched, 1);
+    }
+}
@@ -1,9 +1,14 @@
-#include <chrono>
 #include <gtest/gtest.h>
 #include <jsom/jsom.hpp>
+#include <sstream>
 
 using namespace jsom;
 
+// Timing is checked by the statistical gate (cmake --build build --target
+// check_performance_regression), not here: single-run wall-clock limits fail under load. These
+// tests pin down the behaviour the fast paths depend on instead, such as numbers keeping their
+// text and pointer lookups being cached.
+
 class PerformanceRegressionTest : public ::testing::Test {
 protected:
     // Multiplier to convert integer indices to varied decimal numbers for testing
@@ -23,76 +28,55 @@ protected:
         oss << "]}";
         return oss.str();
     }
-
-    template <typename Func> static auto measure_time_ms(Func&& func) -> double {
-        auto start = std::chrono::high_resolution_clock::now();
-        func();
-        auto end = std::chrono::high_resolution_clock::now();
-        auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
-        // NOLINTNEXTLINE(readability-magic-numbers)
-        return static_cast<double>(duration.count()) / 1000.0;
-    }
 };
 
 TEST_F(PerformanceRegressionTest, ParseOnlyPerformance) {
     // NOLINTNEXTLINE(readability-magic-numbers)
     std::string json = create_number_heavy_json(1000);
+    auto doc = parse_document(json);
 
-    double time_ms = measure_time_ms([&]() { auto doc = parse_document(json); });
-
-    EXPECT_LT(time_ms, 100.0);
+    // NOLINTNEXTLINE(readability-magic-numbers)
+    EXPECT_EQ(doc["numbers"].size(), 1000U);
+    // Numbers are stored as their text and only converted when read
+    const auto* number = doc["numbers"][3].get_if<LazyNumber>();
+    ASSERT_NE(number, nullptr);
+    EXPECT_TRUE(number->has_original_repr());
+    EXPECT_EQ(number->get_original_repr(), "4.5");
 }
 
 TEST_F(PerformanceRegressionTest, ParseSerializePerformance) {
     // NOLINTNEXTLINE(readability-magic-numbers)
     std::string json = create_number_heavy_json(100);
 
-    double time_ms = measure_time_ms([&]() {
-        auto doc = parse_document(json);
-        [[maybe_unused]] auto output = doc.to_json();
-    });
-
-    EXPECT_LT(time_ms, 50.0);
+    // Unread numbers are written back from their text, without a conversion round trip
+    EXPECT_EQ(parse_document(json).to_json(), json);
 }
 
 TEST_F(PerformanceRegressionTest, NumberAccessPerformance) {
     // NOLINTNEXTLINE(readability-magic-numbers)
     auto doc = parse_document(create_number_heavy_json(100));
 
-    double time_ms = measure_time_ms([&]() {
-        // NOLINTNEXTLINE(readability-magic-numbers)
-        for (size_t i = 0; i < 100; ++i) {
-            auto value = doc["numbers"][i].as<double>();
-            (void)value;
-        }
-    });
-
-    EXPECT_LT(time_ms, 10.0);
+    double sum = 0.0;
+    // NOLINTNEXTLINE(readability-magic-numbers)
+    for (size_t i = 0; i < 100; ++i) {
+        sum += doc["numbers"][i].as<double>();
+    }
+    // NOLINTNEXTLINE(readability-magic-numbers)
+    EXPECT_DOUBLE_EQ(sum, NUMBER_VARIATION_MULTIPLIER * 4950.0);
 }
 
 TEST_F(PerformanceRegressionTest, RepeatedAccessCaching) {
-    auto doc = parse_document(R"({"value": 123.456})");
-
-    // Measure multiple iterations to get measurable timing
-    constexpr int iterations = 10000;
+    auto doc = parse_document(R"({"outer": {"value": 123.456}})");
 
-    double first_access = measure_time_ms([&]() {
-        for (int i = 0; i < iterations; ++i) {
-            auto value = doc["value"].as<double>();
-            (void)value;
-        }
-    });
-
-    double second_access = measure_time_ms([&]() {
-        for (int i = 0; i < iterations; ++i) {
-            auto value = doc["value"].as<double>();
-            (void)value;
-        }
-    });
+    const auto* first = &doc.at("/outer/value");
+    EXPECT_EQ(doc.get_path_cache_stats().exact_cache_size, 1U);
+    EXPECT_EQ(doc.get_path_cache_stats().prefix_cache_size, 1U);
 
-    // Second access should be faster due to caching, but allow for some variance
-    // Since both should be cached after first iteration, expect them to be similar
-    EXPECT_GT(first_access, 0.0);                 // Ensure we actually measured something
-    EXPECT_GT(second_access, 0.0);                // Ensure we actually measured something
-    EXPECT_LT(second_access, first_access * 1.5); // Allow 50% variance for timing noise
+    // Later lookups are answered from the cache: nothing new is cached
+    constexpr int iterations = 100;
+    for (int i = 0; i < iterations; ++i) {
+        EXPECT_EQ(&doc.at("/outer/value"), first);
+    }
+    EXPECT_EQ(doc.get_path_cache_stats().total_entries, 2U);
+    EXPECT_DOUBLE_EQ(first->as<double>(), 123.456);
 }
@@ -0,0 +1,59 @@
+#include <gtest/gtest.h>
+#include "benchmarks/regression_stats.hpp"
+
+using namespace regression_stats;
+
+TEST(RegressionStatsTest, StudentTDistribution) {
+    // Reference values from standard t tables
+    EXPECT_NEAR(t_cdf(0.0, 10.0), 0.5, 1e-12);
+    EXPECT_NEAR(t_cdf(2.0, 10.0), 0.963306, 1e-6);
+    EXPECT_NEAR(t_cdf(-2.0, 10.0), 0.036694, 1e-6);
+    EXPECT_NEAR(t_quantile(0.975, 10.0), 2.228139, 1e-5);
+    EXPECT_NEAR(t_quantile(0.995, 5.0), 4.032143, 1e-5);
+    EXPECT_NEAR(t_quantile(0.975, 1e6), 1.959964, 1e-4); // Approaches the normal
+}
+
+TEST(RegressionStatsTest, Summary) {
+    auto summary = summarize({2.0, 4.0, 4.0, 4.0, 5.0, 5.0, 7.0, 9.0});
+    EXPECT_EQ(summary.count, 8U);
+    EXPECT_DOUBLE_EQ(summary.mean, 5.0);
+    EXPECT_NEAR(summary.variance, 32.0 / 7.0, 1e-12);
+}
+
+TEST(RegressionStatsTest, ClearSlowdownIsSignificant) {
+    std::vector<double> baseline = {100, 101, 99, 100, 102, 98, 100, 101};
+    std::vector<double> candidate = {130, 131, 129, 130, 132, 128, 130, 131};
+
+    auto result = compare(baseline, candidate, 0.99);
+    EXPECT_NEAR(result.change, 0.30, 0.01);
+    EXPECT_LT(result.p_value, 1e-6);
+    EXPECT_LT(result.change_low, result.change);
+    EXPECT_GT(result.change_high, result.change);
+    EXPECT_GT(result.change_low, 0.25);
+}
+
+TEST(RegressionStatsTest, NoiseIsNotSignificant) {
+    std::vector<double> baseline = {100, 140, 90, 120, 80, 110, 130, 95};
+    std::vector<double> candidate = {105, 150, 85, 125, 90, 115, 120, 100};
+
+    auto result = compare(baseline, candidate, 0.99);
+    EXPECT_GT(result.p_value, 0.01);
+    EXPECT_LT(result.change_low, 0.0); // The interval includes "no change"
+    EXPECT_GT(result.change_high, 0.0);
+}
+
+TEST(RegressionStatsTest, SpeedupHasHighSlowdownPValue) {
+    std::vector<double> baseline = {200, 202, 198, 201, 199};
+    std::vector<double> candidate = {100, 101, 99, 100, 102};
+    auto result = compare(baseline, candidate, 0.95);
+    EXPECT_NEAR(result.change, -0.5, 0.01);
+    EXPECT_GT(result.p_value, 0.999);
+}
+
+TEST(RegressionStatsTest, ExactSamplesAndInvalidInput) {
+    auto result = compare({10, 10, 10}, {12, 12, 12}, 0.99);
+    EXPECT_DOUBLE_EQ(result.change, 0.2);
+    EXPECT_EQ(result.p_value, 0.0);
+
+    EXPECT_THROW((void)compare({10}, {10, 11}, 0.99), std::invalid_argument);
+}
@@ -0,0 +1,103 @@
+#include <gtest/gtest.h>
+#include "jsom/jsom.hpp"
+
+using namespace jsom;
+
+namespace {
+
+// Far deeper than a recursive destructor survives on a default 8 MiB stack
+constexpr std::size_t DEEP = 200000;
+
+// Nested arrays built bottom-up by moving, so construction does not recurse either
+auto nested_arrays(std::size_t depth) -> JsonDocument {
+    JsonDocument doc = JsonDocument::make_array();
+    for (std::size_t i = 0; i < depth; ++i) {
+        std::vector<JsonDocument> wrapper;
+        wrapper.push_back(std::move(doc));
+        doc = JsonDocument(std::move(wrapper));
+    }
+    return doc;
+}
+
+// {"child": {"child": ... {"leaf": "..."}}}, alternating with a sibling array per level
+auto nested_objects(std::size_t depth) -> JsonDocument {
+    JsonDocument doc{{"leaf", JsonDocument("a string well beyond any small-string buffer")}};
+    for (std::size_t i = 0; i < depth; ++i) {
+        JsonDocument parent = JsonDocument::make_object();
+        parent.set("child", std::move(doc));
+        parent.set("siblings", JsonDocument(std::vector<JsonDocument>{JsonDocument(1)}));
+        doc = std::move(parent);
+    }
+    return doc;
+}
+
+auto depth_of(const JsonDocument& doc) -> std::size_t {
+    std::size_t depth = 0;
+    const JsonDocument* node = &doc;
+    while (node->is_array() && !node->empty()) {
+        node = &(*node)[0];
+        ++depth;
+    }
+    return depth;
+}
+
+} // namespace
+
+TEST(TeardownTest, DeepArraysAreFreedWithoutRecursion) {
+    auto doc = nested_arrays(DEEP);
+    EXPECT_EQ(depth_of(doc), DEEP);
+    // Going out of scope here would overflow the stack with a recursive destructor
+}
+
+TEST(TeardownTest, DeepObjectsAreFreedWhenReplaced) {
+    auto doc = nested_objects(DEEP);
+    doc = JsonDocument(1);
+    EXPECT_EQ(doc.as<int>(), 1);
+
+    std::vector<JsonDocument> many;
+    many.push_back(nested_objects(DEEP / 10));
+    many.push_back(nested_arrays(DEEP / 10));
+    many.clear();
+    EXPECT_TRUE(many.empty());
+}
+
+TEST(TeardownTest, ShallowDocumentsAreUnaffected) {
+    auto doc = parse_document(R"({"a": [1, {"b": [2, 3]}], "c": {"d": null}})");
+    auto copy = doc;
+    doc = parse_document("[]");
+    EXPECT_EQ(copy.to_json(), R"({"a":[1,{"b":[2,3]}],"c":{"d":null}})");
+    EXPECT_EQ(doc.to_json(), "[]");
+}
+
+TEST(DeferredDestroyerTest, DestroyTakesTheDocument) {
+    DeferredDestroyer reclaimer;
+    auto doc = parse_document(R"({"items": [1, 2, 3], "name": "x"})");
+    auto number = JsonDocument(42);
+
+    reclaimer.destroy(std::move(doc));
+    reclaimer.destroy(std::move(number)); // Freed inline, never queued
+    EXPECT_TRUE(doc.is_null());
+    EXPECT_TRUE(number.is_null());
+
+    reclaimer.flush();
+    EXPECT_EQ(reclaimer.pending(), 0U);
+}
+
+TEST(DeferredDestroyerTest, FreesDeepDocumentsInTheBackground) {
+    DeferredDestroyer reclaimer;
+    for (int i = 0; i < 3; ++i) {
+        auto doc = nested_arrays(DEEP / 4);
+        reclaimer.destroy(std::move(doc));
+    }
+    reclaimer.flush();
+    EXPECT_EQ(reclaimer.pending(), 0U);
+}
+
+TEST(DeferredDestroyerTest, DestructorFreesWhatIsStillQueued) {
+    auto reclaimer = std::make_unique<DeferredDestroyer>();
+    for (int i = 0; i < 100; ++i) {
+        reclaimer->destroy(parse_document(R"({"a": [1, 2, {"b": "text"}]})"));
+    }
+    reclaimer.reset(); // Joins only after the queue is empty
+    SUCCEED();
+}
@@ -0,0 +1,162 @@
+#include <gtest/gtest.h>
+#include "jsom/jsom.hpp"
+#include "jsom/navigation_engine.hpp"
+#include "jsom/trace.hpp"
+#include <thread>
+#include <vector>
+
+using namespace jsom;
+
+// The ring buffer and drain callback work in every build; the hooks on parse, format,
+// to_json and navigation only record when JSOM_ENABLE_TRACING is defined.
+
+namespace {
+
+// Installs a callback collecting drained spans; removes it and clears the buffer on exit
+class TraceTest : public ::testing::Test {
+protected:
+    std::vector<trace::Span> drained;
+
+    void SetUp() override {
+        trace::clear();
+        trace::set_drain_callback([this](const trace::Span* spans, std::size_t count) {
+            drained.insert(drained.end(), spans, spans + count);
+        });
+    }
+
+    void TearDown() override {
+        trace::set_drain_callback(nullptr);
+        trace::clear();
+    }
+
+    auto spans_of(trace::SpanKind kind) -> std::vector<trace::Span> {
+        trace::flush();
+        std::vector<trace::Span> result;
+        for (const auto& span : drained) {
+            if (span.kind == kind) {
+                result.push_back(span);
+            }
+        }
+        return result;
+    }
+};
+
+auto make_span(std::size_t bytes) -> trace::Span {
+    trace::Span span;
+    span.kind = trace::SpanKind::Parse;
+    span.bytes = bytes;
+    return span;
+}
+
+} // namespace
+
+TEST_F(TraceTest, FlushDeliversSpansInOrder) {
+    trace::record(make_span(1));
+    trace::record(make_span(2));
+    EXPECT_EQ(trace::flush(), 2U);
+    ASSERT_EQ(drained.size(), 2U);
+    EXPECT_EQ(drained[0].bytes, 1U);
+    EXPECT_EQ(drained[1].bytes, 2U);
+    EXPECT_TRUE(trace::snapshot().empty());
+}
+
+TEST_F(TraceTest, FullBufferDrainsAutomatically) {
+    for (std::size_t i = 0; i <= trace_constants::RING_CAPACITY; ++i) {
+        trace::record(make_span(i));
+    }
+    ASSERT_EQ(drained.size(), trace_constants::RING_CAPACITY);
+    EXPECT_EQ(drained.back().bytes, trace_constants::RING_CAPACITY - 1);
+    EXPECT_EQ(trace::snapshot().size(), 1U);
+}
+
+TEST_F(TraceTest, WithoutCallbackKeepsMostRecentSpans) {
+    trace::set_drain_callback(nullptr);
+    constexpr std::size_t EXTRA = 10;
+    for (std::size_t i = 0; i < trace_constants::RING_CAPACITY + EXTRA; ++i) {
+        trace::record(make_span(i));
+    }
+    auto spans = trace::snapshot();
+    ASSERT_EQ(spans.size(), trace_constants::RING_CAPACITY);
+    EXPECT_EQ(spans.front().bytes, EXTRA);
+    EXPECT_EQ(spans.back().bytes, trace_constants::RING_CAPACITY + EXTRA - 1);
+    EXPECT_EQ(trace::flush(), 0U);
+}
+
+TEST_F(TraceTest, ThreadExitDrainsItsBuffer) {
+    std::thread worker([]() { trace::record(make_span(7)); });
+    worker.join();
+    ASSERT_EQ(drained.size(), 1U);
+    EXPECT_EQ(drained[0].bytes, 7U);
+}
+
+TEST_F(TraceTest, ScopedSpanRecordsDurationAndCounts) {
+    {
+        trace::ScopedSpan span(trace::SpanKind::Format, 3);
+        span.set_nodes(4);
+    }
+    auto spans = spans_of(trace::SpanKind::Format);
+    ASSERT_EQ(spans.size(), 1U);
+    EXPECT_EQ(spans[0].bytes, 3U);
+    EXPECT_EQ(spans[0].nodes, 4U);
+    EXPECT_GT(spans[0].start_ns, 0U);
+}
+
+#ifdef JSOM_ENABLE_TRACING
+
+TEST_F(TraceTest, ParseRecordsBytesAndValues) {
+    std::string json = R"({"a": [1, 2, 3], "b": "text"})";
+    auto doc = parse_document(json);
+    auto spans = spans_of(trace::SpanKind::Parse);
+    ASSERT_EQ(spans.size(), 1U);
+    EXPECT_EQ(spans[0].bytes, json.size());
+    EXPECT_EQ(spans[0].nodes, 6U); // Object, array, three numbers, string
+}
+
+TEST_F(TraceTest, SerializationRecordsOutputBytes) {
+    auto doc = parse_document(R"({"a": [1, 2, 3]})");
+    std::string compact = doc.to_json();
+    std::string pretty = doc.to_json(FormatPresets::Pretty);
+
+    auto to_json_spans = spans_of(trace::SpanKind::ToJson);
+    ASSERT_EQ(to_json_spans.size(), 1U);
+    EXPECT_EQ(to_json_spans[0].bytes, compact.size());
+
+    auto format_spans = spans_of(trace::SpanKind::Format);
+    ASSERT_EQ(format_spans.size(), 1U);
+    EXPECT_EQ(format_spans[0].bytes, pretty.size());
+    EXPECT_GE(format_spans[0].nodes, 5U); // Width measurement formats some values twice
+}
+
+TEST_F(TraceTest, NavigationRecordsPointerAndSteps) {
+    auto doc = parse_document(R"({"a": {"b": {"c": 1}}})");
+    PathCache cache;
+    NavigationEngine::navigate_with_cache(&doc, "/a/b/c", cache);
+    auto spans = spans_of(trace::SpanKind::Navigate);
+    ASSERT_EQ(spans.size(), 1U);
+    EXPECT_EQ(spans[0].bytes, 6U);
+    EXPECT_EQ(spans[0].nodes, 3U);
+}
+
+TEST_F(TraceTest, CacheEvictionIsRecorded) {
+    auto doc = parse_document(R"({"a": 1})");
+    PathCache cache;
+    for (std::size_t i = 0; i <= cache_constants::MAX_EXACT_CACHE_SIZE; ++i) {
+        cache.put_exact("/" + std::to_string(i), &doc);
+    }
+    auto spans = spans_of(trace::SpanKind::CacheEvict);
+    ASSERT_EQ(spans.size(), 1U);
+    EXPECT_EQ(spans[0].nodes, 1U);
+}
+
+#else
+
+TEST_F(TraceTest, HooksCompiledOutByDefault) {
+    auto doc = parse_document(R"({"a": [1, 2, 3]})");
+    auto output = doc.to_json(FormatPresets::Pretty);
+    EXPECT_FALSE(trace::ENABLED);
+    EXPECT_TRUE(trace::snapshot().empty());
+    EXPECT_EQ(trace::flush(), 0U);
+    EXPECT_TRUE(drained.empty());
+}
+
+#endif